@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImage_h
+#define itkBlockedImage_h
+
+#include "itkImageBase.h"
+#include "itkImportImageContainer.h"
+#include "itkDefaultPixelAccessor.h"
+#include "itkWeakPointer.h"
+
+namespace itk
+{
+/** \class BlockedImage
+ *  \brief Templated n-dimensional image class stored as cubic bricks.
+ *
+ * BlockedImage has the same geometry as Image, but its pixel container holds
+ * the buffered region as a grid of bricks of BrickEdgeLength pixels along
+ * every dimension. The bricks are stored one after the other, with the
+ * first dimension varying most rapidly, and the pixels of a brick are
+ * stored like those of a small Image. Pixels that are close along any
+ * dimension are therefore close in memory, which keeps sweeps along the
+ * slowest dimension and 3D kernels of large volumes in the cache.
+ *
+ * The bricks on the upper edges of the buffered region are padded, so the
+ * pixel container holds a whole number of bricks. BrickEdgeLength must be a
+ * power of two, and is applied by the next call to Allocate().
+ *
+ * Because the buffer is not a single row-major array, BlockedImage does not
+ * provide GetBufferPointer() and cannot be used with the iterators of Image.
+ * Use BlockedImageScanlineConstIterator and BlockedImageScanlineIterator,
+ * which visit a region brick by brick, and the ImageToBlockedImageFilter and
+ * BlockedImageToImageFilter to convert from and to Image. MedianImageFilter
+ * accepts a BlockedImage input and reads it brick by brick.
+ *
+ * \sa Image
+ * \sa BlockedImageScanlineConstIterator
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+template< typename TPixel, unsigned int VImageDimension = 3 >
+class BlockedImage:public ImageBase< VImageDimension >
+{
+public:
+  /** Standard class typedefs */
+  typedef BlockedImage                 Self;
+  typedef ImageBase< VImageDimension > Superclass;
+  typedef SmartPointer< Self >         Pointer;
+  typedef SmartPointer< const Self >   ConstPointer;
+  typedef WeakPointer< const Self >    ConstWeakPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(BlockedImage, ImageBase);
+
+  /** Pixel typedef support. */
+  typedef TPixel PixelType;
+  typedef TPixel ValueType;
+  typedef TPixel InternalPixelType;
+  typedef TPixel IOPixelType;
+
+  /** Accessor type that convert data between internal and external
+   *  representations. */
+  typedef DefaultPixelAccessor< PixelType > AccessorType;
+
+  /** Dimension of the image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, VImageDimension);
+
+  /** Superclass typedefs. */
+  typedef typename Superclass::IndexType        IndexType;
+  typedef typename Superclass::IndexValueType   IndexValueType;
+  typedef typename Superclass::OffsetType       OffsetType;
+  typedef typename Superclass::OffsetValueType  OffsetValueType;
+  typedef typename Superclass::SizeType         SizeType;
+  typedef typename Superclass::SizeValueType    SizeValueType;
+  typedef typename Superclass::DirectionType    DirectionType;
+  typedef typename Superclass::RegionType       RegionType;
+  typedef typename Superclass::SpacingType      SpacingType;
+  typedef typename Superclass::SpacingValueType SpacingValueType;
+  typedef typename Superclass::PointType        PointType;
+
+  /** Container used to store pixels in the image. */
+  typedef ImportImageContainer< SizeValueType, PixelType > PixelContainer;
+  typedef typename PixelContainer::Pointer                 PixelContainerPointer;
+  typedef typename PixelContainer::ConstPointer            PixelContainerConstPointer;
+
+  template <typename UPixelType, unsigned int UImageDimension = VImageDimension>
+  struct Rebind
+    {
+      typedef itk::BlockedImage<UPixelType, UImageDimension>  Type;
+    };
+
+  /** Set/Get the number of pixels along each edge of a brick. Must be a
+   * power of two. Defaults to 8. */
+  void SetBrickEdgeLength(unsigned int length);
+  itkGetConstMacro(BrickEdgeLength, unsigned int);
+
+  /** Set the region object that defines the size and starting index
+   * of the region of the image currently loaded in memory, and update the
+   * brick grid accordingly. */
+  virtual void SetBufferedRegion(const RegionType & region) ITK_OVERRIDE;
+
+  /** Allocate the image memory. The size of the image must
+   * already be set, e.g. by calling SetRegions(). */
+  virtual void Allocate(bool initializePixels = false) ITK_OVERRIDE;
+
+  /** Restore the data object to its initial state. This means releasing
+   * memory. */
+  virtual void Initialize() ITK_OVERRIDE;
+
+  /** Fill the image buffer with a value.  Be sure to call Allocate()
+   * first. */
+  void FillBuffer(const TPixel & value);
+
+  /** Compute the position in the pixel container of the pixel at index.
+   * This hides ImageBase::ComputeOffset(), which assumes a row-major
+   * buffer. */
+  OffsetValueType ComputeOffset(const IndexType & index) const
+  {
+    const IndexType & bufferedRegionIndex = this->GetBufferedRegion().GetIndex();
+
+    OffsetValueType brickOffset = 0;
+    OffsetValueType pixelOffset = 0;
+    for ( unsigned int i = 0; i < VImageDimension; ++i )
+      {
+      const OffsetValueType position = index[i] - bufferedRegionIndex[i];
+      brickOffset += ( position >> m_BrickShift ) * m_BrickOffsetTable[i];
+      pixelOffset += ( position & m_BrickMask ) << ( m_BrickShift * i );
+      }
+    return ( brickOffset << ( m_BrickShift * VImageDimension ) ) + pixelOffset;
+  }
+
+  /** Compute the index of the pixel stored at offset in the pixel
+   * container. This hides ImageBase::ComputeIndex(). */
+  IndexType ComputeIndex(OffsetValueType offset) const;
+
+  /** \brief Set a pixel value.
+   *
+   * Allocate() needs to have been called first -- for efficiency,
+   * this function does not check that the image has actually been
+   * allocated yet. */
+  void SetPixel(const IndexType & index, const TPixel & value)
+  {
+    ( *m_Buffer )[this->ComputeOffset(index)] = value;
+  }
+
+  /** \brief Get a pixel (read only version). */
+  const TPixel & GetPixel(const IndexType & index) const
+  {
+    return ( *m_Buffer )[this->ComputeOffset(index)];
+  }
+
+  /** \brief Get a reference to a pixel (e.g. for editing). */
+  TPixel & GetPixel(const IndexType & index)
+  {
+    return ( *m_Buffer )[this->ComputeOffset(index)];
+  }
+
+  /** \brief Access a pixel. This version can be an lvalue. */
+  TPixel & operator[](const IndexType & index)
+  { return this->GetPixel(index); }
+
+  /** \brief Access a pixel. This version can only be an rvalue. */
+  const TPixel & operator[](const IndexType & index) const
+  { return this->GetPixel(index); }
+
+  /** Return a pointer to the container. */
+  PixelContainer * GetPixelContainer()
+  { return m_Buffer.GetPointer(); }
+
+  const PixelContainer * GetPixelContainer() const
+  { return m_Buffer.GetPointer(); }
+
+  /** Set the container to use. The container must hold the bricks of the
+   * buffered region laid out for the current BrickEdgeLength. Note that
+   * this does not cause the DataObject to be modified. */
+  void SetPixelContainer(PixelContainer *container);
+
+  /** Number of bricks along each dimension of the buffered region. */
+  const SizeType & GetNumberOfBricks() const
+  { return m_NumberOfBricks; }
+
+  /** Return the region covered by the brick that holds index, cropped to
+   * the buffered region. */
+  RegionType GetBrickRegion(const IndexType & index) const;
+
+  /** Graft the data and information from one blocked image to another,
+   * sharing the pixel container. */
+  virtual void Graft(const DataObject *data) ITK_OVERRIDE;
+
+  /** Return the Pixel Accessor object */
+  AccessorType GetPixelAccessor(void)
+  { return AccessorType(); }
+
+  /** Return the Pixel Accesor object */
+  const AccessorType GetPixelAccessor(void) const
+  { return AccessorType(); }
+
+  virtual unsigned int GetNumberOfComponentsPerPixel() const ITK_OVERRIDE;
+
+protected:
+  BlockedImage();
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  virtual ~BlockedImage() {}
+
+  /** Compute the brick grid of the buffered region. */
+  void ComputeBrickOffsetTable();
+
+private:
+  BlockedImage(const Self &);          //purposely not implemented
+  void operator=(const Self &);        //purposely not implemented
+
+  /** Memory for the current buffer. */
+  PixelContainerPointer m_Buffer;
+
+  unsigned int    m_BrickEdgeLength;
+  unsigned int    m_BrickShift;
+  OffsetValueType m_BrickMask;
+
+  SizeType        m_NumberOfBricks;
+  OffsetValueType m_BrickOffsetTable[VImageDimension + 1];
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBlockedImage.hxx"
+#endif
+
+#endif
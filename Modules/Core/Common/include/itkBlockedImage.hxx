@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImage_hxx
+#define itkBlockedImage_hxx
+
+#include "itkBlockedImage.h"
+#include <algorithm>
+
+namespace itk
+{
+
+template< typename TPixel, unsigned int VImageDimension >
+BlockedImage< TPixel, VImageDimension >
+::BlockedImage() :
+  m_BrickEdgeLength( 8 ),
+  m_BrickShift( 3 ),
+  m_BrickMask( 7 )
+{
+  m_Buffer = PixelContainer::New();
+  m_NumberOfBricks.Fill( 0 );
+  std::fill_n( m_BrickOffsetTable, VImageDimension + 1, 0 );
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::SetBrickEdgeLength(unsigned int length)
+{
+  if ( length == 0 || ( length & ( length - 1 ) ) != 0 )
+    {
+    itkExceptionMacro( << "The brick edge length must be a power of two, not " << length );
+    }
+  if ( m_BrickEdgeLength != length )
+    {
+    m_BrickEdgeLength = length;
+    m_BrickShift = 0;
+    while ( ( 1u << m_BrickShift ) < length )
+      {
+      ++m_BrickShift;
+      }
+    m_BrickMask = static_cast< OffsetValueType >( length - 1 );
+    this->ComputeBrickOffsetTable();
+    this->Modified();
+    }
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::ComputeBrickOffsetTable()
+{
+  const SizeType & bufferedRegionSize = this->GetBufferedRegion().GetSize();
+
+  m_BrickOffsetTable[0] = 1;
+  for ( unsigned int i = 0; i < VImageDimension; ++i )
+    {
+    m_NumberOfBricks[i] = ( bufferedRegionSize[i] + m_BrickEdgeLength - 1 ) >> m_BrickShift;
+    m_BrickOffsetTable[i + 1] = m_BrickOffsetTable[i] * static_cast< OffsetValueType >( m_NumberOfBricks[i] );
+    }
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::SetBufferedRegion(const RegionType & region)
+{
+  Superclass::SetBufferedRegion(region);
+  this->ComputeBrickOffsetTable();
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::Allocate(bool initializePixels)
+{
+  this->ComputeOffsetTable();
+  this->ComputeBrickOffsetTable();
+
+  const SizeValueType num =
+    static_cast< SizeValueType >( m_BrickOffsetTable[VImageDimension] ) << ( m_BrickShift * VImageDimension );
+
+  m_Buffer->Reserve(num, initializePixels);
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::Initialize()
+{
+  //
+  // We don't modify ourselves because the "ReleaseData" methods depend upon
+  // no modification when initialized.
+  //
+
+  // Call the superclass which should initialize the BufferedRegion ivar.
+  Superclass::Initialize();
+  this->ComputeBrickOffsetTable();
+
+  // Replace the handle to the buffer. This is the safest thing to do,
+  // since the same container can be shared by multiple images (e.g.
+  // Grafted outputs and in place filters).
+  m_Buffer = PixelContainer::New();
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::FillBuffer(const TPixel & value)
+{
+  // the padding of the edge bricks is filled too
+  std::fill_n( m_Buffer->GetBufferPointer(), m_Buffer->Size(), value );
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+typename BlockedImage< TPixel, VImageDimension >::IndexType
+BlockedImage< TPixel, VImageDimension >
+::ComputeIndex(OffsetValueType offset) const
+{
+  const IndexType & bufferedRegionIndex = this->GetBufferedRegion().GetIndex();
+
+  const unsigned int brickVolumeShift = m_BrickShift * VImageDimension;
+  OffsetValueType    brickOffset = offset >> brickVolumeShift;
+  const OffsetValueType pixelOffset = offset & ( ( static_cast< OffsetValueType >( 1 ) << brickVolumeShift ) - 1 );
+
+  IndexType index;
+  for ( int i = VImageDimension - 1; i >= 0; --i )
+    {
+    const OffsetValueType brick = brickOffset / m_BrickOffsetTable[i];
+    brickOffset -= brick * m_BrickOffsetTable[i];
+    index[i] = bufferedRegionIndex[i] + ( brick << m_BrickShift )
+               + ( ( pixelOffset >> ( m_BrickShift * i ) ) & m_BrickMask );
+    }
+  return index;
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+typename BlockedImage< TPixel, VImageDimension >::RegionType
+BlockedImage< TPixel, VImageDimension >
+::GetBrickRegion(const IndexType & index) const
+{
+  const IndexType & bufferedRegionIndex = this->GetBufferedRegion().GetIndex();
+
+  IndexType brickIndex;
+  SizeType  brickSize;
+  for ( unsigned int i = 0; i < VImageDimension; ++i )
+    {
+    brickIndex[i] = bufferedRegionIndex[i] + ( ( index[i] - bufferedRegionIndex[i] ) & ~m_BrickMask );
+    brickSize[i] = m_BrickEdgeLength;
+    }
+
+  RegionType brickRegion( brickIndex, brickSize );
+  brickRegion.Crop( this->GetBufferedRegion() );
+  return brickRegion;
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::SetPixelContainer(PixelContainer *container)
+{
+  if ( m_Buffer != container )
+    {
+    m_Buffer = container;
+    this->Modified();
+    }
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::Graft(const DataObject *data)
+{
+  // call the superclass' implementation
+  Superclass::Graft(data);
+
+  if ( data )
+    {
+    // Attempt to cast data to a BlockedImage
+    const Self * const imgData = dynamic_cast< const Self * >( data );
+
+    if ( imgData != ITK_NULLPTR )
+      {
+      // Now copy anything remaining that is needed
+      this->SetBrickEdgeLength( imgData->GetBrickEdgeLength() );
+      this->SetPixelContainer( const_cast< PixelContainer * >
+                               ( imgData->GetPixelContainer() ) );
+      }
+    else
+      {
+      // pointer could not be cast back down
+      itkExceptionMacro( << "itk::BlockedImage::Graft() cannot cast "
+                         << typeid( data ).name() << " to "
+                         << typeid( const Self * ).name() );
+      }
+    }
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+unsigned int
+BlockedImage< TPixel, VImageDimension >
+::GetNumberOfComponentsPerPixel() const
+{
+  PixelType p;
+  return NumericTraits< PixelType >::GetLength(p);
+}
+
+
+template< typename TPixel, unsigned int VImageDimension >
+void
+BlockedImage< TPixel, VImageDimension >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BrickEdgeLength: " << m_BrickEdgeLength << std::endl;
+  os << indent << "NumberOfBricks: " << m_NumberOfBricks << std::endl;
+  os << indent << "PixelContainer: " << std::endl;
+  m_Buffer->Print( os, indent.GetNextIndent() );
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,158 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImageScanlineConstIterator_h
+#define itkBlockedImageScanlineConstIterator_h
+
+#include "itkBlockedImage.h"
+
+namespace itk
+{
+/** \class BlockedImageScanlineConstIterator
+ * \brief A multi-dimensional iterator templated over a BlockedImage that
+ * walks a region brick by brick, one line of a brick at a time.
+ *
+ * The region is visited one brick after the other, in the order the bricks
+ * are stored, and within each brick one line of pixels along the first
+ * dimension at a time, so the memory is read sequentially. A line never
+ * extends past the brick it belongs to.
+ *
+ * The iterator is used like ImageScanlineConstIterator:
+ *
+ * \code
+ *
+ * it.GoToBegin();
+ * while ( !it.IsAtEnd() )
+ *   {
+ *   while ( !it.IsAtEndOfLine() )
+ *     {
+ *     value = it.Get();
+ *     ++it;
+ *     }
+ *   it.NextLine();
+ *   }
+ *
+ * \endcode
+ *
+ * Iterating beyond the end of a line results in undefined behavior.
+ *
+ * \sa BlockedImageScanlineIterator
+ * \sa BlockedImage
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template< typename TImage >
+class BlockedImageScanlineConstIterator
+{
+public:
+  /** Standard class typedef. */
+  typedef BlockedImageScanlineConstIterator Self;
+
+  /** Dimension of the image the iterator walks. */
+  itkStaticConstMacro(ImageIteratorDimension, unsigned int, TImage::ImageDimension);
+
+  /** Image typedefs. */
+  typedef TImage                                ImageType;
+  typedef typename TImage::IndexType            IndexType;
+  typedef typename TImage::SizeType             SizeType;
+  typedef typename TImage::OffsetValueType      OffsetValueType;
+  typedef typename TImage::RegionType           RegionType;
+  typedef typename TImage::PixelType            PixelType;
+  typedef typename TImage::InternalPixelType    InternalPixelType;
+
+  /** Default Constructor. Need to provide a default constructor since we
+   * provide a copy constructor. */
+  BlockedImageScanlineConstIterator();
+
+  /** Constructor establishes an iterator to walk a particular image and a
+   * particular region of that image. */
+  BlockedImageScanlineConstIterator(const ImageType *ptr, const RegionType & region);
+
+  /** Move the iterator to the beginning of the region. */
+  void GoToBegin();
+
+  /** Is the iterator past the last line of the region? */
+  bool IsAtEnd() const
+  { return m_IsAtEnd; }
+
+  /** Is the iterator past the last pixel of the current line? */
+  bool IsAtEndOfLine() const
+  { return m_Position >= m_LineEnd; }
+
+  /** Move the iterator to the beginning of the next line, which is in the
+   * next brick after the last line of a brick. */
+  void NextLine();
+
+  /** Increment along the current line. */
+  Self & operator++()
+  {
+    itkAssertInDebugAndIgnoreInReleaseMacro( !this->IsAtEndOfLine() );
+    ++m_Position;
+    return *this;
+  }
+
+  /** Get the index of the current pixel. */
+  IndexType GetIndex() const
+  {
+    IndexType index = m_LineIndex;
+    index[0] += static_cast< typename IndexType::IndexValueType >( m_Position - m_LineBegin );
+    return index;
+  }
+
+  /** Get the part of the region inside the current brick. */
+  const RegionType & GetBrickRegion() const
+  { return m_BrickRegion; }
+
+  /** Get the value of the current pixel. */
+  const PixelType & Get() const
+  { return *m_Position; }
+
+  /** Get the region this iterator walks. */
+  const RegionType & GetRegion() const
+  { return m_Region; }
+
+protected:
+  /** Set up the lines of the current brick. */
+  void GoToBrick();
+
+  /** Point the iterator to the beginning of the line at m_LineIndex. */
+  void GoToLine();
+
+  typename TImage::ConstWeakPointer m_Image;
+
+  RegionType m_Region;
+  RegionType m_BrickRegion;
+
+  IndexType m_BrickIndex;
+  IndexType m_BeginBrickIndex;
+  IndexType m_EndBrickIndex;
+  IndexType m_LineIndex;
+
+  InternalPixelType *m_Buffer;
+  InternalPixelType *m_LineBegin;
+  InternalPixelType *m_LineEnd;
+  InternalPixelType *m_Position;
+
+  bool m_IsAtEnd;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBlockedImageScanlineConstIterator.hxx"
+#endif
+
+#endif
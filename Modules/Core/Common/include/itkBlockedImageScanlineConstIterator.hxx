@@ -0,0 +1,155 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImageScanlineConstIterator_hxx
+#define itkBlockedImageScanlineConstIterator_hxx
+
+#include "itkBlockedImageScanlineConstIterator.h"
+
+namespace itk
+{
+
+template< typename TImage >
+BlockedImageScanlineConstIterator< TImage >
+::BlockedImageScanlineConstIterator() :
+  m_Buffer( ITK_NULLPTR ),
+  m_LineBegin( ITK_NULLPTR ),
+  m_LineEnd( ITK_NULLPTR ),
+  m_Position( ITK_NULLPTR ),
+  m_IsAtEnd( true )
+{
+  m_BrickIndex.Fill( 0 );
+  m_BeginBrickIndex.Fill( 0 );
+  m_EndBrickIndex.Fill( 0 );
+  m_LineIndex.Fill( 0 );
+}
+
+
+template< typename TImage >
+BlockedImageScanlineConstIterator< TImage >
+::BlockedImageScanlineConstIterator(const ImageType *ptr, const RegionType & region) :
+  m_Image( ptr ),
+  m_Region( region ),
+  m_LineBegin( ITK_NULLPTR ),
+  m_LineEnd( ITK_NULLPTR ),
+  m_Position( ITK_NULLPTR ),
+  m_IsAtEnd( true )
+{
+  // the iterators write through the const image, like ImageConstIterator
+  m_Buffer = const_cast< ImageType * >( ptr )->GetPixelContainer()->GetBufferPointer();
+
+  const RegionType & bufferedRegion = ptr->GetBufferedRegion();
+  if ( region.GetNumberOfPixels() > 0 )
+    {
+    itkAssertOrThrowMacro( bufferedRegion.IsInside( region ),
+                           "Region " << region << " is outside of buffered region " << bufferedRegion );
+    }
+
+  const OffsetValueType brickMask = static_cast< OffsetValueType >( ptr->GetBrickEdgeLength() - 1 );
+  for ( unsigned int i = 0; i < ImageIteratorDimension; ++i )
+    {
+    const OffsetValueType begin = region.GetIndex(i) - bufferedRegion.GetIndex(i);
+    const OffsetValueType end = begin + static_cast< OffsetValueType >( region.GetSize(i) );
+    m_BeginBrickIndex[i] = bufferedRegion.GetIndex(i) + ( begin & ~brickMask );
+    m_EndBrickIndex[i] = bufferedRegion.GetIndex(i) + ( ( end + brickMask ) & ~brickMask );
+    }
+
+  this->GoToBegin();
+}
+
+
+template< typename TImage >
+void
+BlockedImageScanlineConstIterator< TImage >
+::GoToBegin()
+{
+  m_IsAtEnd = ( m_Region.GetNumberOfPixels() == 0 );
+  if ( m_IsAtEnd )
+    {
+    m_LineBegin = m_LineEnd = m_Position = m_Buffer;
+    return;
+    }
+  m_BrickIndex = m_BeginBrickIndex;
+  this->GoToBrick();
+}
+
+
+template< typename TImage >
+void
+BlockedImageScanlineConstIterator< TImage >
+::NextLine()
+{
+  // next line of the current brick
+  for ( unsigned int i = 1; i < ImageIteratorDimension; ++i )
+    {
+    ++m_LineIndex[i];
+    if ( m_LineIndex[i] < m_BrickRegion.GetIndex(i)
+         + static_cast< OffsetValueType >( m_BrickRegion.GetSize(i) ) )
+      {
+      this->GoToLine();
+      return;
+      }
+    m_LineIndex[i] = m_BrickRegion.GetIndex(i);
+    }
+
+  // first line of the next brick
+  const OffsetValueType brickEdgeLength = static_cast< OffsetValueType >( m_Image->GetBrickEdgeLength() );
+  for ( unsigned int i = 0; i < ImageIteratorDimension; ++i )
+    {
+    m_BrickIndex[i] += brickEdgeLength;
+    if ( m_BrickIndex[i] < m_EndBrickIndex[i] )
+      {
+      this->GoToBrick();
+      return;
+      }
+    m_BrickIndex[i] = m_BeginBrickIndex[i];
+    }
+
+  m_IsAtEnd = true;
+  m_LineBegin = m_LineEnd = m_Position;
+}
+
+
+template< typename TImage >
+void
+BlockedImageScanlineConstIterator< TImage >
+::GoToBrick()
+{
+  SizeType brickSize;
+  brickSize.Fill( m_Image->GetBrickEdgeLength() );
+
+  m_BrickRegion = RegionType( m_BrickIndex, brickSize );
+  m_BrickRegion.Crop( m_Region );
+
+  m_LineIndex = m_BrickRegion.GetIndex();
+  this->GoToLine();
+}
+
+
+template< typename TImage >
+void
+BlockedImageScanlineConstIterator< TImage >
+::GoToLine()
+{
+  m_LineBegin = m_Buffer + m_Image->ComputeOffset( m_LineIndex );
+  m_LineEnd = m_LineBegin + m_BrickRegion.GetSize(0);
+  m_Position = m_LineBegin;
+}
+
+} // end namespace itk
+
+#endif
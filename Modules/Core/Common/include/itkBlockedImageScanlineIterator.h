@@ -0,0 +1,74 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImageScanlineIterator_h
+#define itkBlockedImageScanlineIterator_h
+
+#include "itkBlockedImageScanlineConstIterator.h"
+
+namespace itk
+{
+/** \class BlockedImageScanlineIterator
+ * \brief A multi-dimensional iterator templated over a BlockedImage that
+ * walks a region brick by brick, one line of a brick at a time, and can
+ * write the pixels.
+ *
+ * \sa BlockedImageScanlineConstIterator
+ * \sa BlockedImage
+ * \ingroup ImageIterators
+ * \ingroup ITKCommon
+ */
+template< typename TImage >
+class BlockedImageScanlineIterator:public BlockedImageScanlineConstIterator< TImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef BlockedImageScanlineIterator                Self;
+  typedef BlockedImageScanlineConstIterator< TImage > Superclass;
+
+  /** Types inherited from the Superclass */
+  typedef typename Superclass::ImageType         ImageType;
+  typedef typename Superclass::RegionType        RegionType;
+  typedef typename Superclass::PixelType         PixelType;
+  typedef typename Superclass::InternalPixelType InternalPixelType;
+
+  /** Default constructor. Needed since we provide a cast constructor. */
+  BlockedImageScanlineIterator() {}
+
+  /** Constructor establishes an iterator to walk a particular image and a
+   * particular region of that image. */
+  BlockedImageScanlineIterator(ImageType *ptr, const RegionType & region) :
+    Superclass(ptr, region) {}
+
+  /** Set the value of the current pixel. */
+  void Set(const PixelType & value) const
+  { *this->m_Position = value; }
+
+  /** Return a reference to the current pixel. */
+  PixelType & Value()
+  { return *this->m_Position; }
+
+  /** Increment along the current line. */
+  Self & operator++()
+  {
+    Superclass::operator++();
+    return *this;
+  }
+};
+} // end namespace itk
+
+#endif
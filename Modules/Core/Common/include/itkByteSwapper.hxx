@@ -281,12 +281,16 @@ void
 ByteSwapper< T >
 ::Swap2Range(void *ptr, BufferSizeType num)
 {
+  // Swap whole words rather than single bytes so the compiler can
+  // turn the loop into vector byte shuffles. memcpy keeps the accesses
+  // valid for unaligned buffers.
   char * pos = reinterpret_cast< char * >( ptr );
   for ( BufferSizeType i = 0; i < num; i++ )
     {
-    const char one_byte = pos[0];
-    pos[0] = pos[1];
-    pos[1] = one_byte;
+    uint16_t word;
+    memcpy(&word, pos, 2);
+    word = static_cast< uint16_t >( ( word << 8 ) | ( word >> 8 ) );
+    memcpy(pos, &word, 2);
     pos = pos + 2;
     }
 }
@@ -307,14 +311,8 @@ ByteSwapper< T >
     {
     memcpy(cpy, ptr, chunkSize * 2);
 
-    char * pos = cpy;
-    for ( BufferSizeType i = 0; i < chunkSize; i++ )
-      {
-      const char one_byte = pos[0];
-      pos[0] = pos[1];
-      pos[1] = one_byte;
-      pos = pos + 2;
-      }
+    ByteSwapper< T >::Swap2Range( (void *)cpy, chunkSize );
+
     fp->write( (char *)cpy, static_cast<std::streamsize>(2 * chunkSize) );
     ptr = (char *)ptr + chunkSize * 2;
     num -= chunkSize;
@@ -352,17 +350,16 @@ void
 ByteSwapper< T >
 ::Swap4Range(void *ptr, BufferSizeType num)
 {
-  char *         pos = reinterpret_cast< char * >( ptr );
-
+  char * pos = reinterpret_cast< char * >( ptr );
   for ( BufferSizeType i = 0; i < num; i++ )
     {
-    char one_byte = pos[0];
-    pos[0] = pos[3];
-    pos[3] = one_byte;
-
-    one_byte = pos[1];
-    pos[1] = pos[2];
-    pos[2] = one_byte;
+    uint32_t word;
+    memcpy(&word, pos, 4);
+    word = ( word << 24 )
+           | ( ( word << 8 ) & 0x00ff0000u )
+           | ( ( word >> 8 ) & 0x0000ff00u )
+           | ( word >> 24 );
+    memcpy(pos, &word, 4);
     pos = pos + 4;
     }
 }
@@ -385,18 +382,8 @@ ByteSwapper< T >
     {
     memcpy(cpy, ptr, chunkSize * 4);
 
-    char * pos = cpy;
-    for ( BufferSizeType i = 0; i < chunkSize; i++ )
-      {
-      char one_byte = pos[0];
-      pos[0] = pos[3];
-      pos[3] = one_byte;
-
-      one_byte = pos[1];
-      pos[1] = pos[2];
-      pos[2] = one_byte;
-      pos = pos + 4;
-      }
+    ByteSwapper< T >::Swap4Range( (void *)cpy, chunkSize );
+
     fp->write( (char *)cpy, static_cast<std::streamsize>(4 * chunkSize) );
     ptr  = (char *)ptr + chunkSize * 4;
     num -= chunkSize;
@@ -442,25 +429,23 @@ void
 ByteSwapper< T >
 ::Swap8Range(void *ptr, BufferSizeType num)
 {
-  char *         pos = reinterpret_cast< char * >( ptr );
-
+  char * pos = reinterpret_cast< char * >( ptr );
   for ( BufferSizeType i = 0; i < num; i++ )
     {
-    char one_byte    = pos[0];
-    pos[0] = pos[7];
-    pos[7] = one_byte;
-
-    one_byte    = pos[1];
-    pos[1] = pos[6];
-    pos[6] = one_byte;
-
-    one_byte    = pos[2];
-    pos[2] = pos[5];
-    pos[5] = one_byte;
-
-    one_byte    = pos[3];
-    pos[3] = pos[4];
-    pos[4] = one_byte;
+    uint32_t low;
+    uint32_t high;
+    memcpy(&low, pos, 4);
+    memcpy(&high, pos + 4, 4);
+    low = ( low << 24 )
+          | ( ( low << 8 ) & 0x00ff0000u )
+          | ( ( low >> 8 ) & 0x0000ff00u )
+          | ( low >> 24 );
+    high = ( high << 24 )
+           | ( ( high << 8 ) & 0x00ff0000u )
+           | ( ( high >> 8 ) & 0x0000ff00u )
+           | ( high >> 24 );
+    memcpy(pos, &high, 4);
+    memcpy(pos + 4, &low, 4);
     pos = pos + 8;
     }
 }
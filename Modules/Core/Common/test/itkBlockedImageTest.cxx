@@ -0,0 +1,214 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+
+#include "itkBlockedImage.h"
+#include "itkBlockedImageScanlineIterator.h"
+
+namespace
+{
+typedef itk::BlockedImage< int, 3 > BlockedImageType;
+
+int PixelValue( const BlockedImageType::IndexType & index )
+{
+  return static_cast< int >( index[0] + 100 * index[1] + 10000 * index[2] );
+}
+
+// Checks that the iterators visit every pixel of the region once, brick by
+// brick, with the container read in increasing order.
+bool TestRegion( BlockedImageType * image, const BlockedImageType::RegionType & region )
+{
+  typedef itk::BlockedImageScanlineIterator< BlockedImageType >      IteratorType;
+  typedef itk::BlockedImageScanlineConstIterator< BlockedImageType > ConstIteratorType;
+
+  itk::SizeValueType count = 0;
+  IteratorType it( image, region );
+  it.GoToBegin();
+  while( !it.IsAtEnd() )
+    {
+    if( !image->GetBrickRegion( it.GetIndex() ).IsInside( it.GetBrickRegion() ) )
+      {
+      std::cerr << "Line at " << it.GetIndex() << " crosses a brick" << std::endl;
+      return false;
+      }
+    while( !it.IsAtEndOfLine() )
+      {
+      if( !region.IsInside( it.GetIndex() ) )
+        {
+        std::cerr << "Iterator left the region at " << it.GetIndex() << std::endl;
+        return false;
+        }
+      it.Set( -PixelValue( it.GetIndex() ) );
+      ++count;
+      ++it;
+      }
+    it.NextLine();
+    }
+
+  if( count != region.GetNumberOfPixels() )
+    {
+    std::cerr << "Visited " << count << " pixels of " << region << std::endl;
+    return false;
+    }
+
+  const BlockedImageType * constImage = image;
+  ConstIteratorType cit( constImage, region );
+  BlockedImageType::OffsetValueType previousOffset = -1;
+  BlockedImageType::OffsetValueType previousBrick = -1;
+  const BlockedImageType::OffsetValueType brickVolume = 4 * 4 * 4;
+  for( cit.GoToBegin(); !cit.IsAtEnd(); cit.NextLine() )
+    {
+    for( ; !cit.IsAtEndOfLine(); ++cit )
+      {
+      const BlockedImageType::OffsetValueType offset = constImage->ComputeOffset( cit.GetIndex() );
+      if( offset / brickVolume < previousBrick ||
+          ( offset / brickVolume == previousBrick && offset <= previousOffset ) )
+        {
+        std::cerr << "Pixel " << cit.GetIndex() << " visited out of order" << std::endl;
+        return false;
+        }
+      previousOffset = offset;
+      previousBrick = offset / brickVolume;
+
+      if( cit.Get() != -PixelValue( cit.GetIndex() ) || constImage->GetPixel( cit.GetIndex() ) != cit.Get() )
+        {
+        std::cerr << "Wrong value at " << cit.GetIndex() << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkBlockedImageTest( int, char* [] )
+{
+  BlockedImageType::Pointer image = BlockedImageType::New();
+
+  // a power of two is required
+  bool caught = false;
+  try
+    {
+    image->SetBrickEdgeLength( 6 );
+    }
+  catch( itk::ExceptionObject & )
+    {
+    caught = true;
+    }
+  if( !caught || image->GetBrickEdgeLength() != 8 )
+    {
+    std::cerr << "SetBrickEdgeLength accepted an edge length of 6" << std::endl;
+    return EXIT_FAILURE;
+    }
+  image->SetBrickEdgeLength( 4 );
+
+  // a size that is not a multiple of the brick edge length
+  BlockedImageType::IndexType start = {{ -3, 2, 5 }};
+  BlockedImageType::SizeType  size = {{ 19, 13, 9 }};
+  BlockedImageType::RegionType bufferedRegion( start, size );
+  image->SetRegions( bufferedRegion );
+  image->Allocate();
+  image->FillBuffer( 0 );
+
+  const BlockedImageType::SizeType & numberOfBricks = image->GetNumberOfBricks();
+  if( numberOfBricks[0] != 5 || numberOfBricks[1] != 4 || numberOfBricks[2] != 3 ||
+      image->GetPixelContainer()->Size() != 5 * 4 * 3 * 64 )
+    {
+    std::cerr << "Wrong brick grid " << numberOfBricks << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // every pixel has its own place in the container
+  std::vector< char > used( image->GetPixelContainer()->Size(), 0 );
+  BlockedImageType::IndexType index;
+  for( index[2] = start[2]; index[2] < start[2] + 9; ++index[2] )
+    {
+    for( index[1] = start[1]; index[1] < start[1] + 13; ++index[1] )
+      {
+      for( index[0] = start[0]; index[0] < start[0] + 19; ++index[0] )
+        {
+        const BlockedImageType::OffsetValueType offset = image->ComputeOffset( index );
+        if( offset < 0 || offset >= static_cast< BlockedImageType::OffsetValueType >( used.size() ) || used[offset] )
+          {
+          std::cerr << "Bad offset " << offset << " for " << index << std::endl;
+          return EXIT_FAILURE;
+          }
+        used[offset] = 1;
+        if( image->ComputeIndex( offset ) != index )
+          {
+          std::cerr << "ComputeIndex( " << offset << " ) returned " << image->ComputeIndex( offset )
+                    << " instead of " << index << std::endl;
+          return EXIT_FAILURE;
+          }
+        image->SetPixel( index, PixelValue( index ) );
+        }
+      }
+    }
+
+  for( index[2] = start[2]; index[2] < start[2] + 9; ++index[2] )
+    {
+    for( index[1] = start[1]; index[1] < start[1] + 13; ++index[1] )
+      {
+      for( index[0] = start[0]; index[0] < start[0] + 19; ++index[0] )
+        {
+        if( ( *image )[index] != PixelValue( index ) )
+          {
+          std::cerr << "Wrong value at " << index << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  // whole buffered region, and a region that starts and ends inside bricks
+  if( !TestRegion( image, bufferedRegion ) )
+    {
+    return EXIT_FAILURE;
+    }
+  BlockedImageType::IndexType subStart = {{ 2, 3, 6 }};
+  BlockedImageType::SizeType  subSize = {{ 9, 7, 6 }};
+  if( !TestRegion( image, BlockedImageType::RegionType( subStart, subSize ) ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // an empty region
+  BlockedImageType::SizeType emptySize = {{ 0, 3, 3 }};
+  itk::BlockedImageScanlineConstIterator< BlockedImageType > emptyIt( image, BlockedImageType::RegionType( subStart, emptySize ) );
+  if( !emptyIt.IsAtEnd() )
+    {
+    std::cerr << "Iterator over an empty region is not at end" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // grafting shares the bricks
+  BlockedImageType::Pointer grafted = BlockedImageType::New();
+  grafted->Graft( image );
+  if( grafted->GetBrickEdgeLength() != 4 || grafted->GetPixel( subStart ) != image->GetPixel( subStart ) ||
+      grafted->GetPixelContainer() != image->GetPixelContainer() )
+    {
+    std::cerr << "Graft failed" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  image->Print( std::cout );
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
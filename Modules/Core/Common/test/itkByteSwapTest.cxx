@@ -17,6 +17,8 @@
  *=========================================================================*/
 
 #include <iostream>
+#include <vector>
+#include <cstring>
 #include "itkByteSwapper.h"
 
 int itkByteSwapTest ( int, char*[] )
@@ -166,6 +168,66 @@ int itkByteSwapTest ( int, char*[] )
     (&err)->Print(std::cerr);
     return EXIT_FAILURE;
     }
+  // Range swapping must match swapping the words one by one, also
+  // when the buffer is not aligned on the word size.
+  const unsigned int rangeSize = 1001;
+  std::vector< char > buffer(8 * rangeSize + 8);
+  for ( size_t i = 0; i < buffer.size(); ++i )
+    {
+    buffer[i] = static_cast< char >( 3 * i + 1 );
+    }
+  char *unaligned = &buffer[1];
+
+  unsigned short usRange[rangeSize];
+  unsigned int   uiRange[rangeSize];
+  double         dRange[rangeSize];
+  memcpy(usRange, unaligned, sizeof( usRange ));
+  memcpy(uiRange, unaligned, sizeof( uiRange ));
+  memcpy(dRange, unaligned, sizeof( dRange ));
+  for ( unsigned int i = 0; i < rangeSize; ++i )
+    {
+    itk::ByteSwapper<unsigned short>::SwapFromSystemToBigEndian( &usRange[i] );
+    itk::ByteSwapper<unsigned short>::SwapFromSystemToLittleEndian( &usRange[i] );
+    itk::ByteSwapper<unsigned int>::SwapFromSystemToBigEndian( &uiRange[i] );
+    itk::ByteSwapper<unsigned int>::SwapFromSystemToLittleEndian( &uiRange[i] );
+    itk::ByteSwapper<double>::SwapFromSystemToBigEndian( &dRange[i] );
+    itk::ByteSwapper<double>::SwapFromSystemToLittleEndian( &dRange[i] );
+    }
+
+  std::vector< char > swapped(buffer);
+  itk::ByteSwapper<unsigned short>::SwapRangeFromSystemToBigEndian(
+    reinterpret_cast< unsigned short * >( &swapped[1] ), rangeSize );
+  itk::ByteSwapper<unsigned short>::SwapRangeFromSystemToLittleEndian(
+    reinterpret_cast< unsigned short * >( &swapped[1] ), rangeSize );
+  if ( memcmp(&swapped[1], usRange, sizeof( usRange )) != 0 )
+    {
+    std::cout << "Failed unsigned short range swap" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  swapped = buffer;
+  itk::ByteSwapper<unsigned int>::SwapRangeFromSystemToBigEndian(
+    reinterpret_cast< unsigned int * >( &swapped[1] ), rangeSize );
+  itk::ByteSwapper<unsigned int>::SwapRangeFromSystemToLittleEndian(
+    reinterpret_cast< unsigned int * >( &swapped[1] ), rangeSize );
+  if ( memcmp(&swapped[1], uiRange, sizeof( uiRange )) != 0 )
+    {
+    std::cout << "Failed unsigned int range swap" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  swapped = buffer;
+  itk::ByteSwapper<double>::SwapRangeFromSystemToBigEndian(
+    reinterpret_cast< double * >( &swapped[1] ), rangeSize );
+  itk::ByteSwapper<double>::SwapRangeFromSystemToLittleEndian(
+    reinterpret_cast< double * >( &swapped[1] ), rangeSize );
+  if ( memcmp(&swapped[1], dRange, sizeof( dRange )) != 0 )
+    {
+    std::cout << "Failed double range swap" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Passed range swaps" << std::endl;
+
   // we failed to throw an exception for the double swap (once it's implemented, this should return 0
   return EXIT_SUCCESS;
 
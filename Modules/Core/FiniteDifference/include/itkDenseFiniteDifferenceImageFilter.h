@@ -61,6 +61,14 @@ namespace itk
  * subclass it to a specific instance that supplies a function and Halt()
  * method.
  *
+ * \par Fused update
+ * When the subclass allows it (see CanUseFusedUpdate()) and UseFusedUpdate
+ * is on, each iteration computes the change of a pixel and writes the
+ * updated value directly into a second image, which is then swapped with
+ * the output. The change is never stored, so the volume is only read and
+ * written once per iteration. The result is identical to the two pass
+ * update.
+ *
  * \ingroup ImageFilters
  * \sa FiniteDifferenceImageFilter
  * \ingroup ITKFiniteDifference
@@ -114,9 +122,19 @@ public:
   // End concept checking
 #endif
 
+  /** Set/Get whether the change and the update are computed in a single
+   * pass. Only used when CanUseFusedUpdate() returns true. On by
+   * default. */
+  itkSetMacro(UseFusedUpdate, bool);
+  itkGetConstMacro(UseFusedUpdate, bool);
+  itkBooleanMacro(UseFusedUpdate);
+
 protected:
   DenseFiniteDifferenceImageFilter()
-  { m_UpdateBuffer = UpdateBufferType::New(); }
+  {
+    m_UpdateBuffer = UpdateBufferType::New();
+    m_UseFusedUpdate = true;
+  }
   ~DenseFiniteDifferenceImageFilter() {}
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
@@ -164,6 +182,22 @@ protected:
   TimeStepType ThreadedCalculateChange(const ThreadRegionType & regionToProcess,
                                        ThreadIdType threadId);
 
+  /** Whether the fused update can be used. Subclasses return true when
+   * the time step of their difference function does not depend on the
+   * computed changes and when they do not customize the change
+   * calculation, the update or the update buffer. Returns false by
+   * default. */
+  virtual bool CanUseFusedUpdate() const
+  { return false; }
+
+  /** Compute the next value of each pixel of a region in a single pass,
+   * writing it to the update buffer.
+   * \sa CalculateChange */
+  virtual
+  void ThreadedFusedUpdate(const TimeStepType & dt,
+                           const ThreadRegionType & regionToProcess,
+                           ThreadIdType threadId);
+
 private:
   DenseFiniteDifferenceImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);                   //purposely not implemented
@@ -185,8 +219,19 @@ private:
    * which it then passes to ThreadedCalculateChange for processing. */
   static ITK_THREAD_RETURN_TYPE CalculateChangeThreaderCallback(void *arg);
 
-  /** The buffer that holds the updates for an iteration of the algorithm. */
+  /** This callback method uses SplitRequestedRegion to acquire a region
+   * which it then passes to ThreadedFusedUpdate for processing. */
+  static ITK_THREAD_RETURN_TYPE FusedUpdateThreaderCallback(void *arg);
+
+  /** Whether the current iteration uses the fused update. */
+  bool IsFusedUpdate() const
+  { return m_UseFusedUpdate && this->CanUseFusedUpdate(); }
+
+  /** The buffer that holds the updates for an iteration of the algorithm,
+   * or the next state of the output with the fused update. */
   typename UpdateBufferType::Pointer m_UpdateBuffer;
+
+  bool m_UseFusedUpdate;
 };
 } // end namespace itk
 
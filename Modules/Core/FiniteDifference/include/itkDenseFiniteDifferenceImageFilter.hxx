@@ -85,6 +85,18 @@ void
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::ApplyUpdate(const TimeStepType& dt)
 {
+  if ( this->IsFusedUpdate() )
+    {
+    // CalculateChange() already wrote the next state to the update
+    // buffer, swap it with the output.
+    OutputImageType *output = this->GetOutput();
+    typename OutputImageType::PixelContainerPointer state = output->GetPixelContainer();
+    output->SetPixelContainer( m_UpdateBuffer->GetPixelContainer() );
+    m_UpdateBuffer->SetPixelContainer(state);
+    output->Modified();
+    return;
+    }
+
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
@@ -138,6 +150,27 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
+  if ( this->IsFusedUpdate() )
+    {
+    // The time step does not depend on the changes, ask for it before
+    // computing them.
+    const typename FiniteDifferenceFunctionType::Pointer df = this->GetDifferenceFunction();
+    void *globalData = df->GetGlobalDataPointer();
+    str.TimeStepList.assign( 1, df->ComputeGlobalTimeStep(globalData) );
+    str.ValidTimeStepList.assign( 1, true );
+    df->ReleaseGlobalDataPointer(globalData);
+
+    str.Filter = this;
+    str.TimeStep = this->ResolveTimeStep( str.TimeStepList, str.ValidTimeStepList );
+    this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+    this->GetMultiThreader()->SetSingleMethod(this->FusedUpdateThreaderCallback,
+                                              &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+
+    this->m_UpdateBuffer->Modified();
+    return str.TimeStep;
+    }
+
   str.Filter = this;
   str.TimeStep = NumericTraits< TimeStepType >::ZeroValue();  // Not used during the
   // calculate change step.
@@ -202,6 +235,31 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   return ITK_THREAD_RETURN_VALUE;
 }
 
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_TYPE
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::FusedUpdateThreaderCallback(void *arg)
+{
+  ThreadIdType threadId = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->ThreadID;
+  ThreadIdType threadCount = ( (MultiThreader::ThreadInfoStruct *)( arg ) )->NumberOfThreads;
+
+  DenseFDThreadStruct * str = (DenseFDThreadStruct *)
+      ( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
+
+  ThreadRegionType splitRegion;
+
+  ThreadIdType total = str->Filter->SplitRequestedRegion( threadId,
+                                                 threadCount,
+                                                 splitRegion );
+
+  if ( threadId < total )
+    {
+    str->Filter->ThreadedFusedUpdate(str->TimeStep, splitRegion, threadId);
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
@@ -300,12 +358,66 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   return timeStep;
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ThreadedFusedUpdate(const TimeStepType & dt,
+                      const ThreadRegionType & regionToProcess,
+                      ThreadIdType)
+{
+  typedef typename OutputImageType::SizeType                      SizeType;
+  typedef typename FiniteDifferenceFunctionType::NeighborhoodType NeighborhoodIteratorType;
+
+  typedef ImageRegionIterator< UpdateBufferType > UpdateIteratorType;
+
+  typename OutputImageType::Pointer output = this->GetOutput();
+
+  const typename FiniteDifferenceFunctionType::Pointer
+      df = this->GetDifferenceFunction();
+
+  const SizeType radius = df->GetRadius();
+
+  void * globalData = df->GetGlobalDataPointer();
+
+  typedef NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< OutputImageType >
+  FaceCalculatorType;
+
+  typedef typename FaceCalculatorType::FaceListType FaceListType;
+
+  FaceCalculatorType faceCalculator;
+
+  FaceListType faceList = faceCalculator(output, regionToProcess, radius);
+
+  // The first face is free of boundary conditions. The next value is
+  // computed exactly as ThreadedApplyUpdate() would from the change.
+  for ( typename FaceListType::iterator fIt = faceList.begin(); fIt != faceList.end(); ++fIt )
+    {
+    NeighborhoodIteratorType nD(radius, output, *fIt);
+    UpdateIteratorType       nU(m_UpdateBuffer, *fIt);
+
+    nD.GoToBegin();
+    nU.GoToBegin();
+    while ( !nD.IsAtEnd() )
+      {
+      const PixelType change = df->ComputeUpdate(nD, globalData);
+      PixelType       next = nD.GetCenterPixel();
+      next += static_cast< PixelType >( change * dt );
+      nU.Value() = next;
+      ++nD;
+      ++nU;
+      }
+    }
+
+  df->ReleaseGlobalDataPointer(globalData);
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "UseFusedUpdate: " << m_UseFusedUpdate << std::endl;
 }
 } // end namespace itk
 
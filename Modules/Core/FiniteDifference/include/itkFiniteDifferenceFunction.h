@@ -182,6 +182,15 @@ public:
    * to which the pointer points. */
   virtual void ReleaseGlobalDataPointer(void *GlobalData) const = 0;
 
+  /** Folds the values accumulated in OtherGlobalData into GlobalData, so
+   * that a solver which splits an iteration over several global data
+   * structures computes the same time step as it would with a single one.
+   * Returns false if the equation does not support merging, in which case
+   * the solver falls back to the smallest of the individual time steps. */
+  virtual bool MergeGlobalData( void *itkNotUsed(GlobalData),
+                                const void *itkNotUsed(OtherGlobalData) ) const
+  { return false; }
+
 protected:
   FiniteDifferenceFunction();
   ~FiniteDifferenceFunction() {}
@@ -145,6 +145,11 @@ protected:
   /** Prepare for the iteration process. */
   virtual void InitializeIteration() ITK_OVERRIDE;
 
+  /** The time step is fixed, so the change and the update of each
+   * iteration can be computed in a single pass. */
+  virtual bool CanUseFusedUpdate() const ITK_OVERRIDE
+  { return true; }
+
   bool m_GradientMagnitudeIsFixed;
 
 private:
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkCurvatureAnisotropicDiffusionImageFilter.h"
+#include "itkVectorGradientAnisotropicDiffusionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace
+{
+template< typename TImage >
+typename TImage::Pointer
+MakeFusedUpdateTestImage()
+{
+  typename TImage::SizeType size;
+  size[0] = 23;
+  size[1] = 19;
+  size[2] = 17;
+
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  // a bright ball on a ramp with some deterministic noise
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const typename TImage::IndexType idx = it.GetIndex();
+    const double dx = idx[0] - 11.0;
+    const double dy = idx[1] - 9.0;
+    const double dz = idx[2] - 8.0;
+    double value = idx[0] + 0.5 * idx[1];
+    if ( dx * dx + dy * dy + dz * dz < 36.0 )
+      {
+      value += 50.0;
+      }
+    value += ( ( idx[0] * 7 + idx[1] * 13 + idx[2] * 29 ) % 11 ) * 0.3;
+
+    it.Set( static_cast< typename TImage::PixelType >( value ) );
+    }
+  return image;
+}
+
+// Run the filter with and without the fused update and compare.
+template< typename TFilter >
+bool
+CompareFusedUpdate(const char *name)
+{
+  typedef typename TFilter::InputImageType  ImageType;
+  typedef typename TFilter::OutputImageType OutputImageType;
+
+  typename ImageType::Pointer image = MakeFusedUpdateTestImage< ImageType >();
+
+  typename OutputImageType::Pointer outputs[2];
+  for ( unsigned int fused = 0; fused < 2; ++fused )
+    {
+    typename TFilter::Pointer filter = TFilter::New();
+    filter->SetInput(image);
+    filter->SetNumberOfIterations(5);
+    filter->SetTimeStep(0.0625);
+    filter->SetConductanceParameter(2.0);
+    filter->SetConductanceScalingUpdateInterval(2);
+    filter->SetNumberOfThreads(3);
+    filter->SetUseFusedUpdate( fused == 1 );
+    filter->Update();
+    outputs[fused] = filter->GetOutput();
+    outputs[fused]->DisconnectPipeline();
+    }
+
+  itk::ImageRegionConstIterator< OutputImageType > it0( outputs[0], outputs[0]->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< OutputImageType > it1( outputs[1], outputs[1]->GetLargestPossibleRegion() );
+  for ( ; !it0.IsAtEnd(); ++it0, ++it1 )
+    {
+    if ( it0.Get() != it1.Get() )
+      {
+      std::cerr << name << ": fused update differs at " << it0.GetIndex()
+                << ": " << it0.Get() << " != " << it1.Get() << std::endl;
+      return false;
+      }
+    }
+  std::cout << name << ": passed" << std::endl;
+  return true;
+}
+}
+
+int itkAnisotropicDiffusionFusedUpdateTest(int, char *[] )
+{
+  typedef itk::Image< float, 3 >                        ImageType;
+  typedef itk::Image< itk::Vector< float, 2 >, 3 >      VectorImageType;
+
+  bool pass = true;
+  pass &= CompareFusedUpdate< itk::GradientAnisotropicDiffusionImageFilter< ImageType, ImageType > >
+    ("GradientAnisotropicDiffusion");
+  pass &= CompareFusedUpdate< itk::CurvatureAnisotropicDiffusionImageFilter< ImageType, ImageType > >
+    ("CurvatureAnisotropicDiffusion");
+  pass &= CompareFusedUpdate< itk::VectorGradientAnisotropicDiffusionImageFilter< VectorImageType, VectorImageType > >
+    ("VectorGradientAnisotropicDiffusion");
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
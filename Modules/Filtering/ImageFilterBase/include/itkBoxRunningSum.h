@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBoxRunningSum_h
+#define itkBoxRunningSum_h
+
+#include "itkImageRegionConstIterator.h"
+#include "itkVector.h"
+#include <algorithm>
+#include <vector>
+
+namespace itk
+{
+namespace Functor
+{
+/** \class BoxSumValue
+ * \brief Converts a pixel to the type summed by BoxRunningSum.
+ * \ingroup ITKImageFilterBase
+ */
+template< typename TInput, typename TOutput >
+class BoxSumValue
+{
+public:
+  inline TOutput operator()(const TInput & value) const
+  {
+    return static_cast< TOutput >( value );
+  }
+};
+
+/** \class BoxSumValueAndSquare
+ * \brief Converts a scalar pixel to its value and its square, so that
+ * BoxRunningSum computes the sum and the sum of squares together.
+ * \ingroup ITKImageFilterBase
+ */
+template< typename TInput, typename TOutput >
+class BoxSumValueAndSquare
+{
+public:
+  inline Vector< TOutput, 2 > operator()(const TInput & value) const
+  {
+    Vector< TOutput, 2 > result;
+    result[0] = static_cast< TOutput >( value );
+    result[1] = result[0] * result[0];
+    return result;
+  }
+};
+} // end namespace Functor
+
+/** \brief Computes the sums over a box neighborhood of every pixel of a
+ * region with running sums.
+ *
+ * For each index of region, sums the values of functor(pixel) over the
+ * box of the given radius centered on the index. Indices of the box that
+ * lie outside the buffered region of the image are clamped to it, as the
+ * ZeroFluxNeumannBoundaryCondition does, so the result only depends on the
+ * buffered pixels and the function can be used on a streamed piece of an
+ * image.
+ *
+ * The box is summed one dimension at a time, and along each dimension the
+ * sum is updated by adding the pixel entering the box and subtracting the
+ * pixel leaving it. The cost per pixel therefore does not depend on the
+ * radius. The intermediate sums are kept in buffers that cover region
+ * padded by radius, and the loops run over the first dimension innermost.
+ *
+ * On return, sums holds the sums over region in the order of an
+ * ImageRegionIterator. TValue must support +=, -= and copy assignment,
+ * and functor must convert the image pixel to TValue.
+ *
+ * \ingroup ITKImageFilterBase
+ */
+template< typename TImage, typename TValue, typename TFunctor >
+void
+BoxRunningSum(const TImage *image,
+              const typename TImage::RegionType & region,
+              const typename TImage::SizeType & radius,
+              TFunctor functor,
+              std::vector< TValue > & sums)
+{
+  typedef typename TImage::RegionType RegionType;
+  const unsigned int ImageDimension = TImage::ImageDimension;
+
+  sums.clear();
+  if ( region.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const RegionType & bufferedRegion = image->GetBufferedRegion();
+
+  // The clamped indices of the boxes of region all lie in this region.
+  RegionType current = region;
+  current.PadByRadius(radius);
+  current.Crop(bufferedRegion);
+
+  std::vector< TValue > source;
+  source.reserve( current.GetNumberOfPixels() );
+  ImageRegionConstIterator< TImage > it(image, current);
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    source.push_back( functor( it.Get() ) );
+    }
+
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    // Only dimension d shrinks from the padded to the output range.
+    RegionType next = current;
+    next.SetIndex( d, region.GetIndex(d) );
+    next.SetSize( d, region.GetSize(d) );
+
+    SizeValueType inner = 1;
+    for ( unsigned int i = 0; i < d; ++i )
+      {
+      inner *= current.GetSize(i);
+      }
+    SizeValueType outer = 1;
+    for ( unsigned int i = d + 1; i < ImageDimension; ++i )
+      {
+      outer *= current.GetSize(i);
+      }
+
+    const OffsetValueType r = static_cast< OffsetValueType >( radius[d] );
+    const OffsetValueType sourceBegin = current.GetIndex(d);
+    const OffsetValueType bufferedBegin = bufferedRegion.GetIndex(d);
+    const OffsetValueType bufferedLast =
+      bufferedBegin + static_cast< OffsetValueType >( bufferedRegion.GetSize(d) ) - 1;
+    const OffsetValueType begin = region.GetIndex(d);
+    const OffsetValueType length = static_cast< OffsetValueType >( region.GetSize(d) );
+    const SizeValueType   sourceLength = current.GetSize(d);
+
+    std::vector< TValue > target;
+    target.resize( next.GetNumberOfPixels() );
+
+    for ( SizeValueType o = 0; o < outer; ++o )
+      {
+      // Rows of inner contiguous values, one per position along d.
+      const TValue *sourceSlab = &source[0] + o * sourceLength * inner;
+      TValue       *targetSlab = &target[0] + o * static_cast< SizeValueType >( length ) * inner;
+
+      // Sum of the first box, computed directly.
+      TValue *row = targetSlab;
+      const TValue *first = sourceSlab + ( std::max( begin - r, bufferedBegin ) - sourceBegin ) * inner;
+      for ( SizeValueType i = 0; i < inner; ++i )
+        {
+        row[i] = first[i];
+        }
+      for ( OffsetValueType k = begin - r + 1; k <= begin + r; ++k )
+        {
+        const TValue *add =
+          sourceSlab + ( std::min( std::max( k, bufferedBegin ), bufferedLast ) - sourceBegin ) * inner;
+        for ( SizeValueType i = 0; i < inner; ++i )
+          {
+          row[i] += add[i];
+          }
+        }
+
+      // Slide the box along d.
+      for ( OffsetValueType x = begin + 1; x < begin + length; ++x )
+        {
+        const TValue *previous = row;
+        row += inner;
+        const TValue *add =
+          sourceSlab + ( std::min( x + r, bufferedLast ) - sourceBegin ) * inner;
+        const TValue *remove =
+          sourceSlab + ( std::max( x - r - 1, bufferedBegin ) - sourceBegin ) * inner;
+        for ( SizeValueType i = 0; i < inner; ++i )
+          {
+          row[i] = previous[i];
+          row[i] += add[i];
+          row[i] -= remove[i];
+          }
+        }
+      }
+
+    source.swap(target);
+    current = next;
+    }
+
+  sums.swap(source);
+}
+} // end namespace itk
+
+#endif
@@ -35,6 +35,10 @@ namespace itk
  * to the neighborhood and calculating the standard deviation of the
  * residuals to this (hyper) plane.
  *
+ * When the radius is larger than one along some dimension, the sums are
+ * computed with running sums (see BoxRunningSum), so their cost does not
+ * grow with the radius.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -109,6 +113,11 @@ protected:
                             ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
+  /** Computes the output of the thread with BoxRunningSum, used when the
+   * radius is larger than one along some dimension. */
+  void ThreadedGenerateDataWithRunningSums(const OutputImageRegionType & outputRegionForThread,
+                                           ThreadIdType threadId);
+
   NoiseImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);   //purposely not implemented
 };
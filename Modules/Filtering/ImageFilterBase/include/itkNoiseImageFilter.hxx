@@ -25,6 +25,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "itkBoxRunningSum.h"
 
 namespace itk
 {
@@ -39,6 +40,17 @@ NoiseImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
+  // The running sums pay off as soon as the box is wider than three
+  // pixels along some dimension.
+  for ( unsigned int d = 0; d < InputImageDimension; ++d )
+    {
+    if ( this->GetRadius()[d] > 1 )
+      {
+      this->ThreadedGenerateDataWithRunningSums(outputRegionForThread, threadId);
+      return;
+      }
+    }
+
   unsigned int i;
 
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
@@ -100,6 +112,46 @@ NoiseImageFilter< TInputImage, TOutputImage >
       }
     }
 }
+
+template< typename TInputImage, typename TOutputImage >
+void
+NoiseImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataWithRunningSums(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId)
+{
+  typedef Vector< InputRealType, 2 > SumsType;
+
+  typename OutputImageType::Pointer output = this->GetOutput();
+  typename  InputImageType::ConstPointer input  = this->GetInput();
+
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  // Sums of the values and of their squares
+  std::vector< SumsType > sums;
+  BoxRunningSum( input.GetPointer(), outputRegionForThread, this->GetRadius(),
+                 Functor::BoxSumValueAndSquare< InputPixelType, InputRealType >(), sums );
+
+  InputRealType num = NumericTraits< InputRealType >::OneValue();
+  for ( unsigned int d = 0; d < InputImageDimension; ++d )
+    {
+    num *= static_cast< InputRealType >( 2 * this->GetRadius()[d] + 1 );
+    }
+
+  ImageRegionIterator< OutputImageType > it(output, outputRegionForThread);
+  typename std::vector< SumsType >::const_iterator sum = sums.begin();
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it, ++sum )
+    {
+    // calculate the standard deviation value. The running sums may leave
+    // a tiny negative variance on flat neighborhoods.
+    InputRealType var = ( ( *sum )[1] - ( ( *sum )[0] * ( *sum )[0] / num ) ) / ( num - 1.0 );
+    if ( var < NumericTraits< InputRealType >::ZeroValue() )
+      {
+      var = NumericTraits< InputRealType >::ZeroValue();
+      }
+    it.Set( static_cast< OutputPixelType >( std::sqrt(var) ) );
+    progress.CompletedPixel();
+    }
+}
 } // end namespace itk
 
 #endif
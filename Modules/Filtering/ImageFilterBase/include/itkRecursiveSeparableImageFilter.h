@@ -45,6 +45,13 @@ namespace itk
  * G. Farneback & C.-F. Westin, "On Implementation of Recursive Gaussian
  * Filters", so far unpublished.
  *
+ * When the filter is applied along any direction but the first, the lines
+ * are strided in memory. In that case NumberOfLinesPerBlock lines that are
+ * adjacent along the first direction are read together, so every access
+ * to the image walks a contiguous run of pixels, and the recurrences of
+ * the block run side by side in an interleaved buffer. Setting
+ * NumberOfLinesPerBlock to 1 filters one line at a time.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -89,6 +96,11 @@ public:
   /** Set the direction in which the filter is to be applied. */
   itkSetMacro(Direction, unsigned int);
 
+  /** Set/Get the number of lines filtered together when the direction is
+   * not the first one. Defaults to 8. */
+  itkSetClampMacro(NumberOfLinesPerBlock, unsigned int, 1, NumericTraits< unsigned int >::max());
+  itkGetConstMacro(NumberOfLinesPerBlock, unsigned int);
+
   /** Set Input Image. */
   void SetInputImage(const TInputImage *);
 
@@ -133,6 +145,13 @@ protected:
   void FilterDataArray(RealType *outs, const RealType *data, RealType *scratch,
                        SizeValueType ln);
 
+  /** Apply the Recursive Filter to a block of numberOfLines lines of
+   * length ln at once. The arrays are interleaved: sample i of line b is at
+   * i * numberOfLines + b. Each line gets the same result as
+   * FilterDataArray. */
+  void FilterDataBlock(RealType *outs, const RealType *data, RealType *scratch,
+                       SizeValueType ln, SizeValueType numberOfLines);
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -232,6 +251,11 @@ private:
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction;
 
+  unsigned int m_NumberOfLinesPerBlock;
+
+  /** Filter the lines of the region in blocks of adjacent lines. */
+  void ThreadedGenerateDataInBlocks(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId);
+
   ImageRegionSplitterDirection::Pointer m_ImageRegionSplitter;
 };
 } // end namespace itk
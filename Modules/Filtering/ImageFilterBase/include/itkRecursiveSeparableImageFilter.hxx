@@ -21,8 +21,10 @@
 #include "itkRecursiveSeparableImageFilter.h"
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 #include <new>
+#include <algorithm>
 
 namespace itk
 {
@@ -50,6 +52,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   m_BM3( 0.0 ),
   m_BM4( 0.0 ),
   m_Direction( 0 ),
+  m_NumberOfLinesPerBlock( 8 ),
   m_ImageRegionSplitter(ImageRegionSplitterDirection::New())
 {
   this->SetNumberOfRequiredOutputs(1);
@@ -170,6 +173,129 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     }
 }
 
+/**
+ * Apply Recursive Filter to a block of interleaved lines
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::FilterDataBlock(RealType *outs, const RealType *data,
+                  RealType *scratch, SizeValueType ln, SizeValueType numberOfLines)
+{
+  const SizeValueType nl = numberOfLines;
+
+  RealType * scratch1 = outs;
+  RealType * scratch2 = scratch;
+
+  /**
+   * Causal direction pass
+   */
+  {
+  // rows of samples 0 to 3 of the block
+  const RealType *d0 = data;
+  const RealType *d1 = d0 + nl;
+  const RealType *d2 = d1 + nl;
+  const RealType *d3 = d2 + nl;
+  RealType       *s0 = scratch1;
+  RealType       *s1 = s0 + nl;
+  RealType       *s2 = s1 + nl;
+  RealType       *s3 = s2 + nl;
+
+  for ( SizeValueType b = 0; b < nl; ++b )
+    {
+    // this value is assumed to exist from the border to infinity.
+    const RealType &outV1 = d0[b];
+
+    MathEMAMAMAM( s0[b], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3 );
+    MathEMAMAMAM( s1[b], d1[b], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3 );
+    MathEMAMAMAM( s2[b], d2[b], m_N0, d1[b], m_N1, outV1, m_N2, outV1, m_N3 );
+    MathEMAMAMAM( s3[b], d3[b], m_N0, d2[b], m_N1, d1[b], m_N2, outV1, m_N3 );
+
+    MathSMAMAMAM( s0[b], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM( s1[b], s0[b], m_D1 , outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM( s2[b], s1[b], m_D1 , s0[b], m_D2 , outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM( s3[b], s2[b], m_D1 , s1[b], m_D2 , s0[b], m_D3 , outV1, m_BN4);
+    }
+  }
+
+  // The loops over b are innermost, so that the recurrences of the lines
+  // of the block advance together on consecutive memory.
+  for ( SizeValueType i = 4; i < ln; i++ )
+    {
+    const RealType *d0 = data + i * nl;
+    const RealType *d1 = d0 - nl;
+    const RealType *d2 = d1 - nl;
+    const RealType *d3 = d2 - nl;
+    RealType       *s0 = scratch1 + i * nl;
+    const RealType *s1 = s0 - nl;
+    const RealType *s2 = s1 - nl;
+    const RealType *s3 = s2 - nl;
+    const RealType *s4 = s3 - nl;
+    for ( SizeValueType b = 0; b < nl; ++b )
+      {
+      MathEMAMAMAM( s0[b], d0[b], m_N0, d1[b], m_N1, d2[b], m_N2, d3[b], m_N3);
+      MathSMAMAMAM( s0[b], s1[b], m_D1, s2[b], m_D2, s3[b], m_D3, s4[b], m_D4);
+      }
+    }
+
+  /**
+   * AntiCausal direction pass
+   */
+  {
+  // rows of samples ln - 1 to ln - 4 of the block
+  const RealType *d0 = data + ( ln - 1 ) * nl;
+  const RealType *d1 = d0 - nl;
+  const RealType *d2 = d1 - nl;
+  RealType       *s0 = scratch2 + ( ln - 1 ) * nl;
+  RealType       *s1 = s0 - nl;
+  RealType       *s2 = s1 - nl;
+  RealType       *s3 = s2 - nl;
+
+  for ( SizeValueType b = 0; b < nl; ++b )
+    {
+    // this value is assumed to exist from the border to infinity.
+    const RealType &outV2 = d0[b];
+
+    MathEMAMAMAM( s0[b], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM( s1[b], d0[b], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM( s2[b], d1[b], m_M1, d0[b], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM( s3[b], d2[b], m_M1, d1[b], m_M2, d0[b], m_M3, outV2, m_M4);
+
+    MathSMAMAMAM( s0[b], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM( s1[b], s0[b], m_D1 , outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM( s2[b], s1[b], m_D1 , s0[b], m_D2 , outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM( s3[b], s2[b], m_D1 , s1[b], m_D2 , s0[b], m_D3 , outV2, m_BM4);
+    }
+  }
+
+  for ( SizeValueType i = ln - 4; i > 0; i-- )
+    {
+    const RealType *d0 = data + i * nl;
+    const RealType *d1 = d0 + nl;
+    const RealType *d2 = d1 + nl;
+    const RealType *d3 = d2 + nl;
+    const RealType *s1 = scratch2 + i * nl;
+    RealType       *s0 = scratch2 + ( i - 1 ) * nl;
+    const RealType *s2 = s1 + nl;
+    const RealType *s3 = s2 + nl;
+    const RealType *s4 = s3 + nl;
+    for ( SizeValueType b = 0; b < nl; ++b )
+      {
+      MathEMAMAMAM( s0[b], d0[b], m_M1, d1[b], m_M2, d2[b], m_M3, d3[b], m_M4);
+      MathSMAMAMAM( s0[b], s1[b], m_D1, s2[b], m_D2, s3[b], m_D3, s4[b], m_D4);
+      }
+    }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  const SizeValueType numberOfSamples = ln * nl;
+  for ( SizeValueType i = 0; i < numberOfSamples; i++ )
+    {
+    outs[i] += scratch2[i];
+    }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -255,6 +381,12 @@ void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
 {
+  if ( this->m_Direction != 0 && this->m_NumberOfLinesPerBlock > 1 )
+    {
+    this->ThreadedGenerateDataInBlocks(outputRegionForThread, threadId);
+    return;
+    }
+
   typedef typename TOutputImage::PixelType OutputPixelType;
 
   typedef ImageLinearConstIteratorWithIndex< TInputImage > InputConstIteratorType;
@@ -337,6 +469,120 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   delete[] scratch;
 }
 
+/**
+ * Compute Recursive filter on blocks of lines that are adjacent along the
+ * first dimension
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataInBlocks(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  typedef ImageScanlineConstIterator< TInputImage > InputConstIteratorType;
+  typedef ImageScanlineIterator< TOutputImage >     OutputIteratorType;
+  typedef ImageLinearConstIteratorWithIndex< TOutputImage > LineIteratorType;
+
+  typename TInputImage::ConstPointer inputImage( this->GetInputImage () );
+  typename TOutputImage::Pointer     outputImage( this->GetOutput() );
+
+  const SizeValueType ln = outputRegionForThread.GetSize(this->m_Direction);
+  const SizeValueType width = outputRegionForThread.GetSize(0);
+  const SizeValueType blockSize = std::min( static_cast< SizeValueType >( this->m_NumberOfLinesPerBlock ), width );
+
+  if ( ln == 0 || width == 0 )
+    {
+    return;
+    }
+
+  // One pixel of each row along the first dimension, for each position
+  // of the lines in the remaining dimensions.
+  OutputImageRegionType rowRegion = outputRegionForThread;
+  rowRegion.SetSize(0, 1);
+  rowRegion.SetSize(this->m_Direction, 1);
+
+  typename OutputImageRegionType::SizeType lineSize;
+  lineSize.Fill(1);
+  lineSize[this->m_Direction] = ln;
+
+  RealType *inps = ITK_NULLPTR;
+  RealType *outs = ITK_NULLPTR;
+  RealType *scratch = ITK_NULLPTR;
+
+  try
+    {
+    inps = new RealType[ln * blockSize];
+    outs = new RealType[ln * blockSize];
+    scratch = new RealType[ln * blockSize];
+
+    const SizeValueType numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / ln;
+    ProgressReporter   progress(this, threadId, numberOfLinesToProcess, 10);
+
+    // A linear iterator along a dimension of size one visits each index of
+    // the region once, one per line.
+    LineIteratorType rowIterator(outputImage, rowRegion);
+    rowIterator.SetDirection(0);
+    for ( rowIterator.GoToBegin(); !rowIterator.IsAtEnd(); rowIterator.NextLine() )
+      {
+      OutputImageRegionType blockRegion( rowIterator.GetIndex(), lineSize );
+
+      for ( SizeValueType first = 0; first < width; first += blockSize )
+        {
+        const SizeValueType numberOfLines = std::min( blockSize, width - first );
+        blockRegion.SetIndex( 0, outputRegionForThread.GetIndex(0) + static_cast< OffsetValueType >( first ) );
+        blockRegion.SetSize(0, numberOfLines);
+
+        // The scanlines of the block run along the first dimension, so the
+        // block is read transposed: sample i of line b lands at
+        // i * numberOfLines + b.
+        InputConstIteratorType inputIterator(inputImage, blockRegion);
+        RealType *inp = inps;
+        while ( !inputIterator.IsAtEnd() )
+          {
+          while ( !inputIterator.IsAtEndOfLine() )
+            {
+            *inp++ = inputIterator.Get();
+            ++inputIterator;
+            }
+          inputIterator.NextLine();
+          }
+
+        this->FilterDataBlock(outs, inps, scratch, ln, numberOfLines);
+
+        OutputIteratorType outputIterator(outputImage, blockRegion);
+        const RealType *out = outs;
+        while ( !outputIterator.IsAtEnd() )
+          {
+          while ( !outputIterator.IsAtEndOfLine() )
+            {
+            outputIterator.Set( static_cast< OutputPixelType >( *out++ ) );
+            ++outputIterator;
+            }
+          outputIterator.NextLine();
+          }
+
+        for ( SizeValueType b = 0; b < numberOfLines; ++b )
+          {
+          progress.CompletedPixel();
+          }
+        }
+      }
+    }
+  catch (...)
+    {
+    delete[] outs;
+    delete[] inps;
+    delete[] scratch;
+
+    throw;
+    }
+
+  delete[] outs;
+  delete[] inps;
+  delete[] scratch;
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
@@ -345,6 +591,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Direction: " << m_Direction << std::endl;
+  os << indent << "NumberOfLinesPerBlock: " << m_NumberOfLinesPerBlock << std::endl;
 }
 } // end namespace itk
 
@@ -0,0 +1,56 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBlockedImageToImageFilter_hxx
+#define itkBlockedImageToImageFilter_hxx
+
+#include "itkBlockedImageToImageFilter.h"
+#include "itkBlockedImageScanlineConstIterator.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage >
+void
+BlockedImageToImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType itkNotUsed(threadId))
+{
+  const InputImageType *input = this->GetInput();
+  OutputImageType      *output = this->GetOutput();
+
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  OutputImagePixelType *outputBuffer = output->GetBufferPointer();
+
+  BlockedImageScanlineConstIterator< InputImageType > inIt(input, outputRegionForThread);
+  for ( inIt.GoToBegin(); !inIt.IsAtEnd(); inIt.NextLine() )
+    {
+    OutputImagePixelType *out = outputBuffer + output->ComputeOffset( inIt.GetIndex() );
+    while ( !inIt.IsAtEndOfLine() )
+      {
+      *out = static_cast< OutputImagePixelType >( inIt.Get() );
+      ++out;
+      ++inIt;
+      }
+    }
+}
+} // end namespace itk
+
+#endif
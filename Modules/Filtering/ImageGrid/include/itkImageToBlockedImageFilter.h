@@ -0,0 +1,104 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageToBlockedImageFilter_h
+#define itkImageToBlockedImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace itk
+{
+/** \class ImageToBlockedImageFilter
+ * \brief Copies an image into the brick layout of a BlockedImage.
+ *
+ * The output is a BlockedImage whose bricks have BrickEdgeLength pixels
+ * along each axis. The input must be an image with a row-major buffer,
+ * such as itk::Image. Each thread fills its region one brick scanline at
+ * a time, so the writes follow the output buffer.
+ *
+ * \sa BlockedImageToImageFilter
+ * \sa BlockedImage
+ *
+ * \ingroup ITKImageGrid
+ */
+template< typename TInputImage, typename TOutputImage >
+class ImageToBlockedImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageToBlockedImageFilter                       Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageToBlockedImageFilter, ImageToImageFilter);
+
+  /** Image typedefs. */
+  typedef TInputImage                          InputImageType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename InputImageType::PixelType   InputImagePixelType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** Set/Get the edge length of the output bricks. Must be a power of
+   * two. Defaults to 8. */
+  itkSetMacro(BrickEdgeLength, unsigned int);
+  itkGetConstMacro(BrickEdgeLength, unsigned int);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro( InputConvertibleToOutputCheck,
+                   ( Concept::Convertible< InputImagePixelType, OutputImagePixelType > ) );
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< InputImageDimension, OutputImageDimension > ) );
+  // End concept checking
+#endif
+
+protected:
+  ImageToBlockedImageFilter();
+  ~ImageToBlockedImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  virtual void GenerateOutputInformation() ITK_OVERRIDE;
+
+  virtual void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                    ThreadIdType threadId) ITK_OVERRIDE;
+
+private:
+  ImageToBlockedImageFilter(const Self &); //purposely not implemented
+  void operator=(const Self &);            //purposely not implemented
+
+  unsigned int m_BrickEdgeLength;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkImageToBlockedImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageToBlockedImageFilter_hxx
+#define itkImageToBlockedImageFilter_hxx
+
+#include "itkImageToBlockedImageFilter.h"
+#include "itkBlockedImageScanlineIterator.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage >
+ImageToBlockedImageFilter< TInputImage, TOutputImage >
+::ImageToBlockedImageFilter() :
+  m_BrickEdgeLength(8)
+{
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+ImageToBlockedImageFilter< TInputImage, TOutputImage >
+::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  OutputImageType *output = this->GetOutput();
+  if ( output )
+    {
+    output->SetBrickEdgeLength(m_BrickEdgeLength);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+ImageToBlockedImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType itkNotUsed(threadId))
+{
+  const InputImageType *input = this->GetInput();
+  OutputImageType      *output = this->GetOutput();
+
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const InputImagePixelType *inputBuffer = input->GetBufferPointer();
+
+  BlockedImageScanlineIterator< OutputImageType > outIt(output, outputRegionForThread);
+  for ( outIt.GoToBegin(); !outIt.IsAtEnd(); outIt.NextLine() )
+    {
+    // Lines never cross a brick, so the input pixels of a line are
+    // contiguous as well.
+    const InputImagePixelType *in = inputBuffer + input->ComputeOffset( outIt.GetIndex() );
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      outIt.Set( static_cast< OutputImagePixelType >( *in ) );
+      ++in;
+      ++outIt;
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+ImageToBlockedImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "BrickEdgeLength: " << m_BrickEdgeLength << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,110 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+
+#include "itkImageToBlockedImageFilter.h"
+#include "itkBlockedImageToImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+int itkBlockedImageConversionTest(int, char* [])
+{
+  typedef itk::Image< short, 3 >        ImageType;
+  typedef itk::BlockedImage< float, 3 > BlockedImageType;
+
+  ImageType::IndexType start;
+  start[0] = -2;
+  start[1] = 3;
+  start[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 21;
+  size[1] = 10;
+  size[2] = 7;
+  ImageType::RegionType region(start, size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it(image, region);
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set( static_cast< short >( index[0] + 30 * index[1] - 300 * index[2] ) );
+    }
+
+  typedef itk::ImageToBlockedImageFilter< ImageType, BlockedImageType > ToBlockedType;
+  typedef itk::BlockedImageToImageFilter< BlockedImageType, ImageType > FromBlockedType;
+
+  const unsigned int edgeLengths[] = { 1, 4, 8 };
+  const unsigned int numberOfThreads[] = { 1, 3, 5 };
+  for ( unsigned int e = 0; e < 3; ++e )
+    {
+    for ( unsigned int t = 0; t < 3; ++t )
+      {
+      ToBlockedType::Pointer toBlocked = ToBlockedType::New();
+      toBlocked->SetInput(image);
+      toBlocked->SetBrickEdgeLength(edgeLengths[e]);
+      toBlocked->SetNumberOfThreads(numberOfThreads[t]);
+
+      FromBlockedType::Pointer fromBlocked = FromBlockedType::New();
+      fromBlocked->SetInput( toBlocked->GetOutput() );
+      fromBlocked->SetNumberOfThreads(numberOfThreads[t]);
+
+      try
+        {
+        fromBlocked->Update();
+        }
+      catch ( itk::ExceptionObject & excp )
+        {
+        std::cerr << excp << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      const BlockedImageType *blocked = toBlocked->GetOutput();
+      if ( blocked->GetBrickEdgeLength() != edgeLengths[e] )
+        {
+        std::cerr << "Brick edge length " << blocked->GetBrickEdgeLength()
+                  << " instead of " << edgeLengths[e] << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      const ImageType *output = fromBlocked->GetOutput();
+      if ( output->GetBufferedRegion() != region )
+        {
+        std::cerr << "Round trip region " << output->GetBufferedRegion() << std::endl;
+        return EXIT_FAILURE;
+        }
+      for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+        {
+        const ImageType::IndexType & index = it.GetIndex();
+        if ( blocked->GetPixel(index) != static_cast< float >( it.Get() )
+             || output->GetPixel(index) != it.Get() )
+          {
+          std::cerr << "Mismatch at " << index << " with edge length "
+                    << edgeLengths[e] << " and " << numberOfThreads[t]
+                    << " threads" << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -49,6 +49,12 @@ namespace itk
  * threaded. It computes statistics in each thread then combines them in
  * its AfterThreadedGenerate method.
  *
+ * Each thread accumulates the pixels of a run of equal labels on a line
+ * at once, so the per label lookup is done once per run rather than once
+ * per pixel. Integral labels in a compact range are looked up in a dense
+ * table, and the others in a hash map. The per thread results are merged
+ * on several threads, each one handling a subset of the labels.
+ *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
  *
@@ -353,9 +359,68 @@ private:
   LabelStatisticsImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);             //purposely not implemented
 
-  std::vector< MapType >        m_LabelStatisticsPerThread;
-  MapType                       m_LabelStatistics;
-  ValidLabelValuesContainerType m_ValidLabelValues;
+  typedef typename HistogramType::AbsoluteFrequencyType AbsoluteFrequencyType;
+
+  /** Statistics accumulated by a thread for a label. The histogram
+   * frequencies are stored in the Frequencies container of the thread,
+   * starting at FrequencyOffset. */
+  struct LabelAccumulator
+  {
+    LabelPixelType Label;
+    IdentifierType Count;
+    RealType       Minimum;
+    RealType       Maximum;
+    RealType       Sum;
+    RealType       SumOfSquares;
+    IndexValueType BoundingBox[2 * ImageDimension];
+    SizeValueType  FrequencyOffset;
+  };
+
+  typedef std::vector< LabelAccumulator >                   LabelAccumulatorVectorType;
+  typedef itksys::hash_map< LabelPixelType, SizeValueType > LabelPositionMapType;
+
+  /** All the labels accumulated by a thread. The labels in the dense
+   * range are found through DenseLookup, where 0 is used for the labels
+   * not seen yet and the position in Labels + 1 otherwise. */
+  struct ThreadAccumulator
+  {
+    LabelAccumulatorVectorType           Labels;
+    std::vector< SizeValueType >         DenseLookup;
+    LabelPositionMapType                 SparseLookup;
+    std::vector< AbsoluteFrequencyType > Frequencies;
+  };
+
+  /** Returns the position of the label in the accumulator of the
+   * thread, adding the label if needed. */
+  SizeValueType FindOrInsertLabel(ThreadAccumulator & accumulator, const LabelPixelType & label) const;
+
+  /** Adds an empty entry for the label and returns its position. */
+  SizeValueType AddLabel(ThreadAccumulator & accumulator, const LabelPixelType & label) const;
+
+  /** Returns true and sets key if the label is in the dense range. */
+  bool GetDenseKey(const LabelPixelType & label, SizeValueType & key) const;
+
+  typedef std::vector< std::pair< LabelPixelType, LabelStatistics > > LabelStatisticsVectorType;
+
+  /** Structure for passing information into the merging threads. */
+  struct MergeThreadStruct {
+    Self *                                   Filter;
+    ThreadIdType                             NumberOfPartitions;
+    std::vector< LabelStatisticsVectorType > Statistics;
+  };
+
+  /** Returns the partition in which the label is merged. */
+  ThreadIdType GetLabelPartition(const LabelPixelType & label, ThreadIdType numberOfPartitions) const;
+
+  /** Merges the accumulators of all the threads for the labels of a
+   * partition, and computes their final statistics. */
+  void ThreadedMergeLabels(MergeThreadStruct *str, ThreadIdType partition);
+
+  static ITK_THREAD_RETURN_TYPE MergeThreaderCallback(void *arg);
+
+  std::vector< ThreadAccumulator > m_ThreadAccumulators;
+  MapType                          m_LabelStatistics;
+  ValidLabelValuesContainerType    m_ValidLabelValues;
 
   bool m_UseHistograms;
 
@@ -364,6 +429,15 @@ private:
   RealType            m_LowerBound;
   RealType            m_UpperBound;
   SimpleFastMutexLock m_Mutex;
+
+  /** Histogram used to find the bin of the pixels in all the threads. */
+  HistogramPointer m_BinningHistogram;
+
+  /** Labels in [m_DenseLabelMinimum, m_DenseLabelMinimum + m_DenseLabelRange)
+   * are looked up in the dense table. m_DenseLabelRange is 0 for non
+   * integral label types. */
+  LabelPixelType m_DenseLabelMinimum;
+  SizeValueType  m_DenseLabelRange;
 }; // end of class
 } // end namespace itk
 
@@ -19,7 +19,6 @@
 #define itkLabelStatisticsImageFilter_hxx
 #include "itkLabelStatisticsImageFilter.h"
 
-#include "itkImageLinearConstIteratorWithIndex.h"
 #include "itkImageScanlineConstIterator.h"
 #include "itkProgressReporter.h"
 
@@ -36,6 +35,8 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
   m_LowerBound = static_cast< RealType >( NumericTraits< PixelType >::NonpositiveMin() );
   m_UpperBound = static_cast< RealType >( NumericTraits< PixelType >::max() );
   m_ValidLabelValues.clear();
+  m_DenseLabelMinimum = NumericTraits< LabelPixelType >::ZeroValue();
+  m_DenseLabelRange = 0;
 }
 
 template< typename TInputImage, typename TLabelImage >
@@ -79,17 +80,131 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
 {
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
 
-  // Resize the thread temporaries
-  m_LabelStatisticsPerThread.resize(numberOfThreads);
+  // Reset the thread temporaries
+  m_ThreadAccumulators.clear();
+  m_ThreadAccumulators.resize(numberOfThreads);
 
-  // Initialize the temporaries
-  for ( ThreadIdType i = 0; i < numberOfThreads; ++i )
+  // Initialize the final map
+  m_LabelStatistics.clear();
+
+  // All the histograms share the same bins, so a single histogram is
+  // enough to find the bin of a pixel
+  if ( m_UseHistograms )
     {
-    m_LabelStatisticsPerThread[i].clear();
+    m_BinningHistogram = LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound).m_Histogram;
+    }
+  else
+    {
+    m_BinningHistogram = ITK_NULLPTR;
     }
 
-  // Initialize the final map
-  m_LabelStatistics.clear();
+  // The dense table covers all the values of the small integral label
+  // types, and the first values of the larger ones, where the labels
+  // produced by a connected component labeling are.
+  m_DenseLabelMinimum = NumericTraits< LabelPixelType >::ZeroValue();
+  m_DenseLabelRange = 0;
+  if ( NumericTraits< LabelPixelType >::is_integer )
+    {
+    if ( sizeof( LabelPixelType ) <= 2 )
+      {
+      m_DenseLabelMinimum = NumericTraits< LabelPixelType >::NonpositiveMin();
+      m_DenseLabelRange = static_cast< SizeValueType >( NumericTraits< LabelPixelType >::max() - m_DenseLabelMinimum ) + 1;
+      }
+    else
+      {
+      m_DenseLabelRange = 1 << 20;
+      }
+    }
+}
+
+template< typename TInputImage, typename TLabelImage >
+bool
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::GetDenseKey(const LabelPixelType & label, SizeValueType & key) const
+{
+  if ( m_DenseLabelRange == 0 || label < m_DenseLabelMinimum )
+    {
+    return false;
+    }
+  key = static_cast< SizeValueType >( label - m_DenseLabelMinimum );
+  return key < m_DenseLabelRange;
+}
+
+template< typename TInputImage, typename TLabelImage >
+SizeValueType
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::AddLabel(ThreadAccumulator & accumulator, const LabelPixelType & label) const
+{
+  LabelAccumulator labelStats;
+
+  labelStats.Label = label;
+  labelStats.Count = NumericTraits< IdentifierType >::ZeroValue();
+  labelStats.Sum = NumericTraits< RealType >::ZeroValue();
+  labelStats.SumOfSquares = NumericTraits< RealType >::ZeroValue();
+
+  // Set such that the first pixel encountered can be compared
+  labelStats.Minimum = NumericTraits< RealType >::max();
+  labelStats.Maximum = NumericTraits< RealType >::NonpositiveMin();
+  for ( unsigned int i = 0; i < 2 * ImageDimension; i += 2 )
+    {
+    labelStats.BoundingBox[i] = NumericTraits< IndexValueType >::max();
+    labelStats.BoundingBox[i + 1] = NumericTraits< IndexValueType >::NonpositiveMin();
+    }
+
+  labelStats.FrequencyOffset = accumulator.Frequencies.size();
+  if ( m_UseHistograms )
+    {
+    accumulator.Frequencies.resize( labelStats.FrequencyOffset + m_NumBins[0],
+                                    NumericTraits< AbsoluteFrequencyType >::ZeroValue() );
+    }
+
+  accumulator.Labels.push_back(labelStats);
+  return accumulator.Labels.size() - 1;
+}
+
+template< typename TInputImage, typename TLabelImage >
+SizeValueType
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::FindOrInsertLabel(ThreadAccumulator & accumulator, const LabelPixelType & label) const
+{
+  SizeValueType key;
+
+  if ( this->GetDenseKey(label, key) )
+    {
+    if ( key >= accumulator.DenseLookup.size() )
+      {
+      accumulator.DenseLookup.resize(key + 1, 0);
+      }
+    if ( accumulator.DenseLookup[key] == 0 )
+      {
+      accumulator.DenseLookup[key] = this->AddLabel(accumulator, label) + 1;
+      }
+    return accumulator.DenseLookup[key] - 1;
+    }
+
+  typename LabelPositionMapType::const_iterator mapIt = accumulator.SparseLookup.find(label);
+  if ( mapIt != accumulator.SparseLookup.end() )
+    {
+    return mapIt->second;
+    }
+  const SizeValueType position = this->AddLabel(accumulator, label);
+  accumulator.SparseLookup.insert( typename LabelPositionMapType::value_type(label, position) );
+  return position;
+}
+
+template< typename TInputImage, typename TLabelImage >
+ThreadIdType
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::GetLabelPartition(const LabelPixelType & label, ThreadIdType numberOfPartitions) const
+{
+  SizeValueType key;
+
+  if ( !this->GetDenseKey(label, key) )
+    {
+    typename LabelPositionMapType::hasher hasher;
+    key = hasher(label);
+    }
+  return static_cast< ThreadIdType >( key % numberOfPartitions );
 }
 
 template< typename TInputImage, typename TLabelImage >
@@ -97,104 +212,163 @@ void
 LabelStatisticsImageFilter< TInputImage, TLabelImage >
 ::AfterThreadedGenerateData()
 {
-  MapIterator      mapIt;
-  MapConstIterator threadIt;
-  ThreadIdType     i;
-  ThreadIdType     numberOfThreads = this->GetNumberOfThreads();
-
-  // Run through the map for each thread and accumulate the count,
-  // sum, and sumofsquares
-  for ( i = 0; i < numberOfThreads; i++ )
-    {
-    // iterate over the map for this thread
-    for ( threadIt = m_LabelStatisticsPerThread[i].begin();
-          threadIt != m_LabelStatisticsPerThread[i].end();
+  // Merge the thread accumulators and compute the statistics, each
+  // partition of the labels on its own thread
+  MergeThreadStruct str;
+  str.Filter = this;
+
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  str.NumberOfPartitions = this->GetMultiThreader()->GetNumberOfThreads();
+  str.Statistics.resize(str.NumberOfPartitions);
+  if ( str.NumberOfPartitions == 1 )
+    {
+    this->ThreadedMergeLabels(&str, 0);
+    }
+  else
+    {
+    this->GetMultiThreader()->SetSingleMethod(this->MergeThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+  m_ThreadAccumulators.clear();
+
+  // gather the statistics of all the partitions
+  SizeValueType numberOfLabels = 0;
+  for ( ThreadIdType partition = 0; partition < str.NumberOfPartitions; ++partition )
+    {
+    numberOfLabels += str.Statistics[partition].size();
+    }
+  m_LabelStatistics.resize(numberOfLabels);
+
+  typedef typename MapType::value_type MapValueType;
+  for ( ThreadIdType partition = 0; partition < str.NumberOfPartitions; ++partition )
+    {
+    const LabelStatisticsVectorType & statistics = str.Statistics[partition];
+    for ( typename LabelStatisticsVectorType::const_iterator statIt = statistics.begin();
+          statIt != statistics.end();
+          ++statIt )
+      {
+      m_LabelStatistics.insert( MapValueType(statIt->first, statIt->second) );
+      }
+    }
+
+    {
+    //Now update the cached vector of valid labels.
+    m_ValidLabelValues.resize(0);
+    m_ValidLabelValues.reserve(m_LabelStatistics.size());
+    for ( MapIterator mapIt = m_LabelStatistics.begin();
+      mapIt != m_LabelStatistics.end();
+      ++mapIt )
+      {
+      m_ValidLabelValues.push_back(mapIt->first);
+      }
+    }
+}
+
+template< typename TInputImage, typename TLabelImage >
+ITK_THREAD_RETURN_TYPE
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::MergeThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  MergeThreadStruct *              str = static_cast< MergeThreadStruct * >( info->UserData );
+
+  str->Filter->ThreadedMergeLabels(str, info->ThreadID);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TLabelImage >
+void
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::ThreadedMergeLabels(MergeThreadStruct *str, ThreadIdType partition)
+{
+  ThreadAccumulator merged;
+
+  // Run through the accumulator of each thread, in order, and accumulate
+  // the count, sum, and sumofsquares of the labels of this partition
+  for ( ThreadIdType i = 0; i < m_ThreadAccumulators.size(); ++i )
+    {
+    const ThreadAccumulator & accumulator = m_ThreadAccumulators[i];
+    for ( typename LabelAccumulatorVectorType::const_iterator threadIt = accumulator.Labels.begin();
+          threadIt != accumulator.Labels.end();
           ++threadIt )
       {
-      // does this label exist in the cumulative structure yet?
-      mapIt = m_LabelStatistics.find( ( *threadIt ).first );
-      if ( mapIt == m_LabelStatistics.end() )
+      if ( str->NumberOfPartitions > 1
+           && this->GetLabelPartition(threadIt->Label, str->NumberOfPartitions) != partition )
         {
-        // create a new entry
-        typedef typename MapType::value_type MapValueType;
-        if ( m_UseHistograms )
-          {
-          mapIt = m_LabelStatistics.insert( MapValueType( ( *threadIt ).first,
-                                                          LabelStatistics(m_NumBins[0], m_LowerBound,
-                                                                          m_UpperBound) ) ).first;
-          }
-        else
-          {
-          mapIt = m_LabelStatistics.insert( MapValueType( ( *threadIt ).first,
-                                                          LabelStatistics() ) ).first;
-          }
+        continue;
         }
 
+      LabelAccumulator & labelStats = merged.Labels[this->FindOrInsertLabel(merged, threadIt->Label)];
 
-      typename MapType::mapped_type &labelStats = ( *mapIt ).second;
-
-      // accumulate the information from this thread
-      labelStats.m_Count += ( *threadIt ).second.m_Count;
-      labelStats.m_Sum += ( *threadIt ).second.m_Sum;
-      labelStats.m_SumOfSquares += ( *threadIt ).second.m_SumOfSquares;
+      labelStats.Count += threadIt->Count;
+      labelStats.Sum += threadIt->Sum;
+      labelStats.SumOfSquares += threadIt->SumOfSquares;
 
-      if ( labelStats.m_Minimum > ( *threadIt ).second.m_Minimum )
+      if ( labelStats.Minimum > threadIt->Minimum )
         {
-        labelStats.m_Minimum = ( *threadIt ).second.m_Minimum;
+        labelStats.Minimum = threadIt->Minimum;
         }
-      if ( labelStats.m_Maximum < ( *threadIt ).second.m_Maximum )
+      if ( labelStats.Maximum < threadIt->Maximum )
         {
-        labelStats.m_Maximum = ( *threadIt ).second.m_Maximum;
+        labelStats.Maximum = threadIt->Maximum;
         }
 
       //bounding box is min,max pairs
-      int dimension = labelStats.m_BoundingBox.size() / 2;
-      for ( int ii = 0; ii < ( dimension * 2 ); ii += 2 )
+      for ( unsigned int ii = 0; ii < 2 * ImageDimension; ii += 2 )
         {
-        if ( labelStats.m_BoundingBox[ii] > ( *threadIt ).second.m_BoundingBox[ii] )
+        if ( labelStats.BoundingBox[ii] > threadIt->BoundingBox[ii] )
           {
-          labelStats.m_BoundingBox[ii] = ( *threadIt ).second.m_BoundingBox[ii];
+          labelStats.BoundingBox[ii] = threadIt->BoundingBox[ii];
           }
-        if ( labelStats.m_BoundingBox[ii + 1] < ( *threadIt ).second.m_BoundingBox[ii + 1] )
+        if ( labelStats.BoundingBox[ii + 1] < threadIt->BoundingBox[ii + 1] )
           {
-          labelStats.m_BoundingBox[ii + 1] = ( *threadIt ).second.m_BoundingBox[ii + 1];
+          labelStats.BoundingBox[ii + 1] = threadIt->BoundingBox[ii + 1];
           }
         }
 
       // if enabled, update the histogram for this label
       if ( m_UseHistograms )
         {
-        typename HistogramType::IndexType index;
-        index.SetSize(1);
         for ( unsigned int bin = 0; bin < m_NumBins[0]; bin++ )
           {
-          index[0] = bin;
-          labelStats.m_Histogram->IncreaseFrequency( bin, ( *threadIt ).second.m_Histogram->GetFrequency(bin) );
+          merged.Frequencies[labelStats.FrequencyOffset + bin] += accumulator.Frequencies[threadIt->FrequencyOffset + bin];
           }
         }
-      } // end of thread map iterator loop
-    }   // end of thread loop
+      }
+    }
 
   // compute the remainder of the statistics
-  for ( mapIt = m_LabelStatistics.begin();
-        mapIt != m_LabelStatistics.end();
-        ++mapIt )
+  LabelStatisticsVectorType & statistics = str->Statistics[partition];
+  statistics.reserve( merged.Labels.size() );
+  for ( typename LabelAccumulatorVectorType::const_iterator labelIt = merged.Labels.begin();
+        labelIt != merged.Labels.end();
+        ++labelIt )
     {
-    typename MapType::mapped_type &labelStats = ( *mapIt ).second;
+    statistics.push_back( std::make_pair( labelIt->Label, m_UseHistograms
+                                          ? LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound)
+                                          : LabelStatistics() ) );
+    LabelStatistics & labelStats = statistics.back().second;
+
+    labelStats.m_Count = labelIt->Count;
+    labelStats.m_Minimum = labelIt->Minimum;
+    labelStats.m_Maximum = labelIt->Maximum;
+    labelStats.m_Sum = labelIt->Sum;
+    labelStats.m_SumOfSquares = labelIt->SumOfSquares;
+    labelStats.m_BoundingBox.assign(labelIt->BoundingBox, labelIt->BoundingBox + 2 * ImageDimension);
 
     // mean
     labelStats.m_Mean = labelStats.m_Sum
-                               / static_cast< RealType >( labelStats.m_Count );
+                        / static_cast< RealType >( labelStats.m_Count );
 
     // variance
     if ( labelStats.m_Count > 1 )
       {
       // unbiased estimate of variance
-      LabelStatistics & ls = mapIt->second;
-      const RealType    sumSquared  = ls.m_Sum * ls.m_Sum;
-      const RealType    count       = static_cast< RealType >( ls.m_Count );
+      const RealType sumSquared  = labelStats.m_Sum * labelStats.m_Sum;
+      const RealType count       = static_cast< RealType >( labelStats.m_Count );
 
-      ls.m_Variance = ( ls.m_SumOfSquares - sumSquared / count ) / ( count - 1.0 );
+      labelStats.m_Variance = ( labelStats.m_SumOfSquares - sumSquared / count ) / ( count - 1.0 );
       }
     else
       {
@@ -203,17 +377,14 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
 
     // sigma
     labelStats.m_Sigma = std::sqrt( labelStats.m_Variance );
-    }
 
-    {
-    //Now update the cached vector of valid labels.
-    m_ValidLabelValues.resize(0);
-    m_ValidLabelValues.reserve(m_LabelStatistics.size());
-    for ( mapIt = m_LabelStatistics.begin();
-      mapIt != m_LabelStatistics.end();
-      ++mapIt )
+    // if enabled, fill the histogram for this label
+    if ( m_UseHistograms )
       {
-      m_ValidLabelValues.push_back(mapIt->first);
+      for ( unsigned int bin = 0; bin < m_NumBins[0]; bin++ )
+        {
+        labelStats.m_Histogram->SetFrequency( bin, merged.Frequencies[labelIt->FrequencyOffset + bin] );
+        }
       }
     }
 }
@@ -234,13 +405,13 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
     return;
     }
 
-  ImageLinearConstIteratorWithIndex< TInputImage > it (this->GetInput(),
-                                                       outputRegionForThread);
+  ImageScanlineConstIterator< TInputImage > it (this->GetInput(),
+                                                outputRegionForThread);
 
   ImageScanlineConstIterator< TLabelImage > labelIt (this->GetLabelInput(),
                                                      outputRegionForThread);
 
-  MapIterator mapIt;
+  ThreadAccumulator & accumulator = m_ThreadAccumulators[threadId];
 
   // support progress methods/callbacks
   const size_t numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / size0;
@@ -249,78 +420,83 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
   // do the work
   while ( !it.IsAtEnd() )
     {
+    const IndexType lineIndex = it.GetIndex();
+    IndexValueType  runBegin = lineIndex[0];
     while ( !it.IsAtEndOfLine() )
       {
-      const RealType & value = static_cast< RealType >( it.Get() );
+      // all the pixels of a run of equal labels go to the same statistics
+      const LabelPixelType label = labelIt.Get();
+      LabelAccumulator &   labelStats = accumulator.Labels[this->FindOrInsertLabel(accumulator, label)];
 
-      const LabelPixelType & label = labelIt.Get();
+      AbsoluteFrequencyType *frequencies = ITK_NULLPTR;
+      if ( m_UseHistograms )
+        {
+        frequencies = &accumulator.Frequencies[labelStats.FrequencyOffset];
+        }
 
-      // is the label already in this thread?
-      mapIt = m_LabelStatisticsPerThread[threadId].find(label);
-      if ( mapIt == m_LabelStatisticsPerThread[threadId].end() )
+      IndexValueType runEnd = runBegin;
+      do
         {
-        // create a new statistics object
-        typedef typename MapType::value_type MapValueType;
-        if ( m_UseHistograms )
+        const RealType value = static_cast< RealType >( it.Get() );
+
+        // update the values for this label and this thread
+        if ( value < labelStats.Minimum )
           {
-          mapIt = m_LabelStatisticsPerThread[threadId].insert( MapValueType( label,
-                                                                             LabelStatistics(m_NumBins[0], m_LowerBound,
-                                                                                             m_UpperBound) ) ).first;
+          labelStats.Minimum = value;
           }
-        else
+        if ( value > labelStats.Maximum )
           {
-          mapIt = m_LabelStatisticsPerThread[threadId].insert( MapValueType( label,
-                                                                             LabelStatistics() ) ).first;
+          labelStats.Maximum = value;
           }
-        }
 
-      typename MapType::mapped_type &labelStats = ( *mapIt ).second;
+        labelStats.Sum += value;
+        labelStats.SumOfSquares += ( value * value );
+        labelStats.Count++;
 
-      // update the values for this label and this thread
-      if ( value < labelStats.m_Minimum )
+        // if enabled, update the histogram for this label. The values
+        // outside of the histogram are not counted.
+        if ( frequencies )
+          {
+          histogramMeasurement[0] = value;
+          if ( m_BinningHistogram->GetIndex(histogramMeasurement, histogramIndex) )
+            {
+            ++frequencies[histogramIndex[0]];
+            }
+          }
+
+        ++labelIt;
+        ++it;
+        ++runEnd;
+        }
+      while ( !it.IsAtEndOfLine() && labelIt.Get() == label );
+
+      // bounding box is min,max pairs
+      if ( labelStats.BoundingBox[0] > runBegin )
         {
-        labelStats.m_Minimum = value;
+        labelStats.BoundingBox[0] = runBegin;
         }
-      if ( value > labelStats.m_Maximum )
+      if ( labelStats.BoundingBox[1] < runEnd - 1 )
         {
-        labelStats.m_Maximum = value;
+        labelStats.BoundingBox[1] = runEnd - 1;
         }
-
-      // bounding box is min,max pairs
-      for ( unsigned int i = 0; i < ( 2 * TInputImage::ImageDimension ); i += 2 )
+      for ( unsigned int i = 2; i < ( 2 * ImageDimension ); i += 2 )
         {
-        const IndexType & index = it.GetIndex();
-        if ( labelStats.m_BoundingBox[i] > index[i / 2] )
+        if ( labelStats.BoundingBox[i] > lineIndex[i / 2] )
           {
-          labelStats.m_BoundingBox[i] = index[i / 2];
+          labelStats.BoundingBox[i] = lineIndex[i / 2];
           }
-        if ( labelStats.m_BoundingBox[i + 1] < index[i / 2] )
+        if ( labelStats.BoundingBox[i + 1] < lineIndex[i / 2] )
           {
-          labelStats.m_BoundingBox[i + 1] = index[i / 2];
+          labelStats.BoundingBox[i + 1] = lineIndex[i / 2];
           }
         }
 
-      labelStats.m_Sum += value;
-      labelStats.m_SumOfSquares += ( value * value );
-      labelStats.m_Count++;
-
-      // if enabled, update the histogram for this label
-      if ( m_UseHistograms )
-        {
-        histogramMeasurement[0] = value;
-        labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
-        labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
-        }
-
-
-      ++labelIt;
-      ++it;
+      runBegin = runEnd;
       }
     labelIt.NextLine();
     it.NextLine();
     progress.CompletedPixel();
     }
-
 }
 
 template< typename TInputImage, typename TLabelImage >
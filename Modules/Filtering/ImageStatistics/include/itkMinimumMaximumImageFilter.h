@@ -18,7 +18,7 @@
 #ifndef itkMinimumMaximumImageFilter_h
 #define itkMinimumMaximumImageFilter_h
 
-#include "itkImageToImageFilter.h"
+#include "itkStreamingStatisticsImageFilterBase.h"
 #include "itkSimpleDataObjectDecorator.h"
 
 #include <vector>
@@ -36,13 +36,17 @@ namespace itk
  * be included within the pipeline. The implementation uses the
  * StatisticsImageFilter.
  *
+ * When the number of stream divisions is greater than one, the filter
+ * updates its input piece by piece and keeps the extrema of all the
+ * pieces (see StreamingStatisticsImageFilterBase).
+ *
  * \ingroup Operators
  * \sa StatisticsImageFilter
  * \ingroup ITKImageStatistics
  */
 template< typename TInputImage >
 class MinimumMaximumImageFilter:
-  public ImageToImageFilter< TInputImage, TInputImage >
+  public StreamingStatisticsImageFilterBase< TInputImage >
 {
 public:
   /** Extract dimension from input image. */
@@ -52,10 +56,10 @@ public:
                       TInputImage::ImageDimension);
 
   /** Standard class typedefs. */
-  typedef MinimumMaximumImageFilter                      Self;
-  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
-  typedef SmartPointer< Self >                           Pointer;
-  typedef SmartPointer< const Self >                     ConstPointer;
+  typedef MinimumMaximumImageFilter                         Self;
+  typedef StreamingStatisticsImageFilterBase< TInputImage > Superclass;
+  typedef SmartPointer< Self >                              Pointer;
+  typedef SmartPointer< const Self >                        ConstPointer;
 
   /** Image related typedefs. */
   typedef typename TInputImage::Pointer InputImagePointer;
@@ -72,7 +76,7 @@ public:
   itkNewMacro(Self);
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro(MinimumMaximumImageFilter, ImageToImageFilter);
+  itkTypeMacro(MinimumMaximumImageFilter, StreamingStatisticsImageFilterBase);
 
   /** Image typedef support. */
   typedef TInputImage InputImageType;
@@ -116,10 +120,6 @@ protected:
   virtual ~MinimumMaximumImageFilter() {}
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-    AllocateOutputs method. */
-  void AllocateOutputs() ITK_OVERRIDE;
-
   /** Initialize some accumulators before the threads run. */
   void BeforeThreadedGenerateData() ITK_OVERRIDE;
 
@@ -132,12 +132,6 @@ protected:
                              outputRegionForThread,
                              ThreadIdType threadId) ITK_OVERRIDE;
 
-  // Override since the filter needs all the data for the algorithm
-  void GenerateInputRequestedRegion() ITK_OVERRIDE;
-
-  // Override since the filter produces all of its output
-  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
-
 private:
   MinimumMaximumImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);            //purposely not implemented
@@ -100,43 +100,6 @@ MinimumMaximumImageFilter< TInputImage >
   return static_cast< const PixelObjectType * >( this->ProcessObject::GetOutput(2) );
 }
 
-template< typename TInputImage >
-void
-MinimumMaximumImageFilter< TInputImage >
-::GenerateInputRequestedRegion()
-{
-  Superclass::GenerateInputRequestedRegion();
-  if ( this->GetInput() )
-    {
-    InputImagePointer image =
-      const_cast< typename Superclass::InputImageType * >( this->GetInput() );
-    image->SetRequestedRegionToLargestPossibleRegion();
-    }
-}
-
-template< typename TInputImage >
-void
-MinimumMaximumImageFilter< TInputImage >
-::EnlargeOutputRequestedRegion(DataObject *data)
-{
-  Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
-}
-
-template< typename TInputImage >
-void
-MinimumMaximumImageFilter< TInputImage >
-::AllocateOutputs()
-{
-  // Pass the input through as the output
-  InputImagePointer image =
-    const_cast< TInputImage * >( this->GetInput() );
-
-  this->GraftOutput(image);
-
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
 template< typename TInputImage >
 void
 MinimumMaximumImageFilter< TInputImage >
@@ -202,7 +165,8 @@ MinimumMaximumImageFilter< TInputImage >
   if ( outputRegionForThread.GetNumberOfPixels()%2 == 1 )
     {
     const PixelType value = it.Get();
-    localMin = localMax = value;
+    localMin = std::min(value,localMin);
+    localMax = std::max(value,localMax);
     ++it;
     }
 
@@ -18,10 +18,12 @@
 #ifndef itkStatisticsImageFilter_h
 #define itkStatisticsImageFilter_h
 
-#include "itkImageToImageFilter.h"
+#include "itkStreamingStatisticsImageFilterBase.h"
 #include "itkNumericTraits.h"
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkCompensatedSummation.h"
+#include <vector>
 
 namespace itk
 {
@@ -38,6 +40,12 @@ namespace itk
  * threaded. It computes statistics in each thread then combines them in
  * its AfterThreadedGenerate method.
  *
+ * When the number of stream divisions is greater than one, the filter
+ * updates its input piece by piece and accumulates the statistics of all
+ * the pieces (see StreamingStatisticsImageFilterBase). The sums are
+ * accumulated with a CompensatedSummation to limit the rounding errors on
+ * large images.
+ *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
  *
@@ -47,20 +55,20 @@ namespace itk
  */
 template< typename TInputImage >
 class StatisticsImageFilter:
-  public ImageToImageFilter< TInputImage, TInputImage >
+  public StreamingStatisticsImageFilterBase< TInputImage >
 {
 public:
   /** Standard Self typedef */
-  typedef StatisticsImageFilter                          Self;
-  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
-  typedef SmartPointer< Self >                           Pointer;
-  typedef SmartPointer< const Self >                     ConstPointer;
+  typedef StatisticsImageFilter                             Self;
+  typedef StreamingStatisticsImageFilterBase< TInputImage > Superclass;
+  typedef SmartPointer< Self >                              Pointer;
+  typedef SmartPointer< const Self >                        ConstPointer;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(StatisticsImageFilter, ImageToImageFilter);
+  itkTypeMacro(StatisticsImageFilter, StreamingStatisticsImageFilterBase);
 
   /** Image related typedefs. */
   typedef typename TInputImage::Pointer InputImagePointer;
@@ -144,11 +152,6 @@ protected:
   ~StatisticsImageFilter(){}
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() ITK_OVERRIDE;
-
   /** Initialize some accumulators before the threads run. */
   void BeforeThreadedGenerateData() ITK_OVERRIDE;
 
@@ -161,21 +164,17 @@ protected:
                              outputRegionForThread,
                              ThreadIdType threadId) ITK_OVERRIDE;
 
-  // Override since the filter needs all the data for the algorithm
-  void GenerateInputRequestedRegion() ITK_OVERRIDE;
-
-  // Override since the filter produces all of its output
-  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
-
 private:
   StatisticsImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);        //purposely not implemented
 
-  Array< RealType >       m_ThreadSum;
-  Array< RealType >       m_SumOfSquares;
-  Array< SizeValueType >  m_Count;
-  Array< PixelType >      m_ThreadMin;
-  Array< PixelType >      m_ThreadMax;
+  typedef CompensatedSummation< RealType > CompensatedSummationType;
+
+  std::vector< CompensatedSummationType > m_ThreadSum;
+  std::vector< CompensatedSummationType > m_SumOfSquares;
+  Array< SizeValueType >                  m_Count;
+  Array< PixelType >                      m_ThreadMin;
+  Array< PixelType >                      m_ThreadMax;
 }; // end of class
 } // end namespace itk
 
@@ -182,43 +182,6 @@ StatisticsImageFilter< TInputImage >
   return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(6) );
 }
 
-template< typename TInputImage >
-void
-StatisticsImageFilter< TInputImage >
-::GenerateInputRequestedRegion()
-{
-  Superclass::GenerateInputRequestedRegion();
-  if ( this->GetInput() )
-    {
-    InputImagePointer image =
-      const_cast< typename Superclass::InputImageType * >( this->GetInput() );
-    image->SetRequestedRegionToLargestPossibleRegion();
-    }
-}
-
-template< typename TInputImage >
-void
-StatisticsImageFilter< TInputImage >
-::EnlargeOutputRequestedRegion(DataObject *data)
-{
-  Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
-}
-
-template< typename TInputImage >
-void
-StatisticsImageFilter< TInputImage >
-::AllocateOutputs()
-{
-  // Pass the input through as the output
-  InputImagePointer image =
-    const_cast< TInputImage * >( this->GetInput() );
-
-  this->GraftOutput(image);
-
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
 template< typename TInputImage >
 void
 StatisticsImageFilter< TInputImage >
@@ -228,15 +191,13 @@ StatisticsImageFilter< TInputImage >
 
   // Resize the thread temporaries
   m_Count.SetSize(numberOfThreads);
-  m_SumOfSquares.SetSize(numberOfThreads);
-  m_ThreadSum.SetSize(numberOfThreads);
+  m_SumOfSquares.assign( numberOfThreads, CompensatedSummationType() );
+  m_ThreadSum.assign( numberOfThreads, CompensatedSummationType() );
   m_ThreadMin.SetSize(numberOfThreads);
   m_ThreadMax.SetSize(numberOfThreads);
 
   // Initialize the temporaries
   m_Count.Fill(NumericTraits< SizeValueType >::ZeroValue());
-  m_ThreadSum.Fill(NumericTraits< RealType >::ZeroValue());
-  m_SumOfSquares.Fill(NumericTraits< RealType >::ZeroValue());
   m_ThreadMin.Fill( NumericTraits< PixelType >::max() );
   m_ThreadMax.Fill( NumericTraits< PixelType >::NonpositiveMin() );
 }
@@ -248,7 +209,6 @@ StatisticsImageFilter< TInputImage >
 {
   ThreadIdType    i;
   SizeValueType   count;
-  RealType        sumOfSquares;
 
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
 
@@ -258,8 +218,10 @@ StatisticsImageFilter< TInputImage >
   RealType  sigma;
   RealType  variance;
   RealType  sum;
+  RealType  sumOfSquares;
 
-  sum = sumOfSquares = NumericTraits< RealType >::ZeroValue();
+  CompensatedSummationType compensatedSum;
+  CompensatedSummationType compensatedSumOfSquares;
   count = 0;
 
   // Find the min/max over all threads and accumulate count, sum and
@@ -269,8 +231,8 @@ StatisticsImageFilter< TInputImage >
   for ( i = 0; i < numberOfThreads; i++ )
     {
     count += m_Count[i];
-    sum += m_ThreadSum[i];
-    sumOfSquares += m_SumOfSquares[i];
+    compensatedSum += m_ThreadSum[i].GetSum();
+    compensatedSumOfSquares += m_SumOfSquares[i].GetSum();
 
     if ( m_ThreadMin[i] < minimum )
       {
@@ -281,6 +243,9 @@ StatisticsImageFilter< TInputImage >
       maximum = m_ThreadMax[i];
       }
     }
+  sum = compensatedSum.GetSum();
+  sumOfSquares = compensatedSumOfSquares.GetSum();
+
   // compute statistics
   mean = sum / static_cast< RealType >( count );
 
@@ -312,11 +277,12 @@ StatisticsImageFilter< TInputImage >
   RealType  realValue;
   PixelType value;
 
-  RealType sum = NumericTraits< RealType >::ZeroValue();
-  RealType sumOfSquares = NumericTraits< RealType >::ZeroValue();
-  SizeValueType count = NumericTraits< SizeValueType >::ZeroValue();
-  PixelType min = NumericTraits< PixelType >::max();
-  PixelType max = NumericTraits< PixelType >::NonpositiveMin();
+  // start from the statistics of the previous pieces of the input
+  CompensatedSummationType sum = m_ThreadSum[threadId];
+  CompensatedSummationType sumOfSquares = m_SumOfSquares[threadId];
+  SizeValueType count = m_Count[threadId];
+  PixelType min = m_ThreadMin[threadId];
+  PixelType max = m_ThreadMax[threadId];
 
   ImageScanlineConstIterator< TInputImage > it (this->GetInput(),  outputRegionForThread);
 
@@ -327,6 +293,9 @@ StatisticsImageFilter< TInputImage >
   // do the work
   while ( !it.IsAtEnd() )
     {
+    // the lines are summed directly, and their sums are compensated
+    RealType lineSum = NumericTraits< RealType >::ZeroValue();
+    RealType lineSumOfSquares = NumericTraits< RealType >::ZeroValue();
     while ( !it.IsAtEndOfLine() )
       {
       value = it.Get();
@@ -340,11 +309,13 @@ StatisticsImageFilter< TInputImage >
         max  = value;
         }
 
-      sum += realValue;
-      sumOfSquares += ( realValue * realValue );
+      lineSum += realValue;
+      lineSumOfSquares += ( realValue * realValue );
       ++count;
       ++it;
       }
+    sum += lineSum;
+    sumOfSquares += lineSumOfSquares;
     it.NextLine();
     progress.CompletedPixel();
     }
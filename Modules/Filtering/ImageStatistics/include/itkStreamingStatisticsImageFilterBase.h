@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingStatisticsImageFilterBase_h
+#define itkStreamingStatisticsImageFilterBase_h
+
+#include "itkImageToImageFilter.h"
+#include "itkImageRegionSplitterBase.h"
+
+namespace itk
+{
+/** \class StreamingStatisticsImageFilterBase
+ * \brief Base class for the filters which compute statistics over their
+ * whole input and pass it through unmodified.
+ *
+ * The input is grafted to the image output and its largest possible
+ * region is requested. Subclasses accumulate their statistics per thread
+ * in ThreadedGenerateData, starting from the values left in the thread
+ * temporaries, and combine them in AfterThreadedGenerateData.
+ *
+ * When the number of stream divisions is greater than one, the input is
+ * updated piece by piece, as StreamingImageFilter does.
+ * BeforeThreadedGenerateData is called once, ThreadedGenerateData for
+ * each piece, and AfterThreadedGenerateData once all the pieces have been
+ * processed, so images which do not fit in memory can be processed from a
+ * streamable pipeline. The image output then only holds the last piece.
+ *
+ * \sa StatisticsImageFilter
+ * \sa MinimumMaximumImageFilter
+ * \ingroup ITKImageStatistics
+ */
+template< typename TInputImage >
+class StreamingStatisticsImageFilterBase:
+  public ImageToImageFilter< TInputImage, TInputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingStatisticsImageFilterBase             Self;
+  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
+  typedef SmartPointer< Self >                           Pointer;
+  typedef SmartPointer< const Self >                     ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingStatisticsImageFilterBase, ImageToImageFilter);
+
+  /** Image related typedefs. */
+  typedef typename TInputImage::Pointer    InputImagePointer;
+  typedef typename TInputImage::RegionType RegionType;
+
+  typedef ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
+
+  /** Typedef for the region splitter used to divide the input in pieces. */
+  typedef ImageRegionSplitterBase SplitterType;
+  typedef SplitterType::Pointer   RegionSplitterPointer;
+
+  /** Set/Get the number of pieces the input is divided into. With
+   * more than one piece, the input is updated and processed one piece
+   * at a time. The default is 1. */
+  itkSetMacro(NumberOfStreamDivisions, unsigned int);
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
+  /** Set/Get the splitter used to divide the input in pieces. */
+  itkSetObjectMacro(RegionSplitter, SplitterType);
+  itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
+
+  /** When streaming, only set the requested regions of the outputs. The
+   * requested region of the input is set for each piece in
+   * UpdateOutputData, so the largest possible region is not propagated
+   * upstream first. */
+  virtual void PropagateRequestedRegion(DataObject *output) ITK_OVERRIDE;
+
+  /** Update the input piece by piece when streaming, and run the
+   * default pipeline otherwise. */
+  virtual void UpdateOutputData(DataObject *output) ITK_OVERRIDE;
+
+protected:
+  StreamingStatisticsImageFilterBase();
+  virtual ~StreamingStatisticsImageFilterBase() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() ITK_OVERRIDE;
+
+  // Override since the filter needs all the data for the algorithm
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  // Override since the filter produces all of its output
+  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+
+private:
+  StreamingStatisticsImageFilterBase(const Self &); //purposely not implemented
+  void operator=(const Self &);                     //purposely not implemented
+
+  /** Runs ThreadedGenerateData on the current piece of the input. */
+  void AccumulatePiece(const RegionType & region);
+
+  unsigned int          m_NumberOfStreamDivisions;
+  RegionSplitterPointer m_RegionSplitter;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkStreamingStatisticsImageFilterBase.hxx"
+#endif
+
+#endif
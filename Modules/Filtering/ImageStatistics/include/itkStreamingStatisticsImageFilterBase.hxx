@@ -0,0 +1,206 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingStatisticsImageFilterBase_hxx
+#define itkStreamingStatisticsImageFilterBase_hxx
+#include "itkStreamingStatisticsImageFilterBase.h"
+
+#include "itkImageRegionSplitterSlowDimension.h"
+
+namespace itk
+{
+template< typename TInputImage >
+StreamingStatisticsImageFilterBase< TInputImage >
+::StreamingStatisticsImageFilterBase():
+  m_NumberOfStreamDivisions(1)
+{
+  m_RegionSplitter = ImageRegionSplitterSlowDimension::New();
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+  if ( this->GetInput() )
+    {
+    InputImagePointer image =
+      const_cast< typename Superclass::InputImageType * >( this->GetInput() );
+    image->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::EnlargeOutputRequestedRegion(DataObject *data)
+{
+  Superclass::EnlargeOutputRequestedRegion(data);
+  data->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::AllocateOutputs()
+{
+  // Pass the input through as the output
+  InputImagePointer image =
+    const_cast< TInputImage * >( this->GetInput() );
+
+  this->GraftOutput(image);
+
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::PropagateRequestedRegion(DataObject *output)
+{
+  if ( m_NumberOfStreamDivisions <= 1 )
+    {
+    Superclass::PropagateRequestedRegion(output);
+    return;
+    }
+
+  // check flag to avoid executing forever if there is a loop
+  if ( this->m_Updating )
+    {
+    return;
+    }
+
+  this->EnlargeOutputRequestedRegion(output);
+  this->GenerateOutputRequestedRegion(output);
+
+  // The requested region of the input is set and propagated for each
+  // piece in UpdateOutputData.
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::UpdateOutputData(DataObject *output)
+{
+  if ( m_NumberOfStreamDivisions <= 1 )
+    {
+    Superclass::UpdateOutputData(output);
+    return;
+    }
+
+  // prevent chasing our tail
+  if ( this->m_Updating )
+    {
+    return;
+    }
+
+  this->PrepareOutputs();
+
+  const DataObjectPointerArraySizeType & ninputs = this->GetNumberOfValidRequiredInputs();
+  if ( ninputs < this->GetNumberOfRequiredInputs() )
+    {
+    itkExceptionMacro(
+      << "At least " << static_cast< unsigned int >( this->GetNumberOfRequiredInputs() )
+      << " inputs are required but only " << ninputs << " are specified.");
+    }
+
+  this->InvokeEvent( StartEvent() );
+  this->SetAbortGenerateData(false);
+  this->UpdateProgress(0.0);
+  this->m_Updating = true;
+
+  try
+    {
+    InputImagePointer inputPtr = const_cast< TInputImage * >( this->GetInput() );
+    const RegionType  largestRegion = inputPtr->GetLargestPossibleRegion();
+
+    const unsigned int numberOfDivisions =
+      m_RegionSplitter->GetNumberOfSplits(largestRegion, m_NumberOfStreamDivisions);
+
+    // accumulate the statistics over all the pieces
+    this->BeforeThreadedGenerateData();
+    for ( unsigned int piece = 0; piece < numberOfDivisions && !this->GetAbortGenerateData(); ++piece )
+      {
+      RegionType streamRegion = largestRegion;
+      m_RegionSplitter->GetSplit(piece, numberOfDivisions, streamRegion);
+
+      inputPtr->SetRequestedRegion(streamRegion);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+
+      this->AccumulatePiece(streamRegion);
+
+      this->UpdateProgress( static_cast< float >( piece + 1 ) / static_cast< float >( numberOfDivisions ) );
+      }
+    this->AfterThreadedGenerateData();
+    }
+  catch ( ... )
+    {
+    this->m_Updating = false;
+    throw;
+    }
+
+  this->InvokeEvent( EndEvent() );
+
+  for ( DataObjectPointerArraySizeType idx = 0; idx < this->GetNumberOfOutputs(); ++idx )
+    {
+    if ( this->ProcessObject::GetOutput(idx) )
+      {
+      this->ProcessObject::GetOutput(idx)->DataHasBeenGenerated();
+      }
+    }
+
+  this->ReleaseInputs();
+
+  this->m_Updating = false;
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::AccumulatePiece(const RegionType & region)
+{
+  // Pass the piece through. Only the region of the piece is processed,
+  // even if the upstream filters produced a larger one, so that no
+  // pixel is counted twice.
+  this->AllocateOutputs();
+  this->GetOutput()->SetRequestedRegion(region);
+
+  typename Superclass::ThreadStruct str;
+  str.Filter = this;
+
+  const unsigned int validThreads =
+    this->GetImageRegionSplitter()->GetNumberOfSplits( region, this->GetNumberOfThreads() );
+
+  this->GetMultiThreader()->SetNumberOfThreads(validThreads);
+  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template< typename TInputImage >
+void
+StreamingStatisticsImageFilterBase< TInputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
+  os << indent << "RegionSplitter: " << m_RegionSplitter << std::endl;
+}
+} // end namespace itk
+#endif
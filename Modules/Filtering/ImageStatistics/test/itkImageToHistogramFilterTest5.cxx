@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageToHistogramFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkRGBPixel.h"
+#include "itkRandomImageSource.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+// Fills the histogram of the image with Histogram::GetIndex(), pixel by
+// pixel, and compares it to the one computed by the filter.
+template< typename TImage >
+int CheckHistogram( TImage * image, itk::ThreadIdType nbOfThreads, unsigned int nbOfBins,
+                    bool autoMinimumMaximum, double minimum, double maximum )
+{
+  typedef itk::Statistics::ImageToHistogramFilter< TImage > FilterType;
+  typedef typename FilterType::HistogramType                HistogramType;
+
+  const unsigned int nbOfComponents = image->GetNumberOfComponentsPerPixel();
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  typename FilterType::HistogramSizeType size( nbOfComponents );
+  size.Fill( nbOfBins );
+  filter->SetHistogramSize( size );
+  filter->SetAutoMinimumMaximum( autoMinimumMaximum );
+  if( !autoMinimumMaximum )
+    {
+    typename FilterType::HistogramMeasurementVectorType lowerBound( nbOfComponents );
+    typename FilterType::HistogramMeasurementVectorType upperBound( nbOfComponents );
+    lowerBound.Fill( minimum );
+    upperBound.Fill( maximum );
+    filter->SetHistogramBinMinimum( lowerBound );
+    filter->SetHistogramBinMaximum( upperBound );
+    }
+
+  filter->SetNumberOfThreads( nbOfThreads );
+  filter->Update();
+  const HistogramType * histogram = filter->GetOutput();
+
+  std::vector< typename HistogramType::AbsoluteFrequencyType > expected( histogram->Size(), 0 );
+  typename HistogramType::MeasurementVectorType m( nbOfComponents );
+  typename HistogramType::IndexType             index( nbOfComponents );
+  itk::ImageRegionConstIterator< TImage > it( image, image->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    itk::NumericTraits< typename TImage::PixelType >::AssignToArray( it.Get(), m );
+    if( histogram->GetIndex( m, index ) )
+      {
+      expected[histogram->GetInstanceIdentifier( index )]++;
+      }
+    }
+
+  for( unsigned int id = 0; id < expected.size(); id++ )
+    {
+    if( histogram->GetFrequency( id ) != expected[id] )
+      {
+      std::cerr << "Wrong frequency for bin " << id << ": "
+                << histogram->GetFrequency( id ) << " instead of " << expected[id] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int itkImageToHistogramFilterTest5( int argc, char * argv [] )
+{
+  if( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const itk::ThreadIdType nbOfThreads = atoi( argv[1] );
+
+  const unsigned int Dimension = 3;
+
+  itk::ImageRegion< Dimension > region;
+  itk::Size< Dimension >        size;
+  size[0] = 31;
+  size[1] = 17;
+  size[2] = 12;
+  region.SetSize( size );
+
+  typedef itk::RGBPixel< unsigned char >             RGBPixelType;
+  typedef itk::Image< RGBPixelType, Dimension >      RGBImageType;
+  typedef itk::Image< short, Dimension >             ShortImageType;
+  typedef itk::Image< float, Dimension >             FloatImageType;
+
+  RGBImageType::Pointer rgbImage = RGBImageType::New();
+  rgbImage->SetRegions( region );
+  rgbImage->Allocate();
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed( 7 );
+  for( itk::ImageRegionIterator< RGBImageType > rgbIt( rgbImage, region ); !rgbIt.IsAtEnd(); ++rgbIt )
+    {
+    RGBPixelType p;
+    for( unsigned int i = 0; i < 3; i++ )
+      {
+      p[i] = static_cast< unsigned char >( generator->GetIntegerVariate( 255 ) );
+      }
+    rgbIt.Set( p );
+    }
+
+  typedef itk::RandomImageSource< ShortImageType > ShortSourceType;
+  ShortSourceType::Pointer shortSource = ShortSourceType::New();
+  shortSource->SetSize( size );
+  shortSource->SetMin( -2500 );
+  shortSource->SetMax( 2499 );
+  shortSource->Update();
+  ShortImageType * shortImage = shortSource->GetOutput();
+
+  typedef itk::RandomImageSource< FloatImageType > FloatSourceType;
+  FloatSourceType::Pointer floatSource = FloatSourceType::New();
+  floatSource->SetSize( size );
+  floatSource->SetMin( -1000.0f );
+  floatSource->SetMax( 1700.0f );
+  floatSource->Update();
+  FloatImageType * floatImage = floatSource->GetOutput();
+
+  // joint histogram, with values out of the histogram
+  if( CheckHistogram< RGBImageType >( rgbImage, nbOfThreads, 8, false, 10.0, 230.0 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+  // joint histogram with the minimum and maximum of the image
+  if( CheckHistogram< RGBImageType >( rgbImage, nbOfThreads, 8, true, 0.0, 0.0 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+  // the histograms of the short image are computed from the counts of
+  // the values, with and without computing the minimum and maximum
+  if( CheckHistogram< ShortImageType >( shortImage, nbOfThreads, 100, true, 0.0, 0.0 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+  if( CheckHistogram< ShortImageType >( shortImage, nbOfThreads, 64, false, -2000.0, 1999.5 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+  if( CheckHistogram< FloatImageType >( floatImage, nbOfThreads, 250, true, 0.0, 0.0 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+  if( CheckHistogram< FloatImageType >( floatImage, nbOfThreads, 33, false, -500.0, 1000.0 ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
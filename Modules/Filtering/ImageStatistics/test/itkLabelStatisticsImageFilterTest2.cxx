@@ -0,0 +1,220 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <map>
+
+#include "itkLabelStatisticsImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+struct ExpectedLabelStatistics
+{
+  ExpectedLabelStatistics():
+    Count(0), Minimum(itk::NumericTraits< double >::max()),
+    Maximum(itk::NumericTraits< double >::NonpositiveMin()), Sum(0.0), SumOfSquares(0.0)
+  {
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      BoundingBox[2 * i] = itk::NumericTraits< itk::IndexValueType >::max();
+      BoundingBox[2 * i + 1] = itk::NumericTraits< itk::IndexValueType >::NonpositiveMin();
+      }
+  }
+
+  itk::SizeValueType                Count;
+  double                            Minimum;
+  double                            Maximum;
+  double                            Sum;
+  double                            SumOfSquares;
+  itk::IndexValueType               BoundingBox[6];
+  std::vector< itk::SizeValueType > Frequencies;
+};
+
+// Labels a 3D image with many labels, in runs of various lengths, and
+// compares the statistics computed by the filter to the ones computed
+// here pixel by pixel.
+template< typename TLabelPixel >
+int CheckLabelStatistics(TLabelPixel firstLabel, TLabelPixel sparseLabel, itk::ThreadIdType numberOfThreads)
+{
+  const unsigned int Dimension = 3;
+  typedef itk::Image< short, Dimension >       ImageType;
+  typedef itk::Image< TLabelPixel, Dimension > LabelImageType;
+
+  typedef itk::LabelStatisticsImageFilter< ImageType, LabelImageType > FilterType;
+  typedef typename FilterType::HistogramType                           HistogramType;
+
+  typename ImageType::RegionType region;
+  typename ImageType::IndexType  start;
+  typename ImageType::SizeType   size;
+  start[0] = -3;
+  start[1] = 5;
+  start[2] = 2;
+  size[0] = 37;
+  size[1] = 23;
+  size[2] = 11;
+  region.SetIndex(start);
+  region.SetSize(size);
+
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  typename LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions(region);
+  labelImage->Allocate();
+
+  const unsigned int numberOfBins = 16;
+  const double       lowerBound = -50.0;
+  const double       upperBound = 900.0;
+
+  typename HistogramType::Pointer binning = HistogramType::New();
+  typename HistogramType::SizeType binningSize(1);
+  typename HistogramType::MeasurementVectorType lower(1);
+  typename HistogramType::MeasurementVectorType upper(1);
+  binningSize[0] = numberOfBins;
+  lower[0] = lowerBound;
+  upper[0] = upperBound;
+  binning->SetMeasurementVectorSize(1);
+  binning->Initialize(binningSize, lower, upper);
+  typename HistogramType::MeasurementVectorType measurement(1);
+  typename HistogramType::IndexType             binIndex(1);
+
+  typedef std::map< TLabelPixel, ExpectedLabelStatistics > ExpectedMapType;
+  ExpectedMapType expected;
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it(image, region);
+  itk::ImageRegionIteratorWithIndex< LabelImageType > labelIt(labelImage, region);
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed(12345);
+
+  TLabelPixel label = firstLabel;
+  while ( !it.IsAtEnd() )
+    {
+    const short value = static_cast< short >( generator->GetIntegerVariate(1099) ) - 100;
+    if ( generator->GetIntegerVariate(4) == 0 )
+      {
+      // start a new run with a label used elsewhere in the image
+      label = static_cast< TLabelPixel >( firstLabel + static_cast< TLabelPixel >( generator->GetIntegerVariate(2999) ) );
+      if ( generator->GetIntegerVariate(6) == 0 )
+        {
+        label = static_cast< TLabelPixel >( sparseLabel + static_cast< TLabelPixel >( generator->GetIntegerVariate(49) ) );
+        }
+      }
+    it.Set(value);
+    labelIt.Set(label);
+
+    ExpectedLabelStatistics & stats = expected[label];
+    stats.Count++;
+    stats.Minimum = std::min( stats.Minimum, static_cast< double >( value ) );
+    stats.Maximum = std::max( stats.Maximum, static_cast< double >( value ) );
+    stats.Sum += value;
+    stats.SumOfSquares += static_cast< double >( value ) * value;
+    for ( unsigned int i = 0; i < Dimension; ++i )
+      {
+      stats.BoundingBox[2 * i] = std::min( stats.BoundingBox[2 * i], it.GetIndex()[i] );
+      stats.BoundingBox[2 * i + 1] = std::max( stats.BoundingBox[2 * i + 1], it.GetIndex()[i] );
+      }
+    stats.Frequencies.resize(numberOfBins, 0);
+    measurement[0] = value;
+    if ( binning->GetIndex(measurement, binIndex) )
+      {
+      stats.Frequencies[binIndex[0]]++;
+      }
+    ++it;
+    ++labelIt;
+    }
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetLabelInput(labelImage);
+  filter->SetHistogramParameters(numberOfBins, lowerBound, upperBound);
+
+  filter->SetNumberOfThreads(numberOfThreads);
+  filter->Update();
+
+  if ( filter->GetNumberOfLabels() != expected.size()
+       || filter->GetValidLabelValues().size() != expected.size() )
+    {
+    std::cerr << "Wrong number of labels: "
+              << filter->GetNumberOfLabels() << " instead of " << expected.size() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for ( typename ExpectedMapType::const_iterator eIt = expected.begin(); eIt != expected.end(); ++eIt )
+    {
+    const TLabelPixel               l = eIt->first;
+    const ExpectedLabelStatistics & stats = eIt->second;
+    bool                            ok = filter->HasLabel(l)
+      && filter->GetCount(l) == stats.Count
+      && filter->GetMinimum(l) == stats.Minimum
+      && filter->GetMaximum(l) == stats.Maximum
+      && filter->GetSum(l) == stats.Sum
+      && itk::Math::FloatAlmostEqual( filter->GetMean(l), stats.Sum / stats.Count );
+
+    const typename FilterType::BoundingBoxType bbox = filter->GetBoundingBox(l);
+    for ( unsigned int i = 0; ok && i < 2 * Dimension; ++i )
+      {
+      ok = bbox[i] == stats.BoundingBox[i];
+      }
+
+    typename HistogramType::Pointer histogram = filter->GetHistogram(l);
+    for ( unsigned int bin = 0; ok && bin < numberOfBins; ++bin )
+      {
+      ok = histogram->GetFrequency(bin) == stats.Frequencies[bin];
+      }
+
+    if ( !ok )
+      {
+      std::cerr << "Wrong statistics for label " << static_cast< double >( l ) << std::endl;
+      std::cerr << "Count: " << filter->GetCount(l) << " expected " << stats.Count << std::endl;
+      std::cerr << "Minimum: " << filter->GetMinimum(l) << " expected " << stats.Minimum << std::endl;
+      std::cerr << "Maximum: " << filter->GetMaximum(l) << " expected " << stats.Maximum << std::endl;
+      std::cerr << "Sum: " << filter->GetSum(l) << " expected " << stats.Sum << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int itkLabelStatisticsImageFilterTest2(int argc, char* argv [] )
+{
+  if ( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const itk::ThreadIdType numberOfThreads = atoi( argv[1] );
+
+  // labels in the dense table and beyond it
+  if ( CheckLabelStatistics< unsigned int >( 1, 5000000, numberOfThreads ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // the dense table covers all the values of a short
+  if ( CheckLabelStatistics< short >( -1500, 20000, numberOfThreads ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
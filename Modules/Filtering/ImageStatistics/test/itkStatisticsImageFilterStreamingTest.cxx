@@ -0,0 +1,171 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+
+#include "itkStatisticsImageFilter.h"
+#include "itkMinimumMaximumImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkPipelineMonitorImageFilter.h"
+
+namespace
+{
+// Checks that the whole image was never requested from the monitored
+// filter, not even before the pieces were propagated.
+template< typename TMonitor >
+bool OnlyPiecesWereRequested(const TMonitor *monitor,
+                             const typename TMonitor::ImageRegionType & region)
+{
+  typename TMonitor::RegionVectorType requested = monitor->GetOutputRequestedRegions();
+  for ( size_t i = 0; i < requested.size(); ++i )
+    {
+    if ( requested[i].GetNumberOfPixels() >= region.GetNumberOfPixels() )
+      {
+      std::cerr << "The whole image was requested: " << requested[i] << std::endl;
+      return false;
+      }
+    }
+  return !requested.empty();
+}
+}
+
+// Computes the statistics of an image with and without streaming, and
+// checks that the streamed pipeline never holds the whole image.
+int itkStatisticsImageFilterStreamingTest(int argc, char* argv [] )
+{
+  if ( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfStreamDivisions" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const unsigned int numberOfDivisions = atoi( argv[1] );
+
+  const unsigned int Dimension = 3;
+  typedef itk::Image< short, Dimension > ShortImageType;
+  typedef itk::Image< float, Dimension > FloatImageType;
+
+  ShortImageType::RegionType region;
+  ShortImageType::SizeType   size;
+  ShortImageType::IndexType  start;
+  size[0] = 21;
+  size[1] = 13;
+  size[2] = 9;
+  start[0] = -4;
+  start[1] = 2;
+  start[2] = 7;
+  region.SetSize(size);
+  region.SetIndex(start);
+
+  ShortImageType::Pointer image = ShortImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed(2015);
+  for ( itk::ImageRegionIterator< ShortImageType > it(image, region); !it.IsAtEnd(); ++it )
+    {
+    it.Set( static_cast< short >( generator->GetIntegerVariate(2000) ) - 1000 );
+    }
+
+  // put the extrema in the middle of the image
+  ShortImageType::IndexType extremum = start;
+  extremum[2] += 4;
+  image->SetPixel(extremum, 3000);
+  extremum[0] += 3;
+  image->SetPixel(extremum, -3000);
+
+  // the cast only produces the requested pieces
+  typedef itk::CastImageFilter< ShortImageType, FloatImageType > CastType;
+  CastType::Pointer cast = CastType::New();
+  cast->SetInput(image);
+
+  typedef itk::PipelineMonitorImageFilter< FloatImageType > MonitorType;
+  MonitorType::Pointer monitor = MonitorType::New();
+  monitor->SetInput( cast->GetOutput() );
+
+  typedef itk::StatisticsImageFilter< FloatImageType > StatisticsType;
+  StatisticsType::Pointer statistics = StatisticsType::New();
+  statistics->SetInput( monitor->GetOutput() );
+  statistics->Update();
+
+  const double sum = statistics->GetSum();
+  const double variance = statistics->GetVariance();
+  if ( statistics->GetMinimum() != -3000 || statistics->GetMaximum() != 3000 )
+    {
+    std::cerr << "Wrong extrema without streaming: " << statistics->GetMinimum()
+              << " " << statistics->GetMaximum() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // run the cast again, on the pieces only
+  cast->Modified();
+  statistics->SetNumberOfStreamDivisions(numberOfDivisions);
+  statistics->Update();
+
+  if ( cast->GetOutput()->GetBufferedRegion().GetNumberOfPixels() >= region.GetNumberOfPixels() )
+    {
+    std::cerr << "The input was not streamed." << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( !OnlyPiecesWereRequested( monitor.GetPointer(), region ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  if ( statistics->GetMinimum() != -3000 || statistics->GetMaximum() != 3000
+       || statistics->GetSum() != sum
+       || std::fabs( statistics->GetVariance() - variance ) > 1e-6 * variance )
+    {
+    std::cerr << "Wrong statistics with streaming." << std::endl;
+    std::cerr << "Minimum: " << statistics->GetMinimum() << " expected -3000" << std::endl;
+    std::cerr << "Maximum: " << statistics->GetMaximum() << " expected 3000" << std::endl;
+    std::cerr << "Sum: " << statistics->GetSum() << " expected " << sum << std::endl;
+    std::cerr << "Variance: " << statistics->GetVariance() << " expected " << variance << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::MinimumMaximumImageFilter< FloatImageType > MinimumMaximumType;
+  MinimumMaximumType::Pointer minimumMaximum = MinimumMaximumType::New();
+  minimumMaximum->SetInput( monitor->GetOutput() );
+  minimumMaximum->SetNumberOfStreamDivisions(numberOfDivisions);
+  cast->Modified();
+  minimumMaximum->Update();
+
+  if ( cast->GetOutput()->GetBufferedRegion().GetNumberOfPixels() >= region.GetNumberOfPixels() )
+    {
+    std::cerr << "The input of the minimum maximum filter was not streamed." << std::endl;
+    return EXIT_FAILURE;
+    }
+  if ( !OnlyPiecesWereRequested( monitor.GetPointer(), region ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  if ( minimumMaximum->GetMinimum() != -3000 || minimumMaximum->GetMaximum() != 3000 )
+    {
+    std::cerr << "Wrong extrema with streaming: "
+              << minimumMaximum->GetMinimum() << " " << minimumMaximum->GetMaximum() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
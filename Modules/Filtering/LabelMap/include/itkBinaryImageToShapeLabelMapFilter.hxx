@@ -31,6 +31,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   m_InputForegroundValue = NumericTraits< OutputImagePixelType >::max();
   m_FullyConnected = false;
   m_ComputeFeretDiameter = false;
+  m_ComputeOrientedBoundingBox = false;
   m_ComputePerimeter = true;
 }
 
@@ -85,6 +86,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   valuator->SetNumberOfThreads( this->GetNumberOfThreads() );
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
+  valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
   progress->RegisterInternalFilter(valuator, .5f);
 
   valuator->GraftOutput( this->GetOutput() );
@@ -106,6 +108,7 @@ BinaryImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   os << indent << "ForegroundValue: "
      << static_cast< typename NumericTraits< OutputImagePixelType >::PrintType >( m_InputForegroundValue ) << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
 }
 } // end namespace itk
@@ -129,6 +129,14 @@ public:
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
   itkBooleanMacro(ComputeFeretDiameter);
 
+  /**
+   * Set/Get whether the oriented bounding box should be computed or not.
+   * Default value is false.
+   */
+  itkSetMacro(ComputeOrientedBoundingBox, bool);
+  itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
+  itkBooleanMacro(ComputeOrientedBoundingBox);
+
   /**
    * Set/Get whether the perimeter should be computed or not. The defaut value
    * is false, because of the high computation time required.
@@ -207,6 +215,7 @@ private:
   OutputImagePixelType m_OutputBackgroundValue;
   InputImagePixelType  m_InputForegroundValue;
   bool                 m_ComputeFeretDiameter;
+  bool                 m_ComputeOrientedBoundingBox;
   bool                 m_ComputePerimeter;
   unsigned int         m_NumberOfBins;
   bool                 m_ComputeHistogram;
@@ -31,6 +31,7 @@ BinaryImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage
   m_InputForegroundValue = NumericTraits< OutputImagePixelType >::max();
   m_FullyConnected = false;
   m_ComputeFeretDiameter = false;
+  m_ComputeOrientedBoundingBox = false;
   m_ComputePerimeter = true;
   m_NumberOfBins = 128;
   m_ComputeHistogram = true;
@@ -89,6 +90,7 @@ BinaryImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage
   valuator->SetNumberOfThreads( this->GetNumberOfThreads() );
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
+  valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
   valuator->SetComputeHistogram(m_ComputeHistogram);
   valuator->SetNumberOfBins(m_NumberOfBins);
   progress->RegisterInternalFilter(valuator, .5f);
@@ -112,6 +114,7 @@ BinaryImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage
   os << indent << "InputForegroundValue: "
      << static_cast< typename NumericTraits< OutputImagePixelType >::PrintType >( m_InputForegroundValue ) << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeHistogram: " << m_ComputeHistogram << std::endl;
   os << indent << "NumberOfBins: " << m_NumberOfBins << std::endl;
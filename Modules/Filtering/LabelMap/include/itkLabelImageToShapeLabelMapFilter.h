@@ -115,6 +115,14 @@ public:
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
   itkBooleanMacro(ComputeFeretDiameter);
 
+  /**
+   * Set/Get whether the oriented bounding box should be computed or not.
+   * Default value is false.
+   */
+  itkSetMacro(ComputeOrientedBoundingBox, bool);
+  itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
+  itkBooleanMacro(ComputeOrientedBoundingBox);
+
   /**
    * Set/Get whether the perimeter should be computed or not.
    * Default value is false, because of the high computation time required.
@@ -145,6 +153,7 @@ private:
 
   OutputImagePixelType m_BackgroundValue;
   bool                 m_ComputeFeretDiameter;
+  bool                 m_ComputeOrientedBoundingBox;
   bool                 m_ComputePerimeter;
 }; // end of class
 } // end namespace itk
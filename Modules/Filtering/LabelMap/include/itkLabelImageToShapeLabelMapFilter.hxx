@@ -29,6 +29,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
 {
   m_BackgroundValue = NumericTraits< OutputImagePixelType >::NonpositiveMin();
   m_ComputeFeretDiameter = false;
+  m_ComputeOrientedBoundingBox = false;
   m_ComputePerimeter = true;
 }
 
@@ -81,6 +82,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   valuator->SetNumberOfThreads( this->GetNumberOfThreads() );
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
+  valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
   progress->RegisterInternalFilter(valuator, .5f);
 
   valuator->GraftOutput( this->GetOutput() );
@@ -98,6 +100,7 @@ LabelImageToShapeLabelMapFilter< TInputImage, TOutputImage >
   os << indent << "BackgroundValue: "
      << static_cast< typename NumericTraits< OutputImagePixelType >::PrintType >( m_BackgroundValue ) << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
 }
 } // end namespace itk
@@ -29,6 +29,7 @@ LabelImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage >
 {
   m_BackgroundValue = NumericTraits< OutputImagePixelType >::NonpositiveMin();
   m_ComputeFeretDiameter = false;
+  m_ComputeOrientedBoundingBox = false;
   m_ComputePerimeter = true;
   m_NumberOfBins = 128;
   m_ComputeHistogram = true;
@@ -85,6 +86,7 @@ LabelImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage >
   valuator->SetNumberOfThreads( this->GetNumberOfThreads() );
   valuator->SetComputePerimeter(m_ComputePerimeter);
   valuator->SetComputeFeretDiameter(m_ComputeFeretDiameter);
+  valuator->SetComputeOrientedBoundingBox(m_ComputeOrientedBoundingBox);
   valuator->SetComputeHistogram(m_ComputeHistogram);
   valuator->SetNumberOfBins(m_NumberOfBins);
   progress->RegisterInternalFilter(valuator, .5f);
@@ -104,6 +106,7 @@ LabelImageToStatisticsLabelMapFilter< TInputImage, TFeatureImage, TOutputImage >
   os << indent << "BackgroundValue: "
      << static_cast< typename NumericTraits< OutputImagePixelType >::PrintType >( m_BackgroundValue ) << std::endl;
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeHistogram: " << m_ComputeHistogram << std::endl;
   os << indent << "NumberOfBins: " << m_NumberOfBins << std::endl;
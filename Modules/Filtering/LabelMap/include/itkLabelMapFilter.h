@@ -30,6 +30,8 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkFastMutexLock.h"
+#include "itkAtomicInt.h"
+#include <vector>
 
 namespace itk
 {
@@ -42,6 +44,12 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The objects are split in chunks of about the same number of lines
+ * before the threads start, and the threads take the chunks one after
+ * the other from an atomic counter. The label map is not modified while
+ * the chunks are made, so subclasses may still remove the object they
+ * process from the output, under m_LabelObjectContainerLock.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -124,9 +132,13 @@ private:
   LabelMapFilter(const Self &); //purposely not implemented
   void operator=(const Self &); //purposely not implemented
 
-  typename InputImageType::Iterator m_LabelObjectIterator;
-  float                             m_InverseNumberOfLabelObjects;
-  SizeValueType                     m_NumberOfLabelObjectsProcessed;
+  // the objects to process, in the label map order, and the first object
+  // of each chunk, plus the end
+  std::vector< LabelObjectType * > m_LabelObjects;
+  std::vector< SizeValueType >     m_ChunkStarts;
+  AtomicInt< int >                 m_NextChunk;
+  float                            m_InverseNumberOfLabelObjects;
+  AtomicInt< int >                 m_NumberOfLabelObjectsProcessed;
 };
 } // end namespace itk
 
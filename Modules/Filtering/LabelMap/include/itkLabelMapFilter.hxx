@@ -28,7 +28,7 @@
 #ifndef itkLabelMapFilter_hxx
 #define itkLabelMapFilter_hxx
 #include "itkLabelMapFilter.h"
-#include "itkMutexLockHolder.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -76,14 +76,44 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::BeforeThreadedGenerateData()
 {
-  // initialize the iterator
-  m_LabelObjectIterator =  typename InputImageType::Iterator(this->GetLabelMap());
-//  m_LabelObjectIterator = typename InputImageType::Iterator(this->GetLabelMap());
+  // collect the objects, weighted by their number of lines. An empty
+  // object still costs a call.
+  InputImageType *labelMap = this->GetLabelMap();
+  m_LabelObjects.clear();
+  m_LabelObjects.reserve( labelMap->GetNumberOfLabelObjects() );
+  SizeValueType totalWeight = 0;
+  for ( typename InputImageType::Iterator it(labelMap); !it.IsAtEnd(); ++it )
+    {
+    m_LabelObjects.push_back( it.GetLabelObject() );
+    totalWeight += it.GetLabelObject()->GetNumberOfLines() + 1;
+    }
+
+  // a few chunks per thread, so the threads which got the small objects
+  // can help with the large ones
+  const SizeValueType numberOfChunks = 16 * static_cast< SizeValueType >( this->GetNumberOfThreads() );
+  const SizeValueType chunkWeight = std::max( totalWeight / numberOfChunks, static_cast< SizeValueType >( 1 ) );
+  m_ChunkStarts.clear();
+  m_ChunkStarts.push_back(0);
+  SizeValueType weight = 0;
+  for ( SizeValueType i = 0; i < m_LabelObjects.size(); ++i )
+    {
+    weight += m_LabelObjects[i]->GetNumberOfLines() + 1;
+    if ( weight >= chunkWeight )
+      {
+      m_ChunkStarts.push_back(i + 1);
+      weight = 0;
+      }
+    }
+  if ( m_ChunkStarts.back() != m_LabelObjects.size() )
+    {
+    m_ChunkStarts.push_back( m_LabelObjects.size() );
+    }
+  m_NextChunk = 0;
 
   // and the mutex
   m_LabelObjectContainerLock = FastMutexLock::New();
 
-  m_InverseNumberOfLabelObjects = 1.0f/this->GetLabelMap()->GetNumberOfLabelObjects();
+  m_InverseNumberOfLabelObjects = 1.0f/labelMap->GetNumberOfLabelObjects();
   m_NumberOfLabelObjectsProcessed = 0;
 }
 
@@ -92,6 +122,8 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::AfterThreadedGenerateData()
 {
+  m_LabelObjects.clear();
+  m_ChunkStarts.clear();
   this->UpdateProgress(1.0);
 }
 
@@ -100,51 +132,32 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData( const OutputImageRegionType &, ThreadIdType threadId )
 {
-  while ( true )
+  const int numberOfChunks = static_cast< int >( m_ChunkStarts.size() ) - 1;
+  for ( int chunk = ( m_NextChunk += 1 ) - 1; chunk < numberOfChunks; chunk = ( m_NextChunk += 1 ) - 1 )
     {
-    LabelObjectType *labelObject;
-    // begin mutex lock
-    {
-    MutexLockHolder< FastMutexLock > lock(*m_LabelObjectContainerLock );
-
-    if ( m_LabelObjectIterator.IsAtEnd() )
+    for ( SizeValueType i = m_ChunkStarts[chunk]; i < m_ChunkStarts[chunk + 1]; ++i )
       {
-      // mutex lock holder deleted
-      return;
+      // run the user defined method for that object
+      this->ThreadedProcessLabelObject(m_LabelObjects[i]);
+
+      // all threads needs to check the abort flag
+      if ( this->GetAbortGenerateData() )
+        {
+        std::string    msg;
+        ProcessAborted e(__FILE__, __LINE__);
+        msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
+        e.SetDescription(msg);
+        throw e;
+        }
       }
 
-    // get the label object
-    labelObject = m_LabelObjectIterator.GetLabelObject();
-
-    // increment the iterator now, so it will not be invalidated if the object
-    // is destroyed
-    ++m_LabelObjectIterator;
-    ++m_NumberOfLabelObjectsProcessed;
-
-    // unlock the mutex, so the other threads can get an object
-    }
-    // end mutex lock
-
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
-
+    const int processed =
+      ( m_NumberOfLabelObjectsProcessed += static_cast< int >( m_ChunkStarts[chunk + 1] - m_ChunkStarts[chunk] ) );
     if (threadId==0)
       {
-      const float progress = m_InverseNumberOfLabelObjects*m_NumberOfLabelObjectsProcessed;
+      const float progress = m_InverseNumberOfLabelObjects*processed;
       this->UpdateProgress(progress);
       }
-
-    // all threads needs to check the abort flag
-    if ( this->GetAbortGenerateData() )
-      {
-      std::string    msg;
-      ProcessAborted e(__FILE__, __LINE__);
-      msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
-      e.SetDescription(msg);
-      throw e;
-      }
-
     }
 }
 
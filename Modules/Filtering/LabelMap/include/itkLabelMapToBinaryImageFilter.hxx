@@ -22,6 +22,7 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionIterator.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -145,11 +146,13 @@ LabelMapToBinaryImageFilter< TInputImage, TOutputImage >
 ::ThreadedProcessLabelObject(LabelObjectType *labelObject)
 {
   OutputImageType *output = this->GetOutput();
-  typename LabelObjectType::ConstIndexIterator it( labelObject );
-  while( ! it.IsAtEnd() )
+  OutputImagePixelType *buffer = output->GetBufferPointer();
+
+  // the lines are contiguous in the output buffer
+  for ( SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i )
     {
-    output->SetPixel( it.GetIndex(), this->m_ForegroundValue );
-    ++it;
+    const typename LabelObjectType::LineType & line = labelObject->GetLine(i);
+    std::fill_n( buffer + output->ComputeOffset( line.GetIndex() ), line.GetLength(), this->m_ForegroundValue );
     }
 }
 
@@ -22,6 +22,7 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -53,13 +54,14 @@ void
 LabelMapToLabelImageFilter< TInputImage, TOutputImage >
 ::ThreadedProcessLabelObject(LabelObjectType *labelObject)
 {
-  const typename LabelObjectType::LabelType & label = labelObject->GetLabel();
-  typename LabelObjectType::ConstIndexIterator it( labelObject );
+  const OutputImagePixelType label = static_cast< OutputImagePixelType >( labelObject->GetLabel() );
+  OutputImagePixelType *buffer = this->m_OutputImage->GetBufferPointer();
 
-  while( !it.IsAtEnd() )
+  // the lines are contiguous in the output buffer
+  for ( SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i )
     {
-    this->m_OutputImage->SetPixel( it.GetIndex(), label );
-    ++it;
+    const typename LabelObjectType::LineType & line = labelObject->GetLine(i);
+    std::fill_n( buffer + this->m_OutputImage->ComputeOffset( line.GetIndex() ), line.GetLength(), label );
     }
 }
 
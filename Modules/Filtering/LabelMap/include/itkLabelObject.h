@@ -18,7 +18,7 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -33,7 +33,8 @@ namespace itk
  * It should be used associated with the LabelMap.
  *
  * LabelObject store mainly 2 things: the label of the object, and a set of lines
- * which are part of the object.
+ * which are part of the object. The lines are stored in a contiguous array, so
+ * an object with a few lines costs a single small allocation.
  * No attribute is available in that class, so this class can be used as a base class
  * to implement a label object with attribute, or when no attribute is needed (see the
  * reconstruction filters for an example. If a simple attribute is needed,
@@ -243,7 +244,7 @@ public:
     }
 
   private:
-    typedef typename std::deque< LineType >            LineContainerType;
+    typedef typename std::vector< LineType >           LineContainerType;
     typedef typename LineContainerType::const_iterator InternalIteratorType;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -338,7 +339,7 @@ public:
 
   private:
 
-    typedef typename std::deque< LineType >            LineContainerType;
+    typedef typename std::vector< LineType >           LineContainerType;
     typedef typename LineContainerType::const_iterator InternalIteratorType;
     void NextValidLine()
     {
@@ -367,7 +368,7 @@ private:
   LabelObject(const Self &);    //purposely not implemented
   void operator=(const Self &); //purposely not implemented
 
-  typedef typename std::deque< LineType >    LineContainerType;
+  typedef typename std::vector< LineType >   LineContainerType;
 
   LineContainerType m_LineContainer;
   LabelType         m_Label;
@@ -19,6 +19,8 @@
 #define itkShapeLabelMapFilter_h
 
 #include "itkInPlaceLabelMapFilter.h"
+#include <vector>
+#include <utility>
 
 namespace itk
 {
@@ -28,15 +30,23 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * The feret diameter and the oriented bounding box are computed from the
+ * convex hull of the object. The ends of the lines are the only pixels
+ * which can be a vertex of the hull, and they are reduced further by
+ * keeping only the vertices of the 2D hulls in the planes parallel to
+ * the image axes. The feret diameter is then searched among the remaining
+ * points only, which is exact and much cheaper than comparing all the
+ * pixels of the object border.
+ *
+ * The oriented bounding box encloses the pixels, not only their centers.
+ * In 2D, it is the minimum area rectangle. In 3D, the box is the smallest
+ * found by fixing one axis to a principal axis or an image axis, and by
+ * searching the minimum area rectangle in the orthogonal plane. In higher
+ * dimensions, the box is aligned on the principal axes.
+ *
+ * ShapeLabelMapFilter takes an optional parameter, the exact copy of the
+ * input LabelMap stored in an Image, which can be set with SetLabelImage().
+ * It is not needed anymore, and is kept for backward compatibility.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -107,6 +117,14 @@ public:
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
   itkBooleanMacro(ComputeFeretDiameter);
 
+  /**
+   * Set/Get whether the oriented bounding box should be computed or not.
+   * Default value is false.
+   */
+  itkSetMacro(ComputeOrientedBoundingBox, bool);
+  itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
+  itkBooleanMacro(ComputeOrientedBoundingBox);
+
   /**
    * Set/Get whether the perimeter should be computed or not.
    * Default value is false because of the high computation time required.
@@ -138,12 +156,92 @@ private:
   void operator=(const Self &);      //purposely not implemented
 
   bool                   m_ComputeFeretDiameter;
+  bool                   m_ComputeOrientedBoundingBox;
   bool                   m_ComputePerimeter;
   LabelImageConstPointer m_LabelImage;
 
-  void ComputeFeretDiameter(LabelObjectType *labelObject);
+  typedef std::vector< IndexType >         IndexListType;
+  typedef std::pair< double, double >      Point2DType;
+  typedef std::vector< Point2DType >       Point2DListType;
+  typedef Vector< double, ImageDimension > DirectionVectorType;
+
+  void ComputeConvexHullPoints(const LabelObjectType *labelObject, IndexListType & points);
+  void ComputeFeretDiameter(LabelObjectType *labelObject, const IndexListType & points);
+  void ComputeOrientedBoundingBox(LabelObjectType *labelObject, const IndexListType & points);
   void ComputePerimeter(LabelObjectType *labelObject);
 
+  /** Keep only the points which are a vertex of the 2D convex hull in their
+   * plane parallel to the axes axis0 and axis1. */
+  static void KeepPlaneConvexHullVertices(IndexListType & points, unsigned int axis0, unsigned int axis1);
+
+  /** Replace the points by the vertices of their convex hull, in counter
+   * clockwise order. */
+  static void ConvexHull2D(Point2DListType & points);
+
+  static double Cross2D(const Point2DType & o, const Point2DType & a, const Point2DType & b)
+  {
+    return ( a.first - o.first ) * ( b.second - o.second ) - ( a.second - o.second ) * ( b.first - o.first );
+  }
+
+  /** Order the indexes plane by plane, for the planes parallel to the axes
+   * axis0 and axis1, and then on axis0 and axis1 in each plane. */
+  class PlaneCompare
+  {
+  public:
+    PlaneCompare(unsigned int axis0, unsigned int axis1):
+      m_Axis0(axis0), m_Axis1(axis1) {}
+
+    bool InSamePlane(const IndexType & a, const IndexType & b) const
+    {
+      for ( unsigned int i = 0; i < ImageDimension; i++ )
+        {
+        if ( i != m_Axis0 && i != m_Axis1 && a[i] != b[i] )
+          {
+          return false;
+          }
+        }
+      return true;
+    }
+
+    bool operator()(const IndexType & a, const IndexType & b) const
+    {
+      for ( unsigned int i = 0; i < ImageDimension; i++ )
+        {
+        if ( i != m_Axis0 && i != m_Axis1 && a[i] != b[i] )
+          {
+          return a[i] < b[i];
+          }
+        }
+      if ( a[m_Axis0] != b[m_Axis0] )
+        {
+        return a[m_Axis0] < b[m_Axis0];
+        }
+      return a[m_Axis1] < b[m_Axis1];
+    }
+
+  private:
+    unsigned int m_Axis0;
+    unsigned int m_Axis1;
+  };
+
+  /** Search the rotation of the box axes u and v in the plane given by the
+   * orthonormal vectors p and q which gives the smallest rectangle around the
+   * points. The points are already in physical units, and the half size of
+   * a pixel is added on each side. */
+  static double MinimumRectangleInPlane(const std::vector< DirectionVectorType > & points,
+                                        const DirectionVectorType & p,
+                                        const DirectionVectorType & q,
+                                        const DirectionVectorType & spacing,
+                                        DirectionVectorType & u,
+                                        DirectionVectorType & v);
+
+  /** Extent of the points along the direction, with the size of the pixels */
+  static void ComputeExtent(const std::vector< DirectionVectorType > & points,
+                            const DirectionVectorType & direction,
+                            const DirectionVectorType & spacing,
+                            double & minimum,
+                            double & maximum);
+
   typedef itk::Offset<2>                                                          Offset2Type;
   typedef itk::Offset<3>                                                          Offset3Type;
   typedef itk::Vector<double, 2>                                                  Spacing2Type;
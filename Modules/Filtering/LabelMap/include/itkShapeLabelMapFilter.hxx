@@ -28,7 +28,9 @@
 #include "itkConnectedComponentAlgorithm.h"
 #include "vnl/algo/vnl_real_eigensystem.h"
 #include "vnl/algo/vnl_symmetric_eigensystem.h"
+#include "vnl/algo/vnl_determinant.h"
 #include "vnl/vnl_math.h"
+#include <algorithm>
 #include <deque>
 #include <map>
 
@@ -39,6 +41,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 ::ShapeLabelMapFilter()
 {
   m_ComputeFeretDiameter = false;
+  m_ComputeOrientedBoundingBox = false;
   m_ComputePerimeter = true;
 }
 
@@ -48,22 +51,6 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 ::BeforeThreadedGenerateData()
 {
   Superclass::BeforeThreadedGenerateData();
-
-  // Generate the label image, if needed
-  if ( m_ComputeFeretDiameter )
-    {
-    if ( !m_LabelImage )
-      {
-      // generate an image of the labelized image
-      typedef LabelMapToLabelImageFilter< TImage, LabelImageType > LCI2IType;
-      typename LCI2IType::Pointer lci2i = LCI2IType::New();
-      lci2i->SetInput( this->GetOutput() );
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfThreads( this->GetNumberOfThreads() );
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
-      }
-    }
 }
 
 template< typename TImage, typename TLabelImage >
@@ -371,9 +358,19 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   labelObject->SetEquivalentEllipsoidDiameter(ellipsoidDiameter);
   labelObject->SetFlatness(flatness);
 
-  if ( m_ComputeFeretDiameter )
+  if ( m_ComputeFeretDiameter || m_ComputeOrientedBoundingBox )
     {
-    this->ComputeFeretDiameter(labelObject);
+    // both are computed from the same points
+    IndexListType hullPoints;
+    this->ComputeConvexHullPoints(labelObject, hullPoints);
+    if ( m_ComputeFeretDiameter )
+      {
+      this->ComputeFeretDiameter(labelObject, hullPoints);
+      }
+    if ( m_ComputeOrientedBoundingBox )
+      {
+      this->ComputeOrientedBoundingBox(labelObject, hullPoints);
+      }
     }
 
   if ( m_ComputePerimeter )
@@ -385,63 +382,145 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 template< typename TImage, typename TLabelImage >
 void
 ShapeLabelMapFilter< TImage, TLabelImage >
-::ComputeFeretDiameter(LabelObjectType *labelObject)
+::ComputeConvexHullPoints(const LabelObjectType *labelObject, IndexListType & points)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
-
-  typedef typename std::deque< IndexType > IndexListType;
-  IndexListType idxList;
-
-  typedef typename itk::ConstNeighborhoodIterator< LabelImageType > NeighborIteratorType;
-  SizeType neighborHoodRadius;
-  neighborHoodRadius.Fill(1);
-  NeighborIteratorType                        it( neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion() );
-  ConstantBoundaryCondition< LabelImageType > lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
+  // only the ends of the lines can be a vertex of the convex hull
+  points.clear();
+  points.reserve( 2 * labelObject->GetNumberOfLines() );
+  for ( SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i )
+    {
+    const typename LabelObjectType::LineType & line = labelObject->GetLine(i);
+    if ( line.GetLength() == 0 )
+      {
+      continue;
+      }
+    IndexType idx = line.GetIndex();
+    points.push_back(idx);
+    if ( line.GetLength() > 1 )
+      {
+      idx[0] += line.GetLength() - 1;
+      points.push_back(idx);
+      }
+    }
 
-  typedef typename NeighborIteratorType::NeighborIndexType   NeighborIndexType;
+  // a vertex of the hull is still a vertex of the hull of any subset which
+  // contains it, in particular of the points in its plane parallel to two
+  // image axes. The points which are not such a vertex can be dropped.
+  for ( unsigned int axis0 = 0; axis0 < ImageDimension; ++axis0 )
+    {
+    for ( unsigned int axis1 = axis0 + 1; axis1 < ImageDimension; ++axis1 )
+      {
+      KeepPlaneConvexHullVertices(points, axis0, axis1);
+      }
+    }
+}
 
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit( labelObject );
-  while( ! iit.IsAtEnd() )
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::KeepPlaneConvexHullVertices(IndexListType & points, unsigned int axis0, unsigned int axis1)
+{
+  PlaneCompare compare(axis0, axis1);
+  std::sort(points.begin(), points.end(), compare);
+  points.erase( std::unique( points.begin(), points.end() ), points.end() );
+
+  IndexListType   kept;
+  Point2DListType plane;
+  kept.reserve( points.size() );
+  typename IndexListType::const_iterator begin = points.begin();
+  while ( begin != points.end() )
     {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
+    typename IndexListType::const_iterator end = begin + 1;
+    while ( end != points.end() && compare.InSamePlane(*begin, *end) )
+      {
+      ++end;
+      }
 
-    // Push the pixel in the list if it is on the border of the object
-    for ( NeighborIndexType i = 0; i < it.Size(); i++ )
+    if ( end - begin <= 2 )
       {
-      if ( it.GetPixel(i) != label )
+      kept.insert(kept.end(), begin, end);
+      }
+    else
+      {
+      plane.clear();
+      for ( typename IndexListType::const_iterator it = begin; it != end; ++it )
         {
-        idxList.push_back( iit.GetIndex() );
-        break;
+        plane.push_back( Point2DType( ( *it )[axis0], ( *it )[axis1] ) );
+        }
+      ConvexHull2D(plane);
+      std::sort(plane.begin(), plane.end());
+      for ( typename IndexListType::const_iterator it = begin; it != end; ++it )
+        {
+        if ( std::binary_search( plane.begin(), plane.end(), Point2DType( ( *it )[axis0], ( *it )[axis1] ) ) )
+          {
+          kept.push_back(*it);
+          }
         }
       }
-    ++iit;
+    begin = end;
     }
+  points.swap(kept);
+}
 
-  ImageType *output = this->GetOutput();
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ConvexHull2D(Point2DListType & points)
+{
+  // Andrew's monotone chain. The collinear points are not kept.
+  std::sort(points.begin(), points.end());
+  points.erase( std::unique( points.begin(), points.end() ), points.end() );
+  const size_t n = points.size();
+  if ( n < 3 )
+    {
+    return;
+    }
 
-  const typename ImageType::SpacingType & spacing = output->GetSpacing();
+  Point2DListType hull(2 * n);
+  size_t          k = 0;
+  for ( size_t i = 0; i < n; ++i )
+    {
+    while ( k >= 2 && Cross2D(hull[k - 2], hull[k - 1], points[i]) <= 0 )
+      {
+      --k;
+      }
+    hull[k++] = points[i];
+    }
+  for ( size_t i = n - 1, t = k + 1; i > 0; --i )
+    {
+    while ( k >= t && Cross2D(hull[k - 2], hull[k - 1], points[i - 1]) <= 0 )
+      {
+      --k;
+      }
+    hull[k++] = points[i - 1];
+    }
+  // the first point is also the last one
+  hull.resize(k - 1);
+  points.swap(hull);
+}
 
-  // We can now search the feret diameter
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ComputeFeretDiameter(LabelObjectType *labelObject, const IndexListType & points)
+{
+  const typename ImageType::SpacingType & spacing = this->GetOutput()->GetSpacing();
+
+  // the two most distant pixels are vertices of the hull
   double feretDiameter = 0;
-  for ( typename IndexListType::const_iterator iIt1 = idxList.begin();
-        iIt1 != idxList.end();
+  for ( typename IndexListType::const_iterator iIt1 = points.begin();
+        iIt1 != points.end();
         iIt1++ )
     {
     typename IndexListType::const_iterator iIt2 = iIt1;
-    for ( iIt2++; iIt2 != idxList.end(); iIt2++ )
+    for ( iIt2++; iIt2 != points.end(); iIt2++ )
       {
       // Compute the length between the 2 indexes
       double length = 0;
       for ( unsigned int i = 0; i < ImageDimension; i++ )
         {
-        const OffsetValueType indexDifference = ( iIt1->operator[](i) - iIt2->operator[](i) );
-        length += std::pow(indexDifference * spacing[i], 2);
+        const double difference = ( iIt1->operator[](i) - iIt2->operator[](i) ) * spacing[i];
+        length += difference * difference;
         }
       if ( feretDiameter < length )
         {
@@ -456,6 +535,288 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   labelObject->SetFeretDiameter(feretDiameter);
 }
 
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ComputeOrientedBoundingBox(LabelObjectType *labelObject, const IndexListType & points)
+{
+  const ImageType *                           output = this->GetOutput();
+  const typename ImageType::DirectionType &   imageDirection = output->GetDirection();
+  const typename ImageType::PointType &       imageOrigin = output->GetOrigin();
+
+  // work on the indexes scaled by the spacing: the boxes found there are
+  // rotated, but not distorted, by the image direction
+  DirectionVectorType spacing;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    spacing[i] = output->GetSpacing()[i];
+    }
+  std::vector< DirectionVectorType > scaled( points.size() );
+  for ( size_t j = 0; j < points.size(); j++ )
+    {
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      scaled[j][i] = points[j][i] * spacing[i];
+      }
+    }
+
+  // the principal axes, in the same frame, are always a candidate
+  const MatrixType &                 principalAxes = labelObject->GetPrincipalAxes();
+  std::vector< DirectionVectorType > axes(ImageDimension);
+  for ( unsigned int k = 0; k < ImageDimension; k++ )
+    {
+    axes[k].Fill(0);
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        axes[k][i] += imageDirection[j][i] * principalAxes[k][j];
+        }
+      }
+    }
+  double bestVolume = NumericTraits< double >::max();
+  if ( vnl_math_abs( vnl_determinant( principalAxes.GetVnlMatrix() ) ) > 0.5 )
+    {
+    bestVolume = 1;
+    for ( unsigned int k = 0; k < ImageDimension; k++ )
+      {
+      double minimum;
+      double maximum;
+      ComputeExtent(scaled, axes[k], spacing, minimum, maximum);
+      bestVolume *= maximum - minimum;
+      }
+    }
+  else
+    {
+    for ( unsigned int k = 0; k < ImageDimension; k++ )
+      {
+      axes[k].Fill(0);
+      axes[k][k] = 1;
+      }
+    }
+
+  if ( ImageDimension == 2 )
+    {
+    // the minimum area rectangle
+    DirectionVectorType p;
+    DirectionVectorType q;
+    p.Fill(0);
+    q.Fill(0);
+    p[0] = 1;
+    q[1] = 1;
+    DirectionVectorType u;
+    DirectionVectorType v;
+    const double area = MinimumRectangleInPlane(scaled, p, q, spacing, u, v);
+    if ( area < bestVolume )
+      {
+      bestVolume = area;
+      axes[0] = u;
+      axes[1] = v;
+      }
+    }
+  else if ( ImageDimension == 3 )
+    {
+    // fix one axis of the box, and search the minimum rectangle in the
+    // orthogonal plane
+    std::vector< DirectionVectorType > candidates(axes);
+    for ( unsigned int k = 0; k < ImageDimension; k++ )
+      {
+      DirectionVectorType e;
+      e.Fill(0);
+      e[k] = 1;
+      candidates.push_back(e);
+      }
+    for ( size_t c = 0; c < candidates.size(); c++ )
+      {
+      const DirectionVectorType & a = candidates[c];
+      // complete a with the image axis the most orthogonal to it
+      unsigned int closest = 0;
+      for ( unsigned int i = 1; i < ImageDimension; i++ )
+        {
+        if ( vnl_math_abs(a[i]) < vnl_math_abs(a[closest]) )
+          {
+          closest = i;
+          }
+        }
+      DirectionVectorType p = -a[closest] * a;
+      p[closest] += 1;
+      p.Normalize();
+      DirectionVectorType q;
+      for ( unsigned int i = 0; i < ImageDimension; i++ )
+        {
+        const unsigned int i1 = ( i + 1 ) % ImageDimension;
+        const unsigned int i2 = ( i + 2 ) % ImageDimension;
+        q[i] = a[i1] * p[i2] - a[i2] * p[i1];
+        }
+
+      double minimum;
+      double maximum;
+      ComputeExtent(scaled, a, spacing, minimum, maximum);
+      DirectionVectorType u;
+      DirectionVectorType v;
+      const double volume = ( maximum - minimum ) * MinimumRectangleInPlane(scaled, p, q, spacing, u, v);
+      if ( volume < bestVolume )
+        {
+        bestVolume = volume;
+        axes[0] = a;
+        axes[1] = u;
+        axes[2] = v;
+        }
+      }
+    }
+
+  // make the axes a direct frame
+  MatrixType direction;
+  for ( unsigned int k = 0; k < ImageDimension; k++ )
+    {
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      direction[k][i] = axes[k][i];
+      }
+    }
+  if ( vnl_determinant( direction.GetVnlMatrix() ) < 0 )
+    {
+    axes[ImageDimension - 1] = -axes[ImageDimension - 1];
+    }
+
+  VectorType          size;
+  DirectionVectorType corner;
+  corner.Fill(0);
+  for ( unsigned int k = 0; k < ImageDimension; k++ )
+    {
+    double minimum;
+    double maximum;
+    ComputeExtent(scaled, axes[k], spacing, minimum, maximum);
+    size[k] = maximum - minimum;
+    corner += minimum * axes[k];
+    }
+
+  // back to the physical space
+  typename LabelObjectType::OrientedBoundingBoxPointType origin;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    origin[i] = imageOrigin[i];
+    for ( unsigned int j = 0; j < ImageDimension; j++ )
+      {
+      origin[i] += imageDirection[i][j] * corner[j];
+      }
+    for ( unsigned int k = 0; k < ImageDimension; k++ )
+      {
+      direction[k][i] = 0;
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        direction[k][i] += imageDirection[i][j] * axes[k][j];
+        }
+      }
+    }
+
+  labelObject->SetOrientedBoundingBoxSize(size);
+  labelObject->SetOrientedBoundingBoxOrigin(origin);
+  labelObject->SetOrientedBoundingBoxDirection(direction);
+}
+
+template< typename TImage, typename TLabelImage >
+double
+ShapeLabelMapFilter< TImage, TLabelImage >
+::MinimumRectangleInPlane(const std::vector< DirectionVectorType > & points,
+                          const DirectionVectorType & p,
+                          const DirectionVectorType & q,
+                          const DirectionVectorType & spacing,
+                          DirectionVectorType & u,
+                          DirectionVectorType & v)
+{
+  Point2DListType hull( points.size() );
+  for ( size_t j = 0; j < points.size(); j++ )
+    {
+    hull[j] = Point2DType( points[j] * p, points[j] * q );
+    }
+  ConvexHull2D(hull);
+
+  // the minimum rectangle has a side along an edge of the hull of the
+  // pixels, which is either an edge of the hull of their centers, or the
+  // projection of an image axis
+  Point2DListType sides;
+  for ( size_t j = 0; hull.size() > 1 && j < hull.size(); j++ )
+    {
+    const Point2DType & a = hull[j];
+    const Point2DType & b = hull[( j + 1 ) % hull.size()];
+    sides.push_back( Point2DType( b.first - a.first, b.second - a.second ) );
+    }
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    sides.push_back( Point2DType( p[i], q[i] ) );
+    }
+
+  double bestArea = NumericTraits< double >::max();
+  for ( size_t s = 0; s < sides.size(); s++ )
+    {
+    const double norm = std::sqrt( sides[s].first * sides[s].first + sides[s].second * sides[s].second );
+    if ( norm < 1e-6 )
+      {
+      continue;
+      }
+    const double c = sides[s].first / norm;
+    const double d = sides[s].second / norm;
+    double       minimumU = NumericTraits< double >::max();
+    double       maximumU = NumericTraits< double >::NonpositiveMin();
+    double       minimumV = NumericTraits< double >::max();
+    double       maximumV = NumericTraits< double >::NonpositiveMin();
+    for ( size_t j = 0; j < hull.size(); j++ )
+      {
+      const double pu = c * hull[j].first + d * hull[j].second;
+      const double pv = c * hull[j].second - d * hull[j].first;
+      minimumU = std::min(minimumU, pu);
+      maximumU = std::max(maximumU, pu);
+      minimumV = std::min(minimumV, pv);
+      maximumV = std::max(maximumV, pv);
+      }
+    const DirectionVectorType su = c * p + d * q;
+    const DirectionVectorType sv = c * q - d * p;
+    double                    padU = 0;
+    double                    padV = 0;
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      padU += vnl_math_abs(su[i]) * spacing[i];
+      padV += vnl_math_abs(sv[i]) * spacing[i];
+      }
+    const double area = ( maximumU - minimumU + padU ) * ( maximumV - minimumV + padV );
+    if ( area < bestArea )
+      {
+      bestArea = area;
+      u = su;
+      v = sv;
+      }
+    }
+  return bestArea;
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ComputeExtent(const std::vector< DirectionVectorType > & points,
+                const DirectionVectorType & direction,
+                const DirectionVectorType & spacing,
+                double & minimum,
+                double & maximum)
+{
+  minimum = NumericTraits< double >::max();
+  maximum = NumericTraits< double >::NonpositiveMin();
+  for ( size_t j = 0; j < points.size(); j++ )
+    {
+    const double projection = points[j] * direction;
+    minimum = std::min(minimum, projection);
+    maximum = std::max(maximum, projection);
+    }
+  // a pixel extends by half its size on each side of its center
+  double pad = 0;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    pad += vnl_math_abs(direction[i]) * spacing[i] / 2;
+    }
+  minimum -= pad;
+  maximum += pad;
+}
+
 template< typename TImage, typename TLabelImage >
 void
 ShapeLabelMapFilter< TImage, TLabelImage >
@@ -757,6 +1118,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   Superclass::PrintSelf(os, indent);
 
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
+  os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
 }
 
@@ -142,6 +142,22 @@ public:
 
   itkStaticConstMacro(PERIMETER_ON_BORDER_RATIO, AttributeType, 118);
 
+  /** OrientedBoundingBoxSize is the size in physical units of the smallest
+    * box found around the pixels of the object, along the axes given by
+    * OrientedBoundingBoxDirection. Like the feret diameter, it is computed
+    * from the convex hull of the object, and not by default.
+    * Its type is VectorType. */
+  itkStaticConstMacro(ORIENTED_BOUNDING_BOX_SIZE, AttributeType, 119);
+
+  /** OrientedBoundingBoxOrigin is the physical position of the corner of the
+    * oriented bounding box from which the box extends along its axes.
+    * Its type is OrientedBoundingBoxPointType. */
+  itkStaticConstMacro(ORIENTED_BOUNDING_BOX_ORIGIN, AttributeType, 120);
+
+  /** OrientedBoundingBoxDirection contains the axes of the oriented bounding
+    * box, one per row, in physical space. Its type is MatrixType. */
+  itkStaticConstMacro(ORIENTED_BOUNDING_BOX_DIRECTION, AttributeType, 121);
+
   static AttributeType GetAttributeFromName(const std::string & s)
   {
     if ( s == "NumberOfPixels" )
@@ -212,6 +228,18 @@ public:
       {
       return PERIMETER_ON_BORDER_RATIO;
       }
+    else if ( s == "OrientedBoundingBoxSize" )
+      {
+      return ORIENTED_BOUNDING_BOX_SIZE;
+      }
+    else if ( s == "OrientedBoundingBoxOrigin" )
+      {
+      return ORIENTED_BOUNDING_BOX_ORIGIN;
+      }
+    else if ( s == "OrientedBoundingBoxDirection" )
+      {
+      return ORIENTED_BOUNDING_BOX_DIRECTION;
+      }
     // can't recognize the name
     return Superclass::GetAttributeFromName(s);
   }
@@ -272,6 +300,15 @@ public:
       case PERIMETER_ON_BORDER_RATIO:
         name = "PerimeterOnBorderRatio";
         break;
+      case ORIENTED_BOUNDING_BOX_SIZE:
+        name = "OrientedBoundingBoxSize";
+        break;
+      case ORIENTED_BOUNDING_BOX_ORIGIN:
+        name = "OrientedBoundingBoxOrigin";
+        break;
+      case ORIENTED_BOUNDING_BOX_DIRECTION:
+        name = "OrientedBoundingBoxDirection";
+        break;
       default:
         // can't recognize the name
         name = Superclass::GetNameFromAttribute(a);
@@ -288,6 +325,8 @@ public:
 
   typedef Vector< double, VImageDimension > VectorType;
 
+  typedef Point< double, VImageDimension > OrientedBoundingBoxPointType;
+
   const RegionType & GetBoundingBox() const
   {
     return m_BoundingBox;
@@ -458,6 +497,36 @@ public:
     m_PerimeterOnBorderRatio = v;
   }
 
+  const VectorType & GetOrientedBoundingBoxSize() const
+  {
+    return m_OrientedBoundingBoxSize;
+  }
+
+  void SetOrientedBoundingBoxSize(const VectorType & v)
+  {
+    m_OrientedBoundingBoxSize = v;
+  }
+
+  const OrientedBoundingBoxPointType & GetOrientedBoundingBoxOrigin() const
+  {
+    return m_OrientedBoundingBoxOrigin;
+  }
+
+  void SetOrientedBoundingBoxOrigin(const OrientedBoundingBoxPointType & v)
+  {
+    m_OrientedBoundingBoxOrigin = v;
+  }
+
+  const MatrixType & GetOrientedBoundingBoxDirection() const
+  {
+    return m_OrientedBoundingBoxDirection;
+  }
+
+  void SetOrientedBoundingBoxDirection(const MatrixType & v)
+  {
+    m_OrientedBoundingBoxDirection = v;
+  }
+
   // some helper methods - not really required, but really useful!
 
   /** Affine transform for mapping to and from principal axis */
@@ -542,6 +611,9 @@ public:
     m_EquivalentEllipsoidDiameter = src->m_EquivalentEllipsoidDiameter;
     m_Flatness = src->m_Flatness;
     m_PerimeterOnBorderRatio = src->m_PerimeterOnBorderRatio;
+    m_OrientedBoundingBoxSize = src->m_OrientedBoundingBoxSize;
+    m_OrientedBoundingBoxOrigin = src->m_OrientedBoundingBoxOrigin;
+    m_OrientedBoundingBoxDirection = src->m_OrientedBoundingBoxDirection;
   }
 
 protected:
@@ -563,6 +635,9 @@ protected:
     m_EquivalentEllipsoidDiameter.Fill(0);
     m_Flatness = 0;
     m_PerimeterOnBorderRatio = 0;
+    m_OrientedBoundingBoxSize.Fill(0);
+    m_OrientedBoundingBoxOrigin.Fill(0);
+    m_OrientedBoundingBoxDirection.Fill(0);
   }
 
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE
@@ -587,6 +662,9 @@ protected:
     os << indent << "PrincipalMoments: " << m_PrincipalMoments << std::endl;
     os << indent << "PrincipalAxes: " << std::endl << m_PrincipalAxes;
     os << indent << "FeretDiameter: " << m_FeretDiameter << std::endl;
+    os << indent << "OrientedBoundingBoxSize: " << m_OrientedBoundingBoxSize << std::endl;
+    os << indent << "OrientedBoundingBoxOrigin: " << m_OrientedBoundingBoxOrigin << std::endl;
+    os << indent << "OrientedBoundingBoxDirection: " << std::endl << m_OrientedBoundingBoxDirection;
   }
 
 private:
@@ -610,6 +688,10 @@ private:
   VectorType    m_EquivalentEllipsoidDiameter;
   double        m_Flatness;
   double        m_PerimeterOnBorderRatio;
+
+  VectorType                   m_OrientedBoundingBoxSize;
+  OrientedBoundingBoxPointType m_OrientedBoundingBoxOrigin;
+  MatrixType                   m_OrientedBoundingBoxDirection;
 };
 } // end namespace itk
 
@@ -256,6 +256,45 @@ public:
   }
 };
 
+template< typename TLabelObject >
+class OrientedBoundingBoxSizeLabelObjectAccessor
+{
+public:
+  typedef TLabelObject                         LabelObjectType;
+  typedef typename LabelObjectType::VectorType AttributeValueType;
+
+  inline AttributeValueType operator()(const LabelObjectType *labelObject) const
+  {
+    return labelObject->GetOrientedBoundingBoxSize();
+  }
+};
+
+template< typename TLabelObject >
+class OrientedBoundingBoxOriginLabelObjectAccessor
+{
+public:
+  typedef TLabelObject                                           LabelObjectType;
+  typedef typename LabelObjectType::OrientedBoundingBoxPointType AttributeValueType;
+
+  inline AttributeValueType operator()(const LabelObjectType *labelObject) const
+  {
+    return labelObject->GetOrientedBoundingBoxOrigin();
+  }
+};
+
+template< typename TLabelObject >
+class OrientedBoundingBoxDirectionLabelObjectAccessor
+{
+public:
+  typedef TLabelObject                         LabelObjectType;
+  typedef typename LabelObjectType::MatrixType AttributeValueType;
+
+  inline AttributeValueType operator()(const LabelObjectType *labelObject) const
+  {
+    return labelObject->GetOrientedBoundingBoxDirection();
+  }
+};
+
 }
 } // end namespace itk
 
@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include "itkLabelMap.h"
+#include "itkShapeLabelObject.h"
+#include "itkShapeLabelMapFilter.h"
+#include "itkChangeRegionLabelMapFilter.h"
+
+// Check that the label objects are all processed exactly once when they
+// are handed out in chunks to many threads, with objects of very
+// different sizes, and when the filter removes objects while it runs.
+int itkLabelMapFilterChunksTest(int argc, char * argv[])
+{
+  if( argc != 1 )
+    {
+    std::cerr << "usage: " << argv[0] << "" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int dim = 2;
+
+  typedef itk::ShapeLabelObject< unsigned long, dim > LabelObjectType;
+  typedef LabelObjectType::IndexType                  IndexType;
+  typedef itk::LabelMap< LabelObjectType >            LabelMapType;
+  typedef LabelMapType::SizeType                      SizeType;
+
+  typedef itk::ShapeLabelMapFilter< LabelMapType >         ShapeFilterType;
+  typedef itk::ChangeRegionLabelMapFilter< LabelMapType >  ChangeRegionFilterType;
+
+  // a few large objects among many one pixel ones
+  SizeType size;
+  size[0] = 200;
+  size[1] = 200;
+  LabelMapType::Pointer map = LabelMapType::New();
+  map->SetRegions( size );
+  map->Allocate();
+
+  unsigned long label = 1;
+  IndexType idx;
+  for ( idx[1] = 0; idx[1] < 200; idx[1]++ )
+    {
+    if ( idx[1] % 50 == 0 )
+      {
+      ++label;
+      }
+    idx[0] = 0;
+    map->SetLine( idx, 100, label );
+    }
+  ++label;
+  for ( idx[1] = 0; idx[1] < 200; idx[1] += 2 )
+    {
+    for ( idx[0] = 100; idx[0] < 200; idx[0] += 2 )
+      {
+      map->SetLine( idx, 1, label++ );
+      }
+    }
+  const unsigned long numberOfObjects = map->GetNumberOfLabelObjects();
+
+  LabelMapType::Pointer results[2];
+  const int numberOfThreads[2] = { 1, 8 };
+  for ( unsigned int i = 0; i < 2; i++ )
+    {
+    ShapeFilterType::Pointer shape = ShapeFilterType::New();
+    shape->SetInput( map );
+    shape->InPlaceOff();
+    shape->SetNumberOfThreads( numberOfThreads[i] );
+    shape->Update();
+    results[i] = shape->GetOutput();
+    results[i]->DisconnectPipeline();
+    }
+
+  if ( results[1]->GetNumberOfLabelObjects() != numberOfObjects )
+    {
+    std::cerr << "Wrong number of objects: " << results[1]->GetNumberOfLabelObjects()
+              << " instead of " << numberOfObjects << std::endl;
+    return EXIT_FAILURE;
+    }
+  for ( LabelMapType::ConstIterator it( results[0] ); !it.IsAtEnd(); ++it )
+    {
+    const LabelObjectType *reference = it.GetLabelObject();
+    const LabelObjectType *object = results[1]->GetLabelObject( it.GetLabel() );
+    if ( object->GetNumberOfPixels() != reference->GetNumberOfPixels()
+         || object->GetCentroid() != reference->GetCentroid()
+         || object->GetBoundingBox() != reference->GetBoundingBox() )
+      {
+      std::cerr << "Object " << it.GetLabel() << " differs with "
+                << numberOfThreads[1] << " threads" << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // cropping removes the objects out of the region from the threads
+  unsigned long expected = 0;
+  for ( LabelMapType::ConstIterator it( map ); !it.IsAtEnd(); ++it )
+    {
+    const IndexType & first = it.GetLabelObject()->GetLine(0).GetIndex();
+    if ( first[0] < 150 )
+      {
+      ++expected;
+      }
+    }
+
+  ChangeRegionFilterType::Pointer change = ChangeRegionFilterType::New();
+  change->SetInput( map );
+  IndexType start;
+  start.Fill( 0 );
+  SizeType cropSize;
+  cropSize[0] = 150;
+  cropSize[1] = 200;
+  change->SetRegion( LabelMapType::RegionType( start, cropSize ) );
+  change->SetNumberOfThreads( 8 );
+  change->Update();
+
+  if ( change->GetOutput()->GetNumberOfLabelObjects() != expected )
+    {
+    std::cerr << "Wrong number of objects after the region change: "
+              << change->GetOutput()->GetNumberOfLabelObjects()
+              << " instead of " << expected << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
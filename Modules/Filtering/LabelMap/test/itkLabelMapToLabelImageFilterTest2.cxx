@@ -0,0 +1,103 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkLabelMapToBinaryImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+// Round trip a 3D label image with a non zero start index through a label
+// map, and check the label and binary images written line by line.
+int itkLabelMapToLabelImageFilterTest2(int argc, char * argv[])
+{
+  if( argc != 1 )
+    {
+    std::cerr << "usage: " << argv[0] << "" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int dim = 3;
+
+  typedef itk::Image< unsigned short, dim >                            ImageType;
+  typedef itk::LabelImageToLabelMapFilter< ImageType >                 ToLabelMapType;
+  typedef ToLabelMapType::OutputImageType                              LabelMapType;
+  typedef itk::LabelMapToLabelImageFilter< LabelMapType, ImageType >   ToLabelImageType;
+  typedef itk::LabelMapToBinaryImageFilter< LabelMapType, ImageType >  ToBinaryImageType;
+
+  ImageType::IndexType start;
+  start[0] = 5;
+  start[1] = -3;
+  start[2] = 7;
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 21;
+  size[2] = 9;
+  ImageType::RegionType region( start, size );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+
+  // runs of various lengths, with some background between them
+  unsigned int i = 0;
+  for ( itk::ImageRegionIterator< ImageType > it( image, region ); !it.IsAtEnd(); ++it, ++i )
+    {
+    const unsigned int run = ( i / 3 ) % 11;
+    it.Set( run == 0 ? 0 : static_cast< unsigned short >( ( i / 7 ) % 250 + 1 ) );
+    }
+
+  ToLabelMapType::Pointer toLabelMap = ToLabelMapType::New();
+  toLabelMap->SetInput( image );
+  toLabelMap->SetBackgroundValue( 0 );
+
+  ToLabelImageType::Pointer toLabelImage = ToLabelImageType::New();
+  toLabelImage->SetInput( toLabelMap->GetOutput() );
+  toLabelImage->SetNumberOfThreads( 4 );
+
+  ToBinaryImageType::Pointer toBinaryImage = ToBinaryImageType::New();
+  toBinaryImage->SetInput( toLabelMap->GetOutput() );
+  toBinaryImage->SetForegroundValue( 255 );
+  toBinaryImage->SetBackgroundValue( 0 );
+  toBinaryImage->SetNumberOfThreads( 4 );
+
+  toLabelImage->Update();
+  toBinaryImage->Update();
+
+  itk::ImageRegionConstIterator< ImageType > iit( image, region );
+  itk::ImageRegionConstIterator< ImageType > lit( toLabelImage->GetOutput(), region );
+  itk::ImageRegionConstIterator< ImageType > bit( toBinaryImage->GetOutput(), region );
+  for ( ; !iit.IsAtEnd(); ++iit, ++lit, ++bit )
+    {
+    if ( lit.Get() != iit.Get() )
+      {
+      std::cerr << "Wrong label at " << iit.GetIndex() << ": " << lit.Get()
+                << " instead of " << iit.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    const unsigned short expected = iit.Get() == 0 ? 0 : 255;
+    if ( bit.Get() != expected )
+      {
+      std::cerr << "Wrong binary value at " << iit.GetIndex() << ": " << bit.Get()
+                << " instead of " << expected << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
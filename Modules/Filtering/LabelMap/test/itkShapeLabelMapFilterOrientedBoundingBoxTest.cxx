@@ -0,0 +1,209 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "vnl/vnl_math.h"
+
+// Compare the feret diameter with the distance of the two most distant
+// pixels, and check that the oriented bounding box holds all the pixels and
+// is not larger than the axis aligned bounding box.
+template< unsigned int VDimension >
+int CheckFeretDiameterAndOrientedBoundingBox( itk::Image< unsigned char, VDimension > * image )
+{
+  typedef itk::Image< unsigned char, VDimension >                 ImageType;
+  typedef itk::LabelImageToShapeLabelMapFilter< ImageType >       ShapeFilterType;
+  typedef typename ShapeFilterType::OutputImageType               LabelMapType;
+  typedef typename LabelMapType::LabelObjectType                  LabelObjectType;
+  typedef typename ImageType::IndexType                           IndexType;
+
+  typename ShapeFilterType::Pointer shape = ShapeFilterType::New();
+  shape->SetInput( image );
+  shape->SetBackgroundValue( 0 );
+  shape->ComputeFeretDiameterOn();
+  shape->ComputeOrientedBoundingBoxOn();
+  shape->ComputePerimeterOff();
+  shape->Update();
+
+  const LabelObjectType *labelObject = shape->GetOutput()->GetLabelObject( 1 );
+  const typename ImageType::SpacingType & spacing = image->GetSpacing();
+
+  std::vector< IndexType > pixels;
+  for ( itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() == 1 )
+      {
+      pixels.push_back( it.GetIndex() );
+      }
+    }
+  double feretDiameter = 0;
+  for ( size_t i = 0; i < pixels.size(); i++ )
+    {
+    for ( size_t j = i + 1; j < pixels.size(); j++ )
+      {
+      double length = 0;
+      for ( unsigned int d = 0; d < VDimension; d++ )
+        {
+        const double difference = ( pixels[i][d] - pixels[j][d] ) * spacing[d];
+        length += difference * difference;
+        }
+      feretDiameter = std::max( feretDiameter, length );
+      }
+    }
+  feretDiameter = std::sqrt( feretDiameter );
+  if ( vnl_math_abs( feretDiameter - labelObject->GetFeretDiameter() ) > 1e-9 )
+    {
+    std::cerr << VDimension << "D: wrong feret diameter: " << labelObject->GetFeretDiameter()
+              << " instead of " << feretDiameter << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const typename LabelObjectType::MatrixType &                   axes = labelObject->GetOrientedBoundingBoxDirection();
+  const typename LabelObjectType::VectorType &                   size = labelObject->GetOrientedBoundingBoxSize();
+  const typename LabelObjectType::OrientedBoundingBoxPointType & origin = labelObject->GetOrientedBoundingBoxOrigin();
+  double volume = 1;
+  double boundingBoxVolume = 1;
+  for ( unsigned int d = 0; d < VDimension; d++ )
+    {
+    volume *= size[d];
+    boundingBoxVolume *= labelObject->GetBoundingBox().GetSize()[d] * spacing[d];
+    }
+  if ( volume > boundingBoxVolume * ( 1 + 1e-9 ) )
+    {
+    std::cerr << VDimension << "D: oriented bounding box larger than the bounding box: "
+              << volume << " > " << boundingBoxVolume << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  for ( size_t i = 0; i < pixels.size(); i++ )
+    {
+    for ( unsigned int corner = 0; corner < ( 1u << VDimension ); corner++ )
+      {
+      itk::ContinuousIndex< double, VDimension > cidx;
+      for ( unsigned int d = 0; d < VDimension; d++ )
+        {
+        cidx[d] = pixels[i][d] + ( ( corner >> d ) & 1 ? 0.5 : -0.5 );
+        }
+      typename ImageType::PointType point;
+      image->TransformContinuousIndexToPhysicalPoint( cidx, point );
+      for ( unsigned int k = 0; k < VDimension; k++ )
+        {
+        double projection = 0;
+        for ( unsigned int d = 0; d < VDimension; d++ )
+          {
+          projection += ( point[d] - origin[d] ) * axes[k][d];
+          }
+        if ( projection < -1e-6 || projection > size[k] + 1e-6 )
+          {
+          std::cerr << VDimension << "D: pixel " << pixels[i] << " out of the oriented bounding box" << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
+
+int itkShapeLabelMapFilterOrientedBoundingBoxTest(int argc, char * argv[])
+{
+  if( argc != 1 )
+    {
+    std::cerr << "usage: " << argv[0] << "" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // a 60x20 rectangle rotated by 30 degrees, in a rotated image
+  typedef itk::Image< unsigned char, 2 > Image2DType;
+  Image2DType::Pointer image2D = Image2DType::New();
+  Image2DType::SizeType size2D;
+  size2D.Fill( 80 );
+  image2D->SetRegions( size2D );
+  image2D->Allocate();
+  image2D->FillBuffer( 0 );
+  Image2DType::DirectionType direction2D;
+  direction2D[0][0] = std::cos( 0.2 );
+  direction2D[0][1] = -std::sin( 0.2 );
+  direction2D[1][0] = std::sin( 0.2 );
+  direction2D[1][1] = std::cos( 0.2 );
+  image2D->SetDirection( direction2D );
+  const double angle = vnl_math::pi / 6;
+  for ( itk::ImageRegionIteratorWithIndex< Image2DType > it( image2D, image2D->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const double x = it.GetIndex()[0] - 40.0;
+    const double y = it.GetIndex()[1] - 40.0;
+    const double u = std::cos( angle ) * x + std::sin( angle ) * y;
+    const double v = -std::sin( angle ) * x + std::cos( angle ) * y;
+    if ( vnl_math_abs( u ) <= 30 && vnl_math_abs( v ) <= 10 )
+      {
+      it.Set( 1 );
+      }
+    }
+  if ( CheckFeretDiameterAndOrientedBoundingBox< 2 >( image2D ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // the box must follow the rectangle
+  typedef itk::LabelImageToShapeLabelMapFilter< Image2DType > ShapeFilter2DType;
+  ShapeFilter2DType::Pointer shape2D = ShapeFilter2DType::New();
+  shape2D->SetInput( image2D );
+  shape2D->ComputeOrientedBoundingBoxOn();
+  shape2D->Update();
+  const ShapeFilter2DType::OutputImageType::LabelObjectType::VectorType & boxSize =
+    shape2D->GetOutput()->GetLabelObject( 1 )->GetOrientedBoundingBoxSize();
+  const double area = boxSize[0] * boxSize[1];
+  if ( area > 62 * 22 )
+    {
+    std::cerr << "2D: oriented bounding box too large: " << boxSize << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // an irregular blob with an anisotropic spacing
+  typedef itk::Image< unsigned char, 3 > Image3DType;
+  Image3DType::Pointer image3D = Image3DType::New();
+  Image3DType::SizeType size3D;
+  size3D.Fill( 24 );
+  image3D->SetRegions( size3D );
+  image3D->Allocate();
+  image3D->FillBuffer( 0 );
+  Image3DType::SpacingType spacing3D;
+  spacing3D[0] = 0.7;
+  spacing3D[1] = 1.0;
+  spacing3D[2] = 1.9;
+  image3D->SetSpacing( spacing3D );
+  for ( itk::ImageRegionIteratorWithIndex< Image3DType > it( image3D, image3D->GetLargestPossibleRegion() ); !it.IsAtEnd(); ++it )
+    {
+    const double x = it.GetIndex()[0] - 12.0;
+    const double y = it.GetIndex()[1] - 11.0;
+    const double z = it.GetIndex()[2] - 12.5;
+    const double u = 0.8 * x + 0.6 * y;
+    const double v = -0.6 * x + 0.8 * y;
+    if ( u * u / 121 + v * v / 25 + z * z / 64 <= 1 && ( it.GetIndex()[0] + 2 * it.GetIndex()[1] ) % 7 != 0 )
+      {
+      it.Set( 1 );
+      }
+    }
+  if ( CheckFeretDiameterAndOrientedBoundingBox< 3 >( image3D ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -50,7 +50,7 @@ AnchorErodeDilateLine< TInputPix, TCompare >
     InputImagePixelType Extreme = inbuffer[0];
     for ( unsigned i = 0; i < bufflength; i++ )
       {
-      if ( StrictCompare(Extreme, inbuffer[i]) )
+      if ( StrictCompare(inbuffer[i], Extreme) )
         {
         Extreme = inbuffer[i];
         }
@@ -59,28 +59,38 @@ GrayscaleDilateImageFilter< TInputImage, TOutputImage, TKernel >
 
   if ( flatKernel != ITK_NULLPTR && flatKernel->GetDecomposable() )
     {
-    m_AnchorFilter->SetKernel(*flatKernel);
-    m_Algorithm = ANCHOR;
+    // van Herk/Gil-Werman costs a fixed number of comparisons per pixel
+    // and line, and measured faster than the anchor algorithm on boxes
+    // and polygons of all sizes and pixel types we tried
+    m_VHGWFilter->SetKernel(*flatKernel);
+    m_Algorithm = VHGW;
     }
-  else if ( m_HistogramFilter->GetUseVectorBasedAlgorithm() )
+  else if ( m_HistogramFilter->GetUseVectorBasedAlgorithm() && sizeof( PixelType ) == 1 )
     {
-    // histogram based filter is as least as good as the basic one, so always
-    // use it
+    // the vector based histogram of 8 bit pixels is as least as good as the
+    // basic filter, so always use it
     m_Algorithm = HISTO;
     m_HistogramFilter->SetKernel(kernel);
     }
   else
     {
-    // basic filter can be better than the histogram based one
-    // apply a poor heuristic to find the best one. What is very important is to
-    // select the histogram for large kernels
+    // basic filter can be better than the histogram based one.
+    // The basic filter costs one comparison per kernel pixel, the histogram
+    // one update per pixel added or removed on translation. The map update
+    // was measured to be about 25 (2D) and 16 (3D) times as expensive as a
+    // comparison. The vector update of 16 bit pixels is cheaper, but the
+    // search for the new extreme may scan many bins: about 4 times in both
+    // 2D and 3D.
 
     // we need to set the kernel on the histogram filter to compare basic and
     // histogram algorithm
     m_HistogramFilter->SetKernel(kernel);
 
-    if ( ( ImageDimension == 2 && this->GetKernel().Size() < m_HistogramFilter->GetPixelsPerTranslation() * 5.4 )
-         || ( ImageDimension == 3 && this->GetKernel().Size() < m_HistogramFilter->GetPixelsPerTranslation() * 4.5 ) )
+    const bool vectorBased = m_HistogramFilter->GetUseVectorBasedAlgorithm();
+    const SizeValueType crossover2D = vectorBased ? 4 : 25;
+    const SizeValueType crossover3D = vectorBased ? 4 : 16;
+    if ( ( ImageDimension == 2 && kernel.Size() < m_HistogramFilter->GetPixelsPerTranslation() * crossover2D )
+         || ( ImageDimension == 3 && kernel.Size() < m_HistogramFilter->GetPixelsPerTranslation() * crossover3D ) )
       {
       m_BasicFilter->SetKernel(kernel);
       m_Algorithm = BASIC;
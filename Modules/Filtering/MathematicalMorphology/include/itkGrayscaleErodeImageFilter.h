@@ -40,6 +40,12 @@ namespace itk
  * values (zero or one). Only elements of the structuring element
  * having values > 0 are candidates for affecting the center pixel.
  *
+ * SetKernel() selects the algorithm: decomposable flat structuring
+ * elements (boxes and polygons) use the van Herk/Gil-Werman filter,
+ * other elements the moving histogram filter, or the basic filter when
+ * the element is small compared to the number of pixels added on each
+ * translation. The algorithm can be overridden with SetAlgorithm().
+ *
  * \sa MorphologyImageFilter, GrayscaleFunctionErodeImageFilter, BinaryErodeImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  * \ingroup ITKMathematicalMorphology
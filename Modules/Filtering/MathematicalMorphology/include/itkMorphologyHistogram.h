@@ -215,6 +215,39 @@ class MorphologyHistogram<bool, TCompare>:
 
 /** \endcond */
 
+/** \class MovingMorphologyHistogram
+ * \brief Histogram used by MovingHistogramDilateImageFilter and
+ * MovingHistogramErodeImageFilter.
+ *
+ * Those filters keep a few histograms for a whole thread, so the vector
+ * based histogram also pays off for 16 bit pixels, where it has 65536
+ * bins. Other users of MorphologyHistogram build short lived histograms
+ * and keep the map for these types.
+ *
+ * \ingroup ITKMathematicalMorphology
+ */
+template< typename TInputPixel, typename TCompare >
+class MovingMorphologyHistogram:
+  public MorphologyHistogram<TInputPixel, TCompare>
+{
+};
+
+/** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
+
+template< typename TCompare >
+class MovingMorphologyHistogram<unsigned short, TCompare>:
+  public VectorMorphologyHistogram<unsigned short, TCompare>
+{
+};
+
+template< typename TCompare >
+class MovingMorphologyHistogram<signed short, TCompare>:
+  public VectorMorphologyHistogram<signed short, TCompare>
+{
+};
+
+/** \endcond */
+
 } // end namespace Function
 } // end namespace itk
 
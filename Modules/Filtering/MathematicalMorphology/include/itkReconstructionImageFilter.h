@@ -23,6 +23,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include <queue>
+#include <utility>
+#include <vector>
 
 //#define BASIC
 #define COPY
@@ -43,6 +45,14 @@ namespace itk
  * applications and efficient algorithms" -- IEEE Transactions on
  * Image processing, Vol 2, No 2, pp 176-201, April 1993
  *
+ * When UseInternalCopy is on and the image is large enough, the image
+ * is cut into slabs along its last dimension, one per thread. Each
+ * thread reconstructs its slab on its own with the algorithm above.
+ * The threads then repeatedly collect the values that the neighbouring
+ * slabs can propagate across the slab boundaries, and propagate them
+ * in their slab with the FIFO step, until no value crosses a boundary.
+ * The result is the same as with a single thread.
+ *
  * \author Richard Beare. Department of Medicine, Monash University,
  * Melbourne, Australia.
  *
@@ -175,6 +185,50 @@ private:
   typedef typename InputImageType::IndexType                InIndexType;
   typedef ConstShapedNeighborhoodIterator< InputImageType > CNInputIterator;
   typedef ShapedNeighborhoodIterator< OutputImageType >     NOutputIterator;
+
+  typedef std::queue< OffsetValueType >                               OffsetFifoType;
+  typedef std::vector< std::pair< OffsetValueType, InputImagePixelType > > BoundaryValueListType;
+
+  /** Structure for passing information into the slab threads. All the
+   * offsets are in the buffers of the padded marker and mask. */
+  struct SlabThreadStruct {
+    Self *                               Filter;
+    InputImageType *                     Marker;
+    const InputImageType *               Mask;
+    std::vector< OffsetValueType >       Offsets;
+    std::vector< OffsetValueType >       OffsetSlices;
+    unsigned int                         NumberOfPreviousOffsets;
+    OffsetValueType                      SliceStride;
+    std::vector< OffsetValueType >       SlabStart;
+    std::vector< BoundaryValueListType > BoundaryValues;
+    std::vector< char >                  InvalidMarker;
+    int                                  Phase;
+  };
+
+  enum { ReconstructSlabPhase = 0, CollectBoundaryPhase = 1, PropagateBoundaryPhase = 2 };
+
+  /** Crops the padded marker into the output. */
+  void GraftInternalCopy(const InputImageType *paddedMarker, const ISizeType & padSize);
+
+  /** Reconstructs the padded marker in slabs on several threads. */
+  void ParallelReconstruction(InputImageType *marker, const InputImageType *mask,
+                              unsigned int numberOfSlabs);
+
+  /** Runs the current phase of the parallel reconstruction on a slab. */
+  void ThreadedReconstructSlab(SlabThreadStruct *str, ThreadIdType slab);
+
+  /** Raster and antiraster passes followed by the FIFO step, restricted
+   * to the slab. */
+  void ReconstructSlab(SlabThreadStruct *str, ThreadIdType slab);
+
+  /** Finds the values the neighbouring slabs propagate into the
+   * boundary slices of the slab. */
+  void CollectBoundaryValues(SlabThreadStruct *str, ThreadIdType slab);
+
+  /** FIFO step restricted to the slab. */
+  void PropagateInSlab(SlabThreadStruct *str, ThreadIdType slab, OffsetFifoType & fifo);
+
+  static ITK_THREAD_RETURN_TYPE SlabThreaderCallback(void *arg);
 }; // end of class
 } // end namespace itk
 
@@ -24,6 +24,8 @@
 
 #include "itkConstantPadImageFilter.h"
 #include "itkCropImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -171,6 +173,26 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
     markerImageP = output;
     }
 
+  // large images are reconstructed in slabs on several threads. Each
+  // slab should be worth the synchronization of the threads.
+  const SizeValueType minimumPixelsPerSlab = 32768;
+  SizeValueType       numberOfSlabs = 1;
+  if ( m_UseInternalCopy && OutputImageDimension > 1 )
+    {
+    const OutputImageRegionType & region = output->GetRequestedRegion();
+    numberOfSlabs = std::min( static_cast< SizeValueType >( this->GetNumberOfThreads() ),
+                              region.GetSize(OutputImageDimension - 1) );
+    numberOfSlabs = std::min( numberOfSlabs, region.GetNumberOfPixels() / minimumPixelsPerSlab );
+    }
+
+  if ( numberOfSlabs > 1 )
+    {
+    this->ParallelReconstruction(const_cast< InputImageType * >( markerImageP.GetPointer() ),
+                                 maskImageP, static_cast< unsigned int >( numberOfSlabs ) );
+    this->GraftInternalCopy(markerImageP, padSize);
+    return;
+    }
+
   // declare our queue type
   typedef typename std::queue< OutputImageIndexType > FifoType;
   FifoType IndexFifo;
@@ -372,18 +394,420 @@ ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
 
   if ( m_UseInternalCopy )
     {
-    typedef typename itk::CropImageFilter< InputImageType, OutputImageType > CropType;
-    typename CropType::Pointer crop = CropType::New();
-
-    crop->SetInput(markerImageP);
-    crop->SetUpperBoundaryCropSize(padSize);
-    crop->SetLowerBoundaryCropSize(padSize);
-    crop->GraftOutput( this->GetOutput() );
-    /** execute the minipipeline */
-    crop->Update();
-
-    /** graft the minipipeline output back into this filter's output */
-    this->GraftOutput( crop->GetOutput() );
+    this->GraftInternalCopy(markerImageP, padSize);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::GraftInternalCopy(const InputImageType *paddedMarker, const ISizeType & padSize)
+{
+  typedef typename itk::CropImageFilter< InputImageType, OutputImageType > CropType;
+  typename CropType::Pointer crop = CropType::New();
+
+  crop->SetInput(paddedMarker);
+  crop->SetUpperBoundaryCropSize(padSize);
+  crop->SetLowerBoundaryCropSize(padSize);
+  crop->GraftOutput( this->GetOutput() );
+  /** execute the minipipeline */
+  crop->Update();
+
+  /** graft the minipipeline output back into this filter's output */
+  this->GraftOutput( crop->GetOutput() );
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::ParallelReconstruction(InputImageType *marker, const InputImageType *mask,
+                         unsigned int numberOfSlabs)
+{
+  SlabThreadStruct str;
+  str.Filter = this;
+  str.Marker = marker;
+  str.Mask = mask;
+
+  this->GetMultiThreader()->SetNumberOfThreads(numberOfSlabs);
+  numberOfSlabs = this->GetMultiThreader()->GetNumberOfThreads();
+
+  // the slabs split the slices of the last dimension, without the padding
+  const unsigned int  lastDimension = MarkerImageDimension - 1;
+  const typename InputImageType::OffsetValueType *offsetTable = marker->GetOffsetTable();
+  const SizeValueType numberOfSlices = marker->GetBufferedRegion().GetSize(lastDimension) - 2;
+  str.SliceStride = offsetTable[lastDimension];
+  str.SlabStart.resize(numberOfSlabs + 1);
+  for ( unsigned int i = 0; i <= numberOfSlabs; ++i )
+    {
+    str.SlabStart[i] = 1 + static_cast< OffsetValueType >( numberOfSlices * i / numberOfSlabs );
+    }
+
+  // the neighbors, previous ones in raster order first
+  std::vector< OffsetValueType > previous, later, previousSlices, laterSlices;
+  Offset< MarkerImageDimension > neighbor;
+  neighbor.Fill(-1);
+  while ( neighbor[lastDimension] <= 1 )
+    {
+    unsigned int    nonZero = 0;
+    OffsetValueType linear = 0;
+    for ( unsigned int d = 0; d < MarkerImageDimension; ++d )
+      {
+      linear += neighbor[d] * offsetTable[d];
+      nonZero += ( neighbor[d] != 0 );
+      }
+    if ( nonZero > 0 && ( m_FullyConnected || nonZero == 1 ) )
+      {
+      if ( linear < 0 )
+        {
+        previous.push_back(linear);
+        previousSlices.push_back(neighbor[lastDimension]);
+        }
+      else
+        {
+        later.push_back(linear);
+        laterSlices.push_back(neighbor[lastDimension]);
+        }
+      }
+    for ( unsigned int d = 0; d < MarkerImageDimension; ++d )
+      {
+      if ( ++neighbor[d] <= 1 || d == lastDimension )
+        {
+        break;
+        }
+      neighbor[d] = -1;
+      }
+    }
+  str.NumberOfPreviousOffsets = static_cast< unsigned int >( previous.size() );
+  str.Offsets = previous;
+  str.Offsets.insert( str.Offsets.end(), later.begin(), later.end() );
+  str.OffsetSlices = previousSlices;
+  str.OffsetSlices.insert( str.OffsetSlices.end(), laterSlices.begin(), laterSlices.end() );
+
+  str.BoundaryValues.resize(numberOfSlabs);
+  str.InvalidMarker.resize(numberOfSlabs, 0);
+
+  this->GetMultiThreader()->SetSingleMethod(this->SlabThreaderCallback, &str);
+
+  str.Phase = ReconstructSlabPhase;
+  this->GetMultiThreader()->SingleMethodExecute();
+  for ( unsigned int i = 0; i < numberOfSlabs; ++i )
+    {
+    if ( str.InvalidMarker[i] )
+      {
+      TCompare compare;
+      if ( compare(0, 1) )
+        {
+        itkExceptionMacro(<< "Marker pixels must be <= mask pixels.");
+        }
+      else
+        {
+        itkExceptionMacro(<< "Marker pixels must be >= mask pixels.");
+        }
+      }
+    }
+
+  // exchange the values across the slab boundaries until they are stable.
+  // The boundaries are read by the neighbouring slabs while collecting,
+  // and only written while propagating.
+  for (;; )
+    {
+    str.Phase = CollectBoundaryPhase;
+    this->GetMultiThreader()->SingleMethodExecute();
+
+    bool changed = false;
+    for ( unsigned int i = 0; i < numberOfSlabs; ++i )
+      {
+      changed = changed || !str.BoundaryValues[i].empty();
+      }
+    if ( !changed )
+      {
+      break;
+      }
+
+    str.Phase = PropagateBoundaryPhase;
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+ITK_THREAD_RETURN_TYPE
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::SlabThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  SlabThreadStruct *               str = static_cast< SlabThreadStruct * >( info->UserData );
+
+  str->Filter->ThreadedReconstructSlab(str, info->ThreadID);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::ThreadedReconstructSlab(SlabThreadStruct *str, ThreadIdType slab)
+{
+  if ( str->Phase == ReconstructSlabPhase )
+    {
+    this->ReconstructSlab(str, slab);
+    }
+  else if ( str->Phase == CollectBoundaryPhase )
+    {
+    this->CollectBoundaryValues(str, slab);
+    }
+  else
+    {
+    TCompare             compare;
+    InputImagePixelType *marker = str->Marker->GetBufferPointer();
+    OffsetFifoType       fifo;
+
+    const BoundaryValueListType & values = str->BoundaryValues[slab];
+    for ( typename BoundaryValueListType::const_iterator it = values.begin(); it != values.end(); ++it )
+      {
+      if ( compare(it->second, marker[it->first]) )
+        {
+        marker[it->first] = it->second;
+        fifo.push(it->first);
+        }
+      }
+    this->PropagateInSlab(str, slab, fifo);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::ReconstructSlab(SlabThreadStruct *str, ThreadIdType slab)
+{
+  TCompare                   compare;
+  InputImagePixelType *      marker = str->Marker->GetBufferPointer();
+  const InputImagePixelType *mask = str->Mask->GetBufferPointer();
+  const OffsetValueType      first = str->SlabStart[slab];
+  const OffsetValueType      last = str->SlabStart[slab + 1] - 1;
+  const unsigned int         numberOfOffsets = static_cast< unsigned int >( str->Offsets.size() );
+  const unsigned int         numberOfPrevious = str->NumberOfPreviousOffsets;
+
+  // iterate over the first pixel of each line of the slab
+  const unsigned int                  lastDimension = MarkerImageDimension - 1;
+  typename InputImageType::RegionType lineRegion = str->Marker->GetBufferedRegion();
+  const SizeValueType                 lineLength = lineRegion.GetSize(0) - 2;
+  for ( unsigned int d = 0; d < MarkerImageDimension; ++d )
+    {
+    lineRegion.SetIndex( d, lineRegion.GetIndex(d) + 1 );
+    lineRegion.SetSize( d, lineRegion.GetSize(d) - 2 );
+    }
+  lineRegion.SetIndex( lastDimension, str->Marker->GetBufferedRegion().GetIndex(lastDimension) + first );
+  lineRegion.SetSize( lastDimension, last - first + 1 );
+  lineRegion.SetSize(0, 1);
+
+  ProgressReporter progress(this, slab, 2 * lineRegion.GetNumberOfPixels(), 100, 0.0f, 0.9f);
+
+  // scan in forward raster order
+  ImageRegionConstIteratorWithIndex< InputImageType > lineIt(str->Marker, lineRegion);
+  for ( lineIt.GoToBegin(); !lineIt.IsAtEnd(); ++lineIt )
+    {
+    const OffsetValueType start = str->Marker->ComputeOffset( lineIt.GetIndex() );
+    const OffsetValueType slice = start / str->SliceStride;
+    for ( OffsetValueType p = start; p < start + static_cast< OffsetValueType >( lineLength ); ++p )
+      {
+      InputImagePixelType       V = marker[p];
+      const InputImagePixelType iV = mask[p];
+
+      // be sure that the pixels in the images follow the preconditions
+      if ( compare(V, iV) )
+        {
+        str->InvalidMarker[slab] = 1;
+        return;
+        }
+
+      // visit the previous neighbours in the slab
+      for ( unsigned int k = 0; k < numberOfPrevious; ++k )
+        {
+        if ( slice + str->OffsetSlices[k] >= first )
+          {
+          const InputImagePixelType VN = marker[p + str->Offsets[k]];
+          if ( compare(VN, V) )
+            {
+            V = VN;
+            }
+          }
+        }
+
+      // this step clamps to the mask
+      if ( compare(V, iV) )
+        {
+        V = iV;
+        }
+      marker[p] = V;
+      }
+    progress.CompletedPixel();
+    }
+
+  // now for the reverse raster order pass
+  OffsetFifoType fifo;
+  for ( lineIt.GoToReverseBegin(); !lineIt.IsAtReverseEnd(); --lineIt )
+    {
+    const OffsetValueType start = str->Marker->ComputeOffset( lineIt.GetIndex() );
+    const OffsetValueType slice = start / str->SliceStride;
+    for ( OffsetValueType p = start + static_cast< OffsetValueType >( lineLength ) - 1; p >= start; --p )
+      {
+      InputImagePixelType V = marker[p];
+      for ( unsigned int k = numberOfPrevious; k < numberOfOffsets; ++k )
+        {
+        if ( slice + str->OffsetSlices[k] <= last )
+          {
+          const InputImagePixelType VN = marker[p + str->Offsets[k]];
+          if ( compare(VN, V) )
+            {
+            V = VN;
+            }
+          }
+        }
+      const InputImagePixelType iV = mask[p];
+      if ( compare(V, iV) )
+        {
+        V = iV;
+        }
+      marker[p] = V;
+
+      // now put the offsets in the fifo
+      for ( unsigned int k = numberOfPrevious; k < numberOfOffsets; ++k )
+        {
+        if ( slice + str->OffsetSlices[k] <= last )
+          {
+          const OffsetValueType     n = p + str->Offsets[k];
+          const InputImagePixelType VN = marker[n];
+          if ( compare(V, VN) && compare(mask[n], VN) )
+            {
+            fifo.push(p);
+            break;
+            }
+          }
+        }
+      }
+    progress.CompletedPixel();
+    }
+
+  this->PropagateInSlab(str, slab, fifo);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::PropagateInSlab(SlabThreadStruct *str, ThreadIdType slab, OffsetFifoType & fifo)
+{
+  TCompare                   compare;
+  InputImagePixelType *      marker = str->Marker->GetBufferPointer();
+  const InputImagePixelType *mask = str->Mask->GetBufferPointer();
+  const OffsetValueType      first = str->SlabStart[slab];
+  const OffsetValueType      last = str->SlabStart[slab + 1] - 1;
+  const unsigned int         numberOfOffsets = static_cast< unsigned int >( str->Offsets.size() );
+
+  while ( !fifo.empty() )
+    {
+    const OffsetValueType p = fifo.front();
+    fifo.pop();
+    const OffsetValueType     slice = p / str->SliceStride;
+    const InputImagePixelType V = marker[p];
+    for ( unsigned int k = 0; k < numberOfOffsets; ++k )
+      {
+      const OffsetValueType neighborSlice = slice + str->OffsetSlices[k];
+      if ( neighborSlice < first || neighborSlice > last )
+        {
+        continue;
+        }
+      const OffsetValueType     n = p + str->Offsets[k];
+      const InputImagePixelType VN = marker[n];
+      const InputImagePixelType iN = mask[n];
+      // candidate for dilation via flooding
+      if ( compare(V, VN) && ( iN != VN ) )
+        {
+        if ( compare(iN, V) )
+          {
+          // not clamped by the mask, propagate the center value
+          marker[n] = V;
+          }
+        else
+          {
+          // apply the clamping
+          marker[n] = iN;
+          }
+        fifo.push(n);
+        }
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TCompare >
+void
+ReconstructionImageFilter< TInputImage, TOutputImage, TCompare >
+::CollectBoundaryValues(SlabThreadStruct *str, ThreadIdType slab)
+{
+  TCompare                   compare;
+  const InputImagePixelType *marker = str->Marker->GetBufferPointer();
+  const InputImagePixelType *mask = str->Mask->GetBufferPointer();
+  const unsigned int         numberOfOffsets = static_cast< unsigned int >( str->Offsets.size() );
+  const unsigned int         lastDimension = MarkerImageDimension - 1;
+  const unsigned int         numberOfSlabs = static_cast< unsigned int >( str->BoundaryValues.size() );
+
+  BoundaryValueListType & values = str->BoundaryValues[slab];
+  values.clear();
+
+  // the first slice receives values from the previous slab, the last
+  // one from the next slab
+  for ( int side = -1; side <= 1; side += 2 )
+    {
+    if ( ( side < 0 && slab == 0 ) || ( side > 0 && slab + 1 == numberOfSlabs ) )
+      {
+      continue;
+      }
+    const OffsetValueType slice = side < 0 ? str->SlabStart[slab] : str->SlabStart[slab + 1] - 1;
+
+    typename InputImageType::RegionType lineRegion = str->Marker->GetBufferedRegion();
+    const SizeValueType                 lineLength = lineRegion.GetSize(0) - 2;
+    for ( unsigned int d = 0; d < lastDimension; ++d )
+      {
+      lineRegion.SetIndex( d, lineRegion.GetIndex(d) + 1 );
+      lineRegion.SetSize( d, lineRegion.GetSize(d) - 2 );
+      }
+    lineRegion.SetIndex( lastDimension, lineRegion.GetIndex(lastDimension) + slice );
+    lineRegion.SetSize(lastDimension, 1);
+    lineRegion.SetSize(0, 1);
+
+    ImageRegionConstIteratorWithIndex< InputImageType > lineIt(str->Marker, lineRegion);
+    for ( lineIt.GoToBegin(); !lineIt.IsAtEnd(); ++lineIt )
+      {
+      const OffsetValueType start = str->Marker->ComputeOffset( lineIt.GetIndex() );
+      for ( OffsetValueType p = start; p < start + static_cast< OffsetValueType >( lineLength ); ++p )
+        {
+        const InputImagePixelType V = marker[p];
+        const InputImagePixelType iV = mask[p];
+        if ( V == iV )
+          {
+          continue;
+          }
+        InputImagePixelType best = V;
+        for ( unsigned int k = 0; k < numberOfOffsets; ++k )
+          {
+          if ( str->OffsetSlices[k] == side )
+            {
+            const InputImagePixelType VN = marker[p + str->Offsets[k]];
+            if ( compare(VN, best) )
+              {
+              best = VN;
+              }
+            }
+          }
+        if ( compare(best, iV) )
+          {
+          best = iV;
+          }
+        if ( compare(best, V) )
+          {
+          values.push_back( std::make_pair(p, best) );
+          }
+        }
+      }
     }
 }
 
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGrayscaleDilateImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+
+template< typename TImage >
+typename TImage::Pointer
+CreateAlgorithmsTestImage()
+{
+  typename TImage::Pointer image = TImage::New();
+  typename TImage::SizeType size;
+  size.Fill( 23 );
+  size[0] = 31;
+  image->SetRegions( size );
+  image->Allocate();
+
+  // pseudo random values over the whole pixel range, with a few flat
+  // plateaus so that the borders of the lines are exercised too
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed( 12345 );
+  itk::ImageRegionIterator< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    typename TImage::PixelType value =
+      static_cast< typename TImage::PixelType >( generator->GetIntegerVariate( 0xffff ) );
+    if ( it.GetIndex()[0] > 20 && it.GetIndex()[1] < 8 )
+      {
+      value = 100;
+      }
+    it.Set( value );
+    }
+  return image;
+}
+
+template< typename TImage >
+bool
+SameImages(const TImage *a, const TImage *b)
+{
+  itk::ImageRegionConstIterator< TImage > ia( a, a->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > ib( b, b->GetLargestPossibleRegion() );
+  for ( ; !ia.IsAtEnd(); ++ia, ++ib )
+    {
+    if ( ia.Get() != ib.Get() )
+      {
+      std::cerr << "Mismatch at " << ia.GetIndex() << ": " << ia.Get() << " != " << ib.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Runs the filter with the given algorithms and compares the outputs to
+// the one of the first algorithm.
+template< typename TFilter >
+bool
+CheckAlgorithms(const typename TFilter::InputImageType *image,
+                const typename TFilter::KernelType & kernel,
+                int expectedAlgorithm,
+                const int *algorithms,
+                unsigned int numberOfAlgorithms)
+{
+  typedef typename TFilter::OutputImageType OutputImageType;
+
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput( image );
+  filter->SetKernel( kernel );
+  if ( filter->GetAlgorithm() != expectedAlgorithm )
+    {
+    std::cerr << "Selected algorithm " << filter->GetAlgorithm()
+              << " instead of " << expectedAlgorithm << std::endl;
+    return false;
+    }
+
+  filter->SetAlgorithm( algorithms[0] );
+  filter->Update();
+  typename OutputImageType::Pointer reference = filter->GetOutput();
+  reference->DisconnectPipeline();
+
+  for ( unsigned int i = 1; i < numberOfAlgorithms; ++i )
+    {
+    filter->SetAlgorithm( algorithms[i] );
+    filter->Update();
+    if ( !SameImages< OutputImageType >( reference, filter->GetOutput() ) )
+      {
+      std::cerr << "Algorithm " << algorithms[i] << " differs from algorithm "
+                << algorithms[0] << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< typename TPixel >
+bool
+CheckPixelType()
+{
+  const unsigned int Dimension = 3;
+  typedef itk::Image< TPixel, Dimension >             ImageType;
+  typedef itk::FlatStructuringElement< Dimension >    KernelType;
+  typedef itk::GrayscaleDilateImageFilter< ImageType, ImageType, KernelType > DilateType;
+  typedef itk::GrayscaleErodeImageFilter< ImageType, ImageType, KernelType >  ErodeType;
+
+  typename ImageType::Pointer image = CreateAlgorithmsTestImage< ImageType >();
+
+  typename KernelType::RadiusType radius;
+  radius[0] = 4;
+  radius[1] = 3;
+  radius[2] = 2;
+
+  // all the algorithms agree on boxes; the lines of a polygon only
+  // approximate its neighborhood, so the decomposition based algorithms
+  // are only compared with each other
+  const int allAlgorithms[4] = { DilateType::BASIC, DilateType::HISTO, DilateType::ANCHOR, DilateType::VHGW };
+  const int lineAlgorithms[2] = { DilateType::VHGW, DilateType::ANCHOR };
+  const int neighborhoodAlgorithms[2] = { DilateType::BASIC, DilateType::HISTO };
+
+  // decomposable elements use the van Herk/Gil-Werman algorithm
+  const KernelType box = KernelType::Box( radius );
+  const KernelType polygon = KernelType::Polygon( radius, 6 );
+  bool ok = CheckAlgorithms< DilateType >( image, box, DilateType::VHGW, allAlgorithms, 4 );
+  ok = CheckAlgorithms< ErodeType >( image, box, ErodeType::VHGW, allAlgorithms, 4 ) && ok;
+  ok = CheckAlgorithms< DilateType >( image, polygon, DilateType::VHGW, lineAlgorithms, 2 ) && ok;
+  ok = CheckAlgorithms< ErodeType >( image, polygon, ErodeType::VHGW, lineAlgorithms, 2 ) && ok;
+
+  // balls are not decomposable; the histogram is used for large balls
+  const KernelType ball = KernelType::Ball( radius );
+  ok = CheckAlgorithms< DilateType >( image, ball, DilateType::HISTO, neighborhoodAlgorithms, 2 ) && ok;
+  ok = CheckAlgorithms< ErodeType >( image, ball, ErodeType::HISTO, neighborhoodAlgorithms, 2 ) && ok;
+
+  // and for small balls too with 8 bit pixels, but 16 bit pixels use the
+  // basic algorithm there
+  typename KernelType::RadiusType smallRadius;
+  smallRadius.Fill( 1 );
+  const KernelType smallBall = KernelType::Ball( smallRadius );
+  const int expectedSmallBallAlgorithm = sizeof( TPixel ) == 1 ? DilateType::HISTO : DilateType::BASIC;
+  ok = CheckAlgorithms< DilateType >( image, smallBall, expectedSmallBallAlgorithm, neighborhoodAlgorithms, 2 ) && ok;
+  ok = CheckAlgorithms< ErodeType >( image, smallBall, expectedSmallBallAlgorithm, neighborhoodAlgorithms, 2 ) && ok;
+  return ok;
+}
+
+}
+
+int itkGrayscaleDilateErodeAlgorithmsTest(int, char *[])
+{
+  bool ok = CheckPixelType< unsigned char >();
+  ok = CheckPixelType< unsigned short >() && ok;
+  ok = CheckPixelType< short >() && ok;
+
+  if ( !ok )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
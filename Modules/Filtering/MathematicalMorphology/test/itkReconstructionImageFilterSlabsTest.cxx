@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkReconstructionByDilationImageFilter.h"
+#include "itkReconstructionByErosionImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+
+// Fills the mask with noise over a pattern of diagonal walls, so that
+// the regions wind across the slabs, and puts a few seeds in the marker.
+template< typename TImage >
+void
+CreateReconstructionSlabsTestImages(TImage *mask, TImage *marker,
+                                    typename TImage::PixelType background)
+{
+  typedef typename TImage::IndexType IndexType;
+  itk::ImageRegionIterator< TImage > maskIt( mask, mask->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< TImage > markerIt( marker, marker->GetLargestPossibleRegion() );
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed( 1 );
+  for ( ; !maskIt.IsAtEnd(); ++maskIt, ++markerIt )
+    {
+    const IndexType index = maskIt.GetIndex();
+    long            sum = 0;
+    for ( unsigned int d = 0; d < TImage::ImageDimension; ++d )
+      {
+      sum += index[d] / ( 3 + d );
+      }
+    const typename TImage::PixelType value =
+      static_cast< typename TImage::PixelType >( generator->GetIntegerVariate( 99 ) + ( sum % 3 == 0 ? 120 : 0 ) );
+    maskIt.Set(value);
+    markerIt.Set( generator->GetIntegerVariate( 498 ) == 0 ? value : background );
+    }
+}
+
+template< typename TImage >
+bool
+SameImages(const TImage *a, const TImage *b)
+{
+  itk::ImageRegionConstIterator< TImage > ia( a, a->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > ib( b, b->GetLargestPossibleRegion() );
+  for ( ; !ia.IsAtEnd(); ++ia, ++ib )
+    {
+    if ( ia.Get() != ib.Get() )
+      {
+      std::cerr << "Mismatch at " << ia.GetIndex() << ": "
+                << static_cast< int >( ia.Get() ) << " != " << static_cast< int >( ib.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Compares the reconstruction on several threads to the single threaded
+// one, and to the one without internal copy.
+template< typename TFilter >
+bool
+CheckReconstruction(const typename TFilter::InputImageType *marker,
+                    const typename TFilter::InputImageType *mask,
+                    bool fullyConnected,
+                    itk::ThreadIdType numberOfThreads)
+{
+  typedef typename TFilter::OutputImageType OutputImageType;
+
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetMarkerImage( marker );
+  filter->SetMaskImage( mask );
+  filter->SetFullyConnected( fullyConnected );
+  filter->SetNumberOfThreads( 1 );
+  filter->Update();
+  typename OutputImageType::Pointer reference = filter->GetOutput();
+  reference->DisconnectPipeline();
+
+  bool ok = true;
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+  if ( !SameImages< OutputImageType >( reference, filter->GetOutput() ) )
+    {
+    std::cerr << "Reconstruction on " << numberOfThreads << " threads differs, FullyConnected: "
+              << fullyConnected << std::endl;
+    ok = false;
+    }
+
+  filter->SetUseInternalCopy( false );
+  filter->Update();
+  if ( !SameImages< OutputImageType >( reference, filter->GetOutput() ) )
+    {
+    std::cerr << "Reconstruction without internal copy differs, FullyConnected: "
+              << fullyConnected << std::endl;
+    ok = false;
+    }
+  return ok;
+}
+
+template< unsigned int VDimension >
+bool
+CheckDimension(const typename itk::Image< unsigned char, VDimension >::SizeType & size,
+               itk::ThreadIdType numberOfThreads)
+{
+  typedef itk::Image< unsigned char, VDimension >                            ImageType;
+  typedef itk::ReconstructionByDilationImageFilter< ImageType, ImageType > DilationType;
+  typedef itk::ReconstructionByErosionImageFilter< ImageType, ImageType >  ErosionType;
+
+  typename ImageType::Pointer mask = ImageType::New();
+  mask->SetRegions( size );
+  mask->Allocate();
+  typename ImageType::Pointer dilationMarker = ImageType::New();
+  dilationMarker->SetRegions( size );
+  dilationMarker->Allocate();
+  typename ImageType::Pointer erosionMarker = ImageType::New();
+  erosionMarker->SetRegions( size );
+  erosionMarker->Allocate();
+
+  CreateReconstructionSlabsTestImages< ImageType >( mask, dilationMarker, 0 );
+  CreateReconstructionSlabsTestImages< ImageType >( mask, erosionMarker, 255 );
+
+  bool ok = true;
+  for ( int fullyConnected = 0; fullyConnected < 2; ++fullyConnected )
+    {
+    ok = CheckReconstruction< DilationType >( dilationMarker, mask, fullyConnected != 0, numberOfThreads ) && ok;
+    ok = CheckReconstruction< ErosionType >( erosionMarker, mask, fullyConnected != 0, numberOfThreads ) && ok;
+    }
+
+  // the preconditions are still checked on several threads
+  dilationMarker->FillBuffer( 255 );
+  typename DilationType::Pointer dilation = DilationType::New();
+  dilation->SetMarkerImage( dilationMarker );
+  dilation->SetMaskImage( mask );
+  dilation->SetNumberOfThreads( numberOfThreads );
+  try
+    {
+    dilation->Update();
+    std::cerr << "Marker above the mask did not throw." << std::endl;
+    ok = false;
+    }
+  catch ( itk::ExceptionObject & )
+    {
+    }
+  return ok;
+}
+
+}
+
+int itkReconstructionImageFilterSlabsTest(int argc, char *argv[])
+{
+  if ( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const itk::ThreadIdType numberOfThreads = atoi( argv[1] );
+
+  itk::Size< 2 > size2;
+  size2[0] = 301;
+  size2[1] = 257;
+  bool ok = CheckDimension< 2 >( size2, numberOfThreads );
+
+  itk::Size< 3 > size3;
+  size3[0] = 53;
+  size3[1] = 47;
+  size3[2] = 61;
+  ok = CheckDimension< 3 >( size3, numberOfThreads ) && ok;
+
+  if ( !ok )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
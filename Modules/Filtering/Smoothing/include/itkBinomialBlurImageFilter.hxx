@@ -22,7 +22,6 @@
 #include "itkProgressReporter.h"
 #include "itkImageRegion.h"
 #include "itkImageRegionConstIterator.h"
-#include "itkImageRegionReverseIterator.h"
 #include "itkBinomialBlurImageFilter.h"
 
 namespace itk
@@ -126,11 +125,9 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
 
   // How big is the input image?
   typename TInputImage::SizeType size = inputPtr->GetRequestedRegion().GetSize();
-  typename TInputImage::IndexType startIndex = inputPtr->GetRequestedRegion().GetIndex();
 
   // Iterator Typedefs for this routine
   typedef ImageRegionIterator< TTempImage >        TempIterator;
-  typedef ImageRegionReverseIterator< TTempImage > TempReverseIterator;
   typedef ImageRegionConstIterator< TInputImage >  InputIterator;
   typedef ImageRegionIterator< TOutputImage >      OutputIterator;
 
@@ -148,17 +145,21 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
     tempIt.Set( static_cast< double >( inputIt.Get() ) );
     }
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  typename TTempImage::IndexType index;
-  typename TTempImage::IndexType indexShift;
+  // The temporary image is walked directly through its buffer. Along
+  // dimension dim, neighbors are stride[dim] values apart, and the buffer
+  // splits into blocks of size[dim] rows of stride[dim] values.
+  double *const buffer = tempPtr->GetBufferPointer();
+  SizeValueType stride[NDimensions];
+  SizeValueType numberOfValues = 1;
+  for ( unsigned int i = 0; i < NDimensions; i++ )
+    {
+    stride[i] = numberOfValues;
+    numberOfValues *= size[i];
+    }
 
   // How many times has the algorithm executed? (for debug)
   int num_reps = 0;
 
-  // Temporary pixel storage
-  double pixelA, pixelB;
-
   // walk the output image forwards and compute blur
   for ( unsigned int rep = 0; rep < m_Repetitions; rep++ )
     {
@@ -169,85 +170,43 @@ BinomialBlurImageFilter< TInputImage, TOutputImage >
     // blur each dimension
     for ( unsigned int dim = 0; dim < NDimensions; dim++ )
       {
-      TempIterator tempItDir = TempIterator( tempPtr,
-                                             tempPtr->GetRequestedRegion() );
-      tempItDir.GoToBegin();
-      while ( !tempItDir.IsAtEnd() )
-        {
-        // determine the index of the output pixel
-        index = tempItDir.GetIndex();
+      const SizeValueType rowLength = stride[dim];
+      const SizeValueType blockLength = rowLength * size[dim];
 
-        if ( index[dim] <
-             ( startIndex[dim] + static_cast< typename TTempImage::OffsetValueType >( size[dim] ) - 1 ) )
+      // Average each pixel with its successor along dim, in the order of
+      // the buffer, so the successor still holds its previous value.
+      for ( SizeValueType block = 0; block < numberOfValues; block += blockLength )
+        {
+        for ( SizeValueType k = 0; k + 1 < size[dim]; k++ )
           {
-          // Figure out the location of the "neighbor" pixel
-          for ( unsigned int i = 0; i < NDimensions; i++ )
+          double *row = buffer + block + k * rowLength;
+          const double *next = row + rowLength;
+          for ( SizeValueType i = 0; i < rowLength; i++ )
             {
-            if ( i == dim )
-              {
-              indexShift.m_Index[i] = index.m_Index[i] + 1;
-              }
-            else
-              {
-              indexShift.m_Index[i] = index.m_Index[i];
-              }
+            row[i] = ( row[i] + next[i] ) / 2.0;
+            progress.CompletedPixel();
             }
-
-          // Average the pixel of interest and shifted pixel
-          pixelA = tempPtr->GetPixel(index);
-          pixelB = tempPtr->GetPixel(indexShift);
-
-          pixelA += pixelB;
-          pixelA = pixelA / 2.0;
-
-          tempPtr->SetPixel(index, pixelA);
-          progress.CompletedPixel();
           }
-
-        ++tempItDir;
-        } // end walk the image forwards
+        }
 
       itkDebugMacro(<< "End processing forward dimension " << dim);
 
       //----------------------Reverse pass----------------------
-      TempReverseIterator tempReverseIt =
-        TempReverseIterator( tempPtr, tempPtr->GetRequestedRegion() );
-
-      tempReverseIt.GoToBegin();
-
-      while ( !tempReverseIt.IsAtEnd() )
+      // Average each pixel with its predecessor along dim, in the reverse
+      // order of the buffer.
+      for ( SizeValueType block = numberOfValues; block > 0; block -= blockLength )
         {
-        // determine the index of the output pixel
-        index = tempReverseIt.GetIndex();
-
-        if ( index[dim] > startIndex[dim] )
+        for ( SizeValueType k = size[dim] - 1; k > 0; k-- )
           {
-          // Figure out the location of the "neighbor" pixel
-          for ( unsigned int i = 0; i < NDimensions; i++ )
+          double *row = buffer + ( block - blockLength ) + k * rowLength;
+          const double *previous = row - rowLength;
+          for ( SizeValueType i = rowLength; i > 0; i-- )
             {
-            if ( i == dim )
-              {
-              indexShift.m_Index[i] = index.m_Index[i] - 1;
-              }
-            else
-              {
-              indexShift.m_Index[i] = index.m_Index[i];
-              }
+            row[i - 1] = ( row[i - 1] + previous[i - 1] ) / 2;
+            progress.CompletedPixel();
             }
-
-          // Average the pixel of interest and shifted pixel
-          pixelA = tempPtr->GetPixel(index);
-          pixelB = tempPtr->GetPixel(indexShift);
-
-          pixelA += pixelB;
-          pixelA = pixelA / 2;
-
-          tempPtr->SetPixel(index, pixelA);
-          progress.CompletedPixel();
           }
-
-        ++tempReverseIt;
-        } // end walk the image backwards
+        }
 
       itkDebugMacro(<< "End processing reverse dimension " << dim);
       } // end dimension loop
@@ -32,6 +32,10 @@ namespace itk
  *
  * A mean filter is one of the family of linear filters.
  *
+ * When the radius is larger than one along some dimension, the sums are
+ * computed with running sums (see BoxRunningSum), so their cost does not
+ * grow with the radius.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -106,6 +110,11 @@ protected:
                             ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
+  /** Computes the output of the thread with BoxRunningSum, used when the
+   * radius is larger than one along some dimension. */
+  void ThreadedGenerateDataWithRunningSums(const OutputImageRegionType & outputRegionForThread,
+                                           ThreadIdType threadId);
+
   MeanImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);  //purposely not implemented
 };
@@ -25,6 +25,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "itkBoxRunningSum.h"
 
 namespace itk
 {
@@ -39,6 +40,17 @@ MeanImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
+  // The running sums pay off as soon as the box is wider than three
+  // pixels along some dimension.
+  for ( unsigned int d = 0; d < InputImageDimension; ++d )
+    {
+    if ( this->GetRadius()[d] > 1 )
+      {
+      this->ThreadedGenerateDataWithRunningSums(outputRegionForThread, threadId);
+      return;
+      }
+    }
+
   unsigned int i;
 
   ZeroFluxNeumannBoundaryCondition< InputImageType > nbc;
@@ -90,6 +102,36 @@ MeanImageFilter< TInputImage, TOutputImage >
       }
     }
 }
+
+template< typename TInputImage, typename TOutputImage >
+void
+MeanImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateDataWithRunningSums(const OutputImageRegionType & outputRegionForThread,
+                                      ThreadIdType threadId)
+{
+  typename OutputImageType::Pointer output = this->GetOutput();
+  typename  InputImageType::ConstPointer input  = this->GetInput();
+
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  std::vector< InputRealType > sums;
+  BoxRunningSum( input.GetPointer(), outputRegionForThread, this->GetRadius(),
+                 Functor::BoxSumValue< InputPixelType, InputRealType >(), sums );
+
+  double neighborhoodSize = 1.0;
+  for ( unsigned int d = 0; d < InputImageDimension; ++d )
+    {
+    neighborhoodSize *= 2.0 * this->GetRadius()[d] + 1.0;
+    }
+
+  ImageRegionIterator< OutputImageType > it(output, outputRegionForThread);
+  typename std::vector< InputRealType >::const_iterator sum = sums.begin();
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it, ++sum )
+    {
+    it.Set( static_cast< OutputPixelType >( *sum / neighborhoodSize ) );
+    progress.CompletedPixel();
+    }
+}
 } // end namespace itk
 
 #endif
@@ -20,6 +20,8 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkBlockedImage.h"
+#include "itkProgressReporter.h"
 
 namespace itk
 {
@@ -35,7 +37,15 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * The input may also be a BlockedImage, e.g. the output of an
+ * ImageToBlockedImageFilter. The output is then computed one input brick
+ * at a time: the brick and its neighborhood are copied in a small buffer,
+ * so the neighborhoods of a 3D volume are read from a few bricks instead
+ * of lines that are far apart in memory. The result is the same as for an
+ * Image input.
+ *
  * \sa Image
+ * \sa BlockedImage
  * \sa Neighborhood
  * \sa NeighborhoodOperator
  * \sa NeighborhoodIterator
@@ -83,6 +93,7 @@ public:
   typedef typename OutputImageType::RegionType OutputImageRegionType;
 
   typedef typename InputImageType::SizeType InputSizeType;
+  typedef typename InputImageType::IndexType InputIndexType;
 
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
@@ -115,6 +126,19 @@ protected:
 private:
   MedianImageFilter(const Self &); //purposely not implemented
   void operator=(const Self &);    //purposely not implemented
+
+  /** Computes the medians of an image whose buffer is row-major, with
+   * neighborhood iterators. */
+  template< typename TImage >
+  void GenerateMedians(const TImage *input,
+                       const OutputImageRegionType & outputRegionForThread,
+                       ProgressReporter & progress);
+
+  /** Computes the medians of a BlockedImage, brick by brick. */
+  template< typename TPixel, unsigned int VDimension >
+  void GenerateMedians(const BlockedImage< TPixel, VDimension > *input,
+                       const OutputImageRegionType & outputRegionForThread,
+                       ProgressReporter & progress);
 };
 } // end namespace itk
 
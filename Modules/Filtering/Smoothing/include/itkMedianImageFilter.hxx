@@ -24,7 +24,6 @@
 #include "itkImageRegionIterator.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
-#include "itkProgressReporter.h"
 
 #include <vector>
 #include <algorithm>
@@ -42,18 +41,27 @@ MedianImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  // Allocate output
-  typename OutputImageType::Pointer output = this->GetOutput();
-  typename  InputImageType::ConstPointer input  = this->GetInput();
+  // support progress methods/callbacks
+  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
+
+  this->GenerateMedians(this->GetInput(), outputRegionForThread, progress);
+}
+
+template< typename TInputImage, typename TOutputImage >
+template< typename TImage >
+void
+MedianImageFilter< TInputImage, TOutputImage >
+::GenerateMedians(const TImage *input,
+                  const OutputImageRegionType & outputRegionForThread,
+                  ProgressReporter & progress)
+{
+  OutputImageType *output = this->GetOutput();
 
   // Find the data-set boundary "faces"
   NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType > bC;
   typename NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< InputImageType >::FaceListType
   faceList = bC( input, outputRegionForThread, this->GetRadius() );
 
-  // support progress methods/callbacks
-  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels() );
-
   // All of our neighborhoods have an odd number of pixels, so there is
   // always a median index (if there where an even number of pixels
   // in the neighborhood we have to average the middle two values).
@@ -94,6 +102,180 @@ MedianImageFilter< TInputImage, TOutputImage >
       }
     }
 }
+
+template< typename TInputImage, typename TOutputImage >
+template< typename TPixel, unsigned int VDimension >
+void
+MedianImageFilter< TInputImage, TOutputImage >
+::GenerateMedians(const BlockedImage< TPixel, VDimension > *input,
+                  const OutputImageRegionType & outputRegionForThread,
+                  ProgressReporter & progress)
+{
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  OutputImageType *output = this->GetOutput();
+
+  const InputSizeType        radius = this->GetRadius();
+  const InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+  const InputIndexType       bufferedBegin = bufferedRegion.GetIndex();
+  InputIndexType             bufferedEnd;
+  InputIndexType             regionEnd;
+  SizeValueType              neighborhoodSize = 1;
+  for ( unsigned int d = 0; d < VDimension; ++d )
+    {
+    bufferedEnd[d] = bufferedBegin[d] + static_cast< OffsetValueType >( bufferedRegion.GetSize(d) ) - 1;
+    regionEnd[d] = outputRegionForThread.GetIndex(d)
+      + static_cast< OffsetValueType >( outputRegionForThread.GetSize(d) );
+    neighborhoodSize *= 2 * radius[d] + 1;
+    }
+  const SizeValueType medianPosition = neighborhoodSize / 2;
+
+  typedef typename BlockedImage< TPixel, VDimension >::PixelContainer PixelContainerType;
+  const PixelContainerType & buffer = *input->GetPixelContainer();
+  const OffsetValueType      brickMask = static_cast< OffsetValueType >( input->GetBrickEdgeLength() ) - 1;
+
+  std::vector< InputPixelType >  tile;
+  std::vector< InputPixelType >  pixels(neighborhoodSize);
+  std::vector< OffsetValueType > neighborOffsets(neighborhoodSize);
+
+  // Visit the region one input brick at a time
+  InputIndexType brickStart = outputRegionForThread.GetIndex();
+  for (;; )
+    {
+    InputImageRegionType piece = input->GetBrickRegion(brickStart);
+    piece.Crop(outputRegionForThread);
+
+    // Copy the piece, padded by the radius, in a row-major tile. The
+    // indices outside the buffered region are clamped to it, as by the
+    // ZeroFluxNeumannBoundaryCondition.
+    InputSizeType   tileSize;
+    OffsetValueType tileStrides[VDimension];
+    SizeValueType   tilePixels = 1;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      tileSize[d] = piece.GetSize(d) + 2 * radius[d];
+      tileStrides[d] = static_cast< OffsetValueType >( tilePixels );
+      tilePixels *= tileSize[d];
+      }
+    tile.resize(tilePixels);
+
+    // The tile is filled one line at a time. Along a line, the pixels of a
+    // brick are contiguous in the buffer.
+    InputIndexType tileIndex;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      tileIndex[d] = 0;
+      }
+    const OffsetValueType lineBegin = piece.GetIndex(0) - static_cast< OffsetValueType >( radius[0] );
+    InputPixelType *      tilePixel = &tile[0];
+    for ( SizeValueType line = 0; line < tilePixels / tileSize[0]; ++line )
+      {
+      InputIndexType index;
+      for ( unsigned int d = 1; d < VDimension; ++d )
+        {
+        index[d] = piece.GetIndex(d) - static_cast< OffsetValueType >( radius[d] ) + tileIndex[d];
+        index[d] = std::min( std::max(index[d], bufferedBegin[d]), bufferedEnd[d] );
+        }
+      index[0] = std::max(lineBegin, bufferedBegin[0]);
+      OffsetValueType offset = input->ComputeOffset(index);
+      for ( SizeValueType t = 0; t < tileSize[0]; ++t )
+        {
+        const OffsetValueType x = lineBegin + static_cast< OffsetValueType >( t );
+        if ( x > index[0] && x <= bufferedEnd[0] )
+          {
+          index[0] = x;
+          offset = ( ( x - bufferedBegin[0] ) & brickMask ) ? offset + 1 : input->ComputeOffset(index);
+          }
+        *tilePixel++ = buffer[offset];
+        }
+
+      for ( unsigned int d = 1; d < VDimension; ++d )
+        {
+        if ( ++tileIndex[d] < static_cast< OffsetValueType >( tileSize[d] ) )
+          {
+          break;
+          }
+        tileIndex[d] = 0;
+        }
+      }
+
+    // Offsets of the neighbors in the tile, relative to the center
+    InputIndexType neighbor;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      neighbor[d] = -static_cast< OffsetValueType >( radius[d] );
+      }
+    for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+      {
+      neighborOffsets[i] = 0;
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        neighborOffsets[i] += neighbor[d] * tileStrides[d];
+        }
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        if ( ++neighbor[d] <= static_cast< OffsetValueType >( radius[d] ) )
+          {
+          break;
+          }
+        neighbor[d] = -static_cast< OffsetValueType >( radius[d] );
+        }
+      }
+
+    // Compute the medians of the piece
+    ImageRegionIterator< OutputImageType > it(output, piece);
+    InputIndexType                         position;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      position[d] = 0;
+      }
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      OffsetValueType center = 0;
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        center += ( position[d] + static_cast< OffsetValueType >( radius[d] ) ) * tileStrides[d];
+        }
+      for ( SizeValueType i = 0; i < neighborhoodSize; ++i )
+        {
+        pixels[i] = tile[center + neighborOffsets[i]];
+        }
+
+      const typename std::vector< InputPixelType >::iterator medianIterator = pixels.begin() + medianPosition;
+      std::nth_element( pixels.begin(), medianIterator, pixels.end() );
+      it.Set( static_cast< typename OutputImageType::PixelType >( *medianIterator ) );
+      progress.CompletedPixel();
+
+      for ( unsigned int d = 0; d < VDimension; ++d )
+        {
+        if ( ++position[d] < static_cast< OffsetValueType >( piece.GetSize(d) ) )
+          {
+          break;
+          }
+        position[d] = 0;
+        }
+      }
+
+    // Move to the next brick
+    unsigned int d = 0;
+    for (; d < VDimension; ++d )
+      {
+      brickStart[d] = piece.GetIndex(d) + static_cast< OffsetValueType >( piece.GetSize(d) );
+      if ( brickStart[d] < regionEnd[d] )
+        {
+        break;
+        }
+      brickStart[d] = outputRegionForThread.GetIndex(d);
+      }
+    if ( d == VDimension )
+      {
+      break;
+      }
+    }
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+#include <algorithm>
+
+#include "itkMeanImageFilter.h"
+#include "itkNoiseImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+
+namespace
+{
+typedef itk::Image< float, 3 >  ImageType;
+typedef itk::Image< double, 3 > RealImageType;
+
+// Mean and standard deviation over the box with the indices clamped to the
+// image, computed pixel by pixel.
+void BoxStatistics( const ImageType * image, const ImageType::IndexType & center,
+                    const ImageType::SizeType & radius, double & mean, double & sigma )
+{
+  const ImageType::RegionType & region = image->GetBufferedRegion();
+  ImageType::SizeType boxSize;
+  for ( unsigned int d = 0; d < 3; ++d )
+    {
+    boxSize[d] = 2 * radius[d] + 1;
+    }
+  ImageType::IndexType boxStart = center - radius;
+  ImageType::RegionType box( boxStart, boxSize );
+
+  double sum = 0.0;
+  double sumOfSquares = 0.0;
+  double count = 0.0;
+  for ( itk::SizeValueType n = 0; n < box.GetNumberOfPixels(); ++n )
+    {
+    ImageType::IndexType index;
+    itk::SizeValueType rest = n;
+    for ( unsigned int d = 0; d < 3; ++d )
+      {
+      index[d] = boxStart[d] + static_cast< itk::OffsetValueType >( rest % boxSize[d] );
+      rest /= boxSize[d];
+      const itk::OffsetValueType last = region.GetIndex(d) + static_cast< itk::OffsetValueType >( region.GetSize(d) ) - 1;
+      index[d] = std::min( std::max( index[d], region.GetIndex(d) ), last );
+      }
+    const double value = image->GetPixel( index );
+    sum += value;
+    sumOfSquares += value * value;
+    count += 1.0;
+    }
+  mean = sum / count;
+  sigma = std::sqrt( std::max( ( sumOfSquares - sum * sum / count ) / ( count - 1.0 ), 0.0 ) );
+}
+
+template< typename TFilter >
+bool CheckFilter( const ImageType * image, const ImageType::SizeType & radius,
+                  unsigned int numberOfStreamDivisions, bool computeMean )
+{
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput( image );
+  filter->SetRadius( radius );
+  filter->SetNumberOfThreads( 3 );
+
+  typedef itk::StreamingImageFilter< RealImageType, RealImageType > StreamerType;
+  typename StreamerType::Pointer streamer = StreamerType::New();
+  streamer->SetInput( filter->GetOutput() );
+  streamer->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  streamer->Update();
+
+  itk::ImageRegionIteratorWithIndex< RealImageType > it( streamer->GetOutput(), image->GetBufferedRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    double mean;
+    double sigma;
+    BoxStatistics( image, it.GetIndex(), radius, mean, sigma );
+    const double expected = computeMean ? mean : sigma;
+    if ( std::abs( it.Get() - expected ) > 1e-6 * ( 1.0 + std::abs( expected ) ) )
+      {
+      std::cerr << ( computeMean ? "Mean" : "Noise" ) << " with radius " << radius << " and "
+                << numberOfStreamDivisions << " stream divisions: " << it.Get()
+                << " instead of " << expected << " at " << it.GetIndex() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+int itkBoxRunningSumFiltersTest( int, char* [] )
+{
+  typedef itk::MeanImageFilter< ImageType, RealImageType >  MeanFilterType;
+  typedef itk::NoiseImageFilter< ImageType, RealImageType > NoiseFilterType;
+
+  ImageType::IndexType start;
+  start[0] = -5;
+  start[1] = 2;
+  start[2] = 0;
+  ImageType::SizeType size;
+  size[0] = 17;
+  size[1] = 12;
+  size[2] = 9;
+  ImageType::RegionType region( start, size );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, region );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & index = it.GetIndex();
+    // A flat patch checks that the noise does not come out negative.
+    if ( index[0] < 0 && index[1] < 6 )
+      {
+      it.Set( 0.1f );
+      }
+    else
+      {
+      it.Set( static_cast< float >( ( index[0] * 11 + index[1] * 5 + index[2] * 23 ) % 13 ) * 0.25f );
+      }
+    }
+
+  // Radius 1 along every dimension uses the neighborhood sums, the others
+  // the running sums, including a radius larger than the image.
+  ImageType::SizeType radii[4];
+  radii[0].Fill( 1 );
+  radii[1].Fill( 2 );
+  radii[2][0] = 4;
+  radii[2][1] = 0;
+  radii[2][2] = 1;
+  radii[3][0] = 10;
+  radii[3][1] = 3;
+  radii[3][2] = 12;
+
+  for ( unsigned int r = 0; r < 4; ++r )
+    {
+    for ( unsigned int divisions = 1; divisions <= 4; divisions += 3 )
+      {
+      if ( !CheckFilter< MeanFilterType >( image, radii[r], divisions, true )
+           || !CheckFilter< NoiseFilterType >( image, radii[r], divisions, false ) )
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
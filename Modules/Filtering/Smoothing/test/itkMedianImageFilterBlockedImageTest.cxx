@@ -0,0 +1,95 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRandomImageSource.h"
+#include "itkMedianImageFilter.h"
+#include "itkImageToBlockedImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+// Checks that the median of a BlockedImage is the median of the same
+// Image, on bricks that do not fit the image and on a requested region
+// that does not touch the image origin.
+int itkMedianImageFilterBlockedImageTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+  typedef itk::Image< float, Dimension >        ImageType;
+  typedef itk::BlockedImage< float, Dimension > BlockedImageType;
+
+  typedef itk::RandomImageSource< ImageType > RandomType;
+  RandomType::Pointer random = RandomType::New();
+  random->SetMin(0.0);
+  random->SetMax(1000.0);
+
+  ImageType::SizeValueType randomSize[Dimension] = { 21, 13, 18 };
+  random->SetSize(randomSize);
+
+  typedef itk::ImageToBlockedImageFilter< ImageType, BlockedImageType > ToBlockedType;
+  ToBlockedType::Pointer toBlocked = ToBlockedType::New();
+  toBlocked->SetInput( random->GetOutput() );
+  toBlocked->SetBrickEdgeLength(4);
+
+  ImageType::SizeType radius;
+  radius[0] = 1;
+  radius[1] = 2;
+  radius[2] = 1;
+
+  typedef itk::MedianImageFilter< ImageType, ImageType > MedianType;
+  MedianType::Pointer median = MedianType::New();
+  median->SetInput( random->GetOutput() );
+  median->SetRadius(radius);
+
+  typedef itk::MedianImageFilter< BlockedImageType, ImageType > BlockedMedianType;
+  BlockedMedianType::Pointer blockedMedian = BlockedMedianType::New();
+  blockedMedian->SetInput( toBlocked->GetOutput() );
+  blockedMedian->SetRadius(radius);
+
+  random->UpdateOutputInformation();
+  ImageType::RegionType requestedRegions[2];
+  requestedRegions[0] = random->GetOutput()->GetLargestPossibleRegion();
+  ImageType::IndexType start;
+  ImageType::SizeType  size;
+  start[0] = 3;
+  start[1] = 1;
+  start[2] = 5;
+  size[0] = 15;
+  size[1] = 11;
+  size[2] = 9;
+  requestedRegions[1] = ImageType::RegionType(start, size);
+
+  for ( unsigned int r = 0; r < 2; ++r )
+    {
+    median->GetOutput()->SetRequestedRegion(requestedRegions[r]);
+    median->Update();
+    blockedMedian->GetOutput()->SetRequestedRegion(requestedRegions[r]);
+    blockedMedian->Update();
+
+    itk::ImageRegionConstIterator< ImageType > it(median->GetOutput(), requestedRegions[r]);
+    itk::ImageRegionConstIterator< ImageType > bit(blockedMedian->GetOutput(), requestedRegions[r]);
+    for ( ; !it.IsAtEnd(); ++it, ++bit )
+      {
+      if ( it.Get() != bit.Get() )
+        {
+        std::cerr << "Median of the blocked image at " << it.GetIndex() << " is " << bit.Get()
+                  << ", expected " << it.Get() << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
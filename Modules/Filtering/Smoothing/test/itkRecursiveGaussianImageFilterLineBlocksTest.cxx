@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include <iostream>
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkMath.h"
+
+namespace
+{
+// Filters the image along the direction with lines processed one at a time
+// and in blocks, and checks that both give the same result.
+template< typename TImage >
+bool CompareLineBlocks( const TImage * image, unsigned int direction, unsigned int numberOfThreads,
+                        unsigned int order, unsigned int numberOfLinesPerBlock )
+{
+  typedef itk::RecursiveGaussianImageFilter< TImage, TImage > FilterType;
+
+  typename FilterType::Pointer lineFilter = FilterType::New();
+  lineFilter->SetInput( image );
+  lineFilter->SetDirection( direction );
+  lineFilter->SetSigma( 1.7 );
+  lineFilter->SetOrder( static_cast< typename FilterType::OrderEnumType >( order ) );
+  lineFilter->SetNumberOfLinesPerBlock( 1 );
+  lineFilter->SetNumberOfThreads( numberOfThreads );
+  lineFilter->Update();
+
+  typename FilterType::Pointer blockFilter = FilterType::New();
+  blockFilter->SetInput( image );
+  blockFilter->SetDirection( direction );
+  blockFilter->SetSigma( 1.7 );
+  blockFilter->SetOrder( static_cast< typename FilterType::OrderEnumType >( order ) );
+  blockFilter->SetNumberOfLinesPerBlock( numberOfLinesPerBlock );
+  blockFilter->SetNumberOfThreads( numberOfThreads );
+  blockFilter->Update();
+
+  const unsigned int numberOfComponents = image->GetNumberOfComponentsPerPixel();
+
+  itk::ImageRegionConstIteratorWithIndex< TImage > lineIt( lineFilter->GetOutput(), image->GetBufferedRegion() );
+  itk::ImageRegionConstIteratorWithIndex< TImage > blockIt( blockFilter->GetOutput(), image->GetBufferedRegion() );
+  for ( ; !lineIt.IsAtEnd(); ++lineIt, ++blockIt )
+    {
+    const typename TImage::PixelType lineValue = lineIt.Get();
+    const typename TImage::PixelType blockValue = blockIt.Get();
+    for ( unsigned int c = 0; c < numberOfComponents; ++c )
+      {
+      const double a = itk::DefaultConvertPixelTraits< typename TImage::PixelType >::GetNthComponent( c, lineValue );
+      const double b = itk::DefaultConvertPixelTraits< typename TImage::PixelType >::GetNthComponent( c, blockValue );
+      if ( !itk::Math::FloatAlmostEqual( a, b, 4, 1e-9 ) )
+        {
+        std::cerr << "Direction " << direction << ", order " << order << ", " << numberOfThreads
+                  << " threads, " << numberOfLinesPerBlock << " lines per block: "
+                  << a << " != " << b << " at " << lineIt.GetIndex() << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkRecursiveGaussianImageFilterLineBlocksTest( int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef itk::Image< float, Dimension >        ImageType;
+  typedef itk::VectorImage< double, Dimension > VectorImageType;
+
+  ImageType::IndexType start;
+  start[0] = 3;
+  start[1] = -4;
+  start[2] = 1;
+  ImageType::SizeType size;
+  size[0] = 19;
+  size[1] = 11;
+  size[2] = 6;
+  ImageType::RegionType region( start, size );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions( region );
+  vectorImage->SetNumberOfComponentsPerPixel( 2 );
+  vectorImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, region );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & index = it.GetIndex();
+    const float value = static_cast< float >( ( index[0] * 7 + index[1] * 13 + index[2] * 29 ) % 17 );
+    it.Set( value );
+
+    VectorImageType::PixelType vector( 2 );
+    vector[0] = value;
+    vector[1] = -0.5 * value + index[1];
+    vectorImage->SetPixel( index, vector );
+    }
+
+  const unsigned int numberOfThreads[] = { 1, 3 };
+  const unsigned int numberOfLinesPerBlock[] = { 2, 8, 32 };
+  for ( unsigned int direction = 0; direction < Dimension; ++direction )
+    {
+    for ( unsigned int t = 0; t < 2; ++t )
+      {
+      for ( unsigned int b = 0; b < 3; ++b )
+        {
+        for ( unsigned int order = 0; order < 3; ++order )
+          {
+          if ( !CompareLineBlocks< ImageType >( image, direction, numberOfThreads[t],
+                                                order, numberOfLinesPerBlock[b] ) )
+            {
+            return EXIT_FAILURE;
+            }
+          }
+        if ( !CompareLineBlocks< VectorImageType >( vectorImage, direction, numberOfThreads[t],
+                                                    0, numberOfLinesPerBlock[b] ) )
+          {
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkGDCMMetaDataScanner_h
+#define itkGDCMMetaDataScanner_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkMultiThreader.h"
+#include "itkAtomicInt.h"
+#include "gdcmFile.h"
+#include "gdcmTag.h"
+#include "ITKIOGDCMExport.h"
+#include <map>
+#include <set>
+#include <vector>
+
+namespace itk
+{
+/** \class GDCMMetaDataScanner
+ * \brief Read a set of tags from the headers of many DICOM files.
+ *
+ * GDCMMetaDataScanner parses the files set with SetFileNames() on
+ * several threads. Only the selected tags are kept and each file is
+ * parsed no further than the pixel data, which is never read. A file
+ * is considered to be a DICOM image when gdcm can read it as an image,
+ * as in gdcm::SerieHelper. The Rows and Columns tags are always
+ * selected.
+ *
+ * When an index file name is set, the selected tags of every scanned
+ * file are saved in the index together with the modification time,
+ * to the fraction of a second where the file system records it, and
+ * the length of the file. The next Scan() only parses the files that
+ * are not in the index or that changed since, which makes repeated
+ * scans of a large directory almost free. The index is discarded when
+ * it was written for a different set of tags.
+ *
+ * \sa GDCMSeriesFileNames
+ *
+ * \ingroup ITKIOGDCM
+ */
+class ITKIOGDCM_EXPORT GDCMMetaDataScanner:public Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef GDCMMetaDataScanner        Self;
+  typedef Object                     Superclass;
+  typedef SmartPointer< Self >       Pointer;
+  typedef SmartPointer< const Self > ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(GDCMMetaDataScanner, Object);
+
+  typedef std::vector< std::string >      FileNamesContainerType;
+  typedef std::set< gdcm::Tag >           TagSetType;
+  typedef gdcm::SmartPointer< gdcm::File > FilePointer;
+
+  /** Set/Get the files to scan. */
+  void SetFileNames(const FileNamesContainerType & names);
+  const FileNamesContainerType & GetFileNames() const
+  {
+    return m_FileNames;
+  }
+
+  /** Add a tag to read from each file. The string format is
+   * "group|element", as in GDCMSeriesFileNames::AddSeriesRestriction. */
+  void AddTag(const gdcm::Tag & tag);
+  void AddTag(const std::string & tag);
+
+  const TagSetType & GetTags() const
+  {
+    return m_Tags;
+  }
+
+  /** Set/Get the file used to keep the scanned headers between runs.
+   * No index is used when empty, which is the default. */
+  itkSetStringMacro(IndexFileName);
+  itkGetStringMacro(IndexFileName);
+
+  /** Set/Get the number of threads parsing the files. Defaults to the
+   * global default number of threads. */
+  itkSetClampMacro(NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfThreads, ThreadIdType);
+
+  /** Parse the files, or fetch them from the index. */
+  void Scan();
+
+  /** Return the selected tags of the i-th file, or ITK_NULLPTR when it
+   * could not be read or is not a DICOM image. */
+  const gdcm::File * GetFile(SizeValueType i) const;
+
+  /** Return the value of a selected tag of the i-th file as a string,
+   * empty when the file does not hold the tag. */
+  std::string GetValue(SizeValueType i, const gdcm::Tag & tag) const;
+
+  /** Number of files actually parsed by the last Scan(). Files found
+   * unchanged in the index are not counted. */
+  itkGetConstMacro(NumberOfParsedFiles, SizeValueType);
+
+protected:
+  GDCMMetaDataScanner();
+  ~GDCMMetaDataScanner();
+  virtual void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+private:
+  GDCMMetaDataScanner(const Self &); //purposely not implemented
+  void operator=(const Self &);      //purposely not implemented
+
+  /** Index entry of a scanned file. */
+  struct IndexEntryType
+  {
+    long int      ModifiedTime;
+    long int      ModifiedTimeNanoseconds;
+    unsigned long Length;
+    bool          IsImage;
+    bool          Parsed;  // not found up to date in the index
+    std::string   Header;  // selected tags written as a DICOM stream
+  };
+
+  /** Read the header of one file, keeping the selected tags. */
+  FilePointer ParseFile(const std::string & filename) const;
+
+  /** Serialize and restore the selected tags of a file. */
+  static bool WriteHeader(const gdcm::File & file, std::string & header);
+  static FilePointer ReadHeader(const std::string & header);
+
+  /** Read and write the index file. */
+  void ReadIndex(std::map< std::string, IndexEntryType > & index) const;
+  void WriteIndex() const;
+
+  static ITK_THREAD_RETURN_TYPE ReadFilesThreaderCallback(void *arg);
+
+  FileNamesContainerType m_FileNames;
+  TagSetType             m_Tags;
+  std::string            m_IndexFileName;
+  ThreadIdType           m_NumberOfThreads;
+  SizeValueType          m_NumberOfParsedFiles;
+
+  std::vector< FilePointer >    m_Files;
+  std::vector< IndexEntryType > m_Entries;
+  std::vector< SizeValueType >  m_FilesToRead;
+  AtomicInt< int >              m_NextFileToRead;
+};
+} // end namespace itk
+
+#endif // itkGDCMMetaDataScanner_h
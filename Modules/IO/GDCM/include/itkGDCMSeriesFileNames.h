@@ -23,6 +23,7 @@
 #include "itkMacro.h"
 #include <vector>
 #include "gdcmSerieHelper.h"
+#include "itkGDCMMetaDataScanner.h"
 #include "ITKIOGDCMExport.h"
 
 namespace itk
@@ -45,6 +46,13 @@ namespace itk
  *    dicom objects, you may want to try calling ->SetUseSeriesDetails(true)
  *    prior to calling SetDirectory().
  *
+ *  With SetUseMetaDataScanner(true), the files are not read completely:
+ *    a GDCMMetaDataScanner parses, on several threads, only the tags
+ *    needed to group and order the files, and can keep them in an index
+ *    file between runs (see SetMetaDataIndexFileName()). The gdcm::File
+ *    objects of the SeriesHelper then only hold these tags; more tags
+ *    can be requested through GetMetaDataScanner()->AddTag().
+ *
  * \ingroup IOFilters
  *
  * \ingroup ITKIOGDCM
@@ -161,6 +169,7 @@ public:
   void AddSeriesRestriction(const std::string & tag)
   {
     m_SerieHelper->AddRestriction(tag);
+    m_MetaDataScanner->AddTag(tag);
   }
 
   /** Parse any sequences in the DICOM file. Defaults to false
@@ -179,6 +188,24 @@ public:
   itkGetConstMacro(LoadPrivateTags, bool);
   itkBooleanMacro(LoadPrivateTags);
 
+  /** Only parse the DICOM tags needed to build the series, on
+   * GetNumberOfThreads() threads, instead of reading every file
+   * completely. Defaults to false. Must be set before SetDirectory().
+   */
+  itkSetMacro(UseMetaDataScanner, bool);
+  itkGetConstMacro(UseMetaDataScanner, bool);
+  itkBooleanMacro(UseMetaDataScanner);
+
+  /** File where the metadata scanner keeps the parsed tags between
+   * runs, keyed by file name, modification time and length. Only used with
+   * UseMetaDataScanner. No index is kept when empty, the default.
+   */
+  itkSetStringMacro(MetaDataIndexFileName);
+  itkGetStringMacro(MetaDataIndexFileName);
+
+  /** Returns the scanner used when UseMetaDataScanner is on. */
+  itkGetModifiableObjectMacro(MetaDataScanner, GDCMMetaDataScanner);
+
 protected:
   GDCMSeriesFileNames();
   ~GDCMSeriesFileNames();
@@ -188,6 +215,10 @@ private:
   GDCMSeriesFileNames(const Self &); //purposely not implemented
   void operator=(const Self &);      //purposely not implemented
 
+  /** Fill the SeriesHelper with the headers read by the metadata
+   * scanner. */
+  void ScanDirectory(const std::string & name);
+
   /** Contains the input directory where the DICOM serie is found */
   std::string m_InputDirectory;
 
@@ -208,6 +239,10 @@ private:
   bool m_Recursive;
   bool m_LoadSequences;
   bool m_LoadPrivateTags;
+  bool m_UseMetaDataScanner;
+
+  std::string                  m_MetaDataIndexFileName;
+  GDCMMetaDataScanner::Pointer m_MetaDataScanner;
 };
 } //namespace ITK
 
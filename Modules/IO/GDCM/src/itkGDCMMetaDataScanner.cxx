@@ -0,0 +1,469 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkGDCMMetaDataScanner.h"
+#include "itksys/SystemTools.hxx"
+
+#include "gdcmImageRegionReader.h"
+#include "gdcmReader.h"
+#include "gdcmWriter.h"
+#include "gdcmStringFilter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <sys/types.h>
+#include <sys/stat.h>
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+#include <windows.h>
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace itk
+{
+namespace
+{
+const char *const IndexMagic = "ITKGDCMMetaDataIndex";
+const int         IndexVersion = 2;
+// number of files handed to a thread at once
+const int         FilesPerBatch = 8;
+
+// Modification time of a file, including the fraction of a second where
+// the file system records it, so that a file rewritten within the second
+// of the previous scan is still detected.
+void GetModifiedTime(const std::string & filename, long int & seconds, long int & nanoseconds)
+{
+  seconds = 0;
+  nanoseconds = 0;
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  WIN32_FILE_ATTRIBUTE_DATA data;
+  if ( GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &data) )
+    {
+    // 100 ns intervals since January 1, 1601
+    ULARGE_INTEGER time;
+    time.LowPart = data.ftLastWriteTime.dwLowDateTime;
+    time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+    seconds = static_cast< long int >( time.QuadPart / 10000000 );
+    nanoseconds = static_cast< long int >( time.QuadPart % 10000000 ) * 100;
+    }
+#else
+  struct stat fs;
+  if ( stat(filename.c_str(), &fs) == 0 )
+    {
+    seconds = static_cast< long int >( fs.st_mtime );
+#if defined( __APPLE__ )
+    nanoseconds = static_cast< long int >( fs.st_mtimespec.tv_nsec );
+#elif defined( _POSIX_C_SOURCE ) && _POSIX_C_SOURCE >= 200809L
+    nanoseconds = static_cast< long int >( fs.st_mtim.tv_nsec );
+#endif
+    }
+#endif
+}
+
+int GetProcessId()
+{
+#if defined( _WIN32 ) && !defined( __CYGWIN__ )
+  return _getpid();
+#else
+  return static_cast< int >( getpid() );
+#endif
+}
+}
+
+GDCMMetaDataScanner::GDCMMetaDataScanner()
+{
+  m_NumberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
+  m_NumberOfParsedFiles = 0;
+  m_NextFileToRead = 0;
+
+  // the size of the images is always kept
+  m_Tags.insert( gdcm::Tag(0x0028, 0x0010) );
+  m_Tags.insert( gdcm::Tag(0x0028, 0x0011) );
+}
+
+GDCMMetaDataScanner::~GDCMMetaDataScanner()
+{
+}
+
+void GDCMMetaDataScanner::SetFileNames(const FileNamesContainerType & names)
+{
+  m_FileNames = names;
+  this->Modified();
+}
+
+void GDCMMetaDataScanner::AddTag(const gdcm::Tag & tag)
+{
+  if ( m_Tags.insert(tag).second )
+    {
+    this->Modified();
+    }
+}
+
+void GDCMMetaDataScanner::AddTag(const std::string & tag)
+{
+  gdcm::Tag t;
+  if ( !t.ReadFromPipeSeparatedString( tag.c_str() ) )
+    {
+    itkExceptionMacro(<< "Invalid tag " << tag << ", expected group|element");
+    }
+  this->AddTag(t);
+}
+
+const gdcm::File * GDCMMetaDataScanner::GetFile(SizeValueType i) const
+{
+  if ( i >= m_Files.size() )
+    {
+    return ITK_NULLPTR;
+    }
+  return m_Files[i].GetPointer();
+}
+
+std::string GDCMMetaDataScanner::GetValue(SizeValueType i, const gdcm::Tag & tag) const
+{
+  const gdcm::File *file = this->GetFile(i);
+  if ( !file || !file->GetDataSet().FindDataElement(tag) )
+    {
+    return "";
+    }
+  gdcm::StringFilter sf;
+  sf.SetFile(*file);
+  return sf.ToString(tag);
+}
+
+void GDCMMetaDataScanner::Scan()
+{
+  const SizeValueType numberOfFiles = m_FileNames.size();
+
+  m_Files.assign( numberOfFiles, FilePointer() );
+  m_Entries.assign( numberOfFiles, IndexEntryType() );
+  m_FilesToRead.clear();
+
+  std::map< std::string, IndexEntryType > index;
+  if ( !m_IndexFileName.empty() )
+    {
+    this->ReadIndex(index);
+    }
+
+  // Files that are up to date in the index are restored from it,
+  // the others are parsed.
+  SizeValueType numberOfIndexedFiles = 0;
+  for ( SizeValueType i = 0; i < numberOfFiles; ++i )
+    {
+    const std::string & filename = m_FileNames[i];
+    IndexEntryType &    entry = m_Entries[i];
+    GetModifiedTime(filename, entry.ModifiedTime, entry.ModifiedTimeNanoseconds);
+    entry.Length = itksys::SystemTools::FileLength(filename);
+    entry.IsImage = false;
+    entry.Parsed = true;
+
+    std::map< std::string, IndexEntryType >::iterator it = index.find(filename);
+    if ( it != index.end()
+         && it->second.ModifiedTime == entry.ModifiedTime
+         && it->second.ModifiedTimeNanoseconds == entry.ModifiedTimeNanoseconds
+         && it->second.Length == entry.Length )
+      {
+      ++numberOfIndexedFiles;
+      if ( !it->second.IsImage )
+        {
+        entry.Parsed = false;
+        continue;
+        }
+      entry.Header.swap(it->second.Header);
+      }
+    m_FilesToRead.push_back(i);
+    }
+
+  m_NextFileToRead = 0;
+  ThreadIdType numberOfThreads = m_NumberOfThreads;
+  const SizeValueType numberOfBatches = ( m_FilesToRead.size() + FilesPerBatch - 1 ) / FilesPerBatch;
+  if ( numberOfBatches < numberOfThreads )
+    {
+    numberOfThreads = static_cast< ThreadIdType >( std::max( numberOfBatches, SizeValueType(1) ) );
+    }
+  MultiThreader::Pointer threader = MultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(ReadFilesThreaderCallback, this);
+  threader->SingleMethodExecute();
+
+  m_NumberOfParsedFiles = 0;
+  for ( SizeValueType i = 0; i < numberOfFiles; ++i )
+    {
+    if ( m_Entries[i].Parsed )
+      {
+      ++m_NumberOfParsedFiles;
+      }
+    }
+
+  if ( !m_IndexFileName.empty()
+       && ( m_NumberOfParsedFiles > 0 || numberOfIndexedFiles != index.size() ) )
+    {
+    this->WriteIndex();
+    }
+}
+
+ITK_THREAD_RETURN_TYPE GDCMMetaDataScanner::ReadFilesThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  Self *self = static_cast< Self * >( info->UserData );
+
+  const int numberOfFiles = static_cast< int >( self->m_FilesToRead.size() );
+  const bool useIndex = !self->m_IndexFileName.empty();
+
+  for (;; )
+    {
+    const int begin = ( self->m_NextFileToRead += FilesPerBatch ) - FilesPerBatch;
+    if ( begin >= numberOfFiles )
+      {
+      break;
+      }
+    const int end = std::min(begin + FilesPerBatch, numberOfFiles);
+    for ( int k = begin; k < end; ++k )
+      {
+      const SizeValueType i = self->m_FilesToRead[k];
+      IndexEntryType &    entry = self->m_Entries[i];
+
+      if ( !entry.Header.empty() )
+        {
+        self->m_Files[i] = ReadHeader(entry.Header);
+        if ( self->m_Files[i].GetPointer() )
+          {
+          entry.IsImage = true;
+          entry.Parsed = false;
+          continue;
+          }
+        entry.Header.clear();
+        }
+
+      self->m_Files[i] = self->ParseFile( self->m_FileNames[i] );
+      entry.IsImage = ( self->m_Files[i].GetPointer() != ITK_NULLPTR );
+      if ( entry.IsImage && useIndex && !WriteHeader(*self->m_Files[i], entry.Header) )
+        {
+        entry.Header.clear();
+        }
+      }
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+GDCMMetaDataScanner::FilePointer GDCMMetaDataScanner::ParseFile(const std::string & filename) const
+{
+  // Same test as gdcm::SerieHelper::AddFileName, an image gdcm can read,
+  // except that the header is read up to the pixel data, not beyond.
+  gdcm::ImageRegionReader reader;
+
+  reader.SetFileName( filename.c_str() );
+  if ( !reader.ReadInformation() )
+    {
+    return FilePointer();
+    }
+
+  // only the selected tags are kept
+  const gdcm::File &    fullFile = reader.GetFile();
+  const gdcm::DataSet & fullDataSet = fullFile.GetDataSet();
+  FilePointer           file = new gdcm::File;
+  file->SetHeader( fullFile.GetHeader() );
+  gdcm::DataSet & ds = file->GetDataSet();
+  for ( TagSetType::const_iterator it = m_Tags.begin(); it != m_Tags.end(); ++it )
+    {
+    if ( fullDataSet.FindDataElement(*it) )
+      {
+      ds.Insert( fullDataSet.GetDataElement(*it) );
+      }
+    }
+  return file;
+}
+
+bool GDCMMetaDataScanner::WriteHeader(const gdcm::File & file, std::string & header)
+{
+  std::ostringstream os;
+  gdcm::Writer       writer;
+
+  writer.SetStream(os);
+  writer.SetFile(file);
+  // keep the meta information exactly as read
+  writer.SetCheckFileMetaInformation(false);
+  if ( !writer.Write() )
+    {
+    return false;
+    }
+  header = os.str();
+  return true;
+}
+
+GDCMMetaDataScanner::FilePointer GDCMMetaDataScanner::ReadHeader(const std::string & header)
+{
+  std::istringstream is(header);
+  FilePointer        file = new gdcm::File;
+  gdcm::Reader       reader;
+
+  reader.SetFile(*file);
+  reader.SetStream(is);
+  if ( !reader.Read() )
+    {
+    return FilePointer();
+    }
+  return file;
+}
+
+void GDCMMetaDataScanner::ReadIndex(std::map< std::string, IndexEntryType > & index) const
+{
+  std::ifstream in(m_IndexFileName.c_str(), std::ios::in | std::ios::binary);
+  if ( !in )
+    {
+    return;
+    }
+
+  std::string magic;
+  int         version = 0;
+  size_t      numberOfTags = 0;
+  in >> magic >> version >> numberOfTags;
+  if ( !in || magic != IndexMagic || version != IndexVersion )
+    {
+    itkDebugMacro(<< "Ignoring " << m_IndexFileName << ", not a metadata index");
+    return;
+    }
+
+  // an index written for other tags is useless
+  TagSetType tags;
+  for ( size_t t = 0; t < numberOfTags; ++t )
+    {
+    std::string tag;
+    gdcm::Tag   gdcmTag;
+    in >> tag;
+    if ( !gdcmTag.ReadFromPipeSeparatedString( tag.c_str() ) )
+      {
+      return;
+      }
+    tags.insert(gdcmTag);
+    }
+  if ( !in || tags != m_Tags )
+    {
+    itkDebugMacro(<< "Ignoring " << m_IndexFileName << ", written for other tags");
+    return;
+    }
+
+  for (;; )
+    {
+    size_t         filenameLength = 0;
+    size_t         headerLength = 0;
+    int            isImage = 0;
+    IndexEntryType entry;
+    in >> filenameLength >> entry.ModifiedTime >> entry.ModifiedTimeNanoseconds
+       >> entry.Length >> isImage >> headerLength;
+    if ( !in || filenameLength == 0 )
+      {
+      break;
+      }
+    in.get(); // end of line
+
+    std::string filename(filenameLength, '\0');
+    in.read(&filename[0], filenameLength);
+    entry.Header.resize(headerLength);
+    if ( headerLength > 0 )
+      {
+      in.read(&entry.Header[0], headerLength);
+      }
+    if ( !in )
+      {
+      break;
+      }
+    IndexEntryType & indexed = index[filename];
+    indexed.ModifiedTime = entry.ModifiedTime;
+    indexed.ModifiedTimeNanoseconds = entry.ModifiedTimeNanoseconds;
+    indexed.Length = entry.Length;
+    indexed.IsImage = ( isImage != 0 );
+    indexed.Parsed = false;
+    indexed.Header.swap(entry.Header);
+    }
+}
+
+void GDCMMetaDataScanner::WriteIndex() const
+{
+  // The index is written to a temporary file, then renamed, so that a
+  // scan running at the same time never reads a partial index.
+  std::ostringstream temporaryName;
+  temporaryName << m_IndexFileName << '.' << GetProcessId() << '.' << this << ".tmp";
+  const std::string temporaryFileName = temporaryName.str();
+
+  std::ofstream out(temporaryFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if ( !out )
+    {
+    itkWarningMacro(<< "Could not write metadata index " << m_IndexFileName);
+    return;
+    }
+
+  out << IndexMagic << ' ' << IndexVersion << '\n' << m_Tags.size();
+  for ( TagSetType::const_iterator it = m_Tags.begin(); it != m_Tags.end(); ++it )
+    {
+    out << ' ' << it->PrintAsPipeSeparatedString();
+    }
+  out << '\n';
+
+  for ( SizeValueType i = 0; i < m_FileNames.size(); ++i )
+    {
+    const IndexEntryType & entry = m_Entries[i];
+    if ( entry.IsImage && entry.Header.empty() )
+      {
+      // could not be serialized, parse it again next time
+      continue;
+      }
+    out << m_FileNames[i].size() << ' ' << entry.ModifiedTime << ' '
+        << entry.ModifiedTimeNanoseconds << ' ' << entry.Length << ' ' << ( entry.IsImage ? 1 : 0 ) << ' '
+        << entry.Header.size() << '\n';
+    out.write( m_FileNames[i].c_str(), m_FileNames[i].size() );
+    out.write( entry.Header.c_str(), entry.Header.size() );
+    }
+
+  out.close();
+  if ( !out )
+    {
+    itkWarningMacro(<< "Could not write metadata index " << m_IndexFileName);
+    itksys::SystemTools::RemoveFile( temporaryFileName.c_str() );
+    return;
+    }
+  if ( std::rename( temporaryFileName.c_str(), m_IndexFileName.c_str() ) != 0 )
+    {
+    // rename does not replace an existing file on Windows
+    itksys::SystemTools::RemoveFile( m_IndexFileName.c_str() );
+    if ( std::rename( temporaryFileName.c_str(), m_IndexFileName.c_str() ) != 0 )
+      {
+      itkWarningMacro(<< "Could not write metadata index " << m_IndexFileName);
+      itksys::SystemTools::RemoveFile( temporaryFileName.c_str() );
+      }
+    }
+}
+
+void GDCMMetaDataScanner::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "NumberOfFileNames: " << m_FileNames.size() << std::endl;
+  os << indent << "Tags:";
+  for ( TagSetType::const_iterator it = m_Tags.begin(); it != m_Tags.end(); ++it )
+    {
+    os << ' ' << it->PrintAsPipeSeparatedString();
+    }
+  os << std::endl;
+  os << indent << "IndexFileName: " << m_IndexFileName << std::endl;
+  os << indent << "NumberOfThreads: " << m_NumberOfThreads << std::endl;
+  os << indent << "NumberOfParsedFiles: " << m_NumberOfParsedFiles << std::endl;
+}
+} // end namespace itk
@@ -21,23 +21,42 @@
 #include "itkGDCMSeriesFileNames.h"
 #include "itksys/SystemTools.hxx"
 #include "itkProgressReporter.h"
+#include "gdcmDirectory.h"
 
 namespace itk
 {
+namespace
+{
+/** SerieHelper that also accepts headers read elsewhere. */
+class ScannedSerieHelper:public gdcm::SerieHelper
+{
+public:
+  void AddScannedFile(const gdcm::File & file, const std::string & filename)
+  {
+    gdcm::SmartPointer< gdcm::FileWithName > f =
+      new gdcm::FileWithName( const_cast< gdcm::File & >( file ) );
+    f->filename = filename;
+    this->AddFile(*f);
+  }
+};
+}
+
 GDCMSeriesFileNames::GDCMSeriesFileNames()
 {
-  m_SerieHelper = new gdcm::SerieHelper();
+  m_SerieHelper = new ScannedSerieHelper();
   m_InputDirectory = "";
   m_OutputDirectory = "";
   m_UseSeriesDetails = true;
   m_Recursive = false;
   m_LoadSequences = false;
   m_LoadPrivateTags = false;
+  m_UseMetaDataScanner = false;
+  m_MetaDataScanner = GDCMMetaDataScanner::New();
 }
 
 GDCMSeriesFileNames::~GDCMSeriesFileNames()
 {
-  delete m_SerieHelper;
+  delete static_cast< ScannedSerieHelper * >( m_SerieHelper );
 }
 
 void GDCMSeriesFileNames::SetInputDirectory(const char *name)
@@ -72,11 +91,60 @@ void GDCMSeriesFileNames::SetInputDirectory(std::string const & name)
   m_SerieHelper->SetUseSeriesDetails(m_UseSeriesDetails);
   m_SerieHelper->SetLoadMode( ( m_LoadSequences ? 0 : gdcm::LD_NOSEQ )
                               | ( m_LoadPrivateTags ? 0 : gdcm::LD_NOSHADOW ) );
-  m_SerieHelper->SetDirectory(name, m_Recursive);
+  if ( m_UseMetaDataScanner )
+    {
+    this->ScanDirectory(name);
+    }
+  else
+    {
+    m_SerieHelper->SetDirectory(name, m_Recursive);
+    }
   //as a side effect it also execute
   this->Modified();
 }
 
+void GDCMSeriesFileNames::ScanDirectory(const std::string & name)
+{
+  gdcm::Directory directory;
+  directory.Load(name, m_Recursive);
+
+  // Tags used by the SerieHelper to group and order the files
+  static const gdcm::Tag tags[] = {
+    gdcm::Tag(0x0008, 0x0016), // SOP Class UID
+    gdcm::Tag(0x0008, 0x0060), // Modality
+    gdcm::Tag(0x0018, 0x0024), // Sequence Name
+    gdcm::Tag(0x0018, 0x0050), // Slice Thickness
+    gdcm::Tag(0x0020, 0x000e), // Series Instance UID
+    gdcm::Tag(0x0020, 0x0011), // Series Number
+    gdcm::Tag(0x0020, 0x0032), // Image Position (Patient)
+    gdcm::Tag(0x0020, 0x0037), // Image Orientation (Patient)
+    gdcm::Tag(0x0054, 0x0022), // Detector Information Sequence
+    gdcm::Tag(0x5200, 0x9229), // Shared Functional Groups Sequence
+    gdcm::Tag(0x5200, 0x9230)  // Per-frame Functional Groups Sequence
+  };
+  for ( unsigned int i = 0; i < sizeof( tags ) / sizeof( tags[0] ); ++i )
+    {
+    m_MetaDataScanner->AddTag(tags[i]);
+    }
+
+  m_MetaDataScanner->SetFileNames( directory.GetFilenames() );
+  m_MetaDataScanner->SetIndexFileName(m_MetaDataIndexFileName);
+  m_MetaDataScanner->SetNumberOfThreads( this->GetNumberOfThreads() );
+  m_MetaDataScanner->Scan();
+
+  ScannedSerieHelper *helper = static_cast< ScannedSerieHelper * >( m_SerieHelper );
+  const GDCMMetaDataScanner::FileNamesContainerType & filenames =
+    m_MetaDataScanner->GetFileNames();
+  for ( SizeValueType i = 0; i < filenames.size(); ++i )
+    {
+    const gdcm::File *file = m_MetaDataScanner->GetFile(i);
+    if ( file )
+      {
+      helper->AddScannedFile(*file, filenames[i]);
+      }
+    }
+}
+
 const GDCMSeriesFileNames::SeriesUIDContainerType & GDCMSeriesFileNames::GetSeriesUIDs()
 {
   m_SeriesUIDs.clear();
@@ -278,6 +346,8 @@ void GDCMSeriesFileNames::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "InputDirectory: " << m_InputDirectory << std::endl;
   os << indent << "LoadSequences:" << m_LoadSequences << std::endl;
   os << indent << "LoadPrivateTags:" << m_LoadPrivateTags << std::endl;
+  os << indent << "UseMetaDataScanner:" << m_UseMetaDataScanner << std::endl;
+  os << indent << "MetaDataIndexFileName:" << m_MetaDataIndexFileName << std::endl;
   if ( m_Recursive )
     {
     os << indent << "Recursive: True" << std::endl;
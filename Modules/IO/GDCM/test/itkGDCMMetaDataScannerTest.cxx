@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageSeriesWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkGDCMImageIO.h"
+#include "itkGDCMSeriesFileNames.h"
+#include "itkGDCMMetaDataScanner.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+
+// Scan a series with GDCMSeriesFileNames with and without the metadata
+// scanner and check that the index avoids parsing unchanged files.
+int itkGDCMMetaDataScannerTest( int argc, char* argv[] )
+{
+  if( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " OutputDicomDirectory" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const std::string directory = argv[1];
+  const std::string indexFileName = directory + ".index";
+  const std::string textFileName = directory + "/notes.txt";
+
+  itksys::SystemTools::RemoveADirectory( directory.c_str() );
+  itksys::SystemTools::MakeDirectory( directory.c_str() );
+  itksys::SystemTools::RemoveFile( indexFileName.c_str() );
+
+  typedef signed short                       PixelType;
+  typedef itk::Image< PixelType, 3 >         ImageType;
+  typedef itk::Image< PixelType, 2 >         Image2DType;
+  typedef itk::GDCMSeriesFileNames           NamesType;
+  typedef NamesType::FileNamesContainerType  FileNamesType;
+
+  const unsigned int numberOfSlices = 6;
+
+  ImageType::SizeType size;
+  size[0] = 16;
+  size[1] = 12;
+  size[2] = numberOfSlices;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 0.5;
+  spacing[2] = 2.0;
+  ImageType::PointType origin;
+  origin[0] = 1.0;
+  origin[1] = 2.0;
+  origin[2] = 3.0;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->SetSpacing( spacing );
+  image->SetOrigin( origin );
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set( static_cast< PixelType >( index[0] + 16 * index[1] + 256 * index[2] ) );
+    }
+
+  FileNamesType sliceFileNames;
+  for( unsigned int k = 0; k < numberOfSlices; ++k )
+    {
+    std::ostringstream name;
+    name << directory << "/slice" << k << ".dcm";
+    sliceFileNames.push_back( name.str() );
+    }
+
+  typedef itk::ImageSeriesWriter< ImageType, Image2DType > SeriesWriterType;
+  SeriesWriterType::Pointer seriesWriter = SeriesWriterType::New();
+  seriesWriter->SetInput( image );
+  seriesWriter->SetImageIO( itk::GDCMImageIO::New() );
+  seriesWriter->SetFileNames( sliceFileNames );
+
+  TRY_EXPECT_NO_EXCEPTION( seriesWriter->Update() );
+
+  // Not a DICOM file, must be left out of the series.
+    {
+    std::ofstream text( textFileName.c_str() );
+    text << "not a DICOM file" << std::endl;
+    }
+
+  // Reference: every file read completely.
+  NamesType::Pointer reference = NamesType::New();
+  reference->SetDirectory( directory );
+  const FileNamesType expected = reference->GetInputFileNames();
+  const NamesType::SeriesUIDContainerType expectedUIDs = reference->GetSeriesUIDs();
+
+  // the slices are written as secondary captures, without a position,
+  // so the series is sorted by file name
+  if( expected != sliceFileNames )
+    {
+    std::cerr << "Unexpected reference series" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // The first scan parses all the files, the second one finds them in the
+  // index, the third one only parses the modified text file.
+  const itk::SizeValueType expectedParsedFiles[3] = { numberOfSlices + 1, 0, 1 };
+  for( unsigned int run = 0; run < 3; ++run )
+    {
+    if( run == 2 )
+      {
+      std::ofstream text( textFileName.c_str(), std::ios::app );
+      text << "modified" << std::endl;
+      }
+
+    NamesType::Pointer names = NamesType::New();
+    names->SetUseMetaDataScanner( true );
+    names->SetMetaDataIndexFileName( indexFileName );
+    names->SetNumberOfThreads( 3 );
+    names->SetDirectory( directory );
+
+    if( names->GetInputFileNames() != expected )
+      {
+      std::cerr << "Run " << run << ": series differs from the reference" << std::endl;
+      return EXIT_FAILURE;
+      }
+    if( names->GetSeriesUIDs() != expectedUIDs )
+      {
+      std::cerr << "Run " << run << ": series UIDs differ from the reference" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    const itk::SizeValueType parsed = names->GetMetaDataScanner()->GetNumberOfParsedFiles();
+    if( parsed != expectedParsedFiles[run] )
+      {
+      std::cerr << "Run " << run << ": parsed " << parsed << " files, expected "
+                << expectedParsedFiles[run] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // Direct use of the scanner.
+  itk::GDCMMetaDataScanner::Pointer scanner = itk::GDCMMetaDataScanner::New();
+  FileNamesType scannedFileNames = sliceFileNames;
+  scannedFileNames.push_back( textFileName );
+  scanner->SetFileNames( scannedFileNames );
+  scanner->AddTag( "0020|0013" ); // Instance Number
+  scanner->Scan();
+
+  std::cout << scanner << std::endl;
+
+  if( scanner->GetFile( numberOfSlices ) != ITK_NULLPTR )
+    {
+    std::cerr << "Text file reported as a DICOM image" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for( unsigned int k = 0; k < numberOfSlices; ++k )
+    {
+    if( scanner->GetFile( k ) == ITK_NULLPTR
+        || scanner->GetValue( k, gdcm::Tag( 0x0028, 0x0011 ) ) != "16" )
+      {
+      std::cerr << "Missing header for " << scannedFileNames[k] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // A file rewritten with the same length, most likely within the same
+  // second, is parsed again.
+  const std::string scannerIndexFileName = directory + ".scanner.index";
+  itksys::SystemTools::RemoveFile( scannerIndexFileName.c_str() );
+  scanner->SetIndexFileName( scannerIndexFileName );
+  scanner->Scan();
+    {
+    std::ofstream text( textFileName.c_str(), std::ios::in | std::ios::out );
+    text << "NOT";
+    }
+  scanner->Scan();
+  if( scanner->GetNumberOfParsedFiles() != 1 )
+    {
+    std::cerr << "Parsed " << scanner->GetNumberOfParsedFiles()
+              << " files after rewriting the text file, expected 1" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
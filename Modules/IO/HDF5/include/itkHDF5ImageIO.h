@@ -80,6 +80,12 @@ class MetaDataDictionary;
  *                             in the MetaDataDictionary
  * re-arrangement.
  *
+ * VoxelData is stored compressed in chunks. By default the chunks are
+ * cubic bricks with an edge of 64 pixels (clipped to the image size),
+ * so that sub-volumes can be read along any axis without decompressing
+ * whole slices. SetChunkSize() selects another chunk shape, and
+ * SetChunkCacheSize() sets the size of the HDF5 raw data chunk cache
+ * used when reading and writing the voxel data.
  *
  */
 
@@ -130,6 +136,36 @@ public:
    * that the IORegions has been set properly. */
   virtual void Write(const void *buffer) ITK_OVERRIDE;
 
+  /** Type of the chunk size: one chunk length per image dimension,
+   * fastest moving dimension first as in ITK. */
+  typedef std::vector< SizeValueType > ChunkSizeType;
+
+  /** Set/Get the size of the chunks of the voxel data that is written.
+   * Each length is clipped to the image size. An empty chunk size, the
+   * default, selects cubic bricks with an edge of 64 pixels. */
+  void SetChunkSize(const ChunkSizeType & chunkSize)
+  {
+    if ( this->m_ChunkSize != chunkSize )
+      {
+      this->m_ChunkSize = chunkSize;
+      this->Modified();
+      }
+  }
+  const ChunkSizeType & GetChunkSize() const
+  {
+    return this->m_ChunkSize;
+  }
+
+  /** Set/Get the size in bytes of the HDF5 raw data chunk cache used
+   * when reading and writing the voxel data. Zero, the default, keeps
+   * the HDF5 default, except for streamed writes which use a cache that
+   * holds one full layer of chunks along the slowest moving axis. When
+   * that layer is larger than 256 MiB, the streamed voxel data is
+   * written contiguously, without chunks or compression, rather than
+   * recompressing partially written chunks for every piece. */
+  itkSetMacro(ChunkCacheSize, SizeValueType);
+  itkGetConstMacro(ChunkCacheSize, SizeValueType);
+
 protected:
   HDF5ImageIO();
   ~HDF5ImageIO();
@@ -187,9 +223,24 @@ private:
                        unsigned long numElements);
   void SetupStreaming(H5::DataSpace *imageSpace,
                       H5::DataSpace *slabSpace);
+
+  /** Compute the chunk dimensions of the voxel data, listed slowest
+   * moving first as in the HDF5 dataspace. */
+  ChunkSizeType ComputeChunkDimensions() const;
+
+  /** Open or create the file with a chunk cache of the given size. */
+  void OpenFile(unsigned int flags, SizeValueType chunkCacheSize);
+
+  /** Size in bytes of one layer of chunks along the slowest moving
+   * axis, including the partial chunks at the image border. */
+  double ComputeChunkLayerSize() const;
+
+  ChunkSizeType m_ChunkSize;
+  SizeValueType m_ChunkCacheSize;
   H5::H5File  *m_H5File;
   H5::DataSet *m_VoxelDataSet;
   bool         m_ImageInformationWritten;
+  bool         m_ContiguousVoxelData;
 };
 } // end namespace itk
 
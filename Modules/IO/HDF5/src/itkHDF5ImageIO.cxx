@@ -22,12 +22,16 @@
 #include "itksys/SystemTools.hxx"
 #include "itk_H5Cpp.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
-HDF5ImageIO::HDF5ImageIO() : m_H5File(ITK_NULLPTR),
+HDF5ImageIO::HDF5ImageIO() : m_ChunkCacheSize(0),
+                             m_H5File(ITK_NULLPTR),
                              m_VoxelDataSet(ITK_NULLPTR),
-                             m_ImageInformationWritten(false)
+                             m_ImageInformationWritten(false),
+                             m_ContiguousVoxelData(false)
 {
 }
 
@@ -52,6 +56,13 @@ HDF5ImageIO
   Superclass::PrintSelf(os, indent);
   // just prints out the pointer value.
   os << indent << "H5File: " << this->m_H5File << std::endl;
+  os << indent << "ChunkSize: [";
+  for ( unsigned int i = 0; i < this->m_ChunkSize.size(); i++ )
+    {
+    os << ( i > 0 ? ", " : "" ) << this->m_ChunkSize[i];
+    }
+  os << "]" << std::endl;
+  os << indent << "ChunkCacheSize: " << this->m_ChunkCacheSize << std::endl;
 }
 
 //
@@ -696,8 +707,7 @@ HDF5ImageIO
 {
   try
     {
-    this->m_H5File = new H5::H5File(this->GetFileName(),
-                                    H5F_ACC_RDONLY);
+    this->OpenFile(H5F_ACC_RDONLY, this->m_ChunkCacheSize);
 
     // not sure what to do with this initially
     //eventually it will be needed if the file versions change
@@ -964,6 +974,80 @@ HDF5ImageIO
   delete[] offset;
 }
 
+HDF5ImageIO::ChunkSizeType
+HDF5ImageIO
+::ComputeChunkDimensions() const
+{
+  const unsigned int numDims = this->GetNumberOfDimensions();
+  const unsigned int numComponents = this->GetNumberOfComponents();
+
+  if(!this->m_ChunkSize.empty() && this->m_ChunkSize.size() != numDims)
+    {
+    itkExceptionMacro(<< "ChunkSize has " << this->m_ChunkSize.size()
+                      << " elements but the image has " << numDims
+                      << " dimensions");
+    }
+
+  // HDF5 dimensions listed slowest moving first, ITK are fastest
+  // moving first.
+  ChunkSizeType chunkDims(numDims + (numComponents > 1 ? 1 : 0));
+  for(unsigned int i = 0; i < numDims; i++)
+    {
+    SizeValueType chunkLength = 64;
+    if(!this->m_ChunkSize.empty())
+      {
+      chunkLength = this->m_ChunkSize[i];
+      }
+    chunkLength = std::max(static_cast<SizeValueType>(1),
+                           std::min(chunkLength, this->GetDimensions(i)));
+    chunkDims[numDims - i - 1] = chunkLength;
+    }
+  // keep the components of a voxel in the same chunk
+  if(numComponents > 1)
+    {
+    chunkDims[numDims] = numComponents;
+    }
+  return chunkDims;
+}
+
+double
+HDF5ImageIO
+::ComputeChunkLayerSize() const
+{
+  const unsigned int numDims = this->GetNumberOfDimensions();
+  const ChunkSizeType chunkDims = this->ComputeChunkDimensions();
+
+  // the chunks at the border of the image are cached whole
+  double layerSize = static_cast<double>(this->GetComponentSize())
+    * this->GetNumberOfComponents() * chunkDims[0];
+  for(unsigned int i = 0; i + 1 < numDims; i++)
+    {
+    const SizeValueType chunkLength = chunkDims[numDims - i - 1];
+    const SizeValueType numberOfChunks =
+      (this->GetDimensions(i) + chunkLength - 1) / chunkLength;
+    layerSize *= static_cast<double>(numberOfChunks * chunkLength);
+    }
+  return layerSize;
+}
+
+void
+HDF5ImageIO
+::OpenFile(unsigned int flags, SizeValueType chunkCacheSize)
+{
+  H5::FileAccPropList fapl;
+  if(chunkCacheSize > 0)
+    {
+    // the number of hash slots should be a prime number much larger
+    // than the number of chunks that fit in the cache; the metadata
+    // cache element count is ignored by HDF5 1.8.
+    fapl.setCache(0, 10007, chunkCacheSize, 0.75);
+    }
+  this->m_H5File = new H5::H5File(this->GetFileName(),
+                                  flags,
+                                  H5::FileCreatPropList::DEFAULT,
+                                  fapl);
+}
+
 void
 HDF5ImageIO
 ::Read(void *buffer)
@@ -1045,8 +1129,27 @@ HDF5ImageIO
 
   try
     {
-    this->m_H5File = new H5::H5File(this->GetFileName(),
-                                    H5F_ACC_TRUNC);
+    SizeValueType chunkCacheSize = this->m_ChunkCacheSize;
+    this->m_ContiguousVoxelData = false;
+    if(chunkCacheSize == 0 && this->GetUseStreamedWriting())
+      {
+      // The writer splits the image along the slowest moving axis, so
+      // the cache must hold one full layer of chunks: otherwise the
+      // partially written chunks are evicted, then read back and
+      // recompressed for every piece. When that layer is too large to
+      // be cached, the voxel data is written contiguously instead.
+      const double maximumChunkCacheSize = 256.0 * 1024.0 * 1024.0;
+      const double chunkLayerSize = this->ComputeChunkLayerSize();
+      if(chunkLayerSize <= maximumChunkCacheSize)
+        {
+        chunkCacheSize = static_cast<SizeValueType>(chunkLayerSize);
+        }
+      else
+        {
+        this->m_ContiguousVoxelData = true;
+        }
+      }
+    this->OpenFile(H5F_ACC_TRUNC, chunkCacheSize);
     this->WriteString(ItkVersion,
                       Version::GetITKVersion());
 
@@ -1270,12 +1373,17 @@ HDF5ImageIO
     VoxelDataName += "/0";
     VoxelDataName += VoxelData;
     // set up properties for chunked, compressed writes.
-    // in this case, set the chunk size to be the N-1 dimension
-    // region
+    const ChunkSizeType chunkSize = this->ComputeChunkDimensions();
+    for(int i = 0; i < numDims; i++)
+      {
+      dims[i] = chunkSize[i];
+      }
     H5::DSetCreatPropList plist;
-    plist.setDeflate(5);
-    dims[0] = 1;
-    plist.setChunk(numDims,dims);
+    if(!this->m_ContiguousVoxelData)
+      {
+      plist.setDeflate(5);
+      plist.setChunk(numDims,dims);
+      }
 
     //
     // Create DataSet Once, potentially write to it many times
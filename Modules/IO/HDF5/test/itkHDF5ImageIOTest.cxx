@@ -320,6 +320,82 @@ int HDF5ReadWriteTest(const char *fileName)
   return success;
 }
 
+int HDF5ChunkedReadWriteTest(const char *fileName)
+{
+  typedef itk::Image<unsigned short,3> ImageType;
+  ImageType::RegionType imageRegion;
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 21;
+  size[2] = 9;
+  imageRegion.SetSize(size);
+  ImageType::SpacingType spacing;
+  spacing.Fill(1.0);
+  ImageType::Pointer im =
+    itk::IOTestHelper::AllocateImageFromRegionAndSpacing<ImageType>(imageRegion,spacing);
+
+  vnl_random randgen(12345678);
+  itk::ImageRegionIterator<ImageType> it(im,im->GetLargestPossibleRegion());
+  for(it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+    ImageType::PixelType pix;
+    itk::IOTestHelper::RandomPix(randgen,pix);
+    it.Set(pix);
+    }
+
+  // chunks that do not divide the image evenly, and one larger than
+  // the image along the slowest axis
+  itk::HDF5ImageIO::ChunkSizeType chunkSize(3);
+  chunkSize[0] = 16;
+  chunkSize[1] = 8;
+  chunkSize[2] = 16;
+
+  ImageType::Pointer im2;
+  try
+    {
+    itk::HDF5ImageIO::Pointer writeIO = itk::HDF5ImageIO::New();
+    writeIO->SetChunkSize(chunkSize);
+    writeIO->SetChunkCacheSize(1024 * 1024);
+
+    typedef itk::ImageFileWriter<ImageType> WriterType;
+    WriterType::Pointer writer = WriterType::New();
+    writer->SetImageIO(writeIO);
+    writer->SetFileName(fileName);
+    writer->SetInput(im);
+    writer->Update();
+
+    itk::HDF5ImageIO::Pointer readIO = itk::HDF5ImageIO::New();
+    readIO->SetChunkCacheSize(1024 * 1024);
+
+    typedef itk::ImageFileReader<ImageType> ReaderType;
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetImageIO(readIO);
+    reader->SetFileName(fileName);
+    reader->Update();
+    im2 = reader->GetOutput();
+    }
+  catch(itk::ExceptionObject &err)
+    {
+    std::cout << "itkHDF5ImageIOTest" << std::endl
+              << "Exception Object caught: " << std::endl
+              << err << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageRegionIterator<ImageType> it2(im2,im2->GetLargestPossibleRegion());
+  for(it.GoToBegin(),it2.GoToBegin(); !it.IsAtEnd() && !it2.IsAtEnd(); ++it,++it2)
+    {
+    if(it.Value() != it2.Value())
+      {
+      std::cout << "Original Pixel (" << it.Value()
+                << ") doesn't match read-in Pixel ("
+                << it2.Value() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
 int
 itkHDF5ImageIOTest(int ac, char * av [] )
 {
@@ -336,5 +412,6 @@ itkHDF5ImageIOTest(int ac, char * av [] )
   result += HDF5ReadWriteTest<unsigned char>("UCharImage.hdf5");
   result += HDF5ReadWriteTest<float>("FloatImage.hdf5");
   result += HDF5ReadWriteTest<itk::RGBPixel<unsigned char> >("RGBImage.hdf5");
+  result += HDF5ChunkedReadWriteTest("ChunkedImage.hdf5");
   return result != 0;
 }
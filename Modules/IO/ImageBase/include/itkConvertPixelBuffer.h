@@ -20,6 +20,7 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkObject.h"
+#include "itkMultiThreader.h"
 #include "itkNumericTraits.h"
 
 namespace itk
@@ -35,6 +36,10 @@ namespace itk
  * OutputConvertTraits() is the traits class.  The default one used is
  * DefaultConvertPixelTraits.
  *
+ * Every output pixel only depends on the input pixel at the same
+ * position, so large buffers are split in contiguous ranges of pixels
+ * that are converted by several threads.
+ *
  * \ingroup ITKIOImageBase
  */
 template<
@@ -57,7 +62,20 @@ public:
                                  int inputNumberOfComponents,
                                  OutputPixelType *outputData, size_t size);
 
+  /** Buffers with fewer pixels than this, times the number of
+   * threads, are converted on the calling thread only. */
+  itkStaticConstMacro(MinimumNumberOfPixelsPerThread, size_t, 1 << 16);
+
 protected:
+  /** Convert size pixels on the calling thread. */
+  static void ConvertRange(InputPixelType *inputData,
+                           int inputNumberOfComponents,
+                           OutputPixelType *outputData, size_t size);
+
+  static void ConvertVectorImageRange(InputPixelType *inputData,
+                                      int inputNumberOfComponents,
+                                      OutputPixelType *outputData, size_t size);
+
   /** Convert to Gray output. */
   /** Input values are cast to output values. */
   static void ConvertGrayToGray(InputPixelType *inputData,
@@ -147,6 +165,24 @@ private:
   ConvertPixelBuffer();
   ~ConvertPixelBuffer();
 
+  /** Split size pixels over the threads and convert them with
+   * ConvertRange or ConvertVectorImageRange. */
+  static void ThreadedConvert(InputPixelType *inputData,
+                              int inputNumberOfComponents,
+                              OutputPixelType *outputData, size_t size,
+                              bool vectorImage);
+
+  struct ThreadStruct
+  {
+    InputPixelType  *InputData;
+    int              InputNumberOfComponents;
+    OutputPixelType *OutputData;
+    size_t           Size;
+    bool             VectorImage;
+  };
+
+  static ITK_THREAD_RETURN_TYPE ConvertThreaderCallback(void *arg);
+
   /** the most common case, where InputComponentType == unsigned
    *  char, the alpha is in the range 0..255. I presume in the
    *  mythical world of rgba<X> for all integral scalar types X, alpha
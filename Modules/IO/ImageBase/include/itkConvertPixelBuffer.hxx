@@ -34,6 +34,106 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::Convert(InputPixelType *inputData,
           int inputNumberOfComponents,
           OutputPixelType *outputData, size_t size)
+{
+  ThreadedConvert(inputData, inputNumberOfComponents, outputData, size, false);
+}
+
+template< typename InputPixelType,
+          typename OutputPixelType,
+          typename OutputConvertTraits
+          >
+void
+ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
+::ConvertVectorImage(InputPixelType *inputData,
+                     int inputNumberOfComponents,
+                     OutputPixelType *outputData, size_t size)
+{
+  ThreadedConvert(inputData, inputNumberOfComponents, outputData, size, true);
+}
+
+template< typename InputPixelType,
+          typename OutputPixelType,
+          typename OutputConvertTraits
+          >
+void
+ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
+::ThreadedConvert(InputPixelType *inputData,
+                  int inputNumberOfComponents,
+                  OutputPixelType *outputData, size_t size,
+                  bool vectorImage)
+{
+  ThreadIdType numberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
+  if ( size / MinimumNumberOfPixelsPerThread < numberOfThreads )
+    {
+    numberOfThreads = static_cast< ThreadIdType >( size / MinimumNumberOfPixelsPerThread );
+    }
+
+  if ( numberOfThreads <= 1 )
+    {
+    if ( vectorImage )
+      {
+      ConvertVectorImageRange(inputData, inputNumberOfComponents, outputData, size);
+      }
+    else
+      {
+      ConvertRange(inputData, inputNumberOfComponents, outputData, size);
+      }
+    return;
+    }
+
+  ThreadStruct str;
+  str.InputData = inputData;
+  str.InputNumberOfComponents = inputNumberOfComponents;
+  str.OutputData = outputData;
+  str.Size = size;
+  str.VectorImage = vectorImage;
+
+  MultiThreader::Pointer threader = MultiThreader::New();
+  threader->SetNumberOfThreads(numberOfThreads);
+  threader->SetSingleMethod(ConvertThreaderCallback, &str);
+  threader->SingleMethodExecute();
+}
+
+template< typename InputPixelType,
+          typename OutputPixelType,
+          typename OutputConvertTraits
+          >
+ITK_THREAD_RETURN_TYPE
+ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
+::ConvertThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const ThreadStruct *str = static_cast< const ThreadStruct * >( info->UserData );
+
+  // contiguous range of pixels converted by this thread
+  const size_t begin = str->Size * info->ThreadID / info->NumberOfThreads;
+  const size_t end = str->Size * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  const size_t inputOffset = begin * static_cast< size_t >( str->InputNumberOfComponents );
+
+  if ( str->VectorImage )
+    {
+    // the output holds the same number of components per pixel
+    ConvertVectorImageRange(str->InputData + inputOffset, str->InputNumberOfComponents,
+                            str->OutputData + inputOffset, end - begin);
+    }
+  else
+    {
+    ConvertRange(str->InputData + inputOffset, str->InputNumberOfComponents,
+                 str->OutputData + begin, end - begin);
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename InputPixelType,
+          typename OutputPixelType,
+          typename OutputConvertTraits
+          >
+void
+ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
+::ConvertRange(InputPixelType *inputData,
+               int inputNumberOfComponents,
+               OutputPixelType *outputData, size_t size)
 {
   switch ( OutputConvertTraits::GetNumberOfComponents() )
     {
@@ -145,6 +245,9 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
     }
 }
 
+// The per-pixel loops below are counted loops indexed by pixel so that the
+// compiler knows the trip count and can vectorize them.
+
 template< typename InputPixelType,
           typename OutputPixelType,
           typename OutputConvertTraits
@@ -154,14 +257,13 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToGray(InputPixelType *inputData,
                     OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
+  const InputPixelType *input = inputData;
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData++,
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
+                                          ( input[i] ) );
     }
 }
 
@@ -179,16 +281,14 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
   // NOTE: The scale factors are converted to whole numbers for precision
 
-  InputPixelType *endInput = inputData + size * 3;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
+    const InputPixelType *pixel = inputData + 3 * i;
     OutputComponentType val = static_cast< OutputComponentType >(
-      ( 2125.0 * static_cast< OutputComponentType >( *inputData )
-        + 7154.0 * static_cast< OutputComponentType >( *( inputData + 1 ) )
-        + 0721.0 * static_cast< OutputComponentType >( *( inputData + 2 ) ) ) / 10000.0 );
-    inputData += 3;
-    OutputConvertTraits::SetNthComponent(0, *outputData++, val);
+      ( 2125.0 * static_cast< OutputComponentType >( pixel[0] )
+        + 7154.0 * static_cast< OutputComponentType >( pixel[1] )
+        + 0721.0 * static_cast< OutputComponentType >( pixel[2] ) ) / 10000.0 );
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
     }
 }
 
@@ -206,7 +306,6 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
   // NOTE: The scale factors are converted to whole numbers for
   // precision
-  InputPixelType *endInput = inputData + size * 4;
   double maxAlpha(Self::MaxAlpha(*inputData));
   //
   // To be backwards campatible, if the output pixel type
@@ -215,20 +314,20 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
     {
     maxAlpha = 1.0;
     }
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
     // this is an ugly implementation of the simple equation
     // greval = (.2125 * red + .7154 * green + .0721 * blue) / alpha
     //
+    const InputPixelType *pixel = inputData + 4 * i;
     double tempval =
-      ((2125.0 * static_cast< double >( * inputData)
-        + 7154.0 * static_cast< double >( *( inputData + 1 ))
-        + 0721.0 * static_cast< double >( *( inputData + 2 ))) / 10000.0)
-      * static_cast< double >(*( inputData + 3))
+      ((2125.0 * static_cast< double >( pixel[0] )
+        + 7154.0 * static_cast< double >( pixel[1] )
+        + 0721.0 * static_cast< double >( pixel[2] )) / 10000.0)
+      * static_cast< double >( pixel[3] )
       / maxAlpha;
-    inputData += 4;
     OutputComponentType val = static_cast< OutputComponentType >( tempval );
-    OutputConvertTraits::SetNthComponent(0, *outputData++, val);
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
     }
 }
 
@@ -253,15 +352,13 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // 2 components assumed intensity and alpha
   if ( inputNumberOfComponents == 2 )
     {
-    InputPixelType *endInput = inputData + size * 2;
-    while ( inputData != endInput )
+    for ( size_t i = 0; i < size; ++i )
       {
+      const InputPixelType *pixel = inputData + 2 * i;
       OutputComponentType val =
-        static_cast< OutputComponentType >( *inputData )
-        * static_cast< OutputComponentType >( *( inputData + 1 )
-                                              / maxAlpha);
-      inputData += 2;
-      OutputConvertTraits::SetNthComponent(0, *outputData++, val);
+        static_cast< OutputComponentType >( pixel[0] )
+        * static_cast< OutputComponentType >( pixel[1] / maxAlpha );
+      OutputConvertTraits::SetNthComponent(0, outputData[i], val);
       }
     }
   // just skip the rest of the data
@@ -272,20 +369,18 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
     // http://www.poynton.com/notes/colour_and_gamma/ColorFAQ.html
     // NOTE: The scale factors are converted to whole numbers for
     // precision
-    ptrdiff_t       diff = inputNumberOfComponents - 4;
-    InputPixelType *endInput = inputData + size * (size_t)inputNumberOfComponents;
-    while ( inputData != endInput )
+    const size_t stride = static_cast< size_t >( inputNumberOfComponents );
+    for ( size_t i = 0; i < size; ++i )
       {
+      const InputPixelType *pixel = inputData + stride * i;
       double tempval =
-        ((2125.0 * static_cast< double >( *inputData )
-          + 7154.0 * static_cast< double >( *( inputData + 1 ) )
-          + 0721.0 * static_cast< double >( *( inputData + 2 ) ) ) / 10000.0)
-        * static_cast< double >(*( inputData + 3 ))
+        ((2125.0 * static_cast< double >( pixel[0] )
+          + 7154.0 * static_cast< double >( pixel[1] )
+          + 0721.0 * static_cast< double >( pixel[2] ) ) / 10000.0)
+        * static_cast< double >( pixel[3] )
         / maxAlpha;
-    inputData += 4;
-    OutputComponentType val = static_cast< OutputComponentType >( tempval );
-    OutputConvertTraits::SetNthComponent(0, *outputData++, val);
-    inputData += diff;
+      OutputComponentType val = static_cast< OutputComponentType >( tempval );
+      OutputConvertTraits::SetNthComponent(0, outputData[i], val);
       }
     }
 }
@@ -299,21 +394,13 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToRGB(InputPixelType *inputData,
                    OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
-    outputData++;
+    const OutputComponentType val =
+      static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(1, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(2, outputData[i], val);
     }
 }
 
@@ -326,21 +413,18 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBToRGB(InputPixelType *inputData,
                   OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 3;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
+    const InputPixelType *pixel = inputData + 3 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                          ( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                          ( pixel[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    inputData += 3;
-    outputData++;
+                                          ( pixel[2] ) );
     }
 }
 
@@ -353,22 +437,19 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBAToRGB(InputPixelType *inputData,
                    OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 4;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
+    // skip alpha
+    const InputPixelType *pixel = inputData + 4 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                          ( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                          ( pixel[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    inputData += 3;
-    inputData++; // skip alpha
-    outputData++;
+                                          ( pixel[2] ) );
     }
 }
 
@@ -386,38 +467,33 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // assume intensity alpha
   if ( inputNumberOfComponents == 2 )
     {
-    InputPixelType *endInput = inputData + size * 2;
-    while ( inputData != endInput )
+    for ( size_t i = 0; i < size; ++i )
       {
+      const InputPixelType *pixel = inputData + 2 * i;
       OutputComponentType val =
-        static_cast< OutputComponentType >( *inputData )
-        * static_cast< OutputComponentType >( *( inputData + 1 ) );
-      inputData += 2;
-      OutputConvertTraits::SetNthComponent(0, *outputData, val);
-      OutputConvertTraits::SetNthComponent(1, *outputData, val);
-      OutputConvertTraits::SetNthComponent(2, *outputData, val);
-      outputData++;
+        static_cast< OutputComponentType >( pixel[0] )
+        * static_cast< OutputComponentType >( pixel[1] );
+      OutputConvertTraits::SetNthComponent(0, outputData[i], val);
+      OutputConvertTraits::SetNthComponent(1, outputData[i], val);
+      OutputConvertTraits::SetNthComponent(2, outputData[i], val);
       }
     }
   // just skip the rest of the data
   else
     {
-    ptrdiff_t       diff = inputNumberOfComponents - 3;
-    InputPixelType *endInput = inputData + size * (size_t)inputNumberOfComponents;
-    while ( inputData != endInput )
+    const size_t stride = static_cast< size_t >( inputNumberOfComponents );
+    for ( size_t i = 0; i < size; ++i )
       {
-      OutputConvertTraits::SetNthComponent( 0, *outputData,
+      const InputPixelType *pixel = inputData + stride * i;
+      OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *inputData ) );
-      OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                            ( pixel[0] ) );
+      OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *( inputData + 1 ) ) );
-      OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                            ( pixel[1] ) );
+      OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *( inputData + 2 ) ) );
-      inputData += 3;
-      inputData += diff;
-      outputData++;
+                                            ( pixel[2] ) );
       }
     }
 }
@@ -432,24 +508,16 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
                     OutputPixelType *outputData, size_t size)
 
 {
-  InputPixelType *endInput = inputData + size;
+  const OutputComponentType alpha = static_cast< OutputComponentType >( 1 );
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( 1 ) );
-    inputData++;
-    outputData++;
+    const OutputComponentType val =
+      static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(1, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(2, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(3, outputData[i], alpha);
     }
 }
 
@@ -462,24 +530,21 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBToRGBA(InputPixelType *inputData,
                    OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 3;
+  const OutputComponentType alpha = static_cast< OutputComponentType >( 1 );
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
+    const InputPixelType *pixel = inputData + 3 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                          ( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                          ( pixel[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( 1 ) );
-    inputData += 3;
-    outputData++;
+                                          ( pixel[2] ) );
+    OutputConvertTraits::SetNthComponent(3, outputData[i], alpha);
     }
 }
 
@@ -492,24 +557,21 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertRGBAToRGBA(InputPixelType *inputData,
                     OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 4;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
+    const InputPixelType *pixel = inputData + 4 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                          ( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                          ( pixel[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
+                                          ( pixel[2] ) );
+    OutputConvertTraits::SetNthComponent( 3, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 3 ) ) );
-    inputData += 4;
-    outputData++;
+                                          ( pixel[3] ) );
     }
 }
 
@@ -527,39 +589,35 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
   // equal weights for 2 components??
   if ( inputNumberOfComponents == 2 )
     {
-    InputPixelType *endInput = inputData + size * 2;
-    while ( inputData != endInput )
+    for ( size_t i = 0; i < size; ++i )
       {
-      OutputComponentType val = static_cast< OutputComponentType >( *inputData );
-      OutputComponentType alpha = static_cast< OutputComponentType >( *( inputData + 1 ) );
-      inputData += 2;
-      OutputConvertTraits::SetNthComponent(0, *outputData, val);
-      OutputConvertTraits::SetNthComponent(1, *outputData, val);
-      OutputConvertTraits::SetNthComponent(2, *outputData, val);
-      OutputConvertTraits::SetNthComponent(3, *outputData, alpha);
+      const InputPixelType *pixel = inputData + 2 * i;
+      OutputComponentType val = static_cast< OutputComponentType >( pixel[0] );
+      OutputComponentType alpha = static_cast< OutputComponentType >( pixel[1] );
+      OutputConvertTraits::SetNthComponent(0, outputData[i], val);
+      OutputConvertTraits::SetNthComponent(1, outputData[i], val);
+      OutputConvertTraits::SetNthComponent(2, outputData[i], val);
+      OutputConvertTraits::SetNthComponent(3, outputData[i], alpha);
       }
     }
   else
     {
-    ptrdiff_t       diff = inputNumberOfComponents - 4;
-    InputPixelType *endInput = inputData + size * (size_t)inputNumberOfComponents;
-    while ( inputData != endInput )
+    const size_t stride = static_cast< size_t >( inputNumberOfComponents );
+    for ( size_t i = 0; i < size; ++i )
       {
-      OutputConvertTraits::SetNthComponent( 0, *outputData,
+      const InputPixelType *pixel = inputData + stride * i;
+      OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *inputData ) );
-      OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                            ( pixel[0] ) );
+      OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *( inputData + 1 ) ) );
-      OutputConvertTraits::SetNthComponent( 2, *outputData,
+                                            ( pixel[1] ) );
+      OutputConvertTraits::SetNthComponent( 2, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *( inputData + 2 ) ) );
-      OutputConvertTraits::SetNthComponent( 3, *outputData,
+                                            ( pixel[2] ) );
+      OutputConvertTraits::SetNthComponent( 3, outputData[i],
                                             static_cast< OutputComponentType >
-                                            ( *( inputData + 3 ) ) );
-      inputData += 4;
-      inputData += diff;
-      outputData++;
+                                            ( pixel[3] ) );
       }
     }
 }
@@ -574,20 +632,12 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 {
   for ( size_t i = 0; i < size; i++ )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast< OutputComponentType >( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-                                          static_cast< OutputComponentType >( *( inputData + 3 ) ) );
-    OutputConvertTraits::SetNthComponent( 4, *outputData,
-                                          static_cast< OutputComponentType >( *( inputData + 4 ) ) );
-    OutputConvertTraits::SetNthComponent( 5, *outputData,
-                                          static_cast< OutputComponentType >( *( inputData + 5 ) ) );
-    ++outputData;
-    inputData += 6;
+    const InputPixelType *pixel = inputData + 6 * i;
+    for ( int c = 0; c < 6; ++c )
+      {
+      OutputConvertTraits::SetNthComponent( c, outputData[i],
+                                            static_cast< OutputComponentType >( pixel[c] ) );
+      }
     }
 }
 
@@ -602,18 +652,12 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertGrayToComplex(InputPixelType *inputData,
                        OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    inputData++;
-    outputData++;
+    const OutputComponentType val =
+      static_cast< OutputComponentType >( inputData[i] );
+    OutputConvertTraits::SetNthComponent(0, outputData[i], val);
+    OutputConvertTraits::SetNthComponent(1, outputData[i], val);
     }
 }
 
@@ -626,20 +670,17 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 ::ConvertComplexToComplex(InputPixelType *inputData,
                           OutputPixelType *outputData, size_t size)
 {
-  InputPixelType *endInput = inputData + size * 2;
-
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
+    const InputPixelType *pixel = inputData + 2 * i;
     OutputConvertTraits::SetNthComponent(
-      0, *outputData,
+      0, outputData[i],
       static_cast< OutputComponentType >
-      ( *inputData ) );
+      ( pixel[0] ) );
     OutputConvertTraits::SetNthComponent(
-      1, *outputData,
+      1, outputData[i],
       static_cast< OutputComponentType >
-      ( *( inputData + 1 ) ) );
-    inputData += 2;
-    outputData++;
+      ( pixel[1] ) );
     }
 }
 
@@ -653,20 +694,19 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
 {
   for ( size_t i = 0; i < size; i++ )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast<  OutputComponentType >( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
-                                          static_cast<  OutputComponentType >( *( inputData + 1 ) ) );
-    OutputConvertTraits::SetNthComponent( 2, *outputData,
-                                          static_cast<  OutputComponentType >( *( inputData + 2 ) ) );
-    OutputConvertTraits::SetNthComponent( 3, *outputData,
-                                          static_cast<  OutputComponentType >( *( inputData + 4 ) ) );
-    OutputConvertTraits::SetNthComponent( 4, *outputData,
-                                          static_cast<  OutputComponentType >( *( inputData + 5 ) ) );
-    OutputConvertTraits::SetNthComponent( 5, *outputData,
-                                          static_cast<  OutputComponentType >( *( inputData + 8 ) ) );
-    ++outputData;
-    inputData += 9;
+    const InputPixelType *pixel = inputData + 9 * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[1] ) );
+    OutputConvertTraits::SetNthComponent( 2, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[2] ) );
+    OutputConvertTraits::SetNthComponent( 3, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[4] ) );
+    OutputConvertTraits::SetNthComponent( 4, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[5] ) );
+    OutputConvertTraits::SetNthComponent( 5, outputData[i],
+                                          static_cast<  OutputComponentType >( pixel[8] ) );
     }
 }
 
@@ -681,20 +721,17 @@ ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
                                  OutputPixelType *outputData,
                                  size_t size)
 {
-  ptrdiff_t       diff = inputNumberOfComponents - 2;
-  InputPixelType *endInput = inputData + size * (size_t)inputNumberOfComponents;
+  const size_t stride = static_cast< size_t >( inputNumberOfComponents );
 
-  while ( inputData != endInput )
+  for ( size_t i = 0; i < size; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
+    const InputPixelType *pixel = inputData + stride * i;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *inputData ) );
-    OutputConvertTraits::SetNthComponent( 1, *outputData,
+                                          ( pixel[0] ) );
+    OutputConvertTraits::SetNthComponent( 1, outputData[i],
                                           static_cast< OutputComponentType >
-                                          ( *( inputData + 1 ) ) );
-    inputData += 2;
-    inputData += diff;
-    outputData++;
+                                          ( pixel[1] ) );
     }
 }
 
@@ -703,18 +740,17 @@ template< typename InputPixelType,
           typename OutputConvertTraits >
 void
 ConvertPixelBuffer< InputPixelType, OutputPixelType, OutputConvertTraits >
-::ConvertVectorImage(InputPixelType *inputData,
-                     int inputNumberOfComponents,
-                     OutputPixelType *outputData, size_t size)
+::ConvertVectorImageRange(InputPixelType *inputData,
+                          int inputNumberOfComponents,
+                          OutputPixelType *outputData, size_t size)
 {
-  size_t length = size * (size_t)inputNumberOfComponents;
+  const InputPixelType *input = inputData;
+  const size_t          length = size * (size_t)inputNumberOfComponents;
 
-  for ( size_t i = 0; i < length; i++ )
+  for ( size_t i = 0; i < length; ++i )
     {
-    OutputConvertTraits::SetNthComponent( 0, *outputData,
-                                          static_cast<  OutputComponentType >( *inputData ) );
-    ++outputData;
-    ++inputData;
+    OutputConvertTraits::SetNthComponent( 0, outputData[i],
+                                          static_cast<  OutputComponentType >( input[i] ) );
     }
 }
 } // end namespace itk
@@ -21,6 +21,7 @@
 
 #include "itkProcessObject.h"
 #include "itkImageIOBase.h"
+#include "itkConditionVariable.h"
 #include "itkMacro.h"
 
 namespace itk
@@ -70,6 +71,12 @@ public:
  * with a suitable suffix (".png", ".jpg", etc) and setting the input
  * to the writer is enough to get the writer to work properly.
  *
+ * When the image is streamed in more than one piece and
+ * UsePipelinedWriting is on, each piece is handed to a separate
+ * thread that writes it with the ImageIO while the upstream pipeline
+ * computes the next piece. Two piece buffers are used alternately, so
+ * at most two pieces are in memory besides the upstream output.
+ *
  * \sa ImageSeriesReader
  * \sa ImageIOBase
  *
@@ -158,6 +165,13 @@ public:
   itkSetMacro(NumberOfStreamDivisions, unsigned int);
   itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
 
+  /** Set/Get whether streamed pieces are written on a separate thread
+   * while the next piece is computed upstream. This only has an effect
+   * when the image is written in more than one piece. Off by default. */
+  itkSetMacro(UsePipelinedWriting, bool);
+  itkGetConstReferenceMacro(UsePipelinedWriting, bool);
+  itkBooleanMacro(UsePipelinedWriting);
+
   /** Aliased to the Write() method to be consistent with the rest of the
    * pipeline. */
   virtual void Update() ITK_OVERRIDE
@@ -220,6 +234,28 @@ private:
   bool m_UseInputMetaDataDictionary;        // whether to use the
                                             // MetaDataDictionary from the
                                             // input or not.
+  bool m_UsePipelinedWriting;
+
+  /** Stream the pieces through the upstream pipeline while a separate
+   * thread writes the previously computed piece. */
+  void WritePiecesPipelined(const std::vector< ImageIORegion > & pieces);
+
+  /** Write the queued pieces in order. Run by the writing thread. */
+  void WriteQueuedPieces();
+
+  static ITK_THREAD_RETURN_TYPE WritePiecesThreaderCallback(void *arg);
+
+  // Double buffered pieces handed to the writing thread. Piece k uses
+  // slot k % 2.
+  InputImagePointer          m_PieceImage[2];
+  ImageIORegion              m_PieceIORegion[2];
+  bool                       m_PieceQueued[2];
+  bool                       m_NoMorePieces;
+  bool                       m_PieceWriteFailed;
+  ExceptionObject            m_PieceWriteException;
+  SimpleMutexLock            m_PieceLock;
+  ConditionVariable::Pointer m_PieceQueuedCondition;
+  ConditionVariable::Pointer m_PieceWrittenCondition;
 };
 } // end namespace itk
 
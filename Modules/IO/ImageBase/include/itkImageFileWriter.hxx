@@ -32,6 +32,7 @@
 #include "itkDiffusionTensor3D.h"
 #include "itkMatrix.h"
 #include "itkImageAlgorithm.h"
+#include "itkMultiThreader.h"
 #include <complex>
 
 namespace itk
@@ -48,6 +49,13 @@ ImageFileWriter< TInputImage >
   m_UserSpecifiedIORegion = false;
   m_UserSpecifiedImageIO = false;
   m_NumberOfStreamDivisions = 1;
+  m_UsePipelinedWriting = false;
+  m_PieceQueued[0] = false;
+  m_PieceQueued[1] = false;
+  m_NoMorePieces = false;
+  m_PieceWriteFailed = false;
+  m_PieceQueuedCondition = ConditionVariable::New();
+  m_PieceWrittenCondition = ConditionVariable::New();
 }
 
 //---------------------------------------------------------
@@ -299,70 +307,93 @@ ImageFileWriter< TInputImage >
                                                               pasteIORegion,
                                                               largestIORegion);
 
-  /**
-   * Loop over the number of pieces, execute the upstream pipeline on each
-   * piece, and copy the results into the output image.
-   */
-  unsigned int piece;
-
-  for ( piece = 0;
-        piece < numDivisions && !this->GetAbortGenerateData();
-        piece++ )
+  if ( m_UsePipelinedWriting && numDivisions > 1 )
     {
-    // get the actual piece to write
-    ImageIORegion streamIORegion = m_ImageIO->GetSplitRegionForWriting(piece, numDivisions,
-                                                                       pasteIORegion, largestIORegion);
-
-    // Check whether the paste region is fully contained inside the
-    // largest region or not.
-    if ( !pasteIORegion.IsInside(streamIORegion) )
+    // Compute all the pieces now, the ImageIO then belongs to the
+    // writing thread.
+    std::vector< ImageIORegion > pieces;
+    for ( unsigned int piece = 0; piece < numDivisions; piece++ )
       {
-      itkExceptionMacro(
-        << "ImageIO returns streamable region that is not fully contain in paste IO region"
-        << "Paste IO region: " << pasteIORegion
-        << "Streamable region: " << streamIORegion);
+      ImageIORegion streamIORegion = m_ImageIO->GetSplitRegionForWriting(piece, numDivisions,
+                                                                         pasteIORegion, largestIORegion);
+      if ( !pasteIORegion.IsInside(streamIORegion) )
+        {
+        itkExceptionMacro(
+          << "ImageIO returns streamable region that is not fully contain in paste IO region"
+          << "Paste IO region: " << pasteIORegion
+          << "Streamable region: " << streamIORegion);
+        }
+      pieces.push_back(streamIORegion);
       }
+    this->WritePiecesPipelined(pieces);
+    }
+  else
+    {
+    /**
+     * Loop over the number of pieces, execute the upstream pipeline on each
+     * piece, and copy the results into the output image.
+     */
+    unsigned int piece;
+
+    for ( piece = 0;
+          piece < numDivisions && !this->GetAbortGenerateData();
+          piece++ )
+      {
+      // get the actual piece to write
+      ImageIORegion streamIORegion = m_ImageIO->GetSplitRegionForWriting(piece, numDivisions,
+                                                                         pasteIORegion, largestIORegion);
 
-    InputImageRegionType streamRegion;
-    ImageIORegionAdaptor< TInputImage::ImageDimension >::
-    Convert( streamIORegion, streamRegion, largestRegion.GetIndex() );
+      // Check whether the paste region is fully contained inside the
+      // largest region or not.
+      if ( !pasteIORegion.IsInside(streamIORegion) )
+        {
+        itkExceptionMacro(
+          << "ImageIO returns streamable region that is not fully contain in paste IO region"
+          << "Paste IO region: " << pasteIORegion
+          << "Streamable region: " << streamIORegion);
+        }
 
-    // execute the the upstream pipeline with the requested
-    // region for streaming
-    nonConstInput->SetRequestedRegion(streamRegion);
-    nonConstInput->PropagateRequestedRegion();
-    nonConstInput->UpdateOutputData();
+      InputImageRegionType streamRegion;
+      ImageIORegionAdaptor< TInputImage::ImageDimension >::
+      Convert( streamIORegion, streamRegion, largestRegion.GetIndex() );
 
-    if( piece == 0 )
-      {
-      // initialize the progress here to mimic the progress behavior of the non
-      // streaming filters, where the progress changes only when the other filters
-      // are done.
-      this->UpdateProgress( 0.0f );
-      }
+      // execute the the upstream pipeline with the requested
+      // region for streaming
+      nonConstInput->SetRequestedRegion(streamRegion);
+      nonConstInput->PropagateRequestedRegion();
+      nonConstInput->UpdateOutputData();
 
-    // check to see if we tried to stream but got the largest possible region
-    if ( piece == 0 && streamRegion != largestRegion )
-      {
-      InputImageRegionType bufferedRegion = input->GetBufferedRegion();
-      if ( bufferedRegion == largestRegion )
+      if( piece == 0 )
         {
-        // if so, then just write the entire image
-        itkDebugMacro("Requested stream region  matches largest region input filter may not support streaming well.");
-        itkDebugMacro("Writer is not streaming now!");
-        numDivisions = 1;
-        streamRegion = largestRegion;
-        ImageIORegionAdaptor< TInputImage::ImageDimension >::
-        Convert( streamRegion, streamIORegion, largestRegion.GetIndex() );
+        // initialize the progress here to mimic the progress behavior of the non
+        // streaming filters, where the progress changes only when the other filters
+        // are done.
+        this->UpdateProgress( 0.0f );
+        }
+
+      // check to see if we tried to stream but got the largest possible region
+      if ( piece == 0 && streamRegion != largestRegion )
+        {
+        InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+        if ( bufferedRegion == largestRegion )
+          {
+          // if so, then just write the entire image
+          itkDebugMacro("Requested stream region  matches largest region input filter may not support streaming well.");
+          itkDebugMacro("Writer is not streaming now!");
+          numDivisions = 1;
+          streamRegion = largestRegion;
+          ImageIORegionAdaptor< TInputImage::ImageDimension >::
+          Convert( streamRegion, streamIORegion, largestRegion.GetIndex() );
+          }
         }
-      }
 
-    m_ImageIO->SetIORegion(streamIORegion);
+      m_ImageIO->SetIORegion(streamIORegion);
 
-    // write the data
-    this->GenerateData();
+      // write the data
+      this->GenerateData();
 
-    this->UpdateProgress( static_cast<float>( piece + 1 ) / static_cast<float>( numDivisions ) );
+      this->UpdateProgress( static_cast<float>( piece + 1 ) / static_cast<float>( numDivisions ) );
+      }
     }
 
   // Notify end event observers
@@ -429,6 +460,214 @@ ImageFileWriter< TInputImage >
   m_ImageIO->Write(dataPtr);
 }
 
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::WritePiecesPipelined(const std::vector< ImageIORegion > & pieces)
+{
+  const InputImageType *input = this->GetInput();
+  InputImageType       *nonConstInput = const_cast< InputImageType * >( input );
+  InputImageRegionType  largestRegion = input->GetLargestPossibleRegion();
+
+  m_PieceQueued[0] = false;
+  m_PieceQueued[1] = false;
+  m_NoMorePieces = false;
+  m_PieceWriteFailed = false;
+
+  ThreadIdType writingThreadId = 0;
+  bool         writingThreadStarted = false;
+
+  try
+    {
+    for ( unsigned int piece = 0;
+          piece < pieces.size() && !this->GetAbortGenerateData();
+          piece++ )
+      {
+      InputImageRegionType streamRegion;
+      ImageIORegionAdaptor< TInputImage::ImageDimension >::
+      Convert( pieces[piece], streamRegion, largestRegion.GetIndex() );
+
+      // execute the the upstream pipeline with the requested
+      // region for streaming
+      nonConstInput->SetRequestedRegion(streamRegion);
+      nonConstInput->PropagateRequestedRegion();
+      nonConstInput->UpdateOutputData();
+
+      if ( piece == 0 )
+        {
+        this->UpdateProgress( 0.0f );
+
+        // check to see if we tried to stream but got the largest possible region
+        if ( streamRegion != largestRegion && input->GetBufferedRegion() == largestRegion )
+          {
+          itkDebugMacro("Requested stream region  matches largest region input filter may not support streaming well.");
+          itkDebugMacro("Writer is not streaming now!");
+          ImageIORegion largestIORegion(TInputImage::ImageDimension);
+          ImageIORegionAdaptor< TInputImage::ImageDimension >::
+          Convert( largestRegion, largestIORegion, largestRegion.GetIndex() );
+          m_ImageIO->SetIORegion(largestIORegion);
+          this->GenerateData();
+          this->UpdateProgress( 1.0f );
+          return;
+          }
+
+        writingThreadId = this->GetMultiThreader()->SpawnThread(Self::WritePiecesThreaderCallback, this);
+        writingThreadStarted = true;
+        }
+
+      // wait until the piece that used this slot has been written
+      const unsigned int slot = piece % 2;
+      m_PieceLock.Lock();
+      while ( m_PieceQueued[slot] && !m_PieceWriteFailed )
+        {
+        m_PieceWrittenCondition->Wait(&m_PieceLock);
+        }
+      const bool writeFailed = m_PieceWriteFailed;
+      m_PieceLock.Unlock();
+      if ( writeFailed )
+        {
+        break;
+        }
+
+      // The upstream output is overwritten by the next piece, so the
+      // writing thread gets its own copy.
+      InputImagePointer & pieceImage = m_PieceImage[slot];
+      if ( pieceImage.IsNull()
+           || pieceImage->GetBufferedRegion().GetSize() != streamRegion.GetSize() )
+        {
+        pieceImage = InputImageType::New();
+        pieceImage->CopyInformation(input);
+        pieceImage->SetBufferedRegion(streamRegion);
+        pieceImage->Allocate();
+        }
+      else
+        {
+        pieceImage->SetBufferedRegion(streamRegion);
+        }
+      ImageAlgorithm::Copy( input, pieceImage.GetPointer(), streamRegion, streamRegion );
+
+      m_PieceLock.Lock();
+      m_PieceIORegion[slot] = pieces[piece];
+      m_PieceQueued[slot] = true;
+      m_PieceQueuedCondition->Signal();
+      m_PieceLock.Unlock();
+
+      this->UpdateProgress( static_cast<float>( piece + 1 ) / static_cast<float>( pieces.size() ) );
+      }
+    }
+  catch ( ... )
+    {
+    if ( writingThreadStarted )
+      {
+      // drop the pieces not yet written and stop the writing thread
+      m_PieceLock.Lock();
+      m_NoMorePieces = true;
+      m_PieceQueued[0] = false;
+      m_PieceQueued[1] = false;
+      m_PieceQueuedCondition->Signal();
+      m_PieceLock.Unlock();
+      this->GetMultiThreader()->TerminateThread(writingThreadId);
+      }
+    m_PieceImage[0] = ITK_NULLPTR;
+    m_PieceImage[1] = ITK_NULLPTR;
+    throw;
+    }
+
+  if ( writingThreadStarted )
+    {
+    // let the writing thread finish the queued pieces
+    m_PieceLock.Lock();
+    m_NoMorePieces = true;
+    m_PieceQueuedCondition->Signal();
+    m_PieceLock.Unlock();
+    this->GetMultiThreader()->TerminateThread(writingThreadId);
+    }
+  m_PieceImage[0] = ITK_NULLPTR;
+  m_PieceImage[1] = ITK_NULLPTR;
+
+  if ( m_PieceWriteFailed )
+    {
+    throw m_PieceWriteException;
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage >
+void
+ImageFileWriter< TInputImage >
+::WriteQueuedPieces()
+{
+  unsigned int slot = 0;
+  while ( true )
+    {
+    m_PieceLock.Lock();
+    while ( !m_PieceQueued[slot] && !m_NoMorePieces )
+      {
+      m_PieceQueuedCondition->Wait(&m_PieceLock);
+      }
+    if ( !m_PieceQueued[slot] )
+      {
+      m_PieceLock.Unlock();
+      return;
+      }
+    m_PieceLock.Unlock();
+
+    bool            failed = false;
+    ExceptionObject exception;
+    try
+      {
+      m_ImageIO->SetIORegion(m_PieceIORegion[slot]);
+      m_ImageIO->Write( static_cast< const void * >( m_PieceImage[slot]->GetBufferPointer() ) );
+      }
+    catch ( ExceptionObject & e )
+      {
+      failed = true;
+      exception = e;
+      }
+    catch ( std::exception & e )
+      {
+      failed = true;
+      exception = ImageFileWriterException(__FILE__, __LINE__, e.what());
+      }
+    catch ( ... )
+      {
+      failed = true;
+      exception = ImageFileWriterException(__FILE__, __LINE__, "Unknown exception while writing a piece");
+      }
+
+    m_PieceLock.Lock();
+    m_PieceQueued[slot] = false;
+    if ( failed )
+      {
+      m_PieceWriteFailed = true;
+      m_PieceWriteException = exception;
+      }
+    m_PieceWrittenCondition->Signal();
+    m_PieceLock.Unlock();
+
+    if ( failed )
+      {
+      return;
+      }
+    slot = 1 - slot;
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage >
+ITK_THREAD_RETURN_TYPE
+ImageFileWriter< TInputImage >
+::WritePiecesThreaderCallback(void *arg)
+{
+  Self *writer = static_cast< Self * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+
+  writer->WriteQueuedPieces();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 //---------------------------------------------------------
 template< typename TInputImage >
 void
@@ -453,6 +692,15 @@ ImageFileWriter< TInputImage >
   os << indent << "IO Region: " << m_PasteIORegion << "\n";
   os << indent << "Number of Stream Divisions: " << m_NumberOfStreamDivisions << "\n";
 
+  if ( m_UsePipelinedWriting )
+    {
+    os << indent << "UsePipelinedWriting: On\n";
+    }
+  else
+    {
+    os << indent << "UsePipelinedWriting: Off\n";
+    }
+
   if ( m_UseCompression )
     {
     os << indent << "Compression: On\n";
@@ -21,8 +21,11 @@
 
 #include "itkImageRegion.h"
 #include "itkImageFileWriter.h"
+#include "itkConditionVariable.h"
+#include "itkProgressReporter.h"
 #include <vector>
 #include <string>
+#include <deque>
 
 namespace itk
 {
@@ -71,6 +74,20 @@ public:
  * the type of file is determined by either the file extension or an
  * ImageIO class if specified.
  *
+ * When UseThreadedEncoding is on, slices are extracted on the calling
+ * thread and, unless an ImageIO has been set explicitly, handed to up
+ * to NumberOfThreads - 1 encoding threads through a bounded queue, so
+ * that the per-file compression of formats such as PNG or TIFF runs
+ * concurrently. Each slice is written with its own ImageIO instance.
+ * When an ImageIO is set, files are written one after another with
+ * that instance, because the per slice MetaDataDictionary is passed
+ * through it. Progress is reported as the files are written.
+ *
+ * When NumberOfSlicesPerRequest is not zero the input is not updated
+ * as a whole. Instead, the writer requests slabs of that many slices
+ * from the upstream pipeline, so that the full volume never needs to
+ * be resident in memory.
+ *
  * \sa ImageFileWriter
  * \sa ImageIOBase
  * \sa ImageSeriesReader
@@ -97,6 +114,7 @@ public:
   /** Some convenient typedefs. */
   typedef TInputImage                          InputImageType;
   typedef typename InputImageType::RegionType  InputImageRegionType;
+  typedef typename InputImageType::IndexType   InputImageIndexType;
   typedef TOutputImage                         OutputImageType;
   typedef typename OutputImageType::RegionType OutputImageRegionType;
   typedef ImageFileWriter< TOutputImage >      WriterType;
@@ -197,6 +215,28 @@ public:
   itkGetConstReferenceMacro(UseCompression, bool);
   itkBooleanMacro(UseCompression);
 
+  /** Set/Get the number of slices requested from the upstream pipeline
+   * at once. When zero (the default) the whole input is updated before
+   * the first file is written. Otherwise the input is streamed in slabs
+   * of at most this many slices along the first dimension that is not
+   * part of the output image. */
+  itkSetMacro(NumberOfSlicesPerRequest, SizeValueType);
+  itkGetConstMacro(NumberOfSlicesPerRequest, SizeValueType);
+
+  /** Set/Get the maximum number of extracted slices waiting to be
+   * encoded when more than one thread is used. This bounds the memory
+   * used by slices in flight. When zero (the default) twice the number
+   * of encoding threads is used. */
+  itkSetMacro(MaximumNumberOfQueuedSlices, SizeValueType);
+  itkGetConstMacro(MaximumNumberOfQueuedSlices, SizeValueType);
+
+  /** Set/Get whether the files are encoded on NumberOfThreads - 1
+   * threads while the calling thread extracts the slices. Off by
+   * default. Ignored when an ImageIO is set. */
+  itkSetMacro(UseThreadedEncoding, bool);
+  itkGetConstMacro(UseThreadedEncoding, bool);
+  itkBooleanMacro(UseThreadedEncoding);
+
 protected:
   ImageSeriesWriter();
   ~ImageSeriesWriter();
@@ -241,6 +281,59 @@ private:
   void GenerateNumericFileNames();
 
   void WriteFiles();
+
+  /** Write one extracted slice to m_FileNames[slice] with the given
+   * writer. inIndex is the index of the first pixel of the slice in the
+   * input image. The writer is created by the calling thread, so that
+   * the object factories are not used from the encoding threads. */
+  void WriteSlice(unsigned int slice, OutputImageType *image,
+                  const InputImageIndexType & inIndex, WriterType *writer);
+
+  /** Pop slices from the queue and write them until the queue is
+   * closed and empty. Run by each encoding thread. */
+  void EncodeQueuedSlices();
+
+  /** Push a slice to the queue, waiting while the queue is full.
+   * Returns false, without queuing, once an encoding thread failed. */
+  bool QueueSlice(unsigned int slice, OutputImageType *image,
+                  const InputImageIndexType & inIndex, WriterType *writer);
+
+  /** Report the progress of the slices written by the encoding threads
+   * since numberOfReportedSlices, after waiting until at least
+   * numberOfSlicesToWaitFor were written or an encoding thread failed.
+   * Returns the number of slices reported so far. */
+  SizeValueType ReportEncodedSlices(ProgressReporter & progress,
+                                    SizeValueType numberOfReportedSlices,
+                                    SizeValueType numberOfSlicesToWaitFor);
+
+  static ITK_THREAD_RETURN_TYPE EncodeSlicesThreaderCallback(void *arg);
+
+  SizeValueType m_NumberOfSlicesPerRequest;
+  SizeValueType m_MaximumNumberOfQueuedSlices;
+  bool          m_UseThreadedEncoding;
+
+  /** A slice waiting to be written by an encoding thread. */
+  struct QueuedSlice
+  {
+    unsigned int                      Slice;
+    typename OutputImageType::Pointer Image;
+    InputImageIndexType               Index;
+    typename WriterType::Pointer      Writer;
+  };
+
+  std::deque< QueuedSlice >  m_SliceQueue;
+  SizeValueType              m_SliceQueueCapacity;
+  bool                       m_SliceQueueClosed;
+  SimpleMutexLock            m_SliceQueueLock;
+  ConditionVariable::Pointer m_SliceQueueNotEmpty;
+  ConditionVariable::Pointer m_SliceQueueNotFull;
+  ConditionVariable::Pointer m_SliceEncoded;
+  SizeValueType              m_NumberOfEncodedSlices;
+
+  /** The first exception raised by an encoding thread. It is rethrown
+   * on the calling thread once all encoding threads have stopped. */
+  bool            m_EncodingFailed;
+  ExceptionObject m_EncodingException;
 };
 } // end namespace itk
 
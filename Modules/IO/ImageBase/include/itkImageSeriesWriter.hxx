@@ -26,8 +26,10 @@
 #include "itkImageAlgorithm.h"
 #include "itkMetaDataObject.h"
 #include "itkArray.h"
+#include "itkMultiThreader.h"
 #include "vnl/algo/vnl_determinant.h"
 #include <cstdio>
+#include <algorithm>
 
 #if defined(_MSC_VER)
 #define snprintf _snprintf
@@ -41,9 +43,16 @@ ImageSeriesWriter< TInputImage, TOutputImage >
 ::ImageSeriesWriter():
   m_ImageIO(ITK_NULLPTR), m_UserSpecifiedImageIO(false),
   m_SeriesFormat("%d"),
-  m_StartIndex(1), m_IncrementIndex(1), m_MetaDataDictionaryArray(ITK_NULLPTR)
+  m_StartIndex(1), m_IncrementIndex(1), m_MetaDataDictionaryArray(ITK_NULLPTR),
+  m_NumberOfSlicesPerRequest(0), m_MaximumNumberOfQueuedSlices(0),
+  m_UseThreadedEncoding(false),
+  m_SliceQueueCapacity(0), m_SliceQueueClosed(false),
+  m_NumberOfEncodedSlices(0), m_EncodingFailed(false)
 {
   m_UseCompression = false;
+  m_SliceQueueNotEmpty = ConditionVariable::New();
+  m_SliceQueueNotFull = ConditionVariable::New();
+  m_SliceEncoded = ConditionVariable::New();
 }
 
 //---------------------------------------------------------
@@ -101,7 +110,17 @@ ImageSeriesWriter< TInputImage, TOutputImage >
   // NOTE: this const_cast<> is due to the lack of const-correctness
   // of the ProcessObject.
   InputImageType *nonConstImage = const_cast< InputImageType * >( inputImage );
-  nonConstImage->Update();
+  if ( m_NumberOfSlicesPerRequest > 0 )
+    {
+    // Only the meta data is needed here, the pixels are requested slab
+    // by slab while the files are written.
+    nonConstImage->UpdateOutputInformation();
+    nonConstImage->SetRequestedRegionToLargestPossibleRegion();
+    }
+  else
+    {
+    nonConstImage->Update();
+    }
 
   // Notify start event observers
   this->InvokeEvent( StartEvent() );
@@ -196,22 +215,26 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     itkExceptionMacro(<< "Input image is ITK_NULLPTR");
     }
 
+  // NOTE: this const_cast<> is due to the lack of const-correctness
+  // of the ProcessObject.
+  InputImageType *nonConstImage = const_cast< InputImageType * >( inputImage );
+
   // We need two regions. One for the input, one for the output.
-  ImageRegion< TInputImage::ImageDimension >  inRegion = inputImage->GetRequestedRegion();
+  const InputImageRegionType                  seriesRegion = inputImage->GetRequestedRegion();
+  ImageRegion< TInputImage::ImageDimension >  inRegion = seriesRegion;
   ImageRegion< TOutputImage::ImageDimension > outRegion;
 
   // The size of the output will match the input sizes, up to the
   // dimension of the input.
   for ( unsigned int i = 0; i < TOutputImage::ImageDimension; i++ )
     {
-    outRegion.SetSize(i, inputImage->GetRequestedRegion().GetSize()[i]);
+    outRegion.SetSize(i, seriesRegion.GetSize()[i]);
     }
 
   // Allocate an image for output and create an iterator for it
   typename OutputImageType::Pointer outputImage = OutputImageType::New();
   outputImage->SetRegions(outRegion);
   outputImage->SetNumberOfComponentsPerPixel(inputImage->GetNumberOfComponentsPerPixel());
-  outputImage->Allocate();
 
   // Set the origin and spacing of the output
   double spacing[TOutputImage::ImageDimension];
@@ -221,7 +244,7 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     {
     origin[i] = inputImage->GetOrigin()[i];
     spacing[i] = inputImage->GetSpacing()[i];
-    outRegion.SetSize(i, inputImage->GetRequestedRegion().GetSize()[i]);
+    outRegion.SetSize(i, seriesRegion.GetSize()[i]);
     for ( unsigned int j = 0; j < TOutputImage::ImageDimension; j++ )
       {
       direction[j][i] = inputImage->GetDirection()[j][i];
@@ -247,8 +270,6 @@ ImageSeriesWriter< TInputImage, TOutputImage >
   Index< TInputImage::ImageDimension > inIndex;
   Size< TInputImage::ImageDimension >  inSize;
 
-  SizeValueType pixelsPerFile = outputImage->GetRequestedRegion().GetNumberOfPixels();
-
   inSize.Fill(1);
   for ( unsigned int ns = 0; ns < TOutputImage::ImageDimension; ns++ )
     {
@@ -258,7 +279,7 @@ ImageSeriesWriter< TInputImage, TOutputImage >
   unsigned int expectedNumberOfFiles = 1;
   for ( unsigned int n = TOutputImage::ImageDimension; n < TInputImage::ImageDimension; n++ )
     {
-    expectedNumberOfFiles *= inRegion.GetSize(n);
+    expectedNumberOfFiles *= seriesRegion.GetSize(n);
     }
 
   if ( m_FileNames.size() != expectedNumberOfFiles )
@@ -269,107 +290,421 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     return;
     }
 
+  if ( m_MetaDataDictionaryArray && !m_ImageIO )
+    {
+    itkExceptionMacro(<< "Attempted to use a MetaDataDictionaryArray without specifying an ImageIO!");
+    }
+
   itkDebugMacro( << "Number of files to write = " << m_FileNames.size() );
 
+  // Files are only encoded concurrently when each encoding thread can
+  // own its ImageIO. The calling thread keeps extracting slices.
+  ThreadIdType numberOfEncodingThreads = 0;
+  if ( m_UseThreadedEncoding && m_ImageIO.IsNull()
+       && this->GetNumberOfThreads() > 1 && expectedNumberOfFiles > 1 )
+    {
+    numberOfEncodingThreads = std::min( this->GetNumberOfThreads() - 1,
+                                        static_cast< ThreadIdType >( expectedNumberOfFiles ) );
+    }
+
+  if ( numberOfEncodingThreads == 0 )
+    {
+    outputImage->Allocate();
+    }
+
+  // The number of consecutive slices that share all their indices
+  // above the first dimension of the series. A streamed slab never
+  // spans more than one such run so that it remains a rectangular
+  // region of the input.
+  SizeValueType sliceRunLength = 1;
+  if ( static_cast< unsigned int >( TOutputImage::ImageDimension )
+       < static_cast< unsigned int >( TInputImage::ImageDimension ) )
+    {
+    sliceRunLength = seriesRegion.GetSize(TOutputImage::ImageDimension);
+    }
+  SizeValueType slabEnd = 0;
+
   ProgressReporter progress(this, 0,
                             expectedNumberOfFiles,
                             expectedNumberOfFiles);
 
+  std::vector< ThreadIdType > encodingThreadIds;
+  SizeValueType               numberOfQueuedSlices = 0;
+  SizeValueType               numberOfReportedSlices = 0;
+  if ( numberOfEncodingThreads > 0 )
+    {
+    m_SliceQueue.clear();
+    m_SliceQueueClosed = false;
+    m_NumberOfEncodedSlices = 0;
+    m_EncodingFailed = false;
+    m_SliceQueueCapacity = m_MaximumNumberOfQueuedSlices;
+    if ( m_SliceQueueCapacity == 0 )
+      {
+      m_SliceQueueCapacity = 2 * numberOfEncodingThreads;
+      }
+    for ( ThreadIdType t = 0; t < numberOfEncodingThreads; ++t )
+      {
+      encodingThreadIds.push_back(
+        this->GetMultiThreader()->SpawnThread(Self::EncodeSlicesThreaderCallback, this) );
+      }
+    }
+
   // For each "slice" in the input, copy the region to the output,
   // build a filename and write the file.
-
-  typename InputImageType::OffsetValueType offset = 0;
-  for ( unsigned int slice = 0; slice < m_FileNames.size(); slice++ )
+  try
     {
-    // Select a "slice" of the image.
-    inIndex = inputImage->ComputeIndex(offset);
-    inRegion.SetIndex(inIndex);
-    inRegion.SetSize(inSize);
+    for ( unsigned int slice = 0; slice < m_FileNames.size(); slice++ )
+      {
+      // Select a "slice" of the image.
+      inIndex = seriesRegion.GetIndex();
+      SizeValueType remainder = slice;
+      for ( unsigned int n = TOutputImage::ImageDimension; n < TInputImage::ImageDimension; n++ )
+        {
+        inIndex[n] += static_cast< IndexValueType >( remainder % seriesRegion.GetSize(n) );
+        remainder /= seriesRegion.GetSize(n);
+        }
+      inRegion.SetIndex(inIndex);
+      inRegion.SetSize(inSize);
 
-    // Copy the selected "slice" into the output image.
-    ImageAlgorithm::Copy(inputImage, outputImage.GetPointer(), inRegion, outRegion);
+      if ( m_NumberOfSlicesPerRequest > 0 && slice >= slabEnd )
+        {
+        // Execute the upstream pipeline for the next slab only.
+        const SizeValueType slabLength =
+          std::min( m_NumberOfSlicesPerRequest, sliceRunLength - slice % sliceRunLength );
+        InputImageRegionType slabRegion = inRegion;
+        if ( static_cast< unsigned int >( TOutputImage::ImageDimension )
+             < static_cast< unsigned int >( TInputImage::ImageDimension ) )
+          {
+          slabRegion.SetSize(TOutputImage::ImageDimension, slabLength);
+          }
+        nonConstImage->SetRequestedRegion(slabRegion);
+        nonConstImage->PropagateRequestedRegion();
+        nonConstImage->UpdateOutputData();
+        slabEnd = slice + slabLength;
+        }
 
-    typename WriterType::Pointer writer = WriterType::New();
+      if ( numberOfEncodingThreads > 0 )
+        {
+        // Each queued slice owns its buffer and its writer. The writer
+        // and its ImageIO are created here so the object factories are
+        // only used from the calling thread.
+        typename OutputImageType::Pointer sliceImage = OutputImageType::New();
+        sliceImage->CopyInformation(outputImage);
+        sliceImage->SetRegions(outRegion);
+        sliceImage->Allocate();
+        ImageAlgorithm::Copy(inputImage, sliceImage.GetPointer(), inRegion, outRegion);
+
+        ImageIOBase::Pointer io =
+          ImageIOFactory::CreateImageIO(m_FileNames[slice].c_str(), ImageIOFactory::WriteMode);
+        if ( io.IsNull() )
+          {
+          ImageSeriesWriterException e(std::string(__FILE__), __LINE__);
+          std::ostringstream         msg;
+          msg << "Could not create IO object for writing file " << m_FileNames[slice];
+          e.SetDescription( msg.str().c_str() );
+          e.SetLocation(ITK_LOCATION);
+          throw e;
+          }
 
-    writer->UseInputMetaDataDictionaryOff(); // use the dictionary from the
-                                             // ImageIO class
-    writer->SetInput(outputImage);
+        typename WriterType::Pointer writer = WriterType::New();
+        writer->SetImageIO(io);
 
-    if ( m_ImageIO )
-      {
-      writer->SetImageIO(m_ImageIO);
+        if ( !this->QueueSlice(slice, sliceImage, inIndex, writer) )
+          {
+          // an encoding thread failed, its exception is rethrown below
+          break;
+          }
+        ++numberOfQueuedSlices;
+        numberOfReportedSlices = this->ReportEncodedSlices(progress, numberOfReportedSlices, 0);
+        }
+      else
+        {
+        // Copy the selected "slice" into the output image.
+        ImageAlgorithm::Copy(inputImage, outputImage.GetPointer(), inRegion, outRegion);
+
+        typename WriterType::Pointer writer = WriterType::New();
+        if ( m_ImageIO )
+          {
+          writer->SetImageIO(m_ImageIO);
+          }
+        this->WriteSlice(slice, outputImage, inIndex, writer);
+        progress.CompletedPixel();
+        }
       }
 
-    if ( m_MetaDataDictionaryArray )
+    if ( numberOfEncodingThreads > 0 )
       {
-      if ( m_ImageIO )
+      // Wait for the queued slices to be written.
+      this->ReportEncodedSlices(progress, numberOfReportedSlices, numberOfQueuedSlices);
+      }
+    }
+  catch ( ... )
+    {
+    if ( m_NumberOfSlicesPerRequest > 0 )
+      {
+      nonConstImage->SetRequestedRegion(seriesRegion);
+      }
+    if ( numberOfEncodingThreads > 0 )
+      {
+      // Discard the pending slices and let the encoding threads exit.
+      m_SliceQueueLock.Lock();
+      m_SliceQueue.clear();
+      m_SliceQueueClosed = true;
+      m_SliceQueueNotEmpty->Broadcast();
+      m_SliceQueueLock.Unlock();
+      for ( size_t t = 0; t < encodingThreadIds.size(); ++t )
         {
-        if ( slice > m_MetaDataDictionaryArray->size() - 1 )
-          {
-          itkExceptionMacro (
-            "The slice number: " << slice + 1 << " exceeds the size of the MetaDataDictionaryArray "
-                                 << m_MetaDataDictionaryArray->size() << ".");
-          }
-        DictionaryRawPointer dictionary = ( *m_MetaDataDictionaryArray )[slice];
-        m_ImageIO->SetMetaDataDictionary( ( *dictionary ) );
+        this->GetMultiThreader()->TerminateThread(encodingThreadIds[t]);
         }
-      else
+      }
+    throw;
+    }
+
+  if ( m_NumberOfSlicesPerRequest > 0 )
+    {
+    // the last slab was requested, the caller expects the region it set
+    nonConstImage->SetRequestedRegion(seriesRegion);
+    }
+
+  if ( numberOfEncodingThreads > 0 )
+    {
+    // Let the encoding threads exit.
+    m_SliceQueueLock.Lock();
+    m_SliceQueueClosed = true;
+    m_SliceQueueNotEmpty->Broadcast();
+    m_SliceQueueLock.Unlock();
+    for ( size_t t = 0; t < encodingThreadIds.size(); ++t )
+      {
+      this->GetMultiThreader()->TerminateThread(encodingThreadIds[t]);
+      }
+    m_SliceQueue.clear();
+
+    if ( m_EncodingFailed )
+      {
+      throw m_EncodingException;
+      }
+    }
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+void
+ImageSeriesWriter< TInputImage, TOutputImage >
+::WriteSlice(unsigned int slice, OutputImageType *image,
+             const InputImageIndexType & inIndex, WriterType *writer)
+{
+  const InputImageType *inputImage = this->GetInput();
+
+  writer->UseInputMetaDataDictionaryOff(); // use the dictionary from the
+                                           // ImageIO class
+  writer->SetInput(image);
+
+  if ( m_MetaDataDictionaryArray )
+    {
+    if ( m_ImageIO )
+      {
+      if ( slice > m_MetaDataDictionaryArray->size() - 1 )
         {
-        itkExceptionMacro(<< "Attempted to use a MetaDataDictionaryArray without specifying an ImageIO!");
+        itkExceptionMacro (
+          "The slice number: " << slice + 1 << " exceeds the size of the MetaDataDictionaryArray "
+                               << m_MetaDataDictionaryArray->size() << ".");
         }
+      DictionaryRawPointer dictionary = ( *m_MetaDataDictionaryArray )[slice];
+      m_ImageIO->SetMetaDataDictionary( ( *dictionary ) );
       }
     else
       {
-      if ( m_ImageIO )
-        {
-        DictionaryType & dictionary = m_ImageIO->GetMetaDataDictionary();
+      itkExceptionMacro(<< "Attempted to use a MetaDataDictionaryArray without specifying an ImageIO!");
+      }
+    }
+  else
+    {
+    if ( m_ImageIO )
+      {
+      DictionaryType & dictionary = m_ImageIO->GetMetaDataDictionary();
 
-        typename InputImageType::SpacingType spacing2 = inputImage->GetSpacing();
+      typename InputImageType::SpacingType spacing2 = inputImage->GetSpacing();
 
-        // origin of the output slice in the
-        // N-Dimensional space of the input image.
-        typename InputImageType::PointType origin2;
+      // origin of the output slice in the
+      // N-Dimensional space of the input image.
+      typename InputImageType::PointType origin2;
 
-        inputImage->TransformIndexToPhysicalPoint(inIndex, origin2);
+      inputImage->TransformIndexToPhysicalPoint(inIndex, origin2);
 
-        const unsigned int inputImageDimension = TInputImage::ImageDimension;
+      const unsigned int inputImageDimension = TInputImage::ImageDimension;
 
-        typedef Array< double > DoubleArrayType;
+      typedef Array< double > DoubleArrayType;
 
-        DoubleArrayType originArray(inputImageDimension);
-        DoubleArrayType spacingArray(inputImageDimension);
+      DoubleArrayType originArray(inputImageDimension);
+      DoubleArrayType spacingArray(inputImageDimension);
 
-        for ( unsigned int d = 0; d < inputImageDimension; d++ )
-          {
-          originArray[d]  = origin2[d];
-          spacingArray[d] = spacing2[d];
-          }
+      for ( unsigned int d = 0; d < inputImageDimension; d++ )
+        {
+        originArray[d]  = origin2[d];
+        spacingArray[d] = spacing2[d];
+        }
 
-        EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Origin, originArray);
-        EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Spacing, spacingArray);
-        EncapsulateMetaData<  unsigned int   >(dictionary, ITK_NumberOfDimensions, inputImageDimension);
+      EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Origin, originArray);
+      EncapsulateMetaData< DoubleArrayType >(dictionary, ITK_Spacing, spacingArray);
+      EncapsulateMetaData<  unsigned int   >(dictionary, ITK_NumberOfDimensions, inputImageDimension);
 
-        typename InputImageType::DirectionType direction2 = inputImage->GetDirection();
-        typedef Matrix< double, inputImageDimension, inputImageDimension> DoubleMatrixType;
-        DoubleMatrixType directionMatrix;
-        for( unsigned int i = 0; i < inputImageDimension; i++ )
+      typename InputImageType::DirectionType direction2 = inputImage->GetDirection();
+      typedef Matrix< double, inputImageDimension, inputImageDimension> DoubleMatrixType;
+      DoubleMatrixType directionMatrix;
+      for( unsigned int i = 0; i < inputImageDimension; i++ )
+        {
+        for( unsigned int j = 0; j < inputImageDimension; j++ )
           {
-          for( unsigned int j = 0; j < inputImageDimension; j++ )
-            {
-            directionMatrix[j][i]  = direction2[i][j];
-            }
+          directionMatrix[j][i]  = direction2[i][j];
           }
-        EncapsulateMetaData< DoubleMatrixType >( dictionary, ITK_ZDirection, directionMatrix );
         }
+      EncapsulateMetaData< DoubleMatrixType >( dictionary, ITK_ZDirection, directionMatrix );
+      }
+    }
+
+  writer->SetFileName( m_FileNames[slice].c_str() );
+  writer->SetUseCompression(m_UseCompression);
+  writer->Update();
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+bool
+ImageSeriesWriter< TInputImage, TOutputImage >
+::QueueSlice(unsigned int slice, OutputImageType *image,
+             const InputImageIndexType & inIndex, WriterType *writer)
+{
+  QueuedSlice queued;
+  queued.Slice = slice;
+  queued.Image = image;
+  queued.Index = inIndex;
+  queued.Writer = writer;
+
+  m_SliceQueueLock.Lock();
+  while ( m_SliceQueue.size() >= m_SliceQueueCapacity && !m_EncodingFailed )
+    {
+    m_SliceQueueNotFull->Wait(&m_SliceQueueLock);
+    }
+  const bool accepted = !m_EncodingFailed;
+  if ( accepted )
+    {
+    m_SliceQueue.push_back(queued);
+    m_SliceQueueNotEmpty->Signal();
+    }
+  m_SliceQueueLock.Unlock();
+
+  return accepted;
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+void
+ImageSeriesWriter< TInputImage, TOutputImage >
+::EncodeQueuedSlices()
+{
+  while ( true )
+    {
+    m_SliceQueueLock.Lock();
+    while ( m_SliceQueue.empty() && !m_SliceQueueClosed )
+      {
+      m_SliceQueueNotEmpty->Wait(&m_SliceQueueLock);
+      }
+    if ( m_SliceQueue.empty() )
+      {
+      m_SliceQueueLock.Unlock();
+      return;
+      }
+    QueuedSlice queued = m_SliceQueue.front();
+    m_SliceQueue.pop_front();
+    const bool skip = m_EncodingFailed;
+    m_SliceQueueNotFull->Signal();
+    m_SliceQueueLock.Unlock();
+
+    if ( skip )
+      {
+      continue;
+      }
+
+    bool            failed = false;
+    ExceptionObject exception;
+    try
+      {
+      this->WriteSlice(queued.Slice, queued.Image, queued.Index, queued.Writer);
+      }
+    catch ( ExceptionObject & e )
+      {
+      failed = true;
+      exception = e;
+      }
+    catch ( std::exception & e )
+      {
+      failed = true;
+      exception = ImageSeriesWriterException(std::string(__FILE__), __LINE__, e.what());
+      }
+    catch ( ... )
+      {
+      failed = true;
+      exception = ImageSeriesWriterException(std::string(__FILE__), __LINE__, "Unknown exception while writing a slice");
+      }
+
+    if ( failed )
+      {
+      m_SliceQueueLock.Lock();
+      if ( !m_EncodingFailed )
+        {
+        m_EncodingFailed = true;
+        m_EncodingException = exception;
+        }
+      m_SliceQueueNotFull->Broadcast();
+      m_SliceEncoded->Broadcast();
+      m_SliceQueueLock.Unlock();
+      }
+    else
+      {
+      m_SliceQueueLock.Lock();
+      ++m_NumberOfEncodedSlices;
+      m_SliceEncoded->Signal();
+      m_SliceQueueLock.Unlock();
       }
+    }
+}
 
-    writer->SetFileName( m_FileNames[slice].c_str() );
-    writer->SetUseCompression(m_UseCompression);
-    writer->Update();
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+SizeValueType
+ImageSeriesWriter< TInputImage, TOutputImage >
+::ReportEncodedSlices(ProgressReporter & progress,
+                      SizeValueType numberOfReportedSlices,
+                      SizeValueType numberOfSlicesToWaitFor)
+{
+  m_SliceQueueLock.Lock();
+  while ( m_NumberOfEncodedSlices < numberOfSlicesToWaitFor && !m_EncodingFailed )
+    {
+    m_SliceEncoded->Wait(&m_SliceQueueLock);
+    }
+  const SizeValueType numberOfEncodedSlices = m_NumberOfEncodedSlices;
+  m_SliceQueueLock.Unlock();
 
+  // progress events are only invoked from the calling thread
+  for ( ; numberOfReportedSlices < numberOfEncodedSlices; ++numberOfReportedSlices )
+    {
     progress.CompletedPixel();
-    offset += pixelsPerFile;
     }
+  return numberOfReportedSlices;
+}
+
+//---------------------------------------------------------
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_TYPE
+ImageSeriesWriter< TInputImage, TOutputImage >
+::EncodeSlicesThreaderCallback(void *arg)
+{
+  Self *writer = static_cast< Self * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+
+  writer->EncodeQueuedSlices();
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
 //---------------------------------------------------------
@@ -403,6 +738,10 @@ ImageSeriesWriter< TInputImage, TOutputImage >
     {
     os << indent << "Compression: Off\n";
     }
+
+  os << indent << "NumberOfSlicesPerRequest: " << m_NumberOfSlicesPerRequest << std::endl;
+  os << indent << "MaximumNumberOfQueuedSlices: " << m_MaximumNumberOfQueuedSlices << std::endl;
+  os << indent << "UseThreadedEncoding: " << ( m_UseThreadedEncoding ? "On" : "Off" ) << std::endl;
 }
 } // end namespace itk
 
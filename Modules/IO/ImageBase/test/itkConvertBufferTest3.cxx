@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include <iostream>
+
+// Convert buffers large enough to be split over several threads and
+// compare with the same conversion done on a single thread.
+template< typename TInput, typename TOutput >
+static bool
+CompareThreadedConversion(const std::vector< TInput > & input,
+                          int inputNumberOfComponents,
+                          size_t size,
+                          bool vectorImage,
+                          const char *name)
+{
+  typedef itk::ConvertPixelBuffer< TInput, TOutput,
+                                   itk::DefaultConvertPixelTraits< TOutput > > ConvertType;
+
+  const size_t outputLength = vectorImage ? size * inputNumberOfComponents : size;
+  std::vector< TOutput > serial(outputLength);
+  std::vector< TOutput > threaded(outputLength);
+  TInput *inputData = const_cast< TInput * >( &input[0] );
+
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(1);
+  if ( vectorImage )
+    {
+    ConvertType::ConvertVectorImage(inputData, inputNumberOfComponents, &serial[0], size);
+    }
+  else
+    {
+    ConvertType::Convert(inputData, inputNumberOfComponents, &serial[0], size);
+    }
+
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(4);
+  if ( vectorImage )
+    {
+    ConvertType::ConvertVectorImage(inputData, inputNumberOfComponents, &threaded[0], size);
+    }
+  else
+    {
+    ConvertType::Convert(inputData, inputNumberOfComponents, &threaded[0], size);
+    }
+
+  for ( size_t i = 0; i < outputLength; ++i )
+    {
+    if ( !( serial[i] == threaded[i] ) )
+      {
+      std::cerr << name << ": mismatch at " << i << std::endl;
+      return false;
+      }
+    }
+  std::cout << name << ": passed" << std::endl;
+  return true;
+}
+
+int itkConvertBufferTest3(int, char* [])
+{
+  // not a multiple of the number of threads
+  const size_t size = 4 * itk::ConvertPixelBuffer< unsigned char, float,
+    itk::DefaultConvertPixelTraits< float > >::MinimumNumberOfPixelsPerThread + 7;
+
+  std::vector< unsigned char > uchar3(3 * size);
+  std::vector< unsigned short > ushort1(size);
+  std::vector< short > short1(size);
+  for ( size_t i = 0; i < size; ++i )
+    {
+    uchar3[3 * i] = static_cast< unsigned char >( i % 251 );
+    uchar3[3 * i + 1] = static_cast< unsigned char >( ( 7 * i ) % 253 );
+    uchar3[3 * i + 2] = static_cast< unsigned char >( ( 13 * i ) % 255 );
+    ushort1[i] = static_cast< unsigned short >( ( 31 * i ) % 65521 );
+    short1[i] = static_cast< short >( static_cast< int >( ( 17 * i ) % 65521 ) - 32760 );
+    }
+
+  const itk::ThreadIdType numberOfThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+
+  bool pass = true;
+  pass &= CompareThreadedConversion< unsigned short, float >(ushort1, 1, size, false, "ushort to float");
+  pass &= CompareThreadedConversion< short, float >(short1, 1, size, false, "short to float");
+  pass &= CompareThreadedConversion< unsigned char, float >(uchar3, 3, size, false, "RGB to gray");
+  pass &= CompareThreadedConversion< unsigned char, itk::RGBAPixel< float > >(uchar3, 3, size, false, "RGB to RGBA");
+  pass &= CompareThreadedConversion< unsigned char, float >(uchar3, 3, size, true, "RGB to vector image");
+
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+
+  return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,116 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+
+int itkImageFileWriterPipelinedStreamingTest(int argc, char* argv[])
+{
+  if( argc < 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " output" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int numberOfDataPieces = 5;
+
+  typedef unsigned short            PixelType;
+  typedef itk::Image<PixelType,3>   ImageType;
+
+  ImageType::SizeType size;
+  size[0] = 31;
+  size[1] = 17;
+  size[2] = 23;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & idx = it.GetIndex();
+    it.Set( static_cast< PixelType >( 1000 * idx[2] + 31 * idx[1] + idx[0] ) );
+    }
+
+  typedef itk::PipelineMonitorImageFilter<ImageType> MonitorFilter;
+  MonitorFilter::Pointer monitor = MonitorFilter::New();
+  monitor->SetInput( image );
+
+  typedef itk::ImageFileWriter< ImageType > WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName( argv[1] );
+  writer->SetInput( monitor->GetOutput() );
+  writer->SetNumberOfStreamDivisions( numberOfDataPieces );
+
+  if ( writer->GetUsePipelinedWriting() )
+    {
+    std::cerr << "Wrong default UsePipelinedWriting value" << std::endl;
+    return EXIT_FAILURE;
+    }
+  writer->UsePipelinedWritingOn();
+
+  try
+    {
+    writer->Update();
+    }
+  catch( itk::ExceptionObject & err )
+    {
+    std::cerr << "ExceptionObject caught !" << std::endl;
+    std::cerr << err << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if( !monitor->VerifyAllInputCanStream( numberOfDataPieces ) )
+    {
+    std::cout << monitor << std::endl;
+    std::cout << "pipeline did not execute as expected!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef itk::ImageFileReader< ImageType > ReaderType;
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName( argv[1] );
+  try
+    {
+    reader->Update();
+    }
+  catch( itk::ExceptionObject & err )
+    {
+    std::cerr << "ExceptionObject caught !" << std::endl;
+    std::cerr << err << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  itk::ImageRegionConstIterator< ImageType > rit( reader->GetOutput(),
+                                                  reader->GetOutput()->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageType > oit( image, image->GetLargestPossibleRegion() );
+  for ( rit.GoToBegin(), oit.GoToBegin(); !rit.IsAtEnd(); ++rit, ++oit )
+    {
+    if ( rit.Get() != oit.Get() )
+      {
+      std::cerr << "Pixel read " << rit.Get() << " does not match pixel written "
+                << oit.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
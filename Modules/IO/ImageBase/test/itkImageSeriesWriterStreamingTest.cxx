@@ -0,0 +1,215 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageSeriesWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkPipelineMonitorImageFilter.h"
+#include "itkShiftScaleImageFilter.h"
+#include "itksys/SystemTools.hxx"
+
+namespace
+{
+// Checks on each progress event that the files accounted for by the
+// progress have been written.
+class SeriesWriterProgressCommand : public itk::Command
+{
+public:
+  typedef SeriesWriterProgressCommand Self;
+  typedef itk::Command                Superclass;
+  typedef itk::SmartPointer< Self >   Pointer;
+
+  itkNewMacro( Self );
+
+  std::vector< std::string > m_FileNames;
+  bool                       m_Failed;
+  float                      m_LastProgress;
+
+  virtual void Execute( itk::Object *caller, const itk::EventObject & event ) ITK_OVERRIDE
+  {
+    this->Execute( static_cast< const itk::Object * >( caller ), event );
+  }
+
+  virtual void Execute( const itk::Object *caller, const itk::EventObject & event ) ITK_OVERRIDE
+  {
+    if ( !itk::ProgressEvent().CheckEvent( &event ) )
+      {
+      return;
+      }
+    const float progress = static_cast< const itk::ProcessObject * >( caller )->GetProgress();
+    unsigned int numberOfWrittenFiles = 0;
+    for ( unsigned int i = 0; i < m_FileNames.size(); ++i )
+      {
+      if ( itksys::SystemTools::FileExists( m_FileNames[i].c_str() ) )
+        {
+        ++numberOfWrittenFiles;
+        }
+      }
+    if ( numberOfWrittenFiles + 0.5f < progress * m_FileNames.size() )
+      {
+      std::cerr << "Progress " << progress << " reported with only " << numberOfWrittenFiles
+                << " of " << m_FileNames.size() << " files written" << std::endl;
+      m_Failed = true;
+      }
+    m_LastProgress = progress;
+  }
+
+protected:
+  SeriesWriterProgressCommand() : m_Failed( false ), m_LastProgress( 0.0f ) {}
+};
+}
+
+int itkImageSeriesWriterStreamingTest(int argc, char* argv[])
+{
+  if( argc < 3 )
+    {
+    std::cerr << "Usage: " << argv[0] << " OutputDirectory FileSuffix [numberOfThreads]" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  typedef unsigned char                 PixelType;
+  typedef itk::Image< PixelType, 3 >    VolumeType;
+  typedef itk::Image< PixelType, 2 >    SliceType;
+
+  // Build a volume whose pixels identify their slice and position.
+  VolumeType::SizeType size;
+  size[0] = 32;
+  size[1] = 24;
+  size[2] = 10;
+  VolumeType::Pointer volume = VolumeType::New();
+  volume->SetRegions( size );
+  volume->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< VolumeType > vit( volume, volume->GetLargestPossibleRegion() );
+  for ( vit.GoToBegin(); !vit.IsAtEnd(); ++vit )
+    {
+    const VolumeType::IndexType & idx = vit.GetIndex();
+    vit.Set( static_cast< PixelType >( 17 * idx[2] + 3 * idx[1] + idx[0] ) );
+    }
+
+  // The volume is buffered as a whole: the identity shift-scale filter
+  // only produces the requested slabs.
+  typedef itk::ShiftScaleImageFilter< VolumeType, VolumeType > ShiftScaleType;
+  ShiftScaleType::Pointer shiftScale = ShiftScaleType::New();
+  shiftScale->SetInput( volume );
+
+  typedef itk::PipelineMonitorImageFilter< VolumeType > MonitorFilter;
+  MonitorFilter::Pointer monitor = MonitorFilter::New();
+  monitor->SetInput( shiftScale->GetOutput() );
+
+  const itk::SizeValueType slicesPerRequest = 3;
+  const unsigned int       numberOfRequests = 4;
+
+  typedef itk::ImageSeriesWriter< VolumeType, SliceType > WriterType;
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetInput( monitor->GetOutput() );
+  writer->SetNumberOfSlicesPerRequest( slicesPerRequest );
+  writer->SetMaximumNumberOfQueuedSlices( 2 );
+  if ( argc > 3 )
+    {
+    writer->SetNumberOfThreads( atoi( argv[3] ) );
+    writer->SetUseThreadedEncoding( writer->GetNumberOfThreads() > 1 );
+    }
+
+  std::vector< std::string > fileNames;
+  for ( unsigned int slice = 0; slice < size[2]; ++slice )
+    {
+    std::ostringstream name;
+    name << argv[1] << "/itkImageSeriesWriterStreamingTest." << slice << "." << argv[2];
+    fileNames.push_back( name.str() );
+    }
+  writer->SetFileNames( fileNames );
+
+  for ( unsigned int slice = 0; slice < size[2]; ++slice )
+    {
+    itksys::SystemTools::RemoveFile( fileNames[slice].c_str() );
+    }
+  SeriesWriterProgressCommand::Pointer progressCommand = SeriesWriterProgressCommand::New();
+  progressCommand->m_FileNames = fileNames;
+  writer->AddObserver( itk::ProgressEvent(), progressCommand );
+
+  try
+    {
+    writer->Update();
+    }
+  catch( itk::ExceptionObject & err )
+    {
+    std::cerr << "ExceptionObject caught !" << std::endl;
+    std::cerr << err << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if ( !monitor->VerifyAllInputCanStream( numberOfRequests ) )
+    {
+    std::cout << monitor << std::endl;
+    std::cerr << "pipeline did not execute as expected!" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if ( progressCommand->m_Failed || progressCommand->m_LastProgress != 1.0f )
+    {
+    std::cerr << "Progress not reported as the files were written, last progress "
+              << progressCommand->m_LastProgress << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  if ( monitor->GetOutput()->GetRequestedRegion() != volume->GetLargestPossibleRegion() )
+    {
+    std::cerr << "Requested region of the input not restored: "
+              << monitor->GetOutput()->GetRequestedRegion() << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // Read each file back and compare it with its slice of the volume.
+  typedef itk::ImageFileReader< SliceType > ReaderType;
+  for ( unsigned int slice = 0; slice < size[2]; ++slice )
+    {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName( fileNames[slice] );
+    try
+      {
+      reader->Update();
+      }
+    catch( itk::ExceptionObject & err )
+      {
+      std::cerr << "ExceptionObject caught !" << std::endl;
+      std::cerr << err << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    itk::ImageRegionConstIteratorWithIndex< SliceType > sit( reader->GetOutput(),
+                                                            reader->GetOutput()->GetLargestPossibleRegion() );
+    for ( sit.GoToBegin(); !sit.IsAtEnd(); ++sit )
+      {
+      VolumeType::IndexType idx;
+      idx[0] = sit.GetIndex()[0];
+      idx[1] = sit.GetIndex()[1];
+      idx[2] = slice;
+      if ( sit.Get() != volume->GetPixel( idx ) )
+        {
+        std::cerr << "Pixel " << idx << " of file " << fileNames[slice] << " is "
+                  << static_cast< int >( sit.Get() ) << " but "
+                  << static_cast< int >( volume->GetPixel( idx ) ) << " was expected" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -19,9 +19,151 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <map>
+#include <vector>
 
 namespace itk
 {
+/** \class MorphologicalWatershedMapQueue
+ * \brief Hierarchical queue of the watershed flooding, with a level per
+ * distinct pixel value.
+ *
+ * The levels are popped in increasing order as a whole; the elements of a
+ * level are in the order they were pushed.
+ *
+ * \ingroup ITKReview
+ */
+template< typename TValue, typename TElement >
+class MorphologicalWatershedMapQueue
+{
+public:
+  typedef std::vector< TElement > LevelType;
+
+  void Push(const TValue & value, const TElement & element)
+  {
+    m_Levels[value].push_back(element);
+  }
+
+  bool Empty() const
+  {
+    return m_Levels.empty();
+  }
+
+  /** Moves the lowest level into level, and returns its value. */
+  TValue PopLowestLevel(LevelType & level)
+  {
+    typename MapType::iterator lowest = m_Levels.begin();
+    const TValue               value = lowest->first;
+    level.clear();
+    level.swap(lowest->second);
+    m_Levels.erase(lowest);
+    return value;
+  }
+
+private:
+  typedef std::map< TValue, LevelType > MapType;
+  MapType m_Levels;
+};
+
+/** \class MorphologicalWatershedBucketQueue
+ * \brief Hierarchical queue of the watershed flooding with a bucket for
+ * every possible pixel value, for pixel types of up to 16 bits.
+ *
+ * \ingroup ITKReview
+ */
+template< typename TValue, typename TElement >
+class MorphologicalWatershedBucketQueue
+{
+public:
+  typedef std::vector< TElement > LevelType;
+
+  MorphologicalWatershedBucketQueue():
+    m_Buckets( static_cast< size_t >( NumericTraits< TValue >::max() )
+               - static_cast< size_t >( NumericTraits< TValue >::NonpositiveMin() ) + 1 ),
+    m_Lowest( m_Buckets.size() ),
+    m_NumberOfElements(0)
+  {}
+
+  void Push(const TValue & value, const TElement & element)
+  {
+    const size_t bucket = this->GetBucket(value);
+    m_Buckets[bucket].push_back(element);
+    if ( bucket < m_Lowest )
+      {
+      m_Lowest = bucket;
+      }
+    ++m_NumberOfElements;
+  }
+
+  bool Empty() const
+  {
+    return m_NumberOfElements == 0;
+  }
+
+  /** Moves the lowest level into level, and returns its value. */
+  TValue PopLowestLevel(LevelType & level)
+  {
+    while ( m_Buckets[m_Lowest].empty() )
+      {
+      ++m_Lowest;
+      }
+    level.clear();
+    level.swap(m_Buckets[m_Lowest]);
+    m_NumberOfElements -= level.size();
+    return static_cast< TValue >( static_cast< size_t >( NumericTraits< TValue >::NonpositiveMin() ) + m_Lowest );
+  }
+
+private:
+  size_t GetBucket(const TValue & value) const
+  {
+    return static_cast< size_t >( value ) - static_cast< size_t >( NumericTraits< TValue >::NonpositiveMin() );
+  }
+
+  std::vector< LevelType > m_Buckets;
+  size_t                   m_Lowest;
+  size_t                   m_NumberOfElements;
+};
+
+/** \cond HIDE_SPECIALIZATION_DOCUMENTATION */
+
+template< typename TValue, typename TElement >
+struct MorphologicalWatershedQueueTraits
+{
+  typedef MorphologicalWatershedMapQueue< TValue, TElement > QueueType;
+};
+
+template< typename TElement >
+struct MorphologicalWatershedQueueTraits< unsigned char, TElement >
+{
+  typedef MorphologicalWatershedBucketQueue< unsigned char, TElement > QueueType;
+};
+
+template< typename TElement >
+struct MorphologicalWatershedQueueTraits< signed char, TElement >
+{
+  typedef MorphologicalWatershedBucketQueue< signed char, TElement > QueueType;
+};
+
+template< typename TElement >
+struct MorphologicalWatershedQueueTraits< char, TElement >
+{
+  typedef MorphologicalWatershedBucketQueue< char, TElement > QueueType;
+};
+
+template< typename TElement >
+struct MorphologicalWatershedQueueTraits< unsigned short, TElement >
+{
+  typedef MorphologicalWatershedBucketQueue< unsigned short, TElement > QueueType;
+};
+
+template< typename TElement >
+struct MorphologicalWatershedQueueTraits< short, TElement >
+{
+  typedef MorphologicalWatershedBucketQueue< short, TElement > QueueType;
+};
+
+/** \endcond */
+
 /** \class MorphologicalWatershedFromMarkersImageFilter
  * \brief Morphological watershed transform from markers
  *
@@ -63,6 +205,12 @@ namespace itk
  * Chapter 9.2 of Pierre Soille's book "Morphological Image Analysis:
  * Principles and Applications", Second Edition, Springer, 2003.
  *
+ * The flooding works on buffer offsets, and the hierarchical queue has a
+ * bucket per value for pixel types of up to 16 bits. The pixels are
+ * processed in the order of the algorithms above, so the labels do not
+ * depend on the implementation. This order is also what keeps the
+ * flooding on a single thread: the labels of the plateaus depend on it.
+ *
  * This code was contributed in the Insight Journal paper:
  * "The watershed transform in ITK - discussion and new developments"
  * by Beare R., Lehmann G.
@@ -100,6 +248,7 @@ public:
   typedef typename LabelImageType::PixelType    LabelImagePixelType;
 
   typedef typename LabelImageType::IndexType IndexType;
+  typedef typename LabelImageType::SizeType  SizeType;
 
   /** ImageDimension constants */
   itkStaticConstMacro(ImageDimension, unsigned int,
@@ -172,7 +321,8 @@ protected:
    * \sa ProcessObject::EnlargeOutputRequestedRegion() */
   void EnlargeOutputRequestedRegion( DataObject *itkNotUsed(output) ) ITK_OVERRIDE;
 
-  /** The filter is single threaded. */
+  /** The filter is single threaded: the order of the flooding defines
+   * the labels of the plateaus. */
   void GenerateData() ITK_OVERRIDE;
 
 private:
@@ -183,6 +333,17 @@ private:
   bool m_FullyConnected;
 
   bool m_MarkWatershedLine;
+
+  typedef Offset< itkGetStaticConstMacro(ImageDimension) > OffsetType;
+
+  /** Fills pixelNeighbors with the offsets of the neighbors of the pixel
+   * which are in the buffer, in the order of the neighbors. */
+  static void GetPixelNeighbors(OffsetValueType pixel,
+                                const SizeType & size,
+                                const OffsetValueType *offsetTable,
+                                const std::vector< OffsetType > & neighbors,
+                                const std::vector< OffsetValueType > & neighborOffsets,
+                                std::vector< OffsetValueType > & pixelNeighbors);
 }; // end of class
 } // end namespace itk
 
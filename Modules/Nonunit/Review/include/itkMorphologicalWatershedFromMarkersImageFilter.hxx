@@ -18,17 +18,8 @@
 #ifndef itkMorphologicalWatershedFromMarkersImageFilter_hxx
 #define itkMorphologicalWatershedFromMarkersImageFilter_hxx
 
-#include <algorithm>
-#include <queue>
-#include <list>
 #include "itkMorphologicalWatershedFromMarkersImageFilter.h"
 #include "itkProgressReporter.h"
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkConstShapedNeighborhoodIterator.h"
-#include "itkConstantBoundaryCondition.h"
-#include "itkSize.h"
-#include "itkConnectedComponentAlgorithm.h"
 
 /*
  * This code was contributed in the Insight Journal paper:
@@ -95,7 +86,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
   // The 2 algorithms are very similar and so are integrated in the same filter.
 
   //---------------------------------------------------------------------------
-  // declare the vars common to the 2 algorithms: constants, iterators,
+  // declare the vars common to the 2 algorithms: constants, neighbors,
   // hierarchical queue, progress reporter, and status image
   // also allocate output images and verify preconditions
   //---------------------------------------------------------------------------
@@ -125,40 +116,57 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     itkExceptionMacro(<< "Marker and input must have the same size.");
     }
 
+  // all the images are entirely buffered, so the pixels are designated by
+  // their offset in the buffers
+  const LabelImagePixelType *marker = markerImage->GetBufferPointer();
+  const InputImagePixelType *input = inputImage->GetBufferPointer();
+  LabelImagePixelType *      output = outputImage->GetBufferPointer();
+
+  const SizeType         size = outputImage->GetBufferedRegion().GetSize();
+  const OffsetValueType *offsetTable = outputImage->GetOffsetTable();
+  const OffsetValueType  numberOfPixels = offsetTable[ImageDimension];
+
+  // the neighbors, in the order of the shaped neighborhood iterators
+  std::vector< OffsetType >      neighbors;
+  std::vector< OffsetValueType > neighborOffsets;
+  OffsetType                     neighbor;
+  neighbor.Fill(-1);
+  while ( neighbor[ImageDimension - 1] <= 1 )
+    {
+    unsigned int    nonZero = 0;
+    OffsetValueType linear = 0;
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      linear += neighbor[d] * offsetTable[d];
+      nonZero += ( neighbor[d] != 0 );
+      }
+    if ( nonZero > 0 && ( m_FullyConnected || nonZero == 1 ) )
+      {
+      neighbors.push_back(neighbor);
+      neighborOffsets.push_back(linear);
+      }
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      if ( ++neighbor[d] <= 1 || d == ImageDimension - 1 )
+        {
+        break;
+        }
+      neighbor[d] = -1;
+      }
+    }
+  const unsigned int numberOfNeighbors = static_cast< unsigned int >( neighbors.size() );
+
+  // the neighbors of a pixel, in the same order as above, without the ones
+  // outside of the image. The pixels outside of the image are never used
+  // by any of the 2 algorithms.
+  std::vector< OffsetValueType > pixelNeighbors;
+  pixelNeighbors.reserve(numberOfNeighbors);
+
   // FAH (in french: File d'Attente Hierarchique)
-  typedef std::queue< IndexType >                    QueueType;
-  typedef std::map< InputImagePixelType, QueueType > MapType;
-  MapType fah;
-
-  // the radius which will be used for all the shaped iterators
-  Size< ImageDimension > radius;
-  radius.Fill(1);
-
-  // iterator for the marker image
-  typedef ConstShapedNeighborhoodIterator< LabelImageType > MarkerIteratorType;
-  typename MarkerIteratorType::ConstIterator nmIt;
-  MarkerIteratorType
-  markerIt( radius, markerImage, markerImage->GetRequestedRegion() );
-  // add a boundary constant to avoid adding pixels on the border in the fah
-  ConstantBoundaryCondition< LabelImageType > lcbc;
-  lcbc.SetConstant( NumericTraits< LabelImagePixelType >::max() );
-  markerIt.OverrideBoundaryCondition(&lcbc);
-  setConnectivity(&markerIt, m_FullyConnected);
-
-  // iterator for the input image
-  typedef ConstShapedNeighborhoodIterator< InputImageType > InputIteratorType;
-  InputIteratorType
-  inputIt( radius, inputImage, inputImage->GetRequestedRegion() );
-  typename InputIteratorType::ConstIterator niIt;
-  setConnectivity(&inputIt, m_FullyConnected);
-
-  // iterator for the output image
-  typedef ShapedNeighborhoodIterator< LabelImageType > OutputIteratorType;
-  typedef typename OutputIteratorType::OffsetType      OffsetType;
-  typename OutputIteratorType::Iterator noIt;
-  OutputIteratorType
-  outputIt( radius, outputImage, outputImage->GetRequestedRegion() );
-  setConnectivity(&outputIt, m_FullyConnected);
+  typedef typename MorphologicalWatershedQueueTraits< InputImagePixelType, OffsetValueType >::QueueType QueueType;
+  typedef typename QueueType::LevelType                                                          LevelType;
+  QueueType fah;
+  LevelType currentQueue;
 
   //---------------------------------------------------------------------------
   // Meyer's algorithm
@@ -171,72 +179,35 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     //  - init FAH with indexes of background pixels with marker pixel(s) in
     //    their neighborhood
 
-    ConstantBoundaryCondition< LabelImageType > lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant(wsLabel);
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    // create a temporary image to store the state of each pixel (processed or
-    // not)
-    typedef Image< bool, ImageDimension > StatusImageType;
-    typename StatusImageType::Pointer statusImage = StatusImageType::New();
-    statusImage->SetRegions( markerImage->GetLargestPossibleRegion() );
-    statusImage->Allocate();
-
-    // iterator for the status image
-    typedef ShapedNeighborhoodIterator< StatusImageType > StatusIteratorType;
-    typename StatusIteratorType::Iterator nsIt;
-    StatusIteratorType
-                                                 statusIt( radius, statusImage, outputImage->GetRequestedRegion() );
-    ConstantBoundaryCondition< StatusImageType > bcbc;
-    bcbc.SetConstant(true);    // outside pixel are already processed
-    statusIt.OverrideBoundaryCondition(&bcbc);
-    setConnectivity(&statusIt, m_FullyConnected);
-
-    // the status image must be initialized before the first stage. In the
-    // first stage, the set to true are the neighbors of the marker (and the
-    // marker) so it's difficult (impossible ?) to init the status image at
-    // the same time
-    // the overhead should be small
-    statusImage->FillBuffer(false);
-
-    for ( markerIt.GoToBegin(), statusIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin();
-          !markerIt.IsAtEnd();
-          ++markerIt, ++outputIt )
+    // the state of each pixel (processed or not)
+    std::vector< bool > status(numberOfPixels, false);
+
+    for ( OffsetValueType p = 0; p < numberOfPixels; ++p )
       {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      LabelImagePixelType markerPixel = marker[p];
       if ( markerPixel != bgLabel )
         {
-        IndexType idx = markerIt.GetIndex();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - statusIt.GetIndex();
-        statusIt += shift;
-        inputIt += shift;
-
         // this pixel belongs to a marker
         // mark it as already processed
-        statusIt.SetCenterPixel(true);
+        status[p] = true;
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[p] = markerPixel;
         // and increase progress because this pixel will not be used in the
         // flooding stage.
         progress.CompletedPixel();
 
         // search the background pixels in the neighborhood
-        for ( nmIt = markerIt.Begin(), nsIt = statusIt.Begin(), niIt = inputIt.Begin();
-              nmIt != markerIt.End();
-              nmIt++, nsIt++, niIt++ )
+        GetPixelNeighbors(p, size, offsetTable, neighbors, neighborOffsets, pixelNeighbors);
+        for ( typename std::vector< OffsetValueType >::const_iterator nIt = pixelNeighbors.begin();
+              nIt != pixelNeighbors.end(); ++nIt )
           {
-          if ( !nsIt.Get() && nmIt.Get() == bgLabel )
+          if ( !status[*nIt] && marker[*nIt] == bgLabel )
             {
             // this neighbor is a background pixel and is not already
             // processed; add its index to fah
-            fah[niIt.Get()].push( markerIt.GetIndex()
-                                  + nmIt.GetNeighborhoodOffset() );
+            fah.Push(input[*nIt], *nIt);
             // mark it as already in the fah to avoid adding it several times
-            nsIt.Set(true);
+            status[*nIt] = true;
             }
           }
         }
@@ -244,88 +215,66 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         {
         // Some pixels may be never processed so, by default, non marked pixels
         // must be marked as watershed
-        outputIt.SetCenterPixel(wsLabel);
+        output[p] = wsLabel;
         }
       // one more pixel done in the init stage
       progress.CompletedPixel();
       }
-    // fill the borders of the status image with "true"
-    //FillSides<StatusImageType>(statusImage, true);
-    // Now disable the boundary checks
-    //outputIt.NeedToUseBoundaryConditionOff();
-    //statusIt.NeedToUseBoundaryConditionOff();
-    //inputIt.NeedToUseBoundaryConditionOff();
     // end of init stage
 
-    // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    statusIt.GoToBegin();
-    inputIt.GoToBegin();
-
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
+      // take the lowest level out of the fah
+      const InputImagePixelType currentValue = fah.PopLowestLevel(currentQueue);
 
-      while ( !currentQueue.empty() )
+      // the level grows while it is processed
+      for ( size_t head = 0; head < currentQueue.size(); ++head )
         {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
-
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        statusIt += shift;
-        inputIt += shift;
+        const OffsetValueType p = currentQueue[head];
+        GetPixelNeighbors(p, size, offsetTable, neighbors, neighborOffsets, pixelNeighbors);
 
         // iterate over the neighbors. If there is only one marker value, give
         // that value to the pixel, else keep it as is (watershed line)
-        LabelImagePixelType marker = wsLabel;
+        LabelImagePixelType markerPixel = wsLabel;
         bool                collision = false;
-        for ( noIt = outputIt.Begin(); noIt != outputIt.End(); noIt++ )
+        for ( typename std::vector< OffsetValueType >::const_iterator nIt = pixelNeighbors.begin();
+              nIt != pixelNeighbors.end(); ++nIt )
           {
-          LabelImagePixelType o = noIt.Get();
+          LabelImagePixelType o = output[*nIt];
           if ( o != wsLabel )
             {
-            if ( marker != wsLabel && o != marker )
+            if ( markerPixel != wsLabel && o != markerPixel )
               {
               collision = true;
               break;
               }
             else
-                  { marker = o; }
+                  { markerPixel = o; }
             }
           }
         if ( !collision )
           {
           // set the marker value
-          outputIt.SetCenterPixel(marker);
+          output[p] = markerPixel;
           // and propagate to the neighbors
-          for ( niIt = inputIt.Begin(), nsIt = statusIt.Begin();
-                niIt != inputIt.End();
-                niIt++, nsIt++ )
+          for ( typename std::vector< OffsetValueType >::const_iterator nIt = pixelNeighbors.begin();
+                nIt != pixelNeighbors.end(); ++nIt )
             {
-            if ( !nsIt.Get() )
+            if ( !status[*nIt] )
               {
               // the pixel is not yet processed. add it to the fah
-              InputImagePixelType GrayVal = niIt.Get();
+              InputImagePixelType GrayVal = input[*nIt];
               if ( GrayVal <= currentValue )
                 {
-                currentQueue.push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
+                currentQueue.push_back(*nIt);
                 }
               else
                 {
-                fah[GrayVal].push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
+                fah.Push(GrayVal, *nIt);
                 }
               // mark it as already in the fah
-              nsIt.Set(true);
+              status[*nIt] = true;
               }
             }
           }
@@ -344,32 +293,21 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     //  - copy markers pixels to output image
     //  - init FAH with indexes of pixels with background pixel in their
     //    neighborhood
-
-    ConstantBoundaryCondition< LabelImageType > lcbc2;
-    // outside pixel are watershed so they won't be use to find real watershed
-    // pixels
-    lcbc2.SetConstant( NumericTraits< LabelImagePixelType >::max() );
-    outputIt.OverrideBoundaryCondition(&lcbc2);
-
-    for ( markerIt.GoToBegin(), outputIt.GoToBegin(), inputIt.GoToBegin();
-          !markerIt.IsAtEnd();
-          ++markerIt, ++outputIt )
+    for ( OffsetValueType p = 0; p < numberOfPixels; ++p )
       {
-      LabelImagePixelType markerPixel = markerIt.GetCenterPixel();
+      LabelImagePixelType markerPixel = marker[p];
       if ( markerPixel != bgLabel )
         {
-        IndexType  idx = markerIt.GetIndex();
-        OffsetType shift = idx - inputIt.GetIndex();
-        inputIt += shift;
-
         // this pixels belongs to a marker
         // copy it to the output image
-        outputIt.SetCenterPixel(markerPixel);
+        output[p] = markerPixel;
         // search if it has background pixel in its neighborhood
+        GetPixelNeighbors(p, size, offsetTable, neighbors, neighborOffsets, pixelNeighbors);
         bool haveBgNeighbor = false;
-        for ( nmIt = markerIt.Begin(); nmIt != markerIt.End(); nmIt++ )
+        for ( typename std::vector< OffsetValueType >::const_iterator nIt = pixelNeighbors.begin();
+              nIt != pixelNeighbors.end(); ++nIt )
           {
-          if ( nmIt.Get() == bgLabel )
+          if ( marker[*nIt] == bgLabel )
             {
             haveBgNeighbor = true;
             break;
@@ -378,7 +316,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         if ( haveBgNeighbor )
           {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push( markerIt.GetIndex() );
+          fah.Push(input[p], p);
           }
         else
           {
@@ -389,58 +327,42 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         }
       else
         {
-        outputIt.SetCenterPixel(wsLabel);
+        output[p] = wsLabel;
         }
       progress.CompletedPixel();
       }
     // end of init stage
 
-    // flooding
-    // init all the iterators
-    outputIt.GoToBegin();
-    inputIt.GoToBegin();
-
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
+      // take the lowest level out of the fah
+      const InputImagePixelType currentValue = fah.PopLowestLevel(currentQueue);
 
-      while ( !currentQueue.empty() )
+      // the level grows while it is processed
+      for ( size_t head = 0; head < currentQueue.size(); ++head )
         {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
+        const OffsetValueType p = currentQueue[head];
+        GetPixelNeighbors(p, size, offsetTable, neighbors, neighborOffsets, pixelNeighbors);
 
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        inputIt += shift;
-
-        LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
-        // get the current value of the pixel
+        LabelImagePixelType currentMarker = output[p];
         // iterate over neighbors to propagate the marker
-        for ( noIt = outputIt.Begin(), niIt = inputIt.Begin();
-              noIt != outputIt.End();
-              noIt++, niIt++ )
+        for ( typename std::vector< OffsetValueType >::const_iterator nIt = pixelNeighbors.begin();
+              nIt != pixelNeighbors.end(); ++nIt )
           {
-          if ( noIt.Get() == wsLabel )
+          if ( output[*nIt] == wsLabel )
             {
             // the pixel is not yet processed. It can be labeled with the
             // current label
-            noIt.Set(currentMarker);
-            InputImagePixelType GrayVal = niIt.Get();
+            output[*nIt] = currentMarker;
+            InputImagePixelType GrayVal = input[*nIt];
             if ( GrayVal <= currentValue )
               {
-              currentQueue.push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
+              currentQueue.push_back(*nIt);
               }
             else
               {
-              fah[GrayVal].push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
+              fah.Push(GrayVal, *nIt);
               }
             progress.CompletedPixel();
             }
@@ -450,6 +372,59 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     }
 }
 
+template< typename TInputImage, typename TLabelImage >
+void
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GetPixelNeighbors(OffsetValueType pixel,
+                    const SizeType & size,
+                    const OffsetValueType *offsetTable,
+                    const std::vector< OffsetType > & neighbors,
+                    const std::vector< OffsetValueType > & neighborOffsets,
+                    std::vector< OffsetValueType > & pixelNeighbors)
+{
+  pixelNeighbors.clear();
+
+  // position of the pixel in the buffer
+  OffsetValueType position[ImageDimension];
+  OffsetValueType remainder = pixel;
+  for ( unsigned int d = ImageDimension - 1; d > 0; --d )
+    {
+    position[d] = remainder / offsetTable[d];
+    remainder -= position[d] * offsetTable[d];
+    }
+  position[0] = remainder;
+
+  bool interior = true;
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    interior = interior && position[d] > 0 && position[d] + 1 < static_cast< OffsetValueType >( size[d] );
+    }
+
+  const size_t numberOfNeighbors = neighbors.size();
+  if ( interior )
+    {
+    for ( size_t k = 0; k < numberOfNeighbors; ++k )
+      {
+      pixelNeighbors.push_back(pixel + neighborOffsets[k]);
+      }
+    return;
+    }
+
+  for ( size_t k = 0; k < numberOfNeighbors; ++k )
+    {
+    bool inside = true;
+    for ( unsigned int d = 0; d < ImageDimension && inside; ++d )
+      {
+      const OffsetValueType c = position[d] + neighbors[k][d];
+      inside = c >= 0 && c < static_cast< OffsetValueType >( size[d] );
+      }
+    if ( inside )
+      {
+      pixelNeighbors.push_back(pixel + neighborOffsets[k]);
+      }
+    }
+}
+
 template< typename TInputImage, typename TLabelImage >
 void
 MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
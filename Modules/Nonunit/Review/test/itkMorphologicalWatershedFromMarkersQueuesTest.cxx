@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+// The bucket queue used for 8 and 16 bit pixels and the map queue used
+// for the other pixel types must flood the pixels in the same order, so
+// the same values give the same labels, plateaus included.
+template< unsigned int VDimension >
+int
+itkMorphologicalWatershedFromMarkersQueuesTestRun(unsigned int sizeValue)
+{
+  typedef itk::Image< unsigned char, VDimension >  CharImageType;
+  typedef itk::Image< float, VDimension >          FloatImageType;
+  typedef itk::Image< unsigned short, VDimension > LabelImageType;
+
+  typename CharImageType::SizeType size;
+  size.Fill(sizeValue);
+
+  typename CharImageType::Pointer charImage = CharImageType::New();
+  charImage->SetRegions(size);
+  charImage->Allocate();
+  typename FloatImageType::Pointer floatImage = FloatImageType::New();
+  floatImage->SetRegions(size);
+  floatImage->Allocate();
+  typename LabelImageType::Pointer markers = LabelImageType::New();
+  markers->SetRegions(size);
+  markers->Allocate();
+
+  // few levels and large plateaus, with markers scattered over them
+  itk::ImageRegionIterator< CharImageType >  charIt( charImage, charImage->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< FloatImageType > floatIt( floatImage, floatImage->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< LabelImageType > markerIt( markers, markers->GetLargestPossibleRegion() );
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed(1);
+  unsigned short label = 0;
+  for ( ; !charIt.IsAtEnd(); ++charIt, ++floatIt, ++markerIt )
+    {
+    unsigned int value = 0;
+    for ( unsigned int d = 0; d < VDimension; ++d )
+      {
+      value += ( charIt.GetIndex()[d] % 11 ) * ( charIt.GetIndex()[d] % 7 );
+      }
+    value = ( value / 8 + generator->GetIntegerVariate(1) ) % 9;
+    charIt.Set( static_cast< unsigned char >( value ) );
+    floatIt.Set( static_cast< float >( value ) );
+    markerIt.Set( generator->GetIntegerVariate(96) == 0 ? ++label : 0 );
+    }
+
+  typedef itk::MorphologicalWatershedFromMarkersImageFilter< CharImageType, LabelImageType >  CharFilterType;
+  typedef itk::MorphologicalWatershedFromMarkersImageFilter< FloatImageType, LabelImageType > FloatFilterType;
+  typename CharFilterType::Pointer charFilter = CharFilterType::New();
+  charFilter->SetInput( charImage );
+  charFilter->SetMarkerImage( markers );
+  typename FloatFilterType::Pointer floatFilter = FloatFilterType::New();
+  floatFilter->SetInput( floatImage );
+  floatFilter->SetMarkerImage( markers );
+
+  int status = EXIT_SUCCESS;
+  for ( int markLines = 0; markLines < 2; ++markLines )
+    {
+    for ( int fullyConnected = 0; fullyConnected < 2; ++fullyConnected )
+      {
+      charFilter->SetMarkWatershedLine( markLines != 0 );
+      charFilter->SetFullyConnected( fullyConnected != 0 );
+      floatFilter->SetMarkWatershedLine( markLines != 0 );
+      floatFilter->SetFullyConnected( fullyConnected != 0 );
+      charFilter->Update();
+      floatFilter->Update();
+
+      itk::ImageRegionIterator< LabelImageType > it1( charFilter->GetOutput(), charFilter->GetOutput()->GetLargestPossibleRegion() );
+      itk::ImageRegionIterator< LabelImageType > it2( floatFilter->GetOutput(), floatFilter->GetOutput()->GetLargestPossibleRegion() );
+      unsigned int numberOfUnlabeled = 0;
+      for ( ; !it1.IsAtEnd(); ++it1, ++it2 )
+        {
+        if ( it1.Get() != it2.Get() )
+          {
+          std::cerr << "Labels differ at " << it1.GetIndex() << " for MarkWatershedLine " << markLines
+                    << " and FullyConnected " << fullyConnected << ": " << it1.Get() << " != " << it2.Get()
+                    << std::endl;
+          return EXIT_FAILURE;
+          }
+        numberOfUnlabeled += ( it1.Get() == 0 );
+        }
+
+      // without watershed lines, every pixel gets a label
+      if ( !markLines && numberOfUnlabeled != 0 )
+        {
+        std::cerr << numberOfUnlabeled << " pixels are not labeled." << std::endl;
+        status = EXIT_FAILURE;
+        }
+      }
+    }
+  return status;
+}
+
+int itkMorphologicalWatershedFromMarkersQueuesTest(int, char *[])
+{
+  if ( itkMorphologicalWatershedFromMarkersQueuesTestRun< 2 >(120) != EXIT_SUCCESS
+       || itkMorphologicalWatershedFromMarkersQueuesTestRun< 3 >(30) != EXIT_SUCCESS )
+    {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -92,11 +92,27 @@ public:
    * one.  This function is convinient to create a histogram. It returns false
    * when the bin id is out of bounds. */
   bool IncreaseFrequency(const InstanceIdentifier id,
-                         const AbsoluteFrequencyType value);
+                         const AbsoluteFrequencyType value)
+  {
+    if ( id >= m_FrequencyContainer->Size() )
+      {
+      return false;
+      }
+    ( *m_FrequencyContainer )[id] += value;
+    m_TotalFrequency += value;
+    return true;
+  }
 
   /** Method to get the frequency of a bin from the histogram. It returns zero
    * when the Id is out of bounds. */
-  AbsoluteFrequencyType GetFrequency(const InstanceIdentifier id) const;
+  AbsoluteFrequencyType GetFrequency(const InstanceIdentifier id) const
+  {
+    if ( id >= m_FrequencyContainer->Size() )
+      {
+      return NumericTraits< AbsoluteFrequencyType >::ZeroValue();
+      }
+    return ( *m_FrequencyContainer )[id];
+  }
 
   /** Gets the sum of the frequencies */
   TotalAbsoluteFrequencyType GetTotalFrequency()
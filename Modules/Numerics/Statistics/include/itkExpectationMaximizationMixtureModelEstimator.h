@@ -21,6 +21,7 @@
 #include "itkMixtureModelComponentBase.h"
 #include "itkGaussianMembershipFunction.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkMultiThreader.h"
 
 namespace itk
 {
@@ -42,6 +43,15 @@ namespace Statistics
  * required. The EM procedure terminates when the current iteration
  * reaches the maximum iteration or the model parameters converge.
  *
+ * The measurement vectors are copied into a contiguous array at the
+ * beginning of the estimation. In the expectation step, the densities of
+ * the components are then evaluated for blocks of measurement vectors
+ * of that array, and the blocks are shared between NumberOfThreads
+ * threads. Gaussian components are evaluated with
+ * GaussianMembershipFunction::EvaluateBlock(); when a component has
+ * another membership function, the expectation step runs on a single
+ * thread.
+ *
  * <b>Recent API changes:</b>
  * The static const macro to get the length of a measurement vector,
  * \c MeasurementVectorSize  has been removed to allow the length of a measurement
@@ -144,6 +154,11 @@ public:
     return m_CurrentIteration;
   }
 
+  /** Set/Get the number of threads of the expectation step. Defaults to
+   * the global default number of threads of the MultiThreader. */
+  itkSetClampMacro(NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS);
+  itkGetConstMacro(NumberOfThreads, ThreadIdType);
+
   /** Adds a new component (or class). */
   int AddComponent(ComponentType *component);
 
@@ -184,9 +199,30 @@ protected:
   void GenerateData();
 
 private:
+  typedef typename TSample::AbsoluteFrequencyType FrequencyType;
+
+  struct ThreadStruct
+  {
+    Self *Estimator;
+    std::vector< const GaussianMembershipFunctionType * > GaussianMembershipFunctions;
+  };
+
+  static ITK_THREAD_RETURN_TYPE CalculateDensitiesThreaderCallback(void *arg);
+
+  /** Computes the weights of the measurement vectors in [begin, end) */
+  void ThreadedCalculateDensities(const ThreadStruct *str,
+                                  SizeValueType begin, SizeValueType end);
+
   /** Target data sample pointer*/
   const TSample *m_Sample;
 
+  /** Measurement vectors of the sample, one after the other, and their
+   * frequencies. Only filled during the estimation. */
+  std::vector< MeasurementType > m_Measurements;
+  std::vector< FrequencyType >   m_Frequencies;
+
+  ThreadIdType m_NumberOfThreads;
+
   int m_MaxIteration;
   int m_CurrentIteration;
 
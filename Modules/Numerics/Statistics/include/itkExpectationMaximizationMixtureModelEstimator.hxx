@@ -35,6 +35,7 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
   m_MembershipFunctionsObject           (MembershipFunctionVectorObjectType::New()),
   m_MembershipFunctionsWeightArrayObject(MembershipFunctionsWeightsArrayObjectType::New())
 {
+  m_NumberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
 }
 
 template< typename TSample >
@@ -47,6 +48,8 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
      << this->GetMaximumIteration() << std::endl;
   os << indent << "Sample: "
      << this->GetSample() << std::endl;
+  os << indent << "Number Of Threads: "
+     << this->GetNumberOfThreads() << std::endl;
   os << indent << "Number Of Components: "
      << this->GetNumberOfComponents() << std::endl;
   for ( unsigned int i = 0; i < this->GetNumberOfComponents(); i++ )
@@ -173,71 +176,153 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
     return false;
     }
 
-  double                temp;
-  size_t                numberOfComponents = m_ComponentVector.size();
-  std::vector< double > tempWeights(numberOfComponents, 0. );
+  const size_t numberOfComponents = m_ComponentVector.size();
 
-  typename TSample::ConstIterator iter = m_Sample->Begin();
-  typename TSample::ConstIterator last = m_Sample->End();
+  ThreadStruct str;
+  str.Estimator = this;
+  str.GaussianMembershipFunctions.resize(numberOfComponents);
 
-  size_t componentIndex;
+  // The Gaussian components are evaluated by blocks, and from several
+  // threads. The other membership functions are only evaluated from one
+  // thread, as they may not be thread safe.
+  bool allGaussian = true;
+  for ( size_t componentIndex = 0; componentIndex < numberOfComponents;
+        ++componentIndex )
+    {
+    str.GaussianMembershipFunctions[componentIndex] =
+      dynamic_cast< const GaussianMembershipFunctionType * >(
+        m_ComponentVector[componentIndex]->GetMembershipFunction() );
+    if ( str.GaussianMembershipFunctions[componentIndex] == ITK_NULLPTR )
+      {
+      allGaussian = false;
+      }
+    }
+
+  const SizeValueType numberOfMeasurements = m_Frequencies.size();
+  ThreadIdType        numberOfThreads = 1;
+  if ( allGaussian )
+    {
+    numberOfThreads = static_cast< ThreadIdType >(
+      std::min( static_cast< SizeValueType >( m_NumberOfThreads ),
+                std::max( numberOfMeasurements, static_cast< SizeValueType >( 1 ) ) ) );
+    }
+
+  if ( numberOfThreads == 1 )
+    {
+    this->ThreadedCalculateDensities(&str, 0, numberOfMeasurements);
+    }
+  else
+    {
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(this->CalculateDensitiesThreaderCallback, &str);
+    threader->SingleMethodExecute();
+    }
+
+  return true;
+}
+
+template< typename TSample >
+ITK_THREAD_RETURN_TYPE
+ExpectationMaximizationMixtureModelEstimator< TSample >
+::CalculateDensitiesThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const ThreadStruct *             str = static_cast< ThreadStruct * >( info->UserData );
+
+  // contiguous ranges of measurement vectors, one per thread
+  const SizeValueType numberOfMeasurements = str->Estimator->m_Frequencies.size();
+  const SizeValueType begin = numberOfMeasurements * info->ThreadID / info->NumberOfThreads;
+  const SizeValueType end = numberOfMeasurements * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  str->Estimator->ThreadedCalculateDensities(str, begin, end);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TSample >
+void
+ExpectationMaximizationMixtureModelEstimator< TSample >
+::ThreadedCalculateDensities(const ThreadStruct *str,
+                             SizeValueType begin, SizeValueType end)
+{
+  const size_t                                         numberOfComponents = m_ComponentVector.size();
+  const typename TSample::MeasurementVectorSizeType measurementVectorSize =
+    m_Sample->GetMeasurementVectorSize();
 
-  typedef typename TSample::AbsoluteFrequencyType FrequencyType;
-  FrequencyType frequency;
-  FrequencyType zeroFrequency = NumericTraits< FrequencyType >::ZeroValue();
-  typename TSample::MeasurementVectorType mvector;
-  double density;
-  double densitySum;
-  double minDouble = NumericTraits<double>::epsilon();
+  const SizeValueType   blockSize = 256;
+  std::vector< double > densities(numberOfComponents * blockSize);
 
-  SizeValueType measurementVectorIndex = 0;
+  MeasurementVectorType mvector;
+  NumericTraits< MeasurementVectorType >::SetLength(mvector, measurementVectorSize);
 
-  while ( iter != last )
+  const FrequencyType zeroFrequency = NumericTraits< FrequencyType >::ZeroValue();
+  const double        minDouble = NumericTraits<double>::epsilon();
+
+  for ( SizeValueType blockStart = begin; blockStart < end; blockStart += blockSize )
     {
-    mvector = iter.GetMeasurementVector();
-    frequency = iter.GetFrequency();
-    densitySum = 0.0;
-    if ( frequency > zeroFrequency )
+    const SizeValueType    count = std::min( blockSize, end - blockStart );
+    const MeasurementType *block = &m_Measurements[0] + blockStart * measurementVectorSize;
+
+    for ( size_t componentIndex = 0; componentIndex < numberOfComponents;
+          ++componentIndex )
       {
-      for ( componentIndex = 0; componentIndex < numberOfComponents;
-            ++componentIndex )
+      double *density = &densities[componentIndex * blockSize];
+      if ( str->GaussianMembershipFunctions[componentIndex] != ITK_NULLPTR )
         {
-        double t_prop = m_Proportions[componentIndex];
-        double t_value = m_ComponentVector[componentIndex]->Evaluate(mvector);
-        density = t_prop * t_value;
-        tempWeights[componentIndex] = density;
-        densitySum += density;
+        str->GaussianMembershipFunctions[componentIndex]->EvaluateBlock(block, count, density);
         }
-
-      for ( componentIndex = 0; componentIndex < numberOfComponents;
-            ++componentIndex )
+      else
         {
-        temp = tempWeights[componentIndex];
-
-        // just to make sure temp does not blow up!
-        if ( densitySum > NumericTraits<double>::epsilon() )
+        for ( SizeValueType i = 0; i < count; ++i )
           {
-          temp /= densitySum;
+          for ( unsigned int d = 0; d < measurementVectorSize; ++d )
+            {
+            mvector[d] = block[i * measurementVectorSize + d];
+            }
+          density[i] = m_ComponentVector[componentIndex]->Evaluate(mvector);
           }
-        m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex,
-                                                     temp);
         }
       }
-    else
+
+    for ( SizeValueType i = 0; i < count; ++i )
       {
-      for ( componentIndex = 0; componentIndex < numberOfComponents;
-            ++componentIndex )
+      const SizeValueType measurementVectorIndex = blockStart + i;
+      if ( m_Frequencies[measurementVectorIndex] > zeroFrequency )
+        {
+        double densitySum = 0.0;
+        for ( size_t componentIndex = 0; componentIndex < numberOfComponents;
+              ++componentIndex )
+          {
+          double & density = densities[componentIndex * blockSize + i];
+          density *= m_Proportions[componentIndex];
+          densitySum += density;
+          }
+
+        for ( size_t componentIndex = 0; componentIndex < numberOfComponents;
+              ++componentIndex )
+          {
+          double temp = densities[componentIndex * blockSize + i];
+
+          // just to make sure temp does not blow up!
+          if ( densitySum > NumericTraits<double>::epsilon() )
+            {
+            temp /= densitySum;
+            }
+          m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex,
+                                                       temp);
+          }
+        }
+      else
         {
-        m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex,
-                                                     minDouble);
+        for ( size_t componentIndex = 0; componentIndex < numberOfComponents;
+              ++componentIndex )
+          {
+          m_ComponentVector[componentIndex]->SetWeight(measurementVectorIndex,
+                                                       minDouble);
+          }
         }
       }
-
-    ++iter;
-    ++measurementVectorIndex;
     }
-
-  return true;
 }
 
 template< typename TSample >
@@ -318,7 +403,7 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
 ::UpdateProportions()
 {
   size_t numberOfComponents = m_ComponentVector.size();
-  size_t sampleSize = m_Sample->Size();
+  size_t sampleSize = m_Frequencies.size();
   double totalFrequency = static_cast< double >( m_Sample->GetTotalFrequency() );
   size_t   i, j;
   double tempSum;
@@ -333,7 +418,7 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
       for ( j = 0; j < sampleSize; ++j )
         {
         tempSum += ( m_ComponentVector[i]->GetWeight(j)
-                     * m_Sample->GetFrequency(j) );
+                     * m_Frequencies[j] );
         }
 
       tempSum /= totalFrequency;
@@ -356,6 +441,25 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
 {
   m_Proportions = m_InitialProportions;
 
+  // copy the measurement vectors and their frequencies, so that the
+  // iterations don't go through the sample
+  const typename TSample::MeasurementVectorSizeType measurementVectorSize =
+    m_Sample->GetMeasurementVectorSize();
+  m_Measurements.clear();
+  m_Measurements.reserve( m_Sample->Size() * measurementVectorSize );
+  m_Frequencies.clear();
+  m_Frequencies.reserve( m_Sample->Size() );
+  for ( typename TSample::ConstIterator iter = m_Sample->Begin();
+        iter != m_Sample->End(); ++iter )
+    {
+    const MeasurementVectorType & mvector = iter.GetMeasurementVector();
+    for ( unsigned int d = 0; d < measurementVectorSize; ++d )
+      {
+      m_Measurements.push_back( mvector[d] );
+      }
+    m_Frequencies.push_back( iter.GetFrequency() );
+    }
+
   int iteration = 0;
   m_CurrentIteration = 0;
   while ( iteration < m_MaxIteration )
@@ -375,6 +479,10 @@ ExpectationMaximizationMixtureModelEstimator< TSample >
     }
 
   m_TerminationCode = NOT_CONVERGED;
+
+  // release the copy of the sample
+  std::vector< MeasurementType >().swap(m_Measurements);
+  std::vector< FrequencyType >().swap(m_Frequencies);
 }
 
 template< typename TSample >
@@ -20,6 +20,8 @@
 
 #include "itkGaussianMembershipFunction.h"
 
+#include <algorithm>
+
 namespace itk
 {
 namespace Statistics
@@ -182,6 +184,81 @@ GaussianMembershipFunction< TMeasurementVector >
   return m_PreFactor * temp;
 }
 
+template< typename TMeasurementVector >
+void
+GaussianMembershipFunction< TMeasurementVector >
+::EvaluateBlock(const MeasurementType *measurements,
+                SizeValueType numberOfMeasurements,
+                double *densities) const
+{
+  const MeasurementVectorSizeType measurementVectorSize =
+    this->GetMeasurementVectorSize();
+
+  if ( m_InverseCovariance.Rows() != measurementVectorSize
+       || NumericTraits< MeanVectorType >::GetLength(m_Mean) != measurementVectorSize )
+    {
+    itkExceptionMacro(<< "The mean and the covariance must have the length"
+                      << " of the measurement vectors.");
+    }
+
+  // The quadratic form is symmetric, so only the upper triangle of the
+  // inverse covariance is used, with the off-diagonal elements counted twice.
+  std::vector< double > upperTriangle;
+  upperTriangle.reserve( measurementVectorSize * ( measurementVectorSize + 1 ) / 2 );
+  for ( MeasurementVectorSizeType r = 0; r < measurementVectorSize; ++r )
+    {
+    upperTriangle.push_back( m_InverseCovariance(r, r) );
+    for ( MeasurementVectorSizeType c = r + 1; c < measurementVectorSize; ++c )
+      {
+      upperTriangle.push_back( m_InverseCovariance(r, c) + m_InverseCovariance(c, r) );
+      }
+    }
+
+  // The differences to the mean are stored one component after the other,
+  // so that the inner loops run over the measurement vectors of a block.
+  const SizeValueType   blockSize = 64;
+  std::vector< double > differences( measurementVectorSize * blockSize );
+  std::vector< double > quadraticForms( blockSize );
+  double *              quadraticForm = &quadraticForms[0];
+
+  for ( SizeValueType blockStart = 0; blockStart < numberOfMeasurements; blockStart += blockSize )
+    {
+    const SizeValueType count = std::min( blockSize, numberOfMeasurements - blockStart );
+    const MeasurementType *block = measurements + blockStart * measurementVectorSize;
+
+    for ( MeasurementVectorSizeType c = 0; c < measurementVectorSize; ++c )
+      {
+      double *     difference = &differences[c * blockSize];
+      const double mean = m_Mean[c];
+      for ( SizeValueType i = 0; i < count; ++i )
+        {
+        difference[i] = static_cast< double >( block[i * measurementVectorSize + c] ) - mean;
+        }
+      }
+
+    std::fill( quadraticForm, quadraticForm + count, 0.0 );
+    unsigned int coefficientIndex = 0;
+    for ( MeasurementVectorSizeType r = 0; r < measurementVectorSize; ++r )
+      {
+      const double *rowDifference = &differences[r * blockSize];
+      for ( MeasurementVectorSizeType c = r; c < measurementVectorSize; ++c )
+        {
+        const double *columnDifference = &differences[c * blockSize];
+        const double  coefficient = upperTriangle[coefficientIndex++];
+        for ( SizeValueType i = 0; i < count; ++i )
+          {
+          quadraticForm[i] += coefficient * rowDifference[i] * columnDifference[i];
+          }
+        }
+      }
+
+    for ( SizeValueType i = 0; i < count; ++i )
+      {
+      densities[blockStart + i] = m_PreFactor * std::exp(-0.5 * quadraticForm[i]);
+      }
+    }
+}
+
 template< typename TVector >
 typename LightObject::Pointer
 GaussianMembershipFunction< TVector >
@@ -67,6 +67,8 @@ public:
   typedef typename HistogramType::SizeType              HistogramSizeType;
   typedef typename HistogramType::MeasurementType       HistogramMeasurementType;
   typedef typename HistogramType::MeasurementVectorType HistogramMeasurementVectorType;
+  typedef typename HistogramType::AbsoluteFrequencyType AbsoluteFrequencyType;
+  typedef typename HistogramType::InstanceIdentifier    InstanceIdentifier;
 
 public:
 
@@ -134,6 +136,14 @@ protected:
   virtual void ThreadedComputeMinimumAndMaximum( const RegionType & inputRegionForThread, ThreadIdType threadId, ProgressReporter & progress );
   virtual void ThreadedComputeHistogram( const RegionType & inputRegionForThread, ThreadIdType threadId, ProgressReporter & progress );
 
+  /** Increase by one the frequency of the bin of the measurement in the
+   * histogram of the thread. The bins set by Histogram::Initialize() are
+   * uniform, so the bin is found with a multiplication and only checked
+   * against the bin bounds, which is faster than Histogram::GetIndex().
+   * The measurements outside of the histogram are ignored. */
+  void IncreaseFrequencyOfMeasurement( const HistogramMeasurementVectorType & m, ThreadIdType threadId,
+                                       AbsoluteFrequencyType value = 1 );
+
   std::vector< HistogramPointer >               m_Histograms;
   std::vector< HistogramMeasurementVectorType > m_Minimums;
   std::vector< HistogramMeasurementVectorType > m_Maximums;
@@ -143,7 +153,48 @@ private:
   void operator=(const Self &);         //purposely not implemented
 
   void ApplyMarginalScale( HistogramMeasurementVectorType & min, HistogramMeasurementVectorType & max, HistogramSizeType & size );
+
+  /** Count the pixels of each value in the region of the thread. */
+  void ThreadedCountValues( const RegionType & inputRegionForThread, ThreadIdType threadId, ProgressReporter & progress,
+                            unsigned int progressStepsPerPixel );
+
+  /** Prepare the bin search for the histogram of the thread, once it is
+   * initialized. */
+  void InitializeBinning( ThreadIdType threadId );
+
+  /** Add the histograms of the threads to the one of the first thread,
+   * pairwise, in log2(number of threads) steps. Each step merges its
+   * pairs of histograms on several threads. This runs after the threaded
+   * part, so that no thread waits for a thread that was aborted. */
+  void MergeHistograms();
+
+  /** Add the histogram threadId + step to the histogram threadId. */
+  void MergeHistogramPair( ThreadIdType threadId, ThreadIdType step );
+
+  struct MergeThreadStruct
+  {
+    Self *       Filter;
+    ThreadIdType Step;
+  };
+
+  static ITK_THREAD_RETURN_TYPE MergeHistogramsThreaderCallback( void *arg );
+
+  /** Bin search data for the histogram of a thread. */
+  struct BinningType
+  {
+    std::vector< HistogramMeasurementType > InverseBinWidth;
+    std::vector< InstanceIdentifier >       Stride;
+  };
+
   typename Barrier::Pointer                     m_Barrier;
+  std::vector< BinningType >                    m_Binnings;
+
+  /** For the scalar images with 8 or 16 bit integer pixels, the number
+   * of pixels of each value is counted while computing the minimum and
+   * maximum, and the histogram is then built from these counts, so the
+   * image is read only once. */
+  bool                                          m_CountValues;
+  std::vector< std::vector< SizeValueType > >   m_ValueCounts;
 
 };
 } // end of namespace Statistics
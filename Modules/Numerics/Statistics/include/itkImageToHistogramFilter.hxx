@@ -120,6 +120,13 @@ ImageToHistogramFilter< TImage >
   m_Maximums.resize(nbOfThreads);
   m_Barrier = Barrier::New();
   m_Barrier->Initialize(nbOfThreads);
+
+  m_Binnings.resize(nbOfThreads);
+  m_CountValues = this->GetInput()->GetNumberOfComponentsPerPixel() == 1
+                  && NumericTraits< ValueType >::is_integer
+                  && sizeof( ValueType ) <= 2;
+  m_ValueCounts.clear();
+  m_ValueCounts.resize(nbOfThreads);
 }
 
 
@@ -222,6 +229,7 @@ ImageToHistogramFilter< TImage >
   // finally, initialize the histogram
   hist->SetMeasurementVectorSize( nbOfComponents );
   hist->Initialize( size, min, max );
+  this->InitializeBinning( threadId );
 
   // now fill the histograms
   this->ThreadedComputeHistogram( inputRegionForThread, threadId, progress );
@@ -231,29 +239,173 @@ ImageToHistogramFilter< TImage >
 template< typename TImage >
 void
 ImageToHistogramFilter< TImage >
-::AfterThreadedGenerateData()
+::InitializeBinning( ThreadIdType threadId )
 {
-  // group the results in the output histogram
-  HistogramType * hist = m_Histograms[0];
-  typename HistogramType::IndexType index;
-  for( unsigned int i=1; i<m_Histograms.size(); i++ )
+  const HistogramType * hist = m_Histograms[threadId];
+  BinningType & binning = m_Binnings[threadId];
+  const unsigned int nbOfComponents = hist->GetMeasurementVectorSize();
+
+  binning.InverseBinWidth.resize( nbOfComponents );
+  binning.Stride.resize( nbOfComponents );
+  InstanceIdentifier stride = 1;
+  for( unsigned int i=0; i<nbOfComponents; i++ )
     {
-    typedef typename HistogramType::ConstIterator         HistogramIterator;
+    const SizeValueType nbOfBins = hist->GetSize(i);
+    const HistogramMeasurementType range = hist->GetBinMax( i, nbOfBins - 1 ) - hist->GetBinMin( i, 0 );
+    binning.InverseBinWidth[i] = NumericTraits< HistogramMeasurementType >::ZeroValue();
+    if( range > NumericTraits< HistogramMeasurementType >::ZeroValue() )
+      {
+      binning.InverseBinWidth[i] = static_cast< HistogramMeasurementType >( nbOfBins ) / range;
+      }
+    binning.Stride[i] = stride;
+    stride *= nbOfBins;
+    }
+}
+
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::IncreaseFrequencyOfMeasurement( const HistogramMeasurementVectorType & m, ThreadIdType threadId,
+                                  AbsoluteFrequencyType value )
+{
+  HistogramType * hist = m_Histograms[threadId];
+  const BinningType & binning = m_Binnings[threadId];
+  const typename HistogramType::BinMinContainerType & mins = hist->GetMins();
+  const typename HistogramType::BinMaxContainerType & maxs = hist->GetMaxs();
+  const bool clipBinsAtEnds = hist->GetClipBinsAtEnds();
+
+  InstanceIdentifier id = 0;
+  for( unsigned int i=0; i<binning.Stride.size(); i++ )
+    {
+    const typename HistogramType::BinMinVectorType & binMins = mins[i];
+    const typename HistogramType::BinMaxVectorType & binMaxs = maxs[i];
+    const HistogramMeasurementType v = m[i];
+    const SizeValueType last = binMins.size() - 1;
+    SizeValueType bin;
+
+    if( v < binMins[0] )
+      {
+      if( clipBinsAtEnds )
+        {
+        return;
+        }
+      bin = 0;
+      }
+    else if( v >= binMaxs[last] )
+      {
+      // the maximum is included in the last bin
+      if( clipBinsAtEnds && v != binMaxs[last] )
+        {
+        return;
+        }
+      bin = last;
+      }
+    else if( v >= binMins[0] )
+      {
+      // guess the bin, and fix the rounding errors with the bin bounds
+      bin = static_cast< SizeValueType >( ( v - binMins[0] ) * binning.InverseBinWidth[i] );
+      if( bin > last )
+        {
+        bin = last;
+        }
+      while( bin > 0 && v < binMins[bin] )
+        {
+        --bin;
+        }
+      while( v >= binMaxs[bin] )
+        {
+        ++bin;
+        }
+      }
+    else
+      {
+      // not a number
+      return;
+      }
+    id += bin * binning.Stride[i];
+    }
+  hist->IncreaseFrequency( id, value );
+}
+
 
-    HistogramIterator hit = m_Histograms[i]->Begin();
-    HistogramIterator end = m_Histograms[i]->End();
-    while ( hit != end )
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::MergeHistograms()
+{
+  const ThreadIdType nbOfHistograms = static_cast< ThreadIdType >( m_Histograms.size() );
+  for( ThreadIdType step = 1; step < nbOfHistograms; step *= 2 )
+    {
+    // the histograms 0, 2*step, 4*step... receive the next one of the step
+    const ThreadIdType nbOfPairs = ( nbOfHistograms - step + 2 * step - 1 ) / ( 2 * step );
+    if( nbOfPairs == 1 )
       {
-      hist->GetIndex( hit.GetMeasurementVector(), index);
-      hist->IncreaseFrequencyOfIndex( index, hit.GetFrequency() );
-      ++hit;
+      this->MergeHistogramPair( 0, step );
+      }
+    else
+      {
+      MergeThreadStruct str;
+      str.Filter = this;
+      str.Step = step;
+
+      MultiThreader::Pointer threader = MultiThreader::New();
+      threader->SetNumberOfThreads( nbOfPairs );
+      threader->SetSingleMethod( this->MergeHistogramsThreaderCallback, &str );
+      threader->SingleMethodExecute();
       }
     }
+}
+
+
+template< typename TImage >
+ITK_THREAD_RETURN_TYPE
+ImageToHistogramFilter< TImage >
+::MergeHistogramsThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const MergeThreadStruct *        str = static_cast< MergeThreadStruct * >( info->UserData );
+
+  str->Filter->MergeHistogramPair( 2 * str->Step * info->ThreadID, str->Step );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::MergeHistogramPair( ThreadIdType threadId, ThreadIdType step )
+{
+  // all the histograms have the same bins, so they are added bin by bin
+  HistogramType * hist = m_Histograms[threadId];
+  const HistogramType * other = m_Histograms[threadId + step];
+  const InstanceIdentifier nbOfBins = hist->Size();
+  for( InstanceIdentifier id = 0; id < nbOfBins; id++ )
+    {
+    const AbsoluteFrequencyType frequency = other->GetFrequency( id );
+    if( frequency != NumericTraits< AbsoluteFrequencyType >::ZeroValue() )
+      {
+      hist->IncreaseFrequency( id, frequency );
+      }
+    }
+}
+
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::AfterThreadedGenerateData()
+{
+  // group the results in the output histogram
+  this->MergeHistograms();
 
   // and drop the temporary histograms
   m_Histograms.clear();
   m_Minimums.clear();
   m_Maximums.clear();
+  m_Binnings.clear();
+  m_ValueCounts.clear();
   m_Barrier = ITK_NULLPTR;
 }
 
@@ -267,6 +419,29 @@ ImageToHistogramFilter< TImage >
   HistogramMeasurementVectorType min( nbOfComponents );
   HistogramMeasurementVectorType max( nbOfComponents );
 
+  if( m_CountValues )
+    {
+    // this pass replaces the one over the pixels to fill the histogram
+    this->ThreadedCountValues( inputRegionForThread, threadId, progress, 2 );
+
+    const std::vector< SizeValueType > & counts = m_ValueCounts[threadId];
+    SizeValueType first = 0;
+    SizeValueType last = counts.size() - 1;
+    while( first < last && counts[first] == 0 )
+      {
+      first++;
+      }
+    while( last > first && counts[last] == 0 )
+      {
+      last--;
+      }
+    min.Fill( static_cast< ValueType >( NumericTraits< ValueType >::NonpositiveMin() + first ) );
+    max.Fill( static_cast< ValueType >( NumericTraits< ValueType >::NonpositiveMin() + last ) );
+    m_Minimums[threadId] = min;
+    m_Maximums[threadId] = max;
+    return;
+    }
+
   ImageRegionConstIterator< TImage > inputIt( this->GetInput(), inputRegionForThread );
   inputIt.GoToBegin();
   HistogramMeasurementVectorType m( nbOfComponents );
@@ -295,22 +470,70 @@ ImageToHistogramFilter< TImage >
 ::ThreadedComputeHistogram(const RegionType & inputRegionForThread, ThreadIdType threadId, ProgressReporter & progress )
 {
   unsigned int nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  HistogramMeasurementVectorType m( nbOfComponents );
+
+  if( m_CountValues )
+    {
+    // the values may have been counted with the minimum and maximum
+    if( m_ValueCounts[threadId].empty() )
+      {
+      this->ThreadedCountValues( inputRegionForThread, threadId, progress, 1 );
+      }
+
+    // and each value is added to the histogram only once
+    const std::vector< SizeValueType > & counts = m_ValueCounts[threadId];
+    for( SizeValueType i=0; i<counts.size(); i++ )
+      {
+      if( counts[i] != 0 )
+        {
+        m[0] = static_cast< ValueType >( NumericTraits< ValueType >::NonpositiveMin() + i );
+        this->IncreaseFrequencyOfMeasurement( m, threadId, counts[i] );
+        }
+      }
+    m_ValueCounts[threadId].clear();
+    return;
+    }
+
   ImageRegionConstIterator< TImage > inputIt( this->GetInput(), inputRegionForThread );
   inputIt.GoToBegin();
-  HistogramMeasurementVectorType m( nbOfComponents );
 
-  typename HistogramType::IndexType index;
   while ( !inputIt.IsAtEnd() )
     {
     const PixelType & p = inputIt.Get();
     NumericTraits<PixelType>::AssignToArray( p, m );
-    m_Histograms[threadId]->GetIndex( m, index );
-    m_Histograms[threadId]->IncreaseFrequencyOfIndex( index, 1 );
+    this->IncreaseFrequencyOfMeasurement( m, threadId );
     ++inputIt;
     progress.CompletedPixel();  // potential exception thrown here
     }
 }
 
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::ThreadedCountValues(const RegionType & inputRegionForThread, ThreadIdType threadId, ProgressReporter & progress,
+                      unsigned int progressStepsPerPixel )
+{
+  std::vector< SizeValueType > & counts = m_ValueCounts[threadId];
+  counts.assign( static_cast< SizeValueType >( NumericTraits< ValueType >::max() )
+                 - static_cast< SizeValueType >( NumericTraits< ValueType >::NonpositiveMin() ) + 1, 0 );
+
+  ImageRegionConstIterator< TImage > inputIt( this->GetInput(), inputRegionForThread );
+  inputIt.GoToBegin();
+  HistogramMeasurementVectorType m( 1 );
+
+  while ( !inputIt.IsAtEnd() )
+    {
+    const PixelType & p = inputIt.Get();
+    NumericTraits<PixelType>::AssignToArray( p, m );
+    counts[ static_cast< SizeValueType >( static_cast< ValueType >( m[0] ) - NumericTraits< ValueType >::NonpositiveMin() ) ]++;
+    ++inputIt;
+    for( unsigned int i=0; i<progressStepsPerPixel; i++ )
+      {
+      progress.CompletedPixel();  // potential exception thrown here
+      }
+    }
+}
+
 template< typename TImage >
 void
 ImageToHistogramFilter< TImage >
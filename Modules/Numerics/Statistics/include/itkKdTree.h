@@ -25,6 +25,7 @@
 #include "itkSize.h"
 #include "itkObject.h"
 #include "itkArray.h"
+#include "itkMultiThreader.h"
 
 #include "itkSubsample.h"
 
@@ -465,7 +466,9 @@ private:
  * To search k-nearest neighbor, call the Search method with the query
  * point in a k-d space and the number of nearest neighbors. The
  * GetSearchResult method returns a pointer to a NearestNeighbors object
- * with k-nearest neighbors.
+ * with k-nearest neighbors. To search the neighbors of many query points,
+ * call the Search method with a container of query points: the queries
+ * are then shared between NumberOfThreads threads.
  *
  * <b>Recent API changes:</b>
  * The static const macro to get the length of a measurement vector,
@@ -686,6 +689,36 @@ public:
   void Search( const MeasurementVectorType &, double,
     InstanceIdentifierVectorType & ) const;
 
+  /** Container of query points for the batched searches */
+  typedef std::vector< MeasurementVectorType > MeasurementVectorContainerType;
+
+  /** The k-nearest neighbors of each query point of a batched search, and
+   * their distances */
+  typedef std::vector< InstanceIdentifierVectorType > InstanceIdentifierVectorContainerType;
+  typedef std::vector< std::vector< double > >        DistanceVectorContainerType;
+
+  /** Set/Get the number of threads the batched searches are shared
+   * between. Defaults to the global default number of threads of the
+   * MultiThreader. */
+  itkSetClampMacro( NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS );
+  itkGetConstMacro( NumberOfThreads, ThreadIdType );
+
+  /** Searches the k-nearest neighbors of each query point. The results are
+   * the same as with one search per query point.
+   *
+   * The measurement vectors are first copied into a contiguous array,
+   * which the threads read instead of the sample. This is only possible
+   * when the instance identifiers of the sample go from 0 to Size() - 1;
+   * otherwise the queries are searched on a single thread, because
+   * samples like the image adaptors can't be read from several threads. */
+  void Search( const MeasurementVectorContainerType &, unsigned int,
+    InstanceIdentifierVectorContainerType & ) const;
+
+  /** Searches the k-nearest neighbors of each query point and returns
+   *  their distances. */
+  void Search( const MeasurementVectorContainerType &, unsigned int,
+    InstanceIdentifierVectorContainerType &, DistanceVectorContainerType & ) const;
+
   /** Returns true if the intermediate k-nearest neighbors exist within
    * the the bounding box defined by the lowerBound and the
    * upperBound. Otherwise returns false. Returns false if the ball
@@ -743,6 +776,37 @@ private:
   KdTree( const Self & );         //purposely not implemented
   void operator=( const Self & ); //purposely not implemented
 
+  struct SearchThreadStruct
+  {
+    const Self *                            Tree;
+    const MeasurementVectorContainerType *  Queries;
+    unsigned int                            NumberOfNeighbors;
+    const MeasurementType *                 Coordinates;
+    InstanceIdentifierVectorContainerType * Results;
+    DistanceVectorContainerType *           Distances;
+  };
+
+  static ITK_THREAD_RETURN_TYPE SearchThreaderCallback( void *arg );
+
+  /** Searches the k-nearest neighbors of the queries in [begin, end) */
+  void ThreadedSearch( const SearchThreadStruct *, SizeValueType,
+    SizeValueType ) const;
+
+  /** Initializes the bounds of the search to the whole space */
+  void InitializeSearchBounds( MeasurementVectorType &,
+    MeasurementVectorType & ) const;
+
+  /** search loop, reading the measurement vectors from the array of
+   * coordinates when there is one, or from the sample */
+  int NearestNeighborSearchLoop( const KdTreeNodeType *,
+    const MeasurementVectorType &, MeasurementVectorType &,
+    MeasurementVectorType &, NearestNeighbors &,
+    const MeasurementType * ) const;
+
+  /** Distance between the query and a measurement vector of the sample */
+  double EvaluateDistance( const MeasurementVectorType &, InstanceIdentifier,
+    const MeasurementType * ) const;
+
   /** Pointer to the input sample */
   const TSample *m_Sample;
 
@@ -760,6 +824,9 @@ private:
 
   /** Measurement vector size */
   MeasurementVectorSizeType m_MeasurementVectorSize;
+
+  /** Number of threads of the batched searches */
+  ThreadIdType m_NumberOfThreads;
 };  // end of class
 } // end of namespace Statistics
 } // end of namespace itk
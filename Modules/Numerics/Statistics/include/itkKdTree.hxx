@@ -86,6 +86,7 @@ KdTree<TSample>
   this->m_Root = ITK_NULLPTR;
   this->m_BucketSize = 16;
   this->m_MeasurementVectorSize = 0;
+  this->m_NumberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
 }
 
 template<typename TSample>
@@ -127,6 +128,7 @@ KdTree<TSample>
     }
   os << indent << "MeasurementVectorSize: "
      << this->m_MeasurementVectorSize << std::endl;
+  os << indent << "NumberOfThreads: " << this->m_NumberOfThreads << std::endl;
 }
 
 template<typename TSample>
@@ -210,6 +212,151 @@ KdTree<TSample>
 
   MeasurementVectorType lowerBound;
   MeasurementVectorType upperBound;
+  this->InitializeSearchBounds( lowerBound, upperBound );
+  this->NearestNeighborSearchLoop( this->m_Root, query, lowerBound, upperBound,
+    nearestNeighbors );
+
+  result = nearestNeighbors.GetNeighbors();
+  distances = nearestNeighbors.GetDistances();
+}
+
+template<typename TSample>
+void
+KdTree<TSample>
+::Search( const MeasurementVectorContainerType & queries,
+  unsigned int numberOfNeighborsRequested,
+  InstanceIdentifierVectorContainerType & results ) const
+{
+  DistanceVectorContainerType not_used_distances;
+  this->Search( queries, numberOfNeighborsRequested, results, not_used_distances );
+}
+
+template<typename TSample>
+void
+KdTree<TSample>
+::Search( const MeasurementVectorContainerType & queries,
+  unsigned int numberOfNeighborsRequested,
+  InstanceIdentifierVectorContainerType & results,
+  DistanceVectorContainerType & distances ) const
+{
+  if( numberOfNeighborsRequested > this->Size() )
+    {
+    itkExceptionMacro( "The numberOfNeighborsRequested for the nearest "
+      << "neighbor search should be less than or equal to the number of "
+      << "the measurement vectors." );
+    }
+
+  for( SizeValueType q = 0; q < queries.size(); ++q )
+    {
+    if( NumericTraits<MeasurementVectorType>::GetLength( queries[q] ) != this->m_MeasurementVectorSize )
+      {
+      itkExceptionMacro( "The query " << q << " doesn't have the length of the "
+        << "measurement vectors of the tree." );
+      }
+    }
+
+  results.resize( queries.size() );
+  distances.resize( queries.size() );
+
+  SearchThreadStruct str;
+  str.Tree = this;
+  str.Queries = &queries;
+  str.NumberOfNeighbors = numberOfNeighborsRequested;
+  str.Coordinates = ITK_NULLPTR;
+  str.Results = &results;
+  str.Distances = &distances;
+
+  ThreadIdType numberOfThreads = std::min( this->m_NumberOfThreads,
+    static_cast< ThreadIdType >( std::max( queries.size(),
+    static_cast< typename MeasurementVectorContainerType::size_type >( 1 ) ) ) );
+
+  // Copy the measurement vectors, in the order of their instance
+  // identifiers, so that the threads don't read the sample
+  std::vector< MeasurementType > coordinates;
+  if( numberOfThreads > 1 )
+    {
+    coordinates.reserve( this->Size() * this->m_MeasurementVectorSize );
+    InstanceIdentifier id = 0;
+    for( ConstIterator it = this->m_Sample->Begin(); it != this->m_Sample->End(); ++it, ++id )
+      {
+      if( it.GetInstanceIdentifier() != id )
+        {
+        break;
+        }
+      const MeasurementVectorType & measurement = it.GetMeasurementVector();
+      for( unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d )
+        {
+        coordinates.push_back( measurement[d] );
+        }
+      }
+    if( coordinates.size() == this->Size() * this->m_MeasurementVectorSize )
+      {
+      str.Coordinates = &coordinates[0];
+      }
+    else
+      {
+      numberOfThreads = 1;
+      }
+    }
+
+  if( numberOfThreads == 1 )
+    {
+    this->ThreadedSearch( &str, 0, queries.size() );
+    }
+  else
+    {
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads( numberOfThreads );
+    threader->SetSingleMethod( this->SearchThreaderCallback, &str );
+    threader->SingleMethodExecute();
+    }
+}
+
+template<typename TSample>
+ITK_THREAD_RETURN_TYPE
+KdTree<TSample>
+::SearchThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const SearchThreadStruct *       str = static_cast< SearchThreadStruct * >( info->UserData );
+
+  // contiguous blocks of queries, one per thread
+  const SizeValueType numberOfQueries = str->Queries->size();
+  const SizeValueType begin = numberOfQueries * info->ThreadID / info->NumberOfThreads;
+  const SizeValueType end = numberOfQueries * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  str->Tree->ThreadedSearch( str, begin, end );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template<typename TSample>
+void
+KdTree<TSample>
+::ThreadedSearch( const SearchThreadStruct *str, SizeValueType begin,
+  SizeValueType end ) const
+{
+  NearestNeighbors nearestNeighbors;
+
+  MeasurementVectorType lowerBound;
+  MeasurementVectorType upperBound;
+  for( SizeValueType q = begin; q < end; ++q )
+    {
+    nearestNeighbors.resize( str->NumberOfNeighbors );
+    this->InitializeSearchBounds( lowerBound, upperBound );
+    this->NearestNeighborSearchLoop( this->m_Root, ( *str->Queries )[q],
+      lowerBound, upperBound, nearestNeighbors, str->Coordinates );
+
+    ( *str->Results )[q] = nearestNeighbors.GetNeighbors();
+    ( *str->Distances )[q] = nearestNeighbors.GetDistances();
+    }
+}
+
+template<typename TSample>
+void
+KdTree<TSample>
+::InitializeSearchBounds( MeasurementVectorType & lowerBound,
+  MeasurementVectorType & upperBound ) const
+{
   NumericTraits<MeasurementVectorType>::SetLength( lowerBound,
     this->m_MeasurementVectorSize );
   NumericTraits<MeasurementVectorType>::SetLength( upperBound,
@@ -223,11 +370,29 @@ KdTree<TSample>
     upperBound[d] = static_cast< MeasurementType >( std::sqrt(
       static_cast<double >( NumericTraits< MeasurementType >::max() ) / 2.0 ) );
     }
-  this->NearestNeighborSearchLoop( this->m_Root, query, lowerBound, upperBound,
-    nearestNeighbors );
+}
 
-  result = nearestNeighbors.GetNeighbors();
-  distances = nearestNeighbors.GetDistances();
+template<typename TSample>
+inline double
+KdTree<TSample>
+::EvaluateDistance( const MeasurementVectorType & query, InstanceIdentifier id,
+  const MeasurementType *coordinates ) const
+{
+  if( coordinates == ITK_NULLPTR )
+    {
+    return this->m_DistanceMetric->Evaluate( query,
+      this->m_Sample->GetMeasurementVector( id ) );
+    }
+
+  // same computation as the EuclideanDistanceMetric
+  const MeasurementType *measurement = coordinates + id * this->m_MeasurementVectorSize;
+  double sumOfSquares = NumericTraits< double >::ZeroValue();
+  for( unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d )
+    {
+    const double temp = query[d] - measurement[d];
+    sumOfSquares += temp * temp;
+    }
+  return std::sqrt( sumOfSquares );
 }
 
 template<typename TSample>
@@ -236,6 +401,18 @@ KdTree<TSample>
 ::NearestNeighborSearchLoop( const KdTreeNodeType *node,
   const MeasurementVectorType &query, MeasurementVectorType &lowerBound,
   MeasurementVectorType &upperBound, NearestNeighbors &nearestNeighbors ) const
+{
+  return this->NearestNeighborSearchLoop( node, query, lowerBound, upperBound,
+    nearestNeighbors, ITK_NULLPTR );
+}
+
+template<typename TSample>
+inline int
+KdTree<TSample>
+::NearestNeighborSearchLoop( const KdTreeNodeType *node,
+  const MeasurementVectorType &query, MeasurementVectorType &lowerBound,
+  MeasurementVectorType &upperBound, NearestNeighbors &nearestNeighbors,
+  const MeasurementType *coordinates ) const
 {
   unsigned int       i;
   InstanceIdentifier tempId;
@@ -253,8 +430,7 @@ KdTree<TSample>
     for(  i = 0; i < node->Size(); ++i )
       {
       tempId = node->GetInstanceIdentifier(i);
-      tempDistance = this->m_DistanceMetric->Evaluate( query,
-        this->m_Sample->GetMeasurementVector( tempId ) );
+      tempDistance = this->EvaluateDistance( query, tempId, coordinates );
       if( tempDistance < nearestNeighbors.GetLargestDistance() )
         {
         nearestNeighbors.ReplaceFarthestNeighbor( tempId, tempDistance );
@@ -280,8 +456,7 @@ KdTree<TSample>
   // and potentially add it to the list of nearest neighbors
   //
   tempId = node->GetInstanceIdentifier(0);
-  tempDistance = this->m_DistanceMetric->Evaluate( query,
-    this->m_Sample->GetMeasurementVector( tempId ) );
+  tempDistance = this->EvaluateDistance( query, tempId, coordinates );
   if( tempDistance < nearestNeighbors.GetLargestDistance() )
     {
     nearestNeighbors.ReplaceFarthestNeighbor( tempId, tempDistance );
@@ -296,7 +471,7 @@ KdTree<TSample>
     tempValue = upperBound[partitionDimension];
     upperBound[partitionDimension] = partitionValue;
     if( this->NearestNeighborSearchLoop( node->Left(), query, lowerBound,
-      upperBound, nearestNeighbors ) )
+      upperBound, nearestNeighbors, coordinates ) )
       {
       return 1;
       }
@@ -309,7 +484,7 @@ KdTree<TSample>
       nearestNeighbors.GetLargestDistance() ) )
       {
       this->NearestNeighborSearchLoop( node->Right(), query, lowerBound,
-        upperBound, nearestNeighbors );
+        upperBound, nearestNeighbors, coordinates );
       }
     lowerBound[partitionDimension] = tempValue;
     }
@@ -319,7 +494,7 @@ KdTree<TSample>
     tempValue = lowerBound[partitionDimension];
     lowerBound[partitionDimension] = partitionValue;
     if( this->NearestNeighborSearchLoop( node->Right(), query, lowerBound,
-      upperBound, nearestNeighbors ) )
+      upperBound, nearestNeighbors, coordinates ) )
       {
       return 1;
       }
@@ -332,7 +507,7 @@ KdTree<TSample>
       nearestNeighbors.GetLargestDistance() ) )
       {
       this->NearestNeighborSearchLoop( node->Left(), query, lowerBound,
-        upperBound, nearestNeighbors );
+        upperBound, nearestNeighbors, coordinates );
       }
     upperBound[partitionDimension] = tempValue;
     }
@@ -355,20 +530,7 @@ KdTree<TSample>
 {
   MeasurementVectorType lowerBound;
   MeasurementVectorType upperBound;
-
-  NumericTraits<MeasurementVectorType>::SetLength( lowerBound,
-    this->m_MeasurementVectorSize );
-  NumericTraits<MeasurementVectorType>::SetLength( upperBound,
-    this->m_MeasurementVectorSize );
-
-  for(  unsigned int d = 0; d < this->m_MeasurementVectorSize; ++d )
-    {
-    lowerBound[d] = static_cast<MeasurementType>( -std::sqrt(
-      -static_cast<double>( NumericTraits<MeasurementType>::
-      NonpositiveMin() ) ) / 2.0 );
-    upperBound[d] = static_cast< MeasurementType >( std::sqrt(
-      static_cast<double>( NumericTraits< MeasurementType >::max() ) / 2.0 ) );
-    }
+  this->InitializeSearchBounds( lowerBound, upperBound );
 
   result.clear();
   this->SearchLoop( this->m_Root, query, radius, lowerBound, upperBound, result );
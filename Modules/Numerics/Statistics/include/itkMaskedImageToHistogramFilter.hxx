@@ -86,15 +86,13 @@ MaskedImageToHistogramFilter< TImage, TMaskImage >
   HistogramMeasurementVectorType m( nbOfComponents );
   MaskPixelType maskValue = this->GetMaskValue();
 
-  typename HistogramType::IndexType index;
   while ( !inputIt.IsAtEnd() )
     {
     if( maskIt.Get() == maskValue )
       {
       const PixelType & p = inputIt.Get();
       NumericTraits<PixelType>::AssignToArray( p, m );
-      this->m_Histograms[threadId]->GetIndex( m, index );
-      this->m_Histograms[threadId]->IncreaseFrequencyOfIndex( index, 1 );
+      this->IncreaseFrequencyOfMeasurement( m, threadId );
       }
     ++inputIt;
     ++maskIt;
@@ -22,6 +22,8 @@
 #include "itkHistogram.h"
 #include "itkVectorContainer.h"
 #include "itkNumericTraits.h"
+#include "itkMultiThreader.h"
+#include "itkImageRegionSplitterBase.h"
 
 namespace itk
 {
@@ -68,6 +70,14 @@ namespace Statistics
  * for a given image, the max and min pixel values that will be placed in the
  * histogram can be set manually. NB: The min and max are INCLUSIVE.
  *
+ * The pixels are first given their bin, then the co-occurrence pairs of
+ * each offset are counted over pieces of the region on several threads,
+ * each thread with its own counts, which are added to the histogram at the
+ * end. The counts of a thread take NumberOfBinsPerAxis^2 elements; when
+ * there are too many bins, fewer threads are used, and when the
+ * histogram is too large, the pairs are added to it directly, on a
+ * single thread.
+ *
  * Further, the type of histogram frequency container used is an optional template
  * parameter. By default, a dense container is used, but for images with little
  * texture or in cases where the user wants more histogram bins, a sparse container
@@ -197,6 +207,37 @@ private:
 
   void NormalizeHistogram();
 
+  /** Bins of the pixels of the buffered region of the input along one axis
+   * of the histogram. The pixels outside the mask or out of [Min, Max] have
+   * the bin NumberOfBinsPerAxis, and are never counted. */
+  typedef std::vector< unsigned int > BinContainerType;
+
+  /** Counts of the co-occurrence pairs, indexed by instance identifier */
+  typedef std::vector< SizeValueType > PairCountContainerType;
+
+  struct ThreadStruct
+  {
+    Self                          *Filter;
+    const ImageType               *MaskImage;
+    RegionType                     Region;
+    const ImageRegionSplitterBase *Splitter;
+  };
+
+  /** Fills the histogram with the co-occurrence pairs of the pixels of the
+   * region that are inside the mask, if there is one. */
+  void ComputeHistogram(const RegionType & region, const ImageType *maskImage);
+
+  void ThreadedComputeBins(const RegionType & region, const ImageType *maskImage);
+
+  void ThreadedCountPairs(const RegionType & region, ThreadIdType threadId);
+
+  static ITK_THREAD_RETURN_TYPE ComputeBinsThreaderCallback(void *arg);
+
+  static ITK_THREAD_RETURN_TYPE CountPairsThreaderCallback(void *arg);
+
+  BinContainerType                      m_Bins;
+  std::vector< PairCountContainerType > m_PairCounts;
+
   OffsetVectorConstPointer m_Offsets;
   PixelType                m_Min;
   PixelType                m_Max;
@@ -20,7 +20,8 @@
 
 #include "itkScalarImageToCooccurrenceMatrixFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "vnl/vnl_math.h"
 
 namespace itk
@@ -202,147 +203,268 @@ ScalarImageToCooccurrenceMatrixFilter< TImageType,
 template< typename TImageType, typename THistogramFrequencyContainer >
 void
 ScalarImageToCooccurrenceMatrixFilter< TImageType,
-                                       THistogramFrequencyContainer >::FillHistogram(RadiusType radius,
+                                       THistogramFrequencyContainer >::FillHistogram(RadiusType itkNotUsed(radius),
                                                                                      RegionType region)
 {
-  // Iterate over all of those pixels and offsets, adding each
-  // co-occurrence pair to the histogram
+  this->ComputeHistogram(region, ITK_NULLPTR);
+}
 
+template< typename TImageType, typename THistogramFrequencyContainer >
+void
+ScalarImageToCooccurrenceMatrixFilter< TImageType,
+                                       THistogramFrequencyContainer >::FillHistogramWithMask(RadiusType itkNotUsed(radius),
+                                                                                             RegionType region,
+                                                                                             const ImageType *maskImage)
+{
+  this->ComputeHistogram(region, maskImage);
+}
+
+template< typename TImageType, typename THistogramFrequencyContainer >
+void
+ScalarImageToCooccurrenceMatrixFilter< TImageType,
+                                       THistogramFrequencyContainer >::ComputeHistogram(const RegionType & region,
+                                                                                        const ImageType *maskImage)
+{
   const ImageType *input = this->GetInput();
 
   HistogramType *output =
     static_cast< HistogramType * >( this->ProcessObject::GetOutput(0) );
 
-  typedef ConstNeighborhoodIterator< ImageType > NeighborhoodIteratorType;
-  NeighborhoodIteratorType neighborIt;
-  neighborIt = NeighborhoodIteratorType(radius, input, region);
-
-  MeasurementVectorType cooccur( output->GetMeasurementVectorSize() );
+  ImageRegionSplitterSlowDimension::Pointer splitter = ImageRegionSplitterSlowDimension::New();
+
+  ThreadStruct str;
+  str.Filter = this;
+  str.MaskImage = maskImage;
+  str.Splitter = splitter;
+
+  // Give each pixel of the buffered region its bin. The neighbors of the
+  // pixels of the region are looked for in the whole buffered region.
+  m_Bins.assign(input->GetBufferedRegion().GetNumberOfPixels(), m_NumberOfBinsPerAxis);
+  str.Region = input->GetBufferedRegion();
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  this->GetMultiThreader()->SetSingleMethod(this->ComputeBinsThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // Each thread counts the pairs in its own matrix of counts, as long as
+  // the matrices of all the threads fit in a reasonable amount of memory.
+  // Larger histograms are filled directly, on a single thread.
+  const SizeValueType maximumNumberOfCounts = 1 << 24;
+  const SizeValueType numberOfBins =
+    static_cast< SizeValueType >( m_NumberOfBinsPerAxis ) * m_NumberOfBinsPerAxis;
+  ThreadIdType numberOfThreads = 1;
+  if ( numberOfBins <= maximumNumberOfCounts )
+    {
+    numberOfThreads = std::max( std::min( this->GetNumberOfThreads(),
+                                          static_cast< ThreadIdType >( maximumNumberOfCounts / numberOfBins ) ),
+                                static_cast< ThreadIdType >( 1 ) );
+    m_PairCounts.resize(numberOfThreads);
+    }
+  str.Region = region;
+  if ( numberOfThreads == 1 )
+    {
+    this->ThreadedCountPairs(region, 0);
+    }
+  else
+    {
+    this->GetMultiThreader()->SetNumberOfThreads(numberOfThreads);
+    this->GetMultiThreader()->SetSingleMethod(this->CountPairsThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
 
-  for ( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
+  // Add the counts of the threads to the histogram
+  if ( !m_PairCounts.empty() )
     {
-    const PixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-    if ( centerPixelIntensity < m_Min
-         || centerPixelIntensity > m_Max )
+    PairCountContainerType & counts = m_PairCounts[0];
+    counts.resize(numberOfBins, 0);
+    for ( ThreadIdType threadId = 1; threadId < m_PairCounts.size(); ++threadId )
       {
-      continue; // don't put a pixel in the histogram if the value
-                // is out-of-bounds.
+      const PairCountContainerType & threadCounts = m_PairCounts[threadId];
+      for ( SizeValueType id = 0; id < threadCounts.size(); ++id )
+        {
+        counts[id] += threadCounts[id];
+        }
       }
-
-    typename OffsetVector::ConstIterator offsets;
-    typename HistogramType::IndexType index;
-    for ( offsets = m_Offsets->Begin(); offsets != m_Offsets->End(); offsets++ )
+    for ( SizeValueType id = 0; id < numberOfBins; ++id )
       {
-      bool            pixelInBounds;
-      const PixelType pixelIntensity =
-        neighborIt.GetPixel(offsets.Value(), pixelInBounds);
-
-      if ( !pixelInBounds )
+      if ( counts[id] != 0 )
         {
-        continue; // don't put a pixel in the histogram if it's out-of-bounds.
+        output->IncreaseFrequency(id, counts[id]);
         }
+      }
+    }
 
-      if ( pixelIntensity < m_Min
-           || pixelIntensity > m_Max )
-        {
-        continue; // don't put a pixel in the histogram if the value
-                  // is out-of-bounds.
-        }
+  m_Bins.clear();
+  m_PairCounts.clear();
+}
+
+template< typename TImageType, typename THistogramFrequencyContainer >
+ITK_THREAD_RETURN_TYPE
+ScalarImageToCooccurrenceMatrixFilter< TImageType,
+                                       THistogramFrequencyContainer >::ComputeBinsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  ThreadStruct *                   str = static_cast< ThreadStruct * >( info->UserData );
 
-      // Now make both possible co-occurrence combinations and increment the
-      // histogram with them.
+  const ThreadIdType total = str->Splitter->GetNumberOfSplits(str->Region, info->NumberOfThreads);
+  if ( info->ThreadID < total )
+    {
+    RegionType region = str->Region;
+    str->Splitter->GetSplit(info->ThreadID, total, region);
+    str->Filter->ThreadedComputeBins(region, str->MaskImage);
+    }
 
-      cooccur[0] = centerPixelIntensity;
-      cooccur[1] = pixelIntensity;
-      output->GetIndex( cooccur, index );
-      output->IncreaseFrequencyOfIndex( index, 1 );
+  return ITK_THREAD_RETURN_VALUE;
+}
 
-      cooccur[1] = centerPixelIntensity;
-      cooccur[0] = pixelIntensity;
-      output->GetIndex( cooccur, index );
-      output->IncreaseFrequencyOfIndex( index, 1 );
-      }
+template< typename TImageType, typename THistogramFrequencyContainer >
+ITK_THREAD_RETURN_TYPE
+ScalarImageToCooccurrenceMatrixFilter< TImageType,
+                                       THistogramFrequencyContainer >::CountPairsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  ThreadStruct *                   str = static_cast< ThreadStruct * >( info->UserData );
+
+  const ThreadIdType total = str->Splitter->GetNumberOfSplits(str->Region, info->NumberOfThreads);
+  if ( info->ThreadID < total )
+    {
+    RegionType region = str->Region;
+    str->Splitter->GetSplit(info->ThreadID, total, region);
+    str->Filter->ThreadedCountPairs(region, info->ThreadID);
     }
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
 template< typename TImageType, typename THistogramFrequencyContainer >
 void
 ScalarImageToCooccurrenceMatrixFilter< TImageType,
-                                       THistogramFrequencyContainer >::FillHistogramWithMask(RadiusType radius,
-                                                                                             RegionType region,
-                                                                                             const ImageType *maskImage)
+                                       THistogramFrequencyContainer >::ThreadedComputeBins(const RegionType & region,
+                                                                                           const ImageType *maskImage)
 {
-  // Iterate over all of those pixels and offsets, adding each
-  // co-occurrence pair to the histogram
+  const ImageType *input = this->GetInput();
+  const HistogramType *output = this->GetOutput();
+
+  // The pixels outside of the mask keep the bin that is never counted
+  RegionType croppedRegion = region;
+  if ( maskImage != ITK_NULLPTR && !croppedRegion.Crop( maskImage->GetBufferedRegion() ) )
+    {
+    return;
+    }
+
+  MeasurementVectorType measurement( output->GetMeasurementVectorSize() );
+  typename HistogramType::IndexType index( output->GetMeasurementVectorSize() );
+
+  ImageScanlineConstIterator< ImageType > it(input, croppedRegion);
+  ImageScanlineConstIterator< ImageType > maskIt;
+  if ( maskImage != ITK_NULLPTR )
+    {
+    maskIt = ImageScanlineConstIterator< ImageType >(maskImage, croppedRegion);
+    }
+  while ( !it.IsAtEnd() )
+    {
+    unsigned int *bin = &m_Bins[input->ComputeOffset( it.GetIndex() )];
+    while ( !it.IsAtEndOfLine() )
+      {
+      const PixelType pixelIntensity = it.Get();
+      if ( ( maskImage == ITK_NULLPTR || maskIt.Get() == m_InsidePixelValue )
+           && !( pixelIntensity < m_Min || pixelIntensity > m_Max ) )
+        {
+        // both axes have the same bins
+        measurement.Fill(pixelIntensity);
+        if ( output->GetIndex(measurement, index) )
+          {
+          *bin = index[0];
+          }
+        }
+      ++bin;
+      ++it;
+      if ( maskImage != ITK_NULLPTR )
+        {
+        ++maskIt;
+        }
+      }
+    it.NextLine();
+    if ( maskImage != ITK_NULLPTR )
+      {
+      maskIt.NextLine();
+      }
+    }
+}
 
+template< typename TImageType, typename THistogramFrequencyContainer >
+void
+ScalarImageToCooccurrenceMatrixFilter< TImageType,
+                                       THistogramFrequencyContainer >::ThreadedCountPairs(const RegionType & region,
+                                                                                          ThreadIdType threadId)
+{
   const ImageType *input = this->GetInput();
 
   HistogramType *output =
     static_cast< HistogramType * >( this->ProcessObject::GetOutput(0) );
 
-  // Iterate over all of those pixels and offsets, adding each
-  // co-occurrence pair to the histogram
-  typedef ConstNeighborhoodIterator< ImageType > NeighborhoodIteratorType;
-  NeighborhoodIteratorType neighborIt, maskNeighborIt;
-  neighborIt = NeighborhoodIteratorType(radius, input, region);
-  maskNeighborIt = NeighborhoodIteratorType(radius, maskImage, region);
-
-  MeasurementVectorType cooccur( output->GetMeasurementVectorSize() );
-  typename HistogramType::IndexType index;
-  for ( neighborIt.GoToBegin(), maskNeighborIt.GoToBegin();
-        !neighborIt.IsAtEnd(); ++neighborIt, ++maskNeighborIt )
+  const RegionType &   bufferedRegion = input->GetBufferedRegion();
+  const OffsetValueType *offsetTable = input->GetOffsetTable();
+  const unsigned int     numberOfBinsPerAxis = m_NumberOfBinsPerAxis;
+
+  PairCountContainerType *counts = ITK_NULLPTR;
+  if ( !m_PairCounts.empty() )
     {
-    if ( maskNeighborIt.GetCenterPixel() != m_InsidePixelValue )
+    counts = &m_PairCounts[threadId];
+    counts->assign(static_cast< SizeValueType >( numberOfBinsPerAxis ) * numberOfBinsPerAxis, 0);
+    }
+
+  typename OffsetVector::ConstIterator offsets;
+  for ( offsets = m_Offsets->Begin(); offsets != m_Offsets->End(); offsets++ )
+    {
+    const OffsetType & offset = offsets.Value();
+
+    // Only the pixels whose neighbor at this offset is in the buffered
+    // region make a pair
+    RegionType shiftedRegion = bufferedRegion;
+    shiftedRegion.SetIndex(bufferedRegion.GetIndex() - offset);
+    RegionType pairRegion = region;
+    if ( !pairRegion.Crop(bufferedRegion) || !pairRegion.Crop(shiftedRegion) )
       {
-      continue; // Go to the next loop if we're not in the mask
+      continue;
       }
 
-    const PixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-
-    if ( centerPixelIntensity < this->GetMin()
-         || centerPixelIntensity > this->GetMax() )
+    OffsetValueType neighborOffset = 0;
+    for ( unsigned int i = 0; i < ImageType::ImageDimension; ++i )
       {
-      continue; // don't put a pixel in the histogram if the value
-                // is out-of-bounds.
+      neighborOffset += offset[i] * offsetTable[i];
       }
 
-    typename OffsetVector::ConstIterator offsets;
-    for ( offsets = this->GetOffsets()->Begin(); offsets != this->GetOffsets()->End(); offsets++ )
+    const SizeValueType lineLength = pairRegion.GetSize(0);
+    ImageScanlineConstIterator< ImageType > it(input, pairRegion);
+    while ( !it.IsAtEnd() )
       {
-      if ( maskNeighborIt.GetPixel( offsets.Value() ) != m_InsidePixelValue )
+      const unsigned int *bin = &m_Bins[input->ComputeOffset( it.GetIndex() )];
+      const unsigned int *neighborBin = bin + neighborOffset;
+      for ( SizeValueType i = 0; i < lineLength; ++i )
         {
-        continue; // Go to the next loop if we're not in the mask
+        const unsigned int centerBin = bin[i];
+        const unsigned int pixelBin = neighborBin[i];
+        if ( centerBin == numberOfBinsPerAxis || pixelBin == numberOfBinsPerAxis )
+          {
+          continue; // don't put a pixel in the histogram if it's outside of
+                    // the mask or if the value is out-of-bounds.
+          }
+
+        // Add both possible co-occurrence combinations
+        const SizeValueType id = centerBin + static_cast< SizeValueType >( pixelBin ) * numberOfBinsPerAxis;
+        const SizeValueType symmetricId = pixelBin + static_cast< SizeValueType >( centerBin ) * numberOfBinsPerAxis;
+        if ( counts != ITK_NULLPTR )
+          {
+          ++( *counts )[id];
+          ++( *counts )[symmetricId];
+          }
+        else
+          {
+          output->IncreaseFrequency(id, 1);
+          output->IncreaseFrequency(symmetricId, 1);
+          }
         }
-
-      bool            pixelInBounds;
-      const PixelType pixelIntensity =
-        neighborIt.GetPixel(offsets.Value(), pixelInBounds);
-
-      if ( !pixelInBounds )
-        {
-        continue; // don't put a pixel in the histogram if it's out-of-bounds.
-        }
-
-      if ( pixelIntensity < this->GetMin()
-           || pixelIntensity > this->GetMax() )
-        {
-        continue; // don't put a pixel in the histogram if the value
-                  // is out-of-bounds.
-        }
-
-      // Now make both possible co-occurrence combinations and increment the
-      // histogram with them.
-
-      cooccur[0] = centerPixelIntensity;
-      cooccur[1] = pixelIntensity;
-      output->GetIndex( cooccur, index );
-      output->IncreaseFrequencyOfIndex(index, 1);
-
-
-      cooccur[1] = centerPixelIntensity;
-      cooccur[0] = pixelIntensity;
-      output->GetIndex( cooccur, index );
-      output->IncreaseFrequencyOfIndex(index, 1);
+      it.NextLine();
       }
     }
 }
@@ -21,6 +21,7 @@
 #include "itkImage.h"
 #include "itkHistogram.h"
 #include "itkNumericTraits.h"
+#include "itkMultiThreader.h"
 #include "itkVectorContainer.h"
 
 namespace itk
@@ -73,6 +74,10 @@ namespace Statistics
  * at a particular point, that distance/intensity pair will not be added to
  * the matrix.
  *
+ * The offsets are processed in parallel, each thread following the runs of
+ * its own offsets and counting them in its own matrix, which are added to
+ * the histogram at the end.
+ *
  * The number of histogram bins on each axis can be set (defaults to 256). Also,
  * by default the histogram min and max corresponds to the largest and smallest
  * possible pixel value of that pixel type. To customize the histogram bounds
@@ -256,6 +261,23 @@ protected:
 
 private:
 
+  /** Counts of the runs, indexed by instance identifier */
+  typedef std::vector< SizeValueType > RunCountContainerType;
+
+  struct ThreadStruct
+  {
+    Self *                    Filter;
+    std::vector< OffsetType > Offsets;
+    ThreadIdType              NumberOfThreads;
+  };
+
+  /** Counts the runs along the offsets of the thread. */
+  void ThreadedCountRuns(const ThreadStruct *str, ThreadIdType threadId);
+
+  static ITK_THREAD_RETURN_TYPE ThreaderCallback(void *arg);
+
+  std::vector< RunCountContainerType > m_RunCounts;
+
   unsigned int             m_NumberOfBinsPerAxis;
   PixelType                m_Min;
   PixelType                m_Max;
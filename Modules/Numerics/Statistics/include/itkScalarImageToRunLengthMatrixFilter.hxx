@@ -20,8 +20,7 @@
 
 #include "itkScalarImageToRunLengthMatrixFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
-#include "itkNeighborhood.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "vnl/vnl_math.h"
 #include "itkMacro.h"
 
@@ -138,9 +137,6 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
   HistogramType *output =
     static_cast<HistogramType *>( this->ProcessObject::GetOutput( 0 ) );
 
-  const ImageType * inputImage = this->GetInput();
-
-
   // First, create an appropriate histogram with the right number of bins
   // and mins and maxes correct for the image type.
   typename HistogramType::SizeType size( output->GetMeasurementVectorSize() );
@@ -152,69 +148,161 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
   this->m_UpperBound[1] = this->m_MaxDistance;
   output->Initialize( size, this->m_LowerBound, this->m_UpperBound );
 
-  MeasurementVectorType run( output->GetMeasurementVectorSize() );
-  typename HistogramType::IndexType hIndex;
+  ThreadStruct str;
+  str.Filter = this;
+  typename OffsetVector::ConstIterator offsets;
+  for( offsets = this->GetOffsets()->Begin();
+    offsets != this->GetOffsets()->End(); offsets++ )
+    {
+    OffsetType offset = offsets.Value();
+    this->NormalizeOffsetDirection(offset);
+    str.Offsets.push_back( offset );
+    }
+  if( str.Offsets.empty() )
+    {
+    return;
+    }
+
+  // The offsets are shared between the threads, each thread counting the
+  // runs in its own matrix as long as the matrices of all the threads fit
+  // in a reasonable amount of memory. Larger histograms are filled
+  // directly, on a single thread.
+  const SizeValueType maximumNumberOfCounts = 1 << 24;
+  const SizeValueType numberOfBins = output->Size();
+  str.NumberOfThreads = 1;
+  if( numberOfBins <= maximumNumberOfCounts )
+    {
+    str.NumberOfThreads = std::min( this->GetNumberOfThreads(),
+      static_cast<ThreadIdType>( str.Offsets.size() ) );
+    str.NumberOfThreads = std::max( std::min( str.NumberOfThreads,
+      static_cast<ThreadIdType>( maximumNumberOfCounts / numberOfBins ) ),
+      static_cast<ThreadIdType>( 1 ) );
+    }
+  if( str.NumberOfThreads == 1 )
+    {
+    if( numberOfBins <= maximumNumberOfCounts )
+      {
+      this->m_RunCounts.resize( 1 );
+      }
+    this->ThreadedCountRuns( &str, 0 );
+    }
+  else
+    {
+    this->GetMultiThreader()->SetNumberOfThreads( str.NumberOfThreads );
+    str.NumberOfThreads = this->GetMultiThreader()->GetNumberOfThreads();
+    this->m_RunCounts.resize( str.NumberOfThreads );
+    this->GetMultiThreader()->SetSingleMethod( this->ThreaderCallback, &str );
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+
+  // Add the counts of the threads to the histogram
+  if( !this->m_RunCounts.empty() )
+    {
+    RunCountContainerType & counts = this->m_RunCounts[0];
+    for( ThreadIdType threadId = 1; threadId < this->m_RunCounts.size(); ++threadId )
+      {
+      const RunCountContainerType & threadCounts = this->m_RunCounts[threadId];
+      for( SizeValueType id = 0; id < threadCounts.size(); ++id )
+        {
+        counts[id] += threadCounts[id];
+        }
+      }
+    for( SizeValueType id = 0; id < counts.size(); ++id )
+      {
+      if( counts[id] != 0 )
+        {
+        output->IncreaseFrequency( id, counts[id] );
+        }
+      }
+    }
+  this->m_RunCounts.clear();
+}
 
-  // Iterate over all of those pixels and offsets, adding each
-  // distance/intensity pair to the histogram
+template<typename TImageType, typename THistogramFrequencyContainer>
+ITK_THREAD_RETURN_TYPE
+ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+::ThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast<MultiThreader::ThreadInfoStruct *>( arg );
+  ThreadStruct *str = static_cast<ThreadStruct *>( info->UserData );
 
-  typedef ConstNeighborhoodIterator<ImageType> NeighborhoodIteratorType;
-  typename NeighborhoodIteratorType::RadiusType radius;
-  radius.Fill( 1 );
-  NeighborhoodIteratorType neighborIt( radius,
-    inputImage, inputImage->GetRequestedRegion() );
+  str->Filter->ThreadedCountRuns( str, info->ThreadID );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
 
+template<typename TImageType, typename THistogramFrequencyContainer>
+void
+ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
+::ThreadedCountRuns( const ThreadStruct *str, ThreadIdType threadId )
+{
+  HistogramType *output =
+    static_cast<HistogramType *>( this->ProcessObject::GetOutput( 0 ) );
 
-  // this temp image has the same dimension for each offset
-  // moving the allocation out of loop of offsets
-  // while keeping FillBuffer with boolean false in each loop
-  typedef Image<bool, ImageDimension> BoolImageType;
-  typename BoolImageType::Pointer alreadyVisitedImage = BoolImageType::New();
-  alreadyVisitedImage->CopyInformation( inputImage );
-  alreadyVisitedImage->SetRegions( inputImage->GetRequestedRegion() );
-  alreadyVisitedImage->Allocate();
+  const ImageType * inputImage = this->GetInput();
+  const ImageType * maskImage = this->GetMaskImage();
+  const RegionType & region = inputImage->GetRequestedRegion();
 
-  typename OffsetVector::ConstIterator offsets;
-  for( offsets = this->GetOffsets()->Begin();
-    offsets != this->GetOffsets()->End(); offsets++ )
+  RunCountContainerType *counts = ITK_NULLPTR;
+  if( !this->m_RunCounts.empty() )
     {
+    counts = &this->m_RunCounts[threadId];
+    counts->assign( output->Size(), 0 );
+    }
 
-    alreadyVisitedImage->FillBuffer( false );
+  MeasurementVectorType run( output->GetMeasurementVectorSize() );
+  typename HistogramType::IndexType hIndex;
 
-    neighborIt.GoToBegin();
-    OffsetType offset = offsets.Value();
+  const MeasurementType lastBinMax =
+    output->GetDimensionMaxs( 0 )[ output->GetSize( 0 ) - 1 ];
 
-    this->NormalizeOffsetDirection(offset);
+  // The pixels of the requested region that are already in a run for the
+  // current offset, stored in the order of the iteration over the region
+  std::vector<bool> alreadyVisited( region.GetNumberOfPixels() );
+  OffsetValueType regionOffsetTable[ImageDimension];
+  regionOffsetTable[0] = 1;
+  for( unsigned int i = 1; i < ImageDimension; ++i )
+    {
+    regionOffsetTable[i] = regionOffsetTable[i - 1] * region.GetSize( i - 1 );
+    }
 
+  for( SizeValueType o = threadId; o < str->Offsets.size(); o += str->NumberOfThreads )
+    {
+    const OffsetType & offset = str->Offsets[o];
 
-    for( neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt )
+    std::fill( alreadyVisited.begin(), alreadyVisited.end(), false );
+
+    OffsetValueType visitedOffset = 0;
+    for( unsigned int i = 0; i < ImageDimension; ++i )
       {
-      const PixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-      IndexType centerIndex = neighborIt.GetIndex();
+      visitedOffset += offset[i] * regionOffsetTable[i];
+      }
+
+    itkDebugMacro("===> offset = " << offset << std::endl);
+
+    ImageRegionConstIteratorWithIndex<ImageType> it( inputImage, region );
+    for( SizeValueType centerVisited = 0; !it.IsAtEnd(); ++it, ++centerVisited )
+      {
+      const PixelType centerPixelIntensity = it.Get();
       if( centerPixelIntensity < this->m_Min ||
         centerPixelIntensity > this->m_Max ||
-        alreadyVisitedImage->GetPixel( centerIndex ) || ( this->GetMaskImage() &&
-        this->GetMaskImage()->GetPixel( centerIndex ) !=
+        alreadyVisited[centerVisited] || ( maskImage &&
+        maskImage->GetPixel( it.GetIndex() ) !=
         this->m_InsidePixelValue ) )
         {
         continue; // don't put a pixel in the histogram if the value
                   // is out-of-bounds or is outside the mask.
         }
 
-      itkDebugMacro("===> offset = " << offset << std::endl);
-
-      MeasurementType centerBinMin = this->GetOutput()->
-        GetBinMinFromValue( 0, centerPixelIntensity );
-      MeasurementType centerBinMax = this->GetOutput()->
-        GetBinMaxFromValue( 0, centerPixelIntensity );
-      MeasurementType lastBinMax = this->GetOutput()->
-              GetDimensionMaxs( 0 )[ this->GetOutput()->GetSize( 0 ) - 1 ];
+      const IndexType & centerIndex = it.GetIndex();
+      const MeasurementType centerBinMin =
+        output->GetBinMinFromValue( 0, centerPixelIntensity );
+      const MeasurementType centerBinMax =
+        output->GetBinMaxFromValue( 0, centerPixelIntensity );
 
-      PixelType pixelIntensity( NumericTraits<PixelType>::ZeroValue() );
-      IndexType index;
-
-      index = centerIndex + offset;
+      IndexType index = centerIndex + offset;
       IndexType lastGoodIndex = centerIndex;
+      SizeValueType visited = centerVisited + visitedOffset;
       bool runLengthSegmentAlreadyVisited = false;
 
       // Scan from the current pixel at index, following
@@ -222,17 +310,17 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
       // length of continuous pixels whose pixel values are
       // in the same bin.
 
-      while ( inputImage->GetRequestedRegion().IsInside(index) )
+      while ( region.IsInside(index) )
         {
         // For the same offset, each run length segment can
         // only be visited once
-        if (alreadyVisitedImage->GetPixel( index ) )
+        if( alreadyVisited[visited] )
           {
           runLengthSegmentAlreadyVisited = true;
           break;
           }
 
-        pixelIntensity = inputImage->GetPixel( index );
+        const PixelType pixelIntensity = inputImage->GetPixel( index );
 
         // Special attention paid to boundaries of bins.
         // For the last bin,
@@ -245,9 +333,10 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
         if ( pixelIntensity >= centerBinMin
             && ( pixelIntensity < centerBinMax || ( pixelIntensity == centerBinMax && centerBinMax == lastBinMax ) ) )
           {
-          alreadyVisitedImage->SetPixel( index, true );
+          alreadyVisited[visited] = true;
           lastGoodIndex = index;
           index += offset;
+          visited += visitedOffset;
           }
         else
           {
@@ -269,24 +358,19 @@ ScalarImageToRunLengthMatrixFilter<TImageType, THistogramFrequencyContainer>
       run[0] = centerPixelIntensity;
       run[1] = centerPoint.EuclideanDistanceTo( point );
 
-      if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance )
+      if( run[1] >= this->m_MinDistance && run[1] <= this->m_MaxDistance
+        && output->GetIndex( run, hIndex ) )
         {
-        output->GetIndex( run, hIndex );
-        output->IncreaseFrequencyOfIndex( hIndex, 1 );
-
-        itkDebugStatement(typename HistogramType::IndexType tempMeasurementIndex;)
-        itkDebugStatement(output->GetIndex(run,tempMeasurementIndex);)
-        itkDebugMacro( "centerIndex<->index: "
-            << static_cast<int>( centerPixelIntensity )
-            << "@"<< centerIndex
-                << "<->" << static_cast<int>( pixelIntensity ) << "@" << index
-                <<", Bin# " << tempMeasurementIndex
-                << ", Measurement: (" << run[0] << ", " << run[1] << ")"
-                << ", Center bin [" << this->GetOutput()->GetBinMinFromValue( 0, run[0] )
-                << "," << this->GetOutput()->GetBinMaxFromValue( 0, run[0] ) << "]"
-                << "~[" << this->GetOutput()->GetBinMinFromValue( 1, run[1] )
-                << "," << this->GetOutput()->GetBinMaxFromValue( 1, run[1] ) << "]"
-                << std::endl );
+        const typename HistogramType::InstanceIdentifier id =
+          output->GetInstanceIdentifier( hIndex );
+        if( counts )
+          {
+          ++( *counts )[id];
+          }
+        else
+          {
+          output->IncreaseFrequency( id, 1 );
+          }
         }
       }
     }
@@ -19,6 +19,7 @@
 #define itkSparseFrequencyContainer2_h
 
 #include <map>
+#include <vector>
 #include "itkObjectFactory.h"
 #include "itkObject.h"
 #include "itkNumericTraits.h"
@@ -32,9 +33,13 @@ namespace Statistics
 /** \class SparseFrequencyContainer2
  *  \brief his class is a container for an histogram.
  *
- *  This class uses an map to store histogram. If your histogram is dense
- *  use DenseHistogram.  You should access each bin by
+ *  This class uses an open addressing hash table to store the frequencies
+ *  of the bins that have been set or increased. If your histogram is dense
+ *  use DenseFrequencyContainer2.  You should access each bin by
  * (InstanceIdentifier)index or measurement vector.
+ *
+ *  The bins are not stored in order; GetSortedFrequencies() exports them
+ *  sorted by instance identifier.
  * \ingroup ITKStatistics
  */
 
@@ -66,7 +71,8 @@ public:
   /** Relative Relative frequency type */
   typedef MeasurementVectorTraits::TotalRelativeFrequencyType TotalRelativeFrequencyType;
 
-  /** Histogram typedef support */
+  /** Container the frequencies are exported to, sorted by instance
+   * identifier */
   typedef std::map< InstanceIdentifier, AbsoluteFrequencyType > FrequencyContainerType;
   typedef FrequencyContainerType::const_iterator
   FrequencyContainerConstIterator;
@@ -96,6 +102,16 @@ public:
     return m_TotalFrequency;
   }
 
+  /** Fills a container with the frequencies of the stored bins, sorted by
+   * instance identifier. */
+  void GetSortedFrequencies(FrequencyContainerType & frequencies) const;
+
+  /** Returns the number of bins stored in the hash table. */
+  SizeValueType GetNumberOfStoredBins() const
+  {
+    return m_NumberOfStoredBins;
+  }
+
 protected:
   SparseFrequencyContainer2();
   virtual ~SparseFrequencyContainer2() {}
@@ -105,8 +121,28 @@ private:
   SparseFrequencyContainer2(const Self &); //purposely not implemented
   void operator=(const Self &);            //purposely not implemented
 
-  // Container of histogram
-  FrequencyContainerType     m_FrequencyContainer;
+  struct BinType
+  {
+    InstanceIdentifier    Id;
+    AbsoluteFrequencyType Frequency;
+  };
+  typedef std::vector< BinType > BinContainerType;
+
+  /** Returns the slot of the bin in the hash table, or the empty slot
+   * where it would be inserted. */
+  SizeValueType FindSlot(const InstanceIdentifier id) const;
+
+  /** Returns the slot of the bin in the hash table, inserting it with a
+   * zero frequency if it is not stored yet. */
+  SizeValueType FindOrInsertSlot(const InstanceIdentifier id);
+
+  /** Doubles the size of the hash table. */
+  void Grow();
+
+  // Hash table of the bins, with linear probing. The size is a power of
+  // two and the table is kept at most half full.
+  BinContainerType           m_Bins;
+  SizeValueType              m_NumberOfStoredBins;
   TotalAbsoluteFrequencyType m_TotalFrequency;
 };  // end of class
 } // end of namespace Statistics
@@ -58,31 +58,6 @@ DenseFrequencyContainer2
   return true;
 }
 
-DenseFrequencyContainer2::AbsoluteFrequencyType
-DenseFrequencyContainer2
-::GetFrequency(const InstanceIdentifier id) const
-{
-  if ( id >= m_FrequencyContainer->Size() )
-    {
-    return NumericTraits< AbsoluteFrequencyType >::ZeroValue();
-    }
-  return ( *m_FrequencyContainer )[id];
-}
-
-bool
-DenseFrequencyContainer2
-::IncreaseFrequency(const InstanceIdentifier id, const AbsoluteFrequencyType value)
-{
-  if ( id >= m_FrequencyContainer->Size() )
-    {
-    return false;
-    }
-  AbsoluteFrequencyType frequency = this->GetFrequency(id);
-  ( *m_FrequencyContainer )[id] = frequency + value;
-  m_TotalFrequency += value;
-  return true;
-}
-
 void
 DenseFrequencyContainer2
 ::PrintSelf(std::ostream & os, Indent indent) const
@@ -17,13 +17,40 @@
  *=========================================================================*/
 #include "itkSparseFrequencyContainer2.h"
 
+#include <algorithm>
+
 namespace itk
 {
 namespace Statistics
 {
+namespace
+{
+// Identifier of the empty slots of the hash table
+const SparseFrequencyContainer2::InstanceIdentifier EmptyId =
+  NumericTraits< SparseFrequencyContainer2::InstanceIdentifier >::max();
+
+const SizeValueType InitialNumberOfSlots = 16;
+
+// Mixes the bits of the identifier, so that identifiers with a large
+// power of two stride, like the ones of a column of a joint histogram,
+// do not collide in the table.
+inline SizeValueType Hash(SparseFrequencyContainer2::InstanceIdentifier id)
+{
+  SizeValueType h = static_cast< SizeValueType >( id );
+
+  h ^= h >> 16;
+  h *= 0x85ebca6bU;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35U;
+  h ^= h >> 16;
+  return h;
+}
+}
+
 SparseFrequencyContainer2
 ::SparseFrequencyContainer2()
 {
+  m_NumberOfStoredBins = 0;
   m_TotalFrequency = NumericTraits< TotalAbsoluteFrequencyType >::ZeroValue();
 }
 
@@ -38,27 +65,82 @@ void
 SparseFrequencyContainer2
 ::SetToZero()
 {
-  typedef FrequencyContainerType::iterator IteratorType;
-  IteratorType iter = m_FrequencyContainer.begin();
-  IteratorType end  = m_FrequencyContainer.end();
-  while ( iter != end )
+  // keep the memory of the table, it is likely to be filled again
+  for ( BinContainerType::iterator it = m_Bins.begin(); it != m_Bins.end(); ++it )
     {
-    iter->second = NumericTraits< AbsoluteFrequencyType >::ZeroValue();
-    ++iter;
+    it->Id = EmptyId;
     }
+  m_NumberOfStoredBins = 0;
   m_TotalFrequency = NumericTraits< TotalAbsoluteFrequencyType >::ZeroValue();
 }
 
+SizeValueType
+SparseFrequencyContainer2
+::FindSlot(const InstanceIdentifier id) const
+{
+  const SizeValueType mask = m_Bins.size() - 1;
+  SizeValueType       slot = Hash(id) & mask;
+
+  while ( m_Bins[slot].Id != id && m_Bins[slot].Id != EmptyId )
+    {
+    slot = ( slot + 1 ) & mask;
+    }
+  return slot;
+}
+
+SizeValueType
+SparseFrequencyContainer2
+::FindOrInsertSlot(const InstanceIdentifier id)
+{
+  if ( 2 * ( m_NumberOfStoredBins + 1 ) > m_Bins.size() )
+    {
+    this->Grow();
+    }
+  const SizeValueType slot = this->FindSlot(id);
+  if ( m_Bins[slot].Id == EmptyId )
+    {
+    m_Bins[slot].Id = id;
+    m_Bins[slot].Frequency = NumericTraits< AbsoluteFrequencyType >::ZeroValue();
+    ++m_NumberOfStoredBins;
+    }
+  return slot;
+}
+
+void
+SparseFrequencyContainer2
+::Grow()
+{
+  BinContainerType bins;
+
+  bins.swap(m_Bins);
+  BinType empty;
+  empty.Id = EmptyId;
+  empty.Frequency = NumericTraits< AbsoluteFrequencyType >::ZeroValue();
+  m_Bins.resize(bins.empty() ? InitialNumberOfSlots : 2 * bins.size(), empty);
+
+  for ( BinContainerType::const_iterator it = bins.begin(); it != bins.end(); ++it )
+    {
+    if ( it->Id != EmptyId )
+      {
+      m_Bins[this->FindSlot(it->Id)] = *it;
+      }
+    }
+}
+
 bool
 SparseFrequencyContainer2
 ::SetFrequency(const InstanceIdentifier id, const AbsoluteFrequencyType value)
 {
-  // No need to test for bounds because in a map container the
-  // element is allocated if the key doesn't exist yet
-  AbsoluteFrequencyType frequency = this->GetFrequency(id);
-
-  m_FrequencyContainer[id] = value;
-  m_TotalFrequency += ( value - frequency );
+  // No need to test for bounds because the bin is inserted in the table
+  // if it doesn't exist yet. Only the identifier used to mark the empty
+  // slots can't be stored.
+  if ( id == EmptyId )
+    {
+    return false;
+    }
+  BinType & bin = m_Bins[this->FindOrInsertSlot(id)];
+  m_TotalFrequency += ( value - bin.Frequency );
+  bin.Frequency = value;
   return true;
 }
 
@@ -66,36 +148,63 @@ SparseFrequencyContainer2::AbsoluteFrequencyType
 SparseFrequencyContainer2
 ::GetFrequency(const InstanceIdentifier id) const
 {
-  FrequencyContainerType::const_iterator iter = m_FrequencyContainer.find(id);
-
-  if ( iter != m_FrequencyContainer.end() )
+  if ( m_NumberOfStoredBins == 0 || id == EmptyId )
     {
-    return iter->second;
+    return NumericTraits< AbsoluteFrequencyType >::ZeroValue();
     }
-  else
+  const BinType & bin = m_Bins[this->FindSlot(id)];
+  if ( bin.Id == EmptyId )
     {
-    return 0;
+    return NumericTraits< AbsoluteFrequencyType >::ZeroValue();
     }
+  return bin.Frequency;
 }
 
 bool
 SparseFrequencyContainer2
 ::IncreaseFrequency(const InstanceIdentifier id, const AbsoluteFrequencyType value)
 {
-  // No need to test for bounds because in a map container the
-  // element is allocated if the key doesn't exist yet
-  AbsoluteFrequencyType frequency = this->GetFrequency(id);
-
-  m_FrequencyContainer[id] = frequency + value;
+  // No need to test for bounds because the bin is inserted in the table
+  // if it doesn't exist yet.
+  if ( id == EmptyId )
+    {
+    return false;
+    }
+  m_Bins[this->FindOrInsertSlot(id)].Frequency += value;
   m_TotalFrequency += value;
   return true;
 }
 
+void
+SparseFrequencyContainer2
+::GetSortedFrequencies(FrequencyContainerType & frequencies) const
+{
+  std::vector< std::pair< InstanceIdentifier, AbsoluteFrequencyType > > sorted;
+  sorted.reserve(m_NumberOfStoredBins);
+  for ( BinContainerType::const_iterator it = m_Bins.begin(); it != m_Bins.end(); ++it )
+    {
+    if ( it->Id != EmptyId )
+      {
+      sorted.push_back( std::make_pair(it->Id, it->Frequency) );
+      }
+    }
+  std::sort( sorted.begin(), sorted.end() );
+
+  // the identifiers are sorted, so each one is inserted at the end of the map
+  frequencies.clear();
+  for ( SizeValueType i = 0; i < sorted.size(); ++i )
+    {
+    frequencies.insert(frequencies.end(), sorted[i]);
+    }
+}
+
 void
 SparseFrequencyContainer2
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfStoredBins: " << m_NumberOfStoredBins << std::endl;
+  os << indent << "TotalFrequency: " << m_TotalFrequency << std::endl;
 }
 } // end of namespace Statistics
 } // end of namespace itk
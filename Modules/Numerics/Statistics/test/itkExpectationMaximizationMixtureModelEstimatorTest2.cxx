@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkListSample.h"
+#include "itkGaussianMixtureModelComponent.h"
+#include "itkExpectationMaximizationMixtureModelEstimator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+// Compares GaussianMembershipFunction::EvaluateBlock() with Evaluate(), and
+// checks that the estimation gives the same parameters with one thread
+// and with the number of threads given on the command line.
+int itkExpectationMaximizationMixtureModelEstimatorTest2(int argc, char* argv[] )
+{
+  if( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int MeasurementVectorSize = 3;
+  typedef itk::Vector< float, MeasurementVectorSize >         MeasurementVectorType;
+  typedef itk::Statistics::ListSample< MeasurementVectorType > SampleType;
+
+  typedef itk::Statistics::GaussianMembershipFunction< MeasurementVectorType >
+    MembershipFunctionType;
+  typedef itk::Statistics::GaussianMixtureModelComponent< SampleType >
+    ComponentType;
+  typedef itk::Statistics::ExpectationMaximizationMixtureModelEstimator< SampleType >
+    EstimatorType;
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->Initialize( 2015 );
+
+  const unsigned int numberOfClasses = 3;
+  const double       trueMeans[numberOfClasses][MeasurementVectorSize] =
+    { { 10.0, 20.0, 30.0 }, { 40.0, 25.0, 10.0 }, { 25.0, 50.0, 45.0 } };
+  const double       standardDeviations[numberOfClasses] = { 4.0, 5.0, 3.0 };
+  const unsigned int numberOfMeasurementsPerClass = 1001;
+
+  SampleType::Pointer sample = SampleType::New();
+  sample->SetMeasurementVectorSize( MeasurementVectorSize );
+  MeasurementVectorType mv;
+  for( unsigned int c = 0; c < numberOfClasses; ++c )
+    {
+    for( unsigned int n = 0; n < numberOfMeasurementsPerClass; ++n )
+      {
+      for( unsigned int d = 0; d < MeasurementVectorSize; ++d )
+        {
+        mv[d] = generator->GetNormalVariate( trueMeans[c][d],
+          standardDeviations[c] * standardDeviations[c] );
+        }
+      sample->PushBack( mv );
+      }
+    }
+
+  // EvaluateBlock() against Evaluate(), with a regular and a nearly
+  // singular covariance
+  MembershipFunctionType::Pointer function = MembershipFunctionType::New();
+  MembershipFunctionType::MeanVectorType mean;
+  mean[0] = 20.0;
+  mean[1] = 30.0;
+  mean[2] = 25.0;
+  function->SetMean( mean );
+
+  MembershipFunctionType::CovarianceMatrixType covariance;
+  covariance.SetSize( MeasurementVectorSize, MeasurementVectorSize );
+  covariance(0, 0) = 150.0; covariance(0, 1) = 20.0;  covariance(0, 2) = -10.0;
+  covariance(1, 0) = 20.0;  covariance(1, 1) = 200.0; covariance(1, 2) = 30.0;
+  covariance(2, 0) = -10.0; covariance(2, 1) = 30.0;  covariance(2, 2) = 120.0;
+
+  std::vector< float > measurements;
+  for( SampleType::ConstIterator it = sample->Begin(); it != sample->End(); ++it )
+    {
+    for( unsigned int d = 0; d < MeasurementVectorSize; ++d )
+      {
+      measurements.push_back( it.GetMeasurementVector()[d] );
+      }
+    }
+  std::vector< double > densities( sample->Size() );
+
+  for( unsigned int test = 0; test < 2; ++test )
+    {
+    if( test == 1 )
+      {
+      covariance.SetIdentity();
+      covariance *= 1.0e-3;
+      }
+    function->SetCovariance( covariance );
+    function->EvaluateBlock( &measurements[0], sample->Size(), &densities[0] );
+
+    for( unsigned int i = 0; i < sample->Size(); ++i )
+      {
+      const double expected = function->Evaluate( sample->GetMeasurementVector( i ) );
+      if( std::fabs( densities[i] - expected ) > 1.0e-10 * std::fabs( expected ) )
+        {
+        std::cerr << "EvaluateBlock() differs from Evaluate() for the measurement vector "
+                  << i << ": " << densities[i] << " != " << expected << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // the estimation, with one and with several threads
+  itk::Array< double > initialProportions( numberOfClasses );
+  initialProportions.Fill( 1.0 / numberOfClasses );
+
+  std::vector< ComponentType::ParametersType > results[2];
+  EstimatorType::ProportionVectorType          proportions[2];
+  const itk::ThreadIdType                      numberOfThreads[2] = { 1, static_cast< itk::ThreadIdType >( atoi( argv[1] ) ) };
+
+  for( unsigned int run = 0; run < 2; ++run )
+    {
+    EstimatorType::Pointer estimator = EstimatorType::New();
+    estimator->SetSample( sample );
+    estimator->SetMaximumIteration( 200 );
+    estimator->SetInitialProportions( initialProportions );
+    estimator->SetNumberOfThreads( numberOfThreads[run] );
+    if( estimator->GetNumberOfThreads() != numberOfThreads[run] )
+      {
+      std::cerr << "GetNumberOfThreads() failed" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    std::vector< ComponentType::Pointer > components;
+    for( unsigned int c = 0; c < numberOfClasses; ++c )
+      {
+      ComponentType::ParametersType parameters( MeasurementVectorSize * ( MeasurementVectorSize + 1 ) );
+      parameters.Fill( 0.0 );
+      for( unsigned int d = 0; d < MeasurementVectorSize; ++d )
+        {
+        parameters[d] = trueMeans[c][d] + 5.0;
+        parameters[MeasurementVectorSize + d * ( MeasurementVectorSize + 1 )] = 100.0;
+        }
+      components.push_back( ComponentType::New() );
+      components[c]->SetSample( sample );
+      components[c]->SetParameters( parameters );
+      estimator->AddComponent( components[c].GetPointer() );
+      }
+
+    estimator->Update();
+
+    proportions[run] = estimator->GetProportions();
+    for( unsigned int c = 0; c < numberOfClasses; ++c )
+      {
+      results[run].push_back( components[c]->GetFullParameters() );
+      }
+    }
+
+  bool passed = true;
+  for( unsigned int c = 0; c < numberOfClasses; ++c )
+    {
+    std::cout << "Cluster[" << c << "]: " << results[0][c]
+              << " proportion " << proportions[0][c] << std::endl;
+
+    if( results[0][c] != results[1][c] || proportions[0][c] != proportions[1][c] )
+      {
+      std::cerr << "The estimation with " << numberOfThreads[1]
+                << " threads differs: " << results[1][c]
+                << " proportion " << proportions[1][c] << std::endl;
+      passed = false;
+      }
+
+    for( unsigned int d = 0; d < MeasurementVectorSize; ++d )
+      {
+      if( std::fabs( results[0][c][d] - trueMeans[c][d] ) > 1.0 )
+        {
+        std::cerr << "The mean of the cluster " << c << " is wrong" << std::endl;
+        passed = false;
+        }
+      }
+    }
+
+  if( !passed )
+    {
+    std::cerr << "Test failed." << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkListSample.h"
+#include "itkKdTreeGenerator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+namespace
+{
+// Compares the batched k-nearest neighbor searches to one search per
+// query point.
+template< typename TSample >
+int CheckBatchedSearch( TSample * sample, const std::vector< typename TSample::MeasurementVectorType > & queries,
+                        itk::ThreadIdType numberOfThreads )
+{
+  typedef itk::Statistics::KdTreeGenerator< TSample > TreeGeneratorType;
+  typedef typename TreeGeneratorType::KdTreeType      TreeType;
+
+  typename TreeGeneratorType::Pointer treeGenerator = TreeGeneratorType::New();
+  treeGenerator->SetSample( sample );
+  treeGenerator->SetBucketSize( 4 );
+  treeGenerator->Update();
+  typename TreeType::Pointer tree = treeGenerator->GetOutput();
+
+  const unsigned int numberOfNeighbors = 5;
+
+  tree->SetNumberOfThreads( numberOfThreads );
+  typename TreeType::InstanceIdentifierVectorContainerType results;
+  typename TreeType::DistanceVectorContainerType           distances;
+  tree->Search( queries, numberOfNeighbors, results, distances );
+
+  if( results.size() != queries.size() || distances.size() != queries.size() )
+    {
+    std::cerr << "Wrong number of results" << std::endl;
+    return EXIT_FAILURE;
+    }
+  for( unsigned int q = 0; q < queries.size(); q++ )
+    {
+    typename TreeType::InstanceIdentifierVectorType neighbors;
+    std::vector< double >                           neighborDistances;
+    tree->Search( queries[q], numberOfNeighbors, neighbors, neighborDistances );
+    if( results[q] != neighbors || distances[q] != neighborDistances )
+      {
+      std::cerr << "Wrong neighbors of query " << q << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // the queries must have the length of the measurement vectors
+  std::vector< typename TSample::MeasurementVectorType > wrongQueries( 1 );
+  try
+    {
+    tree->Search( wrongQueries, numberOfNeighbors, results );
+    std::cerr << "Failed to throw an exception for a query of wrong length" << std::endl;
+    return EXIT_FAILURE;
+    }
+  catch( itk::ExceptionObject & )
+    {
+    }
+  return EXIT_SUCCESS;
+}
+}
+
+int itkKdTreeBatchedSearchTest( int argc, char * argv [] )
+{
+  if( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+  const itk::ThreadIdType numberOfThreads = atoi( argv[1] );
+
+  typedef itk::Array< float >                                  MeasurementVectorType;
+  typedef itk::Statistics::ListSample< MeasurementVectorType > SampleType;
+  typedef itk::Statistics::Subsample< SampleType >             SubsampleType;
+
+  const unsigned int measurementVectorSize = 3;
+
+  SampleType::Pointer sample = SampleType::New();
+  sample->SetMeasurementVectorSize( measurementVectorSize );
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator NumberGeneratorType;
+  NumberGeneratorType::Pointer randomNumberGenerator = NumberGeneratorType::New();
+  randomNumberGenerator->SetSeed( 5 );
+
+  MeasurementVectorType mv( measurementVectorSize );
+  for( unsigned int i = 0; i < 1500; i++ )
+    {
+    for( unsigned int d = 0; d < measurementVectorSize; d++ )
+      {
+      // few distinct values, so that there are ties between the distances
+      mv[d] = static_cast< float >( randomNumberGenerator->GetIntegerVariate( 39 ) ) / 4.0f;
+      }
+    sample->PushBack( mv );
+    }
+
+  std::vector< MeasurementVectorType > queries;
+  for( unsigned int i = 0; i < 200; i++ )
+    {
+    for( unsigned int d = 0; d < measurementVectorSize; d++ )
+      {
+      mv[d] = static_cast< float >( randomNumberGenerator->GetUniformVariate( -0.5, 10.6 ) );
+      }
+    queries.push_back( mv );
+    }
+
+  if( CheckBatchedSearch< SampleType >( sample, queries, numberOfThreads ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // the instance identifiers of a subsample don't go from 0 to Size() - 1
+  SubsampleType::Pointer subsample = SubsampleType::New();
+  subsample->SetSample( sample );
+  for( unsigned int i = 0; i < sample->Size(); i += 3 )
+    {
+    subsample->AddInstance( i );
+    }
+  if( CheckBatchedSearch< SubsampleType >( subsample, queries, numberOfThreads ) == EXIT_FAILURE )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkScalarImageToCooccurrenceMatrixFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNeighborhood.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+
+// Compares the co-occurrence matrices computed with and without a mask to
+// the pairs counted pixel by pixel.
+int itkScalarImageToCooccurrenceMatrixFilterTest3( int argc, char * argv [] )
+{
+  if( argc != 2 )
+    {
+    std::cerr << "Usage: " << argv[0] << " numberOfThreads" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  const unsigned int Dimension = 3;
+  typedef itk::Image< short, Dimension >                                 ImageType;
+  typedef itk::Statistics::ScalarImageToCooccurrenceMatrixFilter< ImageType > FilterType;
+  typedef FilterType::HistogramType                                      HistogramType;
+
+  ImageType::RegionType region;
+  ImageType::SizeType   size;
+  ImageType::IndexType  start;
+  size[0] = 23;
+  size[1] = 14;
+  size[2] = 9;
+  start[0] = -3;
+  start[1] = 5;
+  start[2] = 0;
+  region.SetSize( size );
+  region.SetIndex( start );
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( region );
+  image->Allocate();
+  ImageType::Pointer mask = ImageType::New();
+  mask->SetRegions( region );
+  mask->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, region );
+  itk::ImageRegionIteratorWithIndex< ImageType > maskIt( mask, region );
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator GeneratorType;
+  GeneratorType::Pointer generator = GeneratorType::New();
+  generator->SetSeed( 11 );
+  for( ; !it.IsAtEnd(); ++it, ++maskIt )
+    {
+    it.Set( static_cast< short >( generator->GetIntegerVariate( 299 ) ) - 50 );
+    maskIt.Set( generator->GetIntegerVariate( 3 ) != 0 ? 1 : 0 );
+    }
+
+  // all the offsets of the neighborhood of radius 1, and a longer one
+  FilterType::OffsetVectorPointer offsets = FilterType::OffsetVector::New();
+  itk::Neighborhood< short, Dimension > hood;
+  hood.SetRadius( 1 );
+  for( unsigned int i = 0; i < hood.Size(); i++ )
+    {
+    if( i != hood.GetCenterNeighborhoodIndex() )
+      {
+      offsets->push_back( hood.GetOffset( i ) );
+      }
+    }
+  ImageType::OffsetType longOffset = {{ 5, -2, 1 }};
+  offsets->push_back( longOffset );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetOffsets( offsets );
+  filter->SetNumberOfBinsPerAxis( 17 );
+  filter->SetPixelValueMinMax( 0, 200 );
+  filter->SetNumberOfThreads( atoi( argv[1] ) );
+
+  for( unsigned int useMask = 0; useMask < 2; useMask++ )
+    {
+    if( useMask )
+      {
+      filter->SetMaskImage( mask );
+      }
+    filter->Update();
+    const HistogramType * histogram = filter->GetOutput();
+
+    // count the pairs pixel by pixel
+    std::vector< HistogramType::AbsoluteFrequencyType > expected( histogram->Size(), 0 );
+    HistogramType::MeasurementVectorType cooccur( 2 );
+    HistogramType::IndexType             index( 2 );
+    for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      for( unsigned int o = 0; o < offsets->size(); o++ )
+        {
+        const ImageType::IndexType neighbor = it.GetIndex() + offsets->ElementAt( o );
+        if( !region.IsInside( neighbor )
+          || ( useMask && ( mask->GetPixel( it.GetIndex() ) != 1 || mask->GetPixel( neighbor ) != 1 ) )
+          || it.Get() < 0 || it.Get() > 200 || image->GetPixel( neighbor ) < 0 || image->GetPixel( neighbor ) > 200 )
+          {
+          continue;
+          }
+        cooccur[0] = it.Get();
+        cooccur[1] = image->GetPixel( neighbor );
+        histogram->GetIndex( cooccur, index );
+        expected[histogram->GetInstanceIdentifier( index )]++;
+        cooccur[0] = image->GetPixel( neighbor );
+        cooccur[1] = it.Get();
+        histogram->GetIndex( cooccur, index );
+        expected[histogram->GetInstanceIdentifier( index )]++;
+        }
+      }
+
+    for( unsigned int id = 0; id < expected.size(); id++ )
+      {
+      if( histogram->GetFrequency( id ) != expected[id] )
+        {
+        std::cerr << "Wrong frequency" << ( useMask ? " with a mask" : "" ) << " for bin " << id << ": "
+                  << histogram->GetFrequency( id ) << " instead of " << expected[id] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
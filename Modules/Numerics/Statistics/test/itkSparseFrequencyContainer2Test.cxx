@@ -113,6 +113,42 @@ int itkSparseFrequencyContainer2Test(int, char* [] )
     std::cout << " PASSED !" << std::endl;
     }   // end of SetFrequency() / GetFrequency() test
 
+  // Test the bins of a large histogram, with identifiers sharing a large
+  // power of two stride, and the sorted export of the frequencies
+    {
+    std::cout << "Testing GetSortedFrequencies method...";
+    container->Initialize( 1 << 30 );
+    const SparseFrequencyContainer2Type::InstanceIdentifier stride = 1 << 16;
+    for( unsigned int bin = 2000; bin > 0; bin-- )
+      {
+      container->IncreaseFrequency( bin * stride, bin );
+      container->IncreaseFrequency( bin * stride, 1 );
+      }
+    if( container->GetNumberOfStoredBins() != 2000
+      || container->GetTotalFrequency() != 2000 * 2001 / 2 + 2000
+      || container->GetFrequency( stride + 1 ) != 0 )
+      {
+      std::cout << "Failed !" << std::endl;
+      std::cout << "Wrong number of bins or total frequency" << std::endl;
+      return EXIT_FAILURE;
+      }
+
+    SparseFrequencyContainer2Type::FrequencyContainerType frequencies;
+    container->GetSortedFrequencies( frequencies );
+    SparseFrequencyContainer2Type::FrequencyContainerConstIterator it = frequencies.begin();
+    for( unsigned int bin = 1; bin <= 2000; bin++, ++it )
+      {
+      if( it == frequencies.end() || it->first != bin * stride || it->second != bin + 1
+        || container->GetFrequency( bin * stride ) != bin + 1 )
+        {
+        std::cout << "Failed !" << std::endl;
+        std::cout << "Wrong frequency for bin " << bin * stride << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    std::cout << " PASSED !" << std::endl;
+    }
+
   std::cout << "Test passed." << std::endl;
   return EXIT_SUCCESS;
 
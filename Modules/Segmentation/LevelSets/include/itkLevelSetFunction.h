@@ -219,6 +219,19 @@ public:
   virtual void ReleaseGlobalDataPointer(void *GlobalData) const ITK_OVERRIDE
   { delete (GlobalDataStruct *)GlobalData; }
 
+  /** Merges the maximum changes recorded in OtherGlobalData into
+   * GlobalData. */
+  virtual bool MergeGlobalData(void *GlobalData, const void *OtherGlobalData) const ITK_OVERRIDE
+  {
+    GlobalDataStruct *      d = (GlobalDataStruct *)GlobalData;
+    const GlobalDataStruct *o = (const GlobalDataStruct *)OtherGlobalData;
+
+    d->m_MaxAdvectionChange   = vnl_math_max(d->m_MaxAdvectionChange, o->m_MaxAdvectionChange);
+    d->m_MaxPropagationChange = vnl_math_max(d->m_MaxPropagationChange, o->m_MaxPropagationChange);
+    d->m_MaxCurvatureChange   = vnl_math_max(d->m_MaxCurvatureChange, o->m_MaxCurvatureChange);
+    return true;
+  }
+
   /**  */
   virtual ScalarValueType ComputeCurvatureTerm(const NeighborhoodType &,
                                                const FloatOffsetType &,
@@ -136,6 +136,16 @@ public:
   virtual void ReleaseGlobalDataPointer(void *GlobalData) const ITK_OVERRIDE
   { delete (ShapePriorGlobalDataStruct *)GlobalData; }
 
+  /** Merge the maximum changes recorded in two global data structures. */
+  virtual bool MergeGlobalData(void *GlobalData, const void *OtherGlobalData) const ITK_OVERRIDE
+  {
+    Superclass::MergeGlobalData(GlobalData, OtherGlobalData);
+    ShapePriorGlobalDataStruct *      d = (ShapePriorGlobalDataStruct *)GlobalData;
+    const ShapePriorGlobalDataStruct *o = (const ShapePriorGlobalDataStruct *)OtherGlobalData;
+    d->m_MaxShapePriorChange = vnl_math_max(d->m_MaxShapePriorChange, o->m_MaxShapePriorChange);
+    return true;
+  }
+
 protected:
   ShapePriorSegmentationLevelSetFunction();
   virtual ~ShapePriorSegmentationLevelSetFunction() {}
@@ -22,6 +22,7 @@
 #include "itkMultiThreader.h"
 #include "itkSparseFieldLayer.h"
 #include "itkObjectStore.h"
+#include "itkAtomicInt.h"
 #include <vector>
 #include "itkNeighborhoodIterator.h"
 
@@ -210,6 +211,15 @@ private:
  * initializes, it will subtract the IsoSurfaceValue from all values, in the
  * input, shifting the isosurface of interest to zero in the output.
  *
+ * \par MULTITHREADING
+ * The changes at the active layer are calculated by NumberOfThreads threads.
+ * The active layer is cut into chunks of NumberOfNodesPerChunk nodes which
+ * the threads claim one at a time, so a thread that hits expensive nodes
+ * does not hold up the others.  Each thread keeps its own global data, and
+ * the global data are merged before the time step is computed, so the
+ * output does not depend on the number of threads.  Reconstructing the
+ * layers is done by a single thread.
+ *
  * \par IMPORTANT!
  *  Read the documentation for FiniteDifferenceImageFilter before attempting to
  *  use this filter.  The solver requires that you specify a
@@ -283,6 +293,10 @@ public:
   /** Container type used to store updates to the active layer. */
   typedef std::vector< ValueType > UpdateBufferType;
 
+  /** Number of active layer nodes a thread claims at a time while
+   * calculating the change. */
+  itkStaticConstMacro(NumberOfNodesPerChunk, unsigned int, 256);
+
   /** Set/Get the number of layers to use in the sparse field.  Argument is the
    *  number of layers on ONE side of the active layer, so the total layers in
    *   the sparse field is 2 * NumberOfLayers +1 */
@@ -370,6 +384,13 @@ protected:
    *  indices to be applied in the current iteration. */
   TimeStepType CalculateChange() ITK_OVERRIDE;
 
+  /** Calculates the change at the active layer nodes m_ActiveNodes[begin]
+   * to m_ActiveNodes[end - 1] and stores it at the same positions in the
+   * update buffer. */
+  void CalculateChangeRange(NeighborhoodIterator< OutputImageType > & outputIt,
+                            void *globalData, ValueType minNorm,
+                            SizeValueType begin, SizeValueType end);
+
   /** Initializes a layer of the sparse field using a previously initialized
    * layer. Builds the list of nodes in m_Layer[to] using m_Layer[from].
    * Marks values in the m_StatusImage. */
@@ -480,6 +501,10 @@ protected:
    *  CalculateChange. */
   UpdateBufferType m_UpdateBuffer;
 
+  /** The nodes of the active layer in list order, gathered at the start of
+   *  CalculateChange so that they can be handed out to threads. */
+  std::vector< const LayerNodeType * > m_ActiveNodes;
+
   /** The RMS change calculated from each update.  Can be used by a subclass to
    *  determine halting criteria.  Valid only for the previous iteration, not
    *  during the current iteration.  Calculated in ApplyUpdate. */
@@ -501,6 +526,24 @@ private:
   /** This flag is true when methods need to check boundary conditions and
       false when methods do not need to check for boundary conditions. */
   bool m_BoundsCheckingActive;
+
+  /** Structure for passing information into the CalculateChange threads. */
+  struct CalculateChangeThreadStruct {
+    Self *                Filter;
+    ValueType             MinNorm;
+    std::vector< void * > GlobalData;
+    std::vector< char >   ProcessedNodes;
+    AtomicInt< int >      NextChunk;
+    int                   NumberOfChunks;
+    SimpleMutexLock       ExceptionLock;
+    bool                  ExceptionCaught;
+    ExceptionObject       Exception;
+  };
+
+  /** Claims chunks of the active layer until none is left. */
+  void ThreadedCalculateChange(CalculateChangeThreadStruct *str, ThreadIdType threadId);
+
+  static ITK_THREAD_RETURN_TYPE CalculateChangeThreaderCallback(void *arg);
 };
 } // end namespace itk
 
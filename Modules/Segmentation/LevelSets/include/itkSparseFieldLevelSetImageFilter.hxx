@@ -903,9 +903,6 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
 {
   const typename Superclass::FiniteDifferenceFunctionType::Pointer df =
     this->GetDifferenceFunction();
-  typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
-  ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue,
-            backwardValue, centerValue;
   unsigned  i;
   ValueType MIN_NORM      = 1.0e-6;
   if ( this->GetUseImageSpacing() )
@@ -918,28 +915,168 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
     MIN_NORM *= minSpacing;
     }
 
-  void *globalData = df->GetGlobalDataPointer();
-
-  typename LayerType::ConstIterator layerIt;
-  NeighborhoodIterator< OutputImageType > outputIt( df->GetRadius(),
-                                                    this->m_OutputImage, this->m_OutputImage->GetRequestedRegion() );
-  TimeStepType timeStep;
-
-  if ( m_BoundsCheckingActive == false )
+  // Gather the active layer nodes so that the threads can address them by
+  // position.  The update buffer is filled in the same order.
+  m_ActiveNodes.clear();
+  m_ActiveNodes.reserve( m_Layers[0]->Size() );
+  for ( typename LayerType::ConstIterator layerIt = m_Layers[0]->Begin();
+        layerIt != m_Layers[0]->End(); ++layerIt )
     {
-    outputIt.NeedToUseBoundaryConditionOff();
+    m_ActiveNodes.push_back( &( *layerIt ) );
+    }
+  m_UpdateBuffer.resize( m_ActiveNodes.size() );
+
+  CalculateChangeThreadStruct str;
+  str.Filter = this;
+  str.MinNorm = MIN_NORM;
+  str.NumberOfChunks = static_cast< int >(
+    ( m_ActiveNodes.size() + NumberOfNodesPerChunk - 1 ) / NumberOfNodesPerChunk );
+  str.NextChunk = 0;
+  str.ExceptionCaught = false;
+
+  ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+  if ( static_cast< int >( numberOfThreads ) > str.NumberOfChunks )
+    {
+    numberOfThreads = static_cast< ThreadIdType >( str.NumberOfChunks );
+    }
+  if ( numberOfThreads < 1 )
+    {
+    numberOfThreads = 1;
     }
 
-  m_UpdateBuffer.clear();
-  m_UpdateBuffer.reserve( m_Layers[0]->Size() );
+  str.GlobalData.resize(numberOfThreads);
+  str.ProcessedNodes.resize(numberOfThreads, 0);
+  for ( ThreadIdType t = 0; t < numberOfThreads; ++t )
+    {
+    str.GlobalData[t] = df->GetGlobalDataPointer();
+    }
 
   // Calculates the update values for the active layer indices in this
-  // iteration.  Iterates through the active layer index list, applying
+  // iteration.  The threads claim chunks of the active layer, applying
   // the level set function to the output image (level set image) at each
   // index.  Update values are stored in the update buffer.
-  for ( layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt )
+  if ( numberOfThreads > 1 )
     {
-    outputIt.SetLocation(layerIt->m_Value);
+    this->GetMultiThreader()->SetNumberOfThreads(numberOfThreads);
+    this->GetMultiThreader()->SetSingleMethod(this->CalculateChangeThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+    }
+  else
+    {
+    this->ThreadedCalculateChange(&str, 0);
+    }
+
+  // Ask the finite difference function to compute the time step for
+  // this iteration.  The global data of the threads are merged first so
+  // that the time step is the one a single thread would have found.  If
+  // the function cannot merge them, the smallest time step is used.
+  TimeStepType timeStep = NumericTraits< TimeStepType >::ZeroValue();
+  if ( !str.ExceptionCaught )
+    {
+    bool merged = true;
+    for ( ThreadIdType t = 1; t < numberOfThreads && merged; ++t )
+      {
+      merged = df->MergeGlobalData(str.GlobalData[0], str.GlobalData[t]);
+      }
+
+    if ( merged )
+      {
+      timeStep = df->ComputeGlobalTimeStep(str.GlobalData[0]);
+      }
+    else
+      {
+      std::vector< TimeStepType > timeStepList(numberOfThreads);
+      for ( ThreadIdType t = 0; t < numberOfThreads; ++t )
+        {
+        timeStepList[t] = df->ComputeGlobalTimeStep(str.GlobalData[t]);
+        }
+      const std::vector< bool > valid( str.ProcessedNodes.begin(), str.ProcessedNodes.end() );
+      timeStep = this->ResolveTimeStep(timeStepList, valid);
+      }
+    }
+
+  for ( ThreadIdType t = 0; t < numberOfThreads; ++t )
+    {
+    df->ReleaseGlobalDataPointer(str.GlobalData[t]);
+    }
+
+  if ( str.ExceptionCaught )
+    {
+    throw str.Exception;
+    }
+
+  return timeStep;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::ThreadedCalculateChange(CalculateChangeThreadStruct *str, ThreadIdType threadId)
+{
+  try
+    {
+    NeighborhoodIterator< OutputImageType > outputIt( this->GetDifferenceFunction()->GetRadius(),
+                                                      this->m_OutputImage,
+                                                      this->m_OutputImage->GetRequestedRegion() );
+    if ( m_BoundsCheckingActive == false )
+      {
+      outputIt.NeedToUseBoundaryConditionOff();
+      }
+
+    const SizeValueType numberOfNodes = static_cast< SizeValueType >( m_ActiveNodes.size() );
+    for ( int chunk = ( str->NextChunk += 1 ) - 1; chunk < str->NumberOfChunks;
+          chunk = ( str->NextChunk += 1 ) - 1 )
+      {
+      const SizeValueType begin = static_cast< SizeValueType >( chunk ) * NumberOfNodesPerChunk;
+      const SizeValueType end = vnl_math_min(begin + NumberOfNodesPerChunk, numberOfNodes);
+      this->CalculateChangeRange(outputIt, str->GlobalData[threadId], str->MinNorm, begin, end);
+      str->ProcessedNodes[threadId] = 1;
+      }
+    }
+  catch ( ExceptionObject & e )
+    {
+    str->ExceptionLock.Lock();
+    if ( !str->ExceptionCaught )
+      {
+      str->ExceptionCaught = true;
+      str->Exception = e;
+      }
+    str->ExceptionLock.Unlock();
+    // Let the other threads run out of work.
+    str->NextChunk = str->NumberOfChunks;
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_TYPE
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::CalculateChangeThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  CalculateChangeThreadStruct *    str = static_cast< CalculateChangeThreadStruct * >( info->UserData );
+
+  str->Filter->ThreadedCalculateChange(str, info->ThreadID);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::CalculateChangeRange(NeighborhoodIterator< OutputImageType > & outputIt,
+                       void *globalData, ValueType minNorm,
+                       SizeValueType begin, SizeValueType end)
+{
+  const typename Superclass::FiniteDifferenceFunctionType::Pointer df =
+    this->GetDifferenceFunction();
+  typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
+  ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue,
+            backwardValue, centerValue;
+  unsigned  i;
+
+  for ( SizeValueType k = begin; k < end; ++k )
+    {
+    outputIt.SetLocation(m_ActiveNodes[k]->m_Value);
 
     // Calculate the offset to the surface from the center of this
     // neighborhood.  This is used by some level set functions in sampling a
@@ -989,25 +1126,16 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
 
       for ( i = 0; i < ImageDimension; ++i )
         {
-        offset[i] = ( offset[i] * centerValue ) / ( norm_grad_phi_squared + MIN_NORM );
+        offset[i] = ( offset[i] * centerValue ) / ( norm_grad_phi_squared + minNorm );
         }
 
-      m_UpdateBuffer.push_back( df->ComputeUpdate(outputIt, globalData, offset) );
+      m_UpdateBuffer[k] = df->ComputeUpdate(outputIt, globalData, offset);
       }
     else // Don't do interpolation
       {
-      m_UpdateBuffer.push_back( df->ComputeUpdate(outputIt, globalData) );
+      m_UpdateBuffer[k] = df->ComputeUpdate(outputIt, globalData);
       }
     }
-
-  // Ask the finite difference function to compute the time step for
-  // this iteration.  We give it the global data pointer to use, then
-  // ask it to free the global data memory.
-  timeStep = df->ComputeGlobalTimeStep(globalData);
-
-  df->ReleaseGlobalDataPointer(globalData);
-
-  return timeStep;
 }
 
 template< typename TInputImage, typename TOutputImage >
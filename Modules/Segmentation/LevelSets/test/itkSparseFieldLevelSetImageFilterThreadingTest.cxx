@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkThresholdSegmentationLevelSetImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+// Runs the same segmentation with one and with several threads.  The
+// changes at the active layer are distributed over the threads, but the
+// result must not depend on how many threads were used.
+
+namespace
+{
+typedef itk::Image< float, 3 > SFLSTImageType;
+
+SFLSTImageType::Pointer
+SFLSTSegment(const SFLSTImageType *seed, const SFLSTImageType *feature,
+             itk::ThreadIdType numberOfThreads, unsigned int & elapsedIterations,
+             double & rmsChange)
+{
+  typedef itk::ThresholdSegmentationLevelSetImageFilter< SFLSTImageType, SFLSTImageType >
+    FilterType;
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(seed);
+  filter->SetFeatureImage(feature);
+  filter->SetUpperThreshold(63);
+  filter->SetLowerThreshold(50);
+  filter->SetMaximumRMSError(0.0);
+  filter->SetNumberOfIterations(15);
+  filter->ReverseExpansionDirectionOn();
+  filter->SetIsoSurfaceValue(0.5);
+  filter->SetNumberOfThreads(numberOfThreads);
+  filter->Update();
+
+  elapsedIterations = filter->GetElapsedIterations();
+  rmsChange = filter->GetRMSChange();
+
+  SFLSTImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+}
+
+int itkSparseFieldLevelSetImageFilterThreadingTest(int, char * [] )
+{
+  const int size = 64;
+
+  SFLSTImageType::RegionType region;
+  SFLSTImageType::SizeType   sz;
+  sz.Fill(size);
+  region.SetSize(sz);
+
+  SFLSTImageType::Pointer seed = SFLSTImageType::New();
+  SFLSTImageType::Pointer feature = SFLSTImageType::New();
+  seed->SetRegions(region);
+  feature->SetRegions(region);
+  seed->Allocate();
+  feature->Allocate();
+
+  // The starting surface is a sphere, the target surface a diamond.
+  SFLSTImageType::IndexType idx;
+  for ( idx[2] = 0; idx[2] < size; idx[2]++ )
+    {
+    for ( idx[1] = 0; idx[1] < size; idx[1]++ )
+      {
+      for ( idx[0] = 0; idx[0] < size; idx[0]++ )
+        {
+        float dis = 0.0f;
+        float val = 0.0f;
+        for ( unsigned int i = 0; i < 3; ++i )
+          {
+          const float d = ( idx[i] - size / 2.0f ) / ( 0.2f * size );
+          dis += d * d;
+          val += ( idx[i] < size / 2 ) ? idx[i] : size - idx[i];
+          }
+        seed->SetPixel(idx, ( 1.0f - dis >= 0.0f ) ? 1.0f : 0.0f);
+        feature->SetPixel(idx, val);
+        }
+      }
+    }
+
+  unsigned int referenceIterations;
+  double       referenceRMS;
+
+  try
+    {
+    SFLSTImageType::Pointer reference =
+      SFLSTSegment(seed, feature, 1, referenceIterations, referenceRMS);
+
+    const itk::ThreadIdType threadCounts[] = { 2, 3, 8 };
+    for ( unsigned int t = 0; t < 3; ++t )
+      {
+      unsigned int iterations;
+      double       rms;
+      SFLSTImageType::Pointer output =
+        SFLSTSegment(seed, feature, threadCounts[t], iterations, rms);
+
+      if ( iterations != referenceIterations || rms != referenceRMS )
+        {
+        std::cerr << "With " << threadCounts[t] << " threads the filter ran "
+                  << iterations << " iterations with RMS change " << rms
+                  << ", with one thread " << referenceIterations
+                  << " iterations with RMS change " << referenceRMS << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      itk::ImageRegionConstIterator< SFLSTImageType > rit(reference, region);
+      itk::ImageRegionConstIterator< SFLSTImageType > oit(output, region);
+      for ( ; !rit.IsAtEnd(); ++rit, ++oit )
+        {
+        if ( rit.Get() != oit.Get() )
+          {
+          std::cerr << "With " << threadCounts[t] << " threads the output at "
+                    << rit.GetIndex() << " is " << oit.Get()
+                    << " instead of " << rit.Get() << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  catch ( itk::ExceptionObject & e )
+    {
+    std::cerr << e << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  std::cout << referenceIterations << " iterations, RMS change "
+            << referenceRMS << std::endl;
+  std::cout << "Test passed." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -137,6 +137,7 @@ BinaryImageToLevelSetImageAdaptor<
   this->m_LabelMap->Optimize();
 
   this->m_LevelSet->SetLabelMap( this->m_LabelMap );
+  this->m_LevelSet->BuildLayerLookup();
 
   // release the memory
   this->m_InternalImage = ITK_NULLPTR;
@@ -463,6 +464,7 @@ void BinaryImageToLevelSetImageAdaptor< TInput, ShiSparseLevelSetImage< TInput::
   FindActiveLayer();
 
   this->m_LevelSet->SetLabelMap( this->m_LabelMap );
+  this->m_LevelSet->BuildLayerLookup();
   this->m_InternalImage = ITK_NULLPTR;
 }
 
@@ -622,6 +624,7 @@ void BinaryImageToLevelSetImageAdaptor< TInput,MalcolmSparseLevelSetImage< TInpu
   this->CreateMinimalInterface();
 
   this->m_LevelSet->SetLabelMap( this->m_LabelMap );
+  this->m_LevelSet->BuildLayerLookup();
   this->m_InternalImage = ITK_NULLPTR;
 }
 
@@ -332,6 +332,11 @@ public:
   typedef UpdateShiSparseLevelSet< ImageDimension, EquationContainerType >  UpdateLevelSetFilterType;
   typedef typename UpdateLevelSetFilterType::Pointer                        UpdateLevelSetFilterPointer;
 
+  /** Set the maximum number of threads to be used. */
+  void SetNumberOfThreads( const ThreadIdType threads );
+  /** Get the maximum number of threads to be used. */
+  ThreadIdType GetNumberOfThreads() const;
+
 protected:
   LevelSetEvolution();
   ~LevelSetEvolution();
@@ -342,6 +347,8 @@ protected:
   /** Update the equations at the end of 1 iteration */
   virtual void UpdateEquations() ITK_OVERRIDE;
 
+  ThreadIdType m_NumberOfThreads;
+
 private:
   LevelSetEvolution( const Self& );
   void operator = ( const Self& );
@@ -412,6 +419,11 @@ public:
   typedef UpdateMalcolmSparseLevelSet< ImageDimension, EquationContainerType > UpdateLevelSetFilterType;
   typedef typename UpdateLevelSetFilterType::Pointer UpdateLevelSetFilterPointer;
 
+  /** Set the maximum number of threads to be used. */
+  void SetNumberOfThreads( const ThreadIdType threads );
+  /** Get the maximum number of threads to be used. */
+  ThreadIdType GetNumberOfThreads() const;
+
 protected:
   LevelSetEvolution();
   virtual ~LevelSetEvolution();
@@ -420,6 +432,8 @@ protected:
 
   virtual void UpdateEquations() ITK_OVERRIDE;
 
+  ThreadIdType m_NumberOfThreads;
+
 private:
   LevelSetEvolution( const Self& ); // purposely not implemented
   void operator = ( const Self& );  // purposely not implemented
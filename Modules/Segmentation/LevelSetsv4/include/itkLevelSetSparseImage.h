@@ -24,6 +24,7 @@
 
 #include "itkLabelObject.h"
 #include "itkLabelMap.h"
+#include "itksys/hash_map.hxx"
 
 namespace itk
 {
@@ -31,6 +32,16 @@ namespace itk
  *  \class LevelSetSparseImage
  *  \brief Base class for the sparse representation of a level-set function on one Image.
  *
+ *  The layers are kept as maps sorted by index, and the remaining pixels
+ *  are described by the label map.  To avoid searching every layer and
+ *  every label object for each evaluated pixel, Graft() builds lookup
+ *  tables: a hash table holding the value of each layer pixel, and the
+ *  lines of all label objects sorted by position.  Their size is
+ *  proportional to the narrow band, not to the image.  Any non-const
+ *  access to the layers or to the label map marks the tables as out of
+ *  date, and the slower search is used until BuildLayerLookup() is called
+ *  again.
+ *
  *  \tparam TImage Input image type of the level set function
  *  \todo Think about using image iterators instead of GetPixel()
  *
@@ -94,7 +105,20 @@ public:
 
   /** Set/Get the label map for computing the sparse representation */
   virtual void SetLabelMap( LabelMapType* labelMap );
-  itkGetModifiableObjectMacro(LabelMap, LabelMapType );
+  virtual LabelMapType * GetModifiableLabelMap();
+  virtual const LabelMapType * GetLabelMap() const;
+#if !defined( ITK_FUTURE_LEGACY_REMOVE )
+  virtual LabelMapType * GetLabelMap();
+#endif
+
+  /** Rebuild the tables used to look up the value and the status of a pixel
+   * from the current layers and label map.  This is done by Graft(); call it
+   * after editing the layers or the label map directly. */
+  void BuildLayerLookup();
+
+  /** Whether the lookup tables reflect the current layers and label map. */
+  bool GetLayerLookupValid() const
+  { return m_LayerLookupValid; }
 
   /** Graft data object as level set object */
   virtual void Graft( const DataObject* data ) ITK_OVERRIDE;
@@ -111,6 +135,11 @@ protected:
   LabelMapPointer   m_LabelMap;
   LayerIdListType   m_InternalLabelList;
 
+  /** Sets value to the value at mapIndex (an index in the label map) using
+   * the lookup tables.  Returns false if the tables are out of date or cannot
+   * tell, in which case the layers and the label map have to be searched. */
+  bool LookupValue( const InputType& mapIndex, OutputType& value ) const;
+
   /** Initialize the sparse field layers */
   virtual void InitializeLayers() = 0;
 
@@ -127,6 +156,30 @@ protected:
 private:
   LevelSetSparseImage( const Self& ); // purposely not implemented
   void operator = ( const Self& ); // purposely not implemented
+
+  /** A run of label map pixels along the first dimension. */
+  struct LookupLineType
+    {
+    SizeValueType m_Offset;
+    SizeValueType m_Length;
+    LayerIdType   m_Label;
+
+    bool operator<( const LookupLineType & other ) const
+    { return m_Offset < other.m_Offset; }
+    };
+
+  typedef itksys::hash_map< SizeValueType, OutputType,
+                            itksys::hash< SizeValueType > > LayerLookupType;
+
+  SizeValueType ComputeLookupOffset( const InputType& mapIndex ) const;
+
+  LayerIdType LookupStatus( SizeValueType offset ) const;
+
+  bool                          m_LayerLookupValid;
+  LayerLookupType               m_LayerLookup;
+  std::vector< LookupLineType > m_LookupLines;
+  RegionType                    m_LookupRegion;
+  OffsetValueType               m_LookupOffsetTable[VDimension];
 };
 
 }
@@ -21,13 +21,18 @@
 
 #include "itkLevelSetSparseImage.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
 template< typename TOutput, unsigned int VDimension >
 LevelSetSparseImage< TOutput, VDimension >
-::LevelSetSparseImage()
-{}
+::LevelSetSparseImage() :
+  m_LayerLookupValid( false )
+{
+  std::fill( m_LookupOffsetTable, m_LookupOffsetTable + VDimension, 0 );
+}
 
 
 template< typename TOutput, unsigned int VDimension >
@@ -42,6 +47,10 @@ LevelSetSparseImage< TOutput, VDimension >
 ::Status( const InputType& inputIndex ) const
 {
   InputType mapIndex = inputIndex - this->m_DomainOffset;
+  if( this->m_LayerLookupValid && this->m_LookupRegion.IsInside( mapIndex ) )
+    {
+    return this->LookupStatus( this->ComputeLookupOffset( mapIndex ) );
+    }
   return this->m_LabelMap->GetPixel( mapIndex );
 }
 
@@ -52,6 +61,7 @@ LevelSetSparseImage< TOutput, VDimension >
 ::SetLabelMap( LabelMapType* labelMap )
 {
   this->m_LabelMap = labelMap;
+  this->m_LayerLookupValid = false;
 
   typedef typename LabelMapType::SpacingType SpacingType;
 
@@ -66,6 +76,36 @@ LevelSetSparseImage< TOutput, VDimension >
 }
 
 
+template< typename TOutput, unsigned int VDimension >
+typename LevelSetSparseImage< TOutput, VDimension >::LabelMapType *
+LevelSetSparseImage< TOutput, VDimension >
+::GetModifiableLabelMap()
+{
+  this->m_LayerLookupValid = false;
+  return this->m_LabelMap.GetPointer();
+}
+
+
+template< typename TOutput, unsigned int VDimension >
+const typename LevelSetSparseImage< TOutput, VDimension >::LabelMapType *
+LevelSetSparseImage< TOutput, VDimension >
+::GetLabelMap() const
+{
+  return this->m_LabelMap.GetPointer();
+}
+
+
+#if !defined( ITK_FUTURE_LEGACY_REMOVE )
+template< typename TOutput, unsigned int VDimension >
+typename LevelSetSparseImage< TOutput, VDimension >::LabelMapType *
+LevelSetSparseImage< TOutput, VDimension >
+::GetLabelMap()
+{
+  return this->GetModifiableLabelMap();
+}
+#endif
+
+
 template< typename TOutput, unsigned int VDimension >
 bool
 LevelSetSparseImage< TOutput, VDimension >
@@ -102,6 +142,7 @@ LevelSetSparseImage< TOutput, VDimension >
     LayerMapType newLayers( levelSet->m_Layers );
     std::swap( m_Layers, newLayers );
     }
+  this->BuildLayerLookup();
 }
 
 
@@ -122,6 +163,7 @@ template< typename TOutput, unsigned int VDimension >
 typename LevelSetSparseImage< TOutput, VDimension >::LayerType&
 LevelSetSparseImage< TOutput, VDimension >::GetLayer( LayerIdType value )
 {
+  this->m_LayerLookupValid = false;
   LayerMapIterator it = m_Layers.find( value );
   if( it == m_Layers.end() )
     {
@@ -139,6 +181,7 @@ LevelSetSparseImage< TOutput, VDimension >
   const LayerMapIterator it = m_Layers.find( value );
   if( it != m_Layers.end() )
     {
+    this->m_LayerLookupValid = false;
     it->second = layer;
     }
   else
@@ -156,11 +199,153 @@ LevelSetSparseImage< TOutput, VDimension >
   Superclass::Initialize();
 
   this->m_LabelMap = ITK_NULLPTR;
+  this->m_LayerLookupValid = false;
   this->InitializeLayers();
   this->InitializeInternalLabelList();
 }
 
 
+template< typename TOutput, unsigned int VDimension >
+void
+LevelSetSparseImage< TOutput, VDimension >
+::BuildLayerLookup()
+{
+  this->m_LayerLookupValid = false;
+  this->m_LayerLookup.clear();
+  this->m_LookupLines.clear();
+
+  if( this->m_LabelMap.IsNull() )
+    {
+    return;
+    }
+
+  this->m_LookupRegion = this->m_LabelMap->GetLargestPossibleRegion();
+  OffsetValueType stride = 1;
+  for( unsigned int dim = 0; dim < Dimension; ++dim )
+    {
+    this->m_LookupOffsetTable[dim] = stride;
+    stride *= static_cast< OffsetValueType >( this->m_LookupRegion.GetSize( dim ) );
+    }
+
+  SizeValueType numberOfLayerNodes = 0;
+  LayerMapConstIterator layerIt = this->m_Layers.begin();
+  while( layerIt != this->m_Layers.end() )
+    {
+    numberOfLayerNodes += static_cast< SizeValueType >( layerIt->second.size() );
+    ++layerIt;
+    }
+  this->m_LayerLookup.resize( numberOfLayerNodes );
+
+  layerIt = this->m_Layers.begin();
+  while( layerIt != this->m_Layers.end() )
+    {
+    LayerConstIterator nodeIt = layerIt->second.begin();
+    while( nodeIt != layerIt->second.end() )
+      {
+      if( !this->m_LookupRegion.IsInside( nodeIt->first ) )
+        {
+        // Such a layer cannot be described by the tables.
+        this->m_LayerLookup.clear();
+        return;
+        }
+      this->m_LayerLookup[ this->ComputeLookupOffset( nodeIt->first ) ] = nodeIt->second;
+      ++nodeIt;
+      }
+    ++layerIt;
+    }
+
+  typename LabelMapType::ConstIterator labelIt( this->m_LabelMap );
+  while( !labelIt.IsAtEnd() )
+    {
+    const LabelObjectType * labelObject = labelIt.GetLabelObject();
+    const SizeValueType numberOfLines = labelObject->GetNumberOfLines();
+    for( SizeValueType i = 0; i < numberOfLines; ++i )
+      {
+      const LabelObjectLineType & line = labelObject->GetLine( i );
+      LookupLineType lookupLine;
+      lookupLine.m_Offset = this->ComputeLookupOffset( line.GetIndex() );
+      lookupLine.m_Length = line.GetLength();
+      lookupLine.m_Label = labelObject->GetLabel();
+      this->m_LookupLines.push_back( lookupLine );
+      }
+    ++labelIt;
+    }
+  std::sort( this->m_LookupLines.begin(), this->m_LookupLines.end() );
+
+  this->m_LayerLookupValid = true;
+}
+
+
+template< typename TOutput, unsigned int VDimension >
+SizeValueType
+LevelSetSparseImage< TOutput, VDimension >
+::ComputeLookupOffset( const InputType& mapIndex ) const
+{
+  const InputType & start = this->m_LookupRegion.GetIndex();
+  OffsetValueType offset = 0;
+  for( unsigned int dim = 0; dim < Dimension; ++dim )
+    {
+    offset += ( mapIndex[dim] - start[dim] ) * this->m_LookupOffsetTable[dim];
+    }
+  return static_cast< SizeValueType >( offset );
+}
+
+
+template< typename TOutput, unsigned int VDimension >
+typename LevelSetSparseImage< TOutput, VDimension >::LayerIdType
+LevelSetSparseImage< TOutput, VDimension >
+::LookupStatus( SizeValueType offset ) const
+{
+  LookupLineType key;
+  key.m_Offset = offset;
+
+  // The last line starting at or before offset is the only candidate.
+  typename std::vector< LookupLineType >::const_iterator lineIt =
+    std::upper_bound( this->m_LookupLines.begin(), this->m_LookupLines.end(), key );
+  if( lineIt != this->m_LookupLines.begin() )
+    {
+    --lineIt;
+    if( offset < lineIt->m_Offset + lineIt->m_Length )
+      {
+      return lineIt->m_Label;
+      }
+    }
+  return this->m_LabelMap->GetBackgroundValue();
+}
+
+
+template< typename TOutput, unsigned int VDimension >
+bool
+LevelSetSparseImage< TOutput, VDimension >
+::LookupValue( const InputType& mapIndex, OutputType& value ) const
+{
+  if( !this->m_LayerLookupValid || !this->m_LookupRegion.IsInside( mapIndex ) )
+    {
+    return false;
+    }
+
+  const SizeValueType offset = this->ComputeLookupOffset( mapIndex );
+
+  typename LayerLookupType::const_iterator it = this->m_LayerLookup.find( offset );
+  if( it != this->m_LayerLookup.end() )
+    {
+    value = it->second;
+    return true;
+    }
+
+  // Outside of the layers the value is given by the status.  A status that
+  // names a layer means the label map and the layers disagree; leave it to
+  // the full search to report.
+  const LayerIdType status = this->LookupStatus( offset );
+  if( this->m_Layers.find( status ) != this->m_Layers.end() )
+    {
+    return false;
+    }
+  value = static_cast< OutputType >( status );
+  return true;
+}
+
+
 template< typename TOutput, unsigned int VDimension >
 void
 LevelSetSparseImage< TOutput, VDimension >
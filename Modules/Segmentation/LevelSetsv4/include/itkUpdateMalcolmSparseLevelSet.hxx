@@ -34,6 +34,7 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 {
   this->m_Offset.Fill( 0 );
   this->m_OutputLevelSet = LevelSetType::New();
+  this->m_EvaluateThreader = EvaluateThreaderType::New();
 }
 
 template< unsigned int VDimension, typename TEquationContainer >
@@ -41,6 +42,38 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 ::~UpdateMalcolmSparseLevelSet()
 {}
 
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
+::SetNumberOfThreads( const ThreadIdType numberOfThreads )
+{
+  this->m_EvaluateThreader->SetMaximumNumberOfThreads( numberOfThreads );
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+ThreadIdType
+UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
+::GetNumberOfThreads() const
+{
+  return this->m_EvaluateThreader->GetMaximumNumberOfThreads();
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
+::EvaluateLayer( const LevelSetLayerType & layer )
+{
+  this->m_NodeUpdates.clear();
+  if( layer.empty() )
+    {
+    return;
+    }
+
+  typedef typename EvaluateThreaderType::DomainType DomainType;
+  DomainType completeDomain( layer.begin(), layer.end() );
+  this->m_EvaluateThreader->Execute( this, completeDomain );
+}
+
 
 template< unsigned int VDimension, typename TEquationContainer >
 void
@@ -54,13 +87,21 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 
   this->m_Offset = this->m_InputLevelSet->GetDomainOffset();
 
-  this->m_OutputLevelSet->SetLayer( LevelSetType::ZeroLayer(), this->m_InputLevelSet->GetLayer( LevelSetType::ZeroLayer() ) );
-  this->m_OutputLevelSet->SetLabelMap( this->m_InputLevelSet->GetModifiableLabelMap() );
+  // the input is only read until the end of the update: any non-const
+  // access would drop the lookup tables built by its last Graft(), through
+  // which the equation is evaluated
+  const LevelSetType * inputLevelSet = this->m_InputLevelSet.GetPointer();
+  if( !inputLevelSet->GetLayerLookupValid() )
+    {
+    this->m_InputLevelSet->BuildLayerLookup();
+    }
+
+  this->m_OutputLevelSet->SetLayer( LevelSetType::ZeroLayer(), inputLevelSet->GetLayer( LevelSetType::ZeroLayer() ) );
   this->m_OutputLevelSet->SetDomainOffset( this->m_Offset );
 
   typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
   typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
-  labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
+  labelMapToLabelImageFilter->SetInput( inputLevelSet->GetLabelMap() );
   labelMapToLabelImageFilter->Update();
 
   this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
@@ -124,8 +165,11 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
   labelImageToLabelMapFilter->SetBackgroundValue( LevelSetType::PlusOneLayer() );
   labelImageToLabelMapFilter->Update();
 
-  LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap( );
+  // the label map is shared with the input, whose lookup tables are dropped
+  // here as they no longer match it
+  LevelSetLabelMapPointer outputLabelMap = this->m_InputLevelSet->GetModifiableLabelMap();
   outputLabelMap->Graft( labelImageToLabelMapFilter->GetOutput() );
+  this->m_OutputLevelSet->SetLabelMap( outputLabelMap );
 }
 
 template< unsigned int VDimension,
@@ -134,20 +178,18 @@ void
 UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 ::FillUpdateContainer()
 {
-  LevelSetLayerType levelZero = this->m_OutputLevelSet->GetLayer( LevelSetType::ZeroLayer() );
+  const LevelSetLayerType & levelZero = this->m_OutputLevelSet->GetLayer( LevelSetType::ZeroLayer() );
 
-  LevelSetLayerIterator nodeIt = levelZero.begin();
-  LevelSetLayerIterator nodeEnd = levelZero.end();
+  this->EvaluateLayer( levelZero );
+  typename std::vector< LevelSetOutputRealType >::const_iterator updateIt = this->m_NodeUpdates.begin();
 
-  TermContainerPointer termContainer = this->m_EquationContainer->GetEquation( this->m_CurrentLevelSetId );
+  LevelSetLayerConstIterator nodeIt = levelZero.begin();
+  LevelSetLayerConstIterator nodeEnd = levelZero.end();
 
-  LevelSetInputType inputIndex;
   while( nodeIt != nodeEnd )
     {
     const LevelSetInputType currentIndex = nodeIt->first;
-    inputIndex = currentIndex + this->m_Offset;
-
-    const LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
+    const LevelSetOutputRealType update = *updateIt;
 
     LevelSetOutputType value = NumericTraits< LevelSetOutputType >::ZeroValue();
 
@@ -160,9 +202,10 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
       value = - NumericTraits< LevelSetOutputType >::OneValue();
       }
 
-    this->m_Update.insert( NodePairType( currentIndex, value ) );
+    this->m_Update.insert( this->m_Update.end(), NodePairType( currentIndex, value ) );
 
     ++nodeIt;
+    ++updateIt;
     }
 }
 
@@ -27,6 +27,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkLabelMapToLabelImageFilter.h"
 #include "itkLabelImageToLabelMapFilter.h"
+#include "itkUpdateSparseLevelSetEvaluateThreader.h"
 
 namespace itk
 {
@@ -103,6 +104,12 @@ public:
   itkSetMacro( CurrentLevelSetId, IdentifierType );
   itkGetMacro( CurrentLevelSetId, IdentifierType );
 
+  /** Set/Get the maximum number of threads used to evaluate the equation
+   * over a layer. The layers are still moved on a single thread, so the
+   * output does not depend on this value. */
+  void SetNumberOfThreads( const ThreadIdType numberOfThreads );
+  ThreadIdType GetNumberOfThreads() const;
+
 protected:
   UpdateShiSparseLevelSet();
   virtual ~UpdateShiSparseLevelSet();
@@ -144,6 +151,17 @@ private:
   LevelSetOffsetType m_Offset;
 
   typedef std::pair< LevelSetInputType, LevelSetOutputType > NodePairType;
+
+  typedef UpdateSparseLevelSetEvaluateThreader< Self > EvaluateThreaderType;
+  friend class UpdateSparseLevelSetEvaluateThreader< Self >;
+  typename EvaluateThreaderType::Pointer m_EvaluateThreader;
+
+  /** Equation values at the nodes of the last layer handed to
+   * EvaluateLayer(), in the order of the layer. */
+  std::vector< LevelSetOutputRealType > m_NodeUpdates;
+
+  /** Evaluate the equation at every node of the layer into m_NodeUpdates. */
+  void EvaluateLayer( const LevelSetLayerType & layer );
 };
 }
 
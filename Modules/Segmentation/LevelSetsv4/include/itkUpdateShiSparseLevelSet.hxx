@@ -32,6 +32,7 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
 {
   this->m_Offset.Fill( 0 );
   this->m_OutputLevelSet = LevelSetType::New();
+  this->m_EvaluateThreader = EvaluateThreaderType::New();
 }
 
 template< unsigned int VDimension,
@@ -40,6 +41,38 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
 ::~UpdateShiSparseLevelSet()
 {}
 
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::SetNumberOfThreads( const ThreadIdType numberOfThreads )
+{
+  this->m_EvaluateThreader->SetMaximumNumberOfThreads( numberOfThreads );
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+ThreadIdType
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::GetNumberOfThreads() const
+{
+  return this->m_EvaluateThreader->GetMaximumNumberOfThreads();
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::EvaluateLayer( const LevelSetLayerType & layer )
+{
+  this->m_NodeUpdates.clear();
+  if( layer.empty() )
+    {
+    return;
+    }
+
+  typedef typename EvaluateThreaderType::DomainType DomainType;
+  DomainType completeDomain( layer.begin(), layer.end() );
+  this->m_EvaluateThreader->Execute( this, completeDomain );
+}
+
 
 template< unsigned int VDimension, typename TEquationContainer >
 void
@@ -55,15 +88,22 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
 
   TermContainerPointer termContainer = this->m_EquationContainer->GetEquation( this->m_CurrentLevelSetId );
 
-  this->m_OutputLevelSet->SetLayer( LevelSetType::MinusOneLayer(), this->m_InputLevelSet->GetLayer( LevelSetType::MinusOneLayer() ) );
-  this->m_OutputLevelSet->SetLayer( LevelSetType::PlusOneLayer(), this->m_InputLevelSet->GetLayer( LevelSetType::PlusOneLayer() ) );
+  // the input is only read until the end of the update: any non-const
+  // access would drop the lookup tables built by its last Graft(), through
+  // which the equation is evaluated
+  const LevelSetType * inputLevelSet = this->m_InputLevelSet.GetPointer();
+  if( !inputLevelSet->GetLayerLookupValid() )
+    {
+    this->m_InputLevelSet->BuildLayerLookup();
+    }
 
-  this->m_OutputLevelSet->SetLabelMap( this->m_InputLevelSet->GetModifiableLabelMap() );
+  this->m_OutputLevelSet->SetLayer( LevelSetType::MinusOneLayer(), inputLevelSet->GetLayer( LevelSetType::MinusOneLayer() ) );
+  this->m_OutputLevelSet->SetLayer( LevelSetType::PlusOneLayer(), inputLevelSet->GetLayer( LevelSetType::PlusOneLayer() ) );
   this->m_OutputLevelSet->SetDomainOffset( this->m_Offset );
 
   typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
   typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
-  labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
+  labelMapToLabelImageFilter->SetInput( inputLevelSet->GetLabelMap() );
   labelMapToLabelImageFilter->Update();
 
   this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
@@ -190,8 +230,11 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   labelImageToLabelMapFilter->SetBackgroundValue( LevelSetType::PlusThreeLayer() );
   labelImageToLabelMapFilter->Update();
 
-  LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap( );
+  // the label map is shared with the input, whose lookup tables are dropped
+  // here as they no longer match it
+  LevelSetLabelMapPointer outputLabelMap = this->m_InputLevelSet->GetModifiableLabelMap();
   outputLabelMap->Graft( labelImageToLabelMapFilter->GetOutput() );
+  this->m_OutputLevelSet->SetLabelMap( outputLabelMap );
 }
 
 template< unsigned int VDimension, typename TEquationContainer >
@@ -229,21 +272,24 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   LevelSetLayerType insertListIn;
   LevelSetLayerType insertListOut;
 
+  // nothing done to the layer below changes the equation, which can then be
+  // evaluated for all the nodes at once
+  this->EvaluateLayer( listOut );
+  typename std::vector< LevelSetOutputRealType >::const_iterator updateIt = this->m_NodeUpdates.begin();
+
   LevelSetLayerIterator nodeIt   = listOut.begin();
   LevelSetLayerIterator nodeEnd  = listOut.end();
 
-  LevelSetInputType inputIndex;
-
   // for each point in Lz
   while( nodeIt != nodeEnd )
     {
     bool erased = false;
     const LevelSetInputType   currentIndex = nodeIt->first;
     const LevelSetOutputType  currentValue = nodeIt->second;
-    inputIndex = currentIndex + this->m_Offset;
 
     // update the level set
-    LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
+    const LevelSetOutputRealType update = *updateIt;
+    ++updateIt;
 
     if( update < NumericTraits< LevelSetOutputRealType >::ZeroValue() )
       {
@@ -346,6 +392,9 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   LevelSetLayerType insertListIn;
   LevelSetLayerType insertListOut;
 
+  this->EvaluateLayer( listIn );
+  typename std::vector< LevelSetOutputRealType >::const_iterator updateIt = this->m_NodeUpdates.begin();
+
   LevelSetLayerIterator nodeIt   = listIn.begin();
   LevelSetLayerIterator nodeEnd  = listIn.end();
 
@@ -355,10 +404,10 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
     bool erased = false;
     const LevelSetInputType   currentIndex = nodeIt->first;
     const LevelSetOutputType  currentValue = nodeIt->second;
-    const LevelSetInputType inputIndex = currentIndex + this->m_Offset;
 
     // update for the current level set
-    LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
+    const LevelSetOutputRealType update = *updateIt;
+    ++updateIt;
 
     if( update > NumericTraits< LevelSetOutputRealType >::ZeroValue() )
       {
@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkUpdateSparseLevelSetEvaluateThreader_h
+#define itkUpdateSparseLevelSetEvaluateThreader_h
+
+#include "itkDomainThreader.h"
+#include "itkThreadedIteratorRangePartitioner.h"
+
+namespace itk
+{
+
+/** \class UpdateSparseLevelSetEvaluateThreader
+ * \brief Evaluate the equation at every node of a sparse level set layer.
+ *
+ * Used by UpdateShiSparseLevelSet and UpdateMalcolmSparseLevelSet to
+ * evaluate the term container of the current level set for a whole layer
+ * before the layer is moved node by node. Each thread handles a contiguous
+ * range of the layer and the values are gathered in the order of the
+ * layer into the \c m_NodeUpdates member of the associate, so the result
+ * does not depend on the number of threads.
+ *
+ * \ingroup ITKLevelSetsv4
+ */
+template< typename TUpdateSparseLevelSet >
+class UpdateSparseLevelSetEvaluateThreader
+  : public DomainThreader< ThreadedIteratorRangePartitioner< typename TUpdateSparseLevelSet::LevelSetLayerConstIterator >, TUpdateSparseLevelSet >
+{
+public:
+  /** Standard class typedefs. */
+  typedef UpdateSparseLevelSetEvaluateThreader                                                                                            Self;
+  typedef DomainThreader< ThreadedIteratorRangePartitioner< typename TUpdateSparseLevelSet::LevelSetLayerConstIterator >, TUpdateSparseLevelSet > Superclass;
+  typedef SmartPointer< Self >                                                                                                            Pointer;
+  typedef SmartPointer< const Self >                                                                                                      ConstPointer;
+
+  /** Run time type information. */
+  itkTypeMacro( UpdateSparseLevelSetEvaluateThreader, DomainThreader );
+
+  /** Standard New macro. */
+  itkNewMacro( Self );
+
+  /** Superclass types. */
+  typedef typename Superclass::DomainType    DomainType;
+  typedef typename Superclass::AssociateType AssociateType;
+
+  /** Types of the associate class. */
+  typedef TUpdateSparseLevelSet                                          UpdateSparseLevelSetType;
+  typedef typename UpdateSparseLevelSetType::LevelSetInputType          LevelSetInputType;
+  typedef typename UpdateSparseLevelSetType::LevelSetOutputRealType     LevelSetOutputRealType;
+  typedef typename UpdateSparseLevelSetType::LevelSetLayerConstIterator LevelSetLayerConstIterator;
+  typedef typename UpdateSparseLevelSetType::TermContainerPointer       TermContainerPointer;
+
+protected:
+  UpdateSparseLevelSetEvaluateThreader();
+
+  virtual void BeforeThreadedExecution() ITK_OVERRIDE;
+
+  virtual void ThreadedExecution( const DomainType & iteratorSubRange, const ThreadIdType threadId ) ITK_OVERRIDE;
+
+  virtual void AfterThreadedExecution() ITK_OVERRIDE;
+
+  std::vector< std::vector< LevelSetOutputRealType > > m_NodeUpdatesPerThread;
+
+private:
+  UpdateSparseLevelSetEvaluateThreader( const Self & ); // purposely not implemented
+  void operator=( const Self & ); // purposely not implemented
+};
+
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkUpdateSparseLevelSetEvaluateThreader.hxx"
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkUpdateSparseLevelSetEvaluateThreader_hxx
+#define itkUpdateSparseLevelSetEvaluateThreader_hxx
+
+#include "itkUpdateSparseLevelSetEvaluateThreader.h"
+
+namespace itk
+{
+
+template< typename TUpdateSparseLevelSet >
+UpdateSparseLevelSetEvaluateThreader< TUpdateSparseLevelSet >
+::UpdateSparseLevelSetEvaluateThreader()
+{
+}
+
+template< typename TUpdateSparseLevelSet >
+void
+UpdateSparseLevelSetEvaluateThreader< TUpdateSparseLevelSet >
+::BeforeThreadedExecution()
+{
+  const ThreadIdType numberOfThreads = this->GetNumberOfThreadsUsed();
+  this->m_NodeUpdatesPerThread.resize( numberOfThreads );
+
+  for( ThreadIdType ii = 0; ii < numberOfThreads; ++ii )
+    {
+    this->m_NodeUpdatesPerThread[ii].clear();
+    }
+}
+
+template< typename TUpdateSparseLevelSet >
+void
+UpdateSparseLevelSetEvaluateThreader< TUpdateSparseLevelSet >
+::ThreadedExecution( const DomainType & iteratorSubRange,
+                     const ThreadIdType threadId )
+{
+  TermContainerPointer termContainer =
+    this->m_Associate->m_EquationContainer->GetEquation( this->m_Associate->m_CurrentLevelSetId );
+
+  std::vector< LevelSetOutputRealType > & nodeUpdates = this->m_NodeUpdatesPerThread[threadId];
+  nodeUpdates.reserve( std::distance( iteratorSubRange.Begin(), iteratorSubRange.End() ) );
+
+  LevelSetLayerConstIterator nodeIt = iteratorSubRange.Begin();
+  while( nodeIt != iteratorSubRange.End() )
+    {
+    const LevelSetInputType inputIndex = nodeIt->first + this->m_Associate->m_Offset;
+    nodeUpdates.push_back( termContainer->Evaluate( inputIndex ) );
+    ++nodeIt;
+    }
+}
+
+template< typename TUpdateSparseLevelSet >
+void
+UpdateSparseLevelSetEvaluateThreader< TUpdateSparseLevelSet >
+::AfterThreadedExecution()
+{
+  // the sub-ranges are handed out in order, so concatenating them in thread
+  // order gives the values in the order of the layer
+  std::vector< LevelSetOutputRealType > & nodeUpdates = this->m_Associate->m_NodeUpdates;
+  nodeUpdates.clear();
+
+  const ThreadIdType numberOfThreads = this->GetNumberOfThreadsUsed();
+  for( ThreadIdType ii = 0; ii < numberOfThreads; ++ii )
+    {
+    nodeUpdates.insert( nodeUpdates.end(),
+                        this->m_NodeUpdatesPerThread[ii].begin(),
+                        this->m_NodeUpdatesPerThread[ii].end() );
+    this->m_NodeUpdatesPerThread[ii].clear();
+    }
+}
+
+} // end namespace itk
+
+#endif
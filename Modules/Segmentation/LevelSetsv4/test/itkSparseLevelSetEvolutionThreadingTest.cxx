@@ -0,0 +1,248 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkSinRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetEvolution.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkSimpleFastMutexLock.h"
+
+namespace
+{
+const unsigned int Dimension = 2;
+
+typedef unsigned short                                      InputPixelType;
+typedef itk::Image< InputPixelType, Dimension >             InputImageType;
+typedef itk::ImageRegionIteratorWithIndex< InputImageType > InputIteratorType;
+
+// Chan and Vese internal term that counts the evaluations made while the
+// lookup tables of the level set are out of date, i.e. through the slow
+// search of the layers and of the label map.
+template< typename TInput, typename TLevelSetContainer >
+class LookupCheckingTerm :
+  public itk::LevelSetEquationChanAndVeseInternalTerm< TInput, TLevelSetContainer >
+{
+public:
+  typedef LookupCheckingTerm                        Self;
+  typedef itk::SmartPointer< Self >                 Pointer;
+  typedef itk::SmartPointer< const Self >           ConstPointer;
+  typedef itk::LevelSetEquationChanAndVeseInternalTerm< TInput, TLevelSetContainer >
+                                                    Superclass;
+
+  itkNewMacro( Self );
+
+  typedef typename Superclass::LevelSetOutputRealType LevelSetOutputRealType;
+  typedef typename Superclass::LevelSetInputIndexType LevelSetInputIndexType;
+
+  itk::SizeValueType GetNumberOfEvaluationsWithoutLookup() const
+  {
+    return this->m_NumberOfEvaluationsWithoutLookup;
+  }
+
+protected:
+  LookupCheckingTerm() : m_NumberOfEvaluationsWithoutLookup( 0 ) {}
+
+  virtual LevelSetOutputRealType Value( const LevelSetInputIndexType & inputPixel ) ITK_OVERRIDE
+  {
+    if( !this->m_CurrentLevelSetPointer->GetLayerLookupValid() )
+      {
+      this->m_Mutex.Lock();
+      ++this->m_NumberOfEvaluationsWithoutLookup;
+      this->m_Mutex.Unlock();
+      }
+    return Superclass::Value( inputPixel );
+  }
+
+private:
+  itk::SimpleFastMutexLock m_Mutex;
+  itk::SizeValueType       m_NumberOfEvaluationsWithoutLookup;
+};
+
+// Evolves a square towards a bright disk with the given number of threads and
+// returns the resulting level set. Fails if the equation was evaluated
+// without the lookup tables of the level set.
+template< typename TLevelSet >
+typename TLevelSet::Pointer
+EvolveSparseLevelSet( InputImageType * input, itk::ThreadIdType numberOfThreads )
+{
+  typedef TLevelSet                                              SparseLevelSetType;
+  typedef itk::BinaryImageToLevelSetImageAdaptor< InputImageType, SparseLevelSetType >
+                                                                 BinaryToSparseAdaptorType;
+  typedef itk::LevelSetContainer< itk::IdentifierType, SparseLevelSetType >
+                                                                 LevelSetContainerType;
+  typedef LookupCheckingTerm< InputImageType, LevelSetContainerType >
+                                                                 ChanAndVeseInternalTermType;
+  typedef itk::LevelSetEquationChanAndVeseExternalTerm< InputImageType, LevelSetContainerType >
+                                                                 ChanAndVeseExternalTermType;
+  typedef itk::LevelSetEquationTermContainer< InputImageType, LevelSetContainerType >
+                                                                 TermContainerType;
+  typedef itk::LevelSetEquationContainer< TermContainerType >    EquationContainerType;
+  typedef itk::LevelSetEvolution< EquationContainerType, SparseLevelSetType >
+                                                                 LevelSetEvolutionType;
+  typedef typename SparseLevelSetType::OutputRealType            LevelSetOutputRealType;
+  typedef itk::SinRegularizedHeavisideStepFunction< LevelSetOutputRealType, LevelSetOutputRealType >
+                                                                 HeavisideFunctionBaseType;
+  typedef itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion< LevelSetContainerType >
+                                                                 StoppingCriterionType;
+
+  InputImageType::Pointer binary = InputImageType::New();
+  binary->SetRegions( input->GetLargestPossibleRegion() );
+  binary->CopyInformation( input );
+  binary->Allocate();
+  binary->FillBuffer( itk::NumericTraits< InputPixelType >::ZeroValue() );
+
+  InputImageType::IndexType index;
+  index.Fill( 8 );
+  InputImageType::SizeType size;
+  size.Fill( 20 );
+  InputImageType::RegionType region( index, size );
+
+  InputIteratorType iIt( binary, region );
+  for( iIt.GoToBegin(); !iIt.IsAtEnd(); ++iIt )
+    {
+    iIt.Set( itk::NumericTraits< InputPixelType >::OneValue() );
+    }
+
+  typename BinaryToSparseAdaptorType::Pointer adaptor = BinaryToSparseAdaptorType::New();
+  adaptor->SetInputImage( binary );
+  adaptor->Initialize();
+
+  typename SparseLevelSetType::Pointer levelSet = adaptor->GetModifiableLevelSet();
+
+  typename HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+  heaviside->SetEpsilon( 2.0 );
+
+  typename LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside( heaviside );
+  lscontainer->AddLevelSet( 0, levelSet, false );
+
+  typename ChanAndVeseInternalTermType::Pointer cvInternalTerm = ChanAndVeseInternalTermType::New();
+  cvInternalTerm->SetInput( input );
+  cvInternalTerm->SetCoefficient( 1.0 );
+
+  typename ChanAndVeseExternalTermType::Pointer cvExternalTerm = ChanAndVeseExternalTermType::New();
+  cvExternalTerm->SetInput( input );
+  cvExternalTerm->SetCoefficient( 1.0 );
+
+  typename TermContainerType::Pointer termContainer = TermContainerType::New();
+  termContainer->SetInput( input );
+  termContainer->SetCurrentLevelSetId( 0 );
+  termContainer->SetLevelSetContainer( lscontainer );
+  termContainer->AddTerm( 0, cvInternalTerm );
+  termContainer->AddTerm( 1, cvExternalTerm );
+
+  typename EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer( lscontainer );
+  equationContainer->AddEquation( 0, termContainer );
+
+  typename StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations( 12 );
+
+  typename LevelSetEvolutionType::Pointer evolution = LevelSetEvolutionType::New();
+  evolution->SetEquationContainer( equationContainer );
+  evolution->SetStoppingCriterion( criterion );
+  evolution->SetLevelSetContainer( lscontainer );
+  evolution->SetNumberOfThreads( numberOfThreads );
+  if( evolution->GetNumberOfThreads() != numberOfThreads )
+    {
+    std::cerr << "GetNumberOfThreads() returned " << evolution->GetNumberOfThreads()
+              << " instead of " << numberOfThreads << std::endl;
+    return ITK_NULLPTR;
+    }
+  evolution->Update();
+
+  if( cvInternalTerm->GetNumberOfEvaluationsWithoutLookup() != 0 )
+    {
+    std::cerr << cvInternalTerm->GetNumberOfEvaluationsWithoutLookup()
+              << " evaluations without the lookup tables with "
+              << numberOfThreads << " threads" << std::endl;
+    return ITK_NULLPTR;
+    }
+
+  return levelSet;
+}
+
+template< typename TLevelSet >
+bool
+CheckThreadedEvolution( const char * name, InputImageType * input )
+{
+  typedef typename TLevelSet::Pointer LevelSetPointer;
+
+  const LevelSetPointer reference = EvolveSparseLevelSet< TLevelSet >( input, 1 );
+  if( reference.IsNull() )
+    {
+    return false;
+    }
+
+  const itk::ThreadIdType numberOfThreads[] = { 2, 3, 7 };
+  for( unsigned int ii = 0; ii < sizeof( numberOfThreads ) / sizeof( numberOfThreads[0] ); ++ii )
+    {
+    const LevelSetPointer threaded = EvolveSparseLevelSet< TLevelSet >( input, numberOfThreads[ii] );
+    if( threaded.IsNull() )
+      {
+      return false;
+      }
+
+    InputIteratorType it( input, input->GetLargestPossibleRegion() );
+    for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      if( reference->Evaluate( it.GetIndex() ) != threaded->Evaluate( it.GetIndex() ) ||
+          reference->Status( it.GetIndex() ) != threaded->Status( it.GetIndex() ) )
+        {
+        std::cerr << name << ": value differs at " << it.GetIndex() << " with "
+                  << numberOfThreads[ii] << " threads" << std::endl;
+        return false;
+        }
+      }
+    }
+
+  std::cout << name << ": identical results with 1, 2, 3 and 7 threads" << std::endl;
+  return true;
+}
+}
+
+int itkSparseLevelSetEvolutionThreadingTest( int, char* [] )
+{
+  // a bright disk partly covered by the initial square
+  InputImageType::Pointer input = InputImageType::New();
+  InputImageType::SizeType size;
+  size.Fill( 48 );
+  input->SetRegions( size );
+  input->Allocate();
+
+  InputIteratorType it( input, input->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const InputImageType::IndexType index = it.GetIndex();
+    const double dx = static_cast< double >( index[0] ) - 26.0;
+    const double dy = static_cast< double >( index[1] ) - 24.0;
+    const double noise = static_cast< double >( ( index[0] * 7 + index[1] * 13 ) % 11 );
+    it.Set( static_cast< InputPixelType >( ( dx * dx + dy * dy < 144.0 ? 200.0 : 40.0 ) + noise ) );
+    }
+
+  bool passed = true;
+  passed &= CheckThreadedEvolution< itk::ShiSparseLevelSetImage< Dimension > >( "Shi", input );
+  passed &= CheckThreadedEvolution< itk::MalcolmSparseLevelSetImage< Dimension > >( "Malcolm", input );
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
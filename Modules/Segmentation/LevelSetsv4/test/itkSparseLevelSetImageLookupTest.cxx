@@ -0,0 +1,128 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+// Checks that the lookup tables of the sparse level sets give the same
+// values and status as searching the layers and the label map.
+
+namespace
+{
+typedef itk::Image< unsigned char, 2 > LookupInputImageType;
+
+template< typename TLevelSet >
+bool
+CheckSparseLevelSetLookup( LookupInputImageType * input, const char * name )
+{
+  typedef itk::BinaryImageToLevelSetImageAdaptor< LookupInputImageType, TLevelSet >
+    AdaptorType;
+
+  typename AdaptorType::Pointer adaptor = AdaptorType::New();
+  adaptor->SetInputImage( input );
+  adaptor->Initialize();
+
+  typename TLevelSet::Pointer levelSet = adaptor->GetModifiableLevelSet();
+  if( !levelSet->GetLayerLookupValid() )
+    {
+    std::cerr << name << ": lookup tables were not built by the adaptor" << std::endl;
+    return false;
+    }
+
+  // Record the answers of the lookup tables.
+  const LookupInputImageType::RegionType region = input->GetLargestPossibleRegion();
+  std::vector< typename TLevelSet::OutputType >  values;
+  std::vector< typename TLevelSet::LayerIdType > status;
+
+  itk::ImageRegionConstIteratorWithIndex< LookupInputImageType > it( input, region );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    values.push_back( levelSet->Evaluate( it.GetIndex() ) );
+    status.push_back( levelSet->Status( it.GetIndex() ) );
+    }
+
+  // Any modifiable access to the label map invalidates the tables, so the
+  // layers and the label map are searched from now on.
+  levelSet->GetModifiableLabelMap();
+  if( levelSet->GetLayerLookupValid() )
+    {
+    std::cerr << name << ": lookup tables still valid after modifiable access" << std::endl;
+    return false;
+    }
+
+  size_t i = 0;
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it, ++i )
+    {
+    const typename TLevelSet::OutputType  value = levelSet->Evaluate( it.GetIndex() );
+    const typename TLevelSet::LayerIdType s = levelSet->Status( it.GetIndex() );
+    if( value != values[i] || s != status[i] )
+      {
+      std::cerr << name << ": at " << it.GetIndex() << " the lookup gives value "
+                << static_cast< double >( values[i] ) << " and status "
+                << static_cast< int >( status[i] ) << ", the search gives value "
+                << static_cast< double >( value ) << " and status "
+                << static_cast< int >( s ) << std::endl;
+      return false;
+      }
+    }
+
+  levelSet->BuildLayerLookup();
+  if( !levelSet->GetLayerLookupValid() )
+    {
+    std::cerr << name << ": lookup tables could not be rebuilt" << std::endl;
+    return false;
+    }
+
+  std::cout << name << ": " << values.size() << " pixels checked" << std::endl;
+  return true;
+}
+}
+
+int itkSparseLevelSetImageLookupTest( int , char* [] )
+{
+  LookupInputImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+
+  LookupInputImageType::Pointer input = LookupInputImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+  input->FillBuffer( 0 );
+
+  // Two disks, one of them touching the image border.
+  itk::ImageRegionIteratorWithIndex< LookupInputImageType > it( input, input->GetLargestPossibleRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const LookupInputImageType::IndexType idx = it.GetIndex();
+    const long dx1 = idx[0] - 10;
+    const long dy1 = idx[1] - 12;
+    const long dx2 = idx[0] - 30;
+    const long dy2 = idx[1] - 24;
+    if( dx1 * dx1 + dy1 * dy1 < 49 || dx2 * dx2 + dy2 * dy2 < 36 )
+      {
+      it.Set( 1 );
+      }
+    }
+
+  bool ok = true;
+  ok &= CheckSparseLevelSetLookup< itk::WhitakerSparseLevelSetImage< double, 2 > >( input, "Whitaker" );
+  ok &= CheckSparseLevelSetLookup< itk::ShiSparseLevelSetImage< 2 > >( input, "Shi" );
+  ok &= CheckSparseLevelSetLookup< itk::MalcolmSparseLevelSetImage< 2 > >( input, "Malcolm" );
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}